@@ -0,0 +1,23 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Types.h>
+#include <AK/kmalloc.h>
+
+namespace AK {
+
+// Containers that take an allocator call allocate() and deallocate() on it for all their storage.
+// This one is what they use unless told otherwise; see AK/Arena.h for an alternative.
+struct DefaultAllocator {
+    void* allocate(size_t size) { return kmalloc(size); }
+    void deallocate(void* ptr, size_t) { kfree(ptr); }
+};
+
+}
+
+using AK::DefaultAllocator;
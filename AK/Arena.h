@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Assertions.h>
+#include <AK/Noncopyable.h>
+#include <AK/StdLibExtras.h>
+#include <AK/Types.h>
+#include <AK/kmalloc.h>
+
+namespace AK {
+
+// A bump allocator: allocating is little more than moving a pointer forward, and nothing is freed until
+// the arena is reset (or destroyed), at which point everything allocated since goes away at once.
+// Destructors are never run, so anything put in here needs to be trivially destructible, or not care.
+class Arena {
+    AK_MAKE_NONCOPYABLE(Arena);
+    AK_MAKE_NONMOVABLE(Arena);
+
+public:
+    static constexpr size_t default_alignment = 2 * sizeof(void*);
+
+private:
+    struct Chunk {
+        Chunk* previous { nullptr };
+        size_t size { 0 };
+        size_t used { 0 };
+
+        u8* data() { return reinterpret_cast<u8*>(this) + header_size; }
+    };
+
+    static constexpr size_t header_size = (sizeof(Chunk) + default_alignment - 1) & ~(default_alignment - 1);
+
+public:
+    // Chunks start out small, so that an arena that only sees a handful of allocations doesn't waste much,
+    // and double in size every time we run out of space, up to max_chunk_size.
+    explicit Arena(size_t initial_chunk_size = 4 * KiB, size_t max_chunk_size = 64 * KiB)
+        : m_next_chunk_size(initial_chunk_size)
+        , m_max_chunk_size(max_chunk_size)
+    {
+    }
+
+    ~Arena()
+    {
+        free_chunks_until(nullptr);
+    }
+
+    [[nodiscard]] void* allocate(size_t size, size_t alignment = default_alignment)
+    {
+        VERIFY(alignment && !(alignment & (alignment - 1)));
+        if (m_current) {
+            size_t offset = (m_current->used + alignment - 1) & ~(alignment - 1);
+            if (offset + size <= m_current->size) {
+                m_current->used = offset + size;
+                m_allocated_bytes += size;
+                return m_current->data() + offset;
+            }
+        }
+        return allocate_in_new_chunk(size, alignment);
+    }
+
+    template<typename T, typename... Args>
+    [[nodiscard]] T& make(Args&&... args)
+    {
+        return *new (allocate(sizeof(T), alignof(T))) T(forward<Args>(args)...);
+    }
+
+    // Everything allocated after a mark was taken can be thrown away by resetting to it.
+    struct Mark {
+        Chunk* chunk { nullptr };
+        size_t used { 0 };
+        size_t allocated_bytes { 0 };
+    };
+
+    Mark mark() const { return { m_current, m_current ? m_current->used : 0, m_allocated_bytes }; }
+
+    void reset_to(const Mark& mark)
+    {
+        if (!mark.chunk) {
+            reset();
+            return;
+        }
+        free_chunks_until(mark.chunk);
+        m_current->used = mark.used;
+        m_allocated_bytes = mark.allocated_bytes;
+    }
+
+    // Throws away everything, but holds on to the most recently allocated chunk to reuse it.
+    // Any marks taken so far are no longer valid afterwards.
+    void reset()
+    {
+        if (!m_current)
+            return;
+        auto* current = m_current;
+        m_current = current->previous;
+        free_chunks_until(nullptr);
+        current->previous = nullptr;
+        current->used = 0;
+        m_current = current;
+        m_allocated_bytes = 0;
+    }
+
+    size_t allocated_bytes() const { return m_allocated_bytes; }
+
+private:
+    void* allocate_in_new_chunk(size_t size, size_t alignment)
+    {
+        // Allocations that wouldn't leave much room in a chunk of their own size get a chunk just for them.
+        size_t data_size = max(m_next_chunk_size, size + alignment);
+        void* slot = kmalloc(header_size + data_size);
+        VERIFY(slot);
+        auto* chunk = new (slot) Chunk;
+        chunk->size = data_size;
+        chunk->previous = m_current;
+        m_current = chunk;
+        if (m_next_chunk_size < m_max_chunk_size)
+            m_next_chunk_size = min(m_next_chunk_size * 2, m_max_chunk_size);
+        return allocate(size, alignment);
+    }
+
+    void free_chunks_until(Chunk* last_chunk_to_keep)
+    {
+        while (m_current != last_chunk_to_keep) {
+            VERIFY(m_current);
+            auto* previous = m_current->previous;
+            kfree(m_current);
+            m_current = previous;
+        }
+    }
+
+    Chunk* m_current { nullptr };
+    size_t m_next_chunk_size { 0 };
+    size_t m_max_chunk_size { 0 };
+    size_t m_allocated_bytes { 0 };
+};
+
+// Resets the arena to the way it was when this was created once it goes out of scope.
+class ArenaScope {
+    AK_MAKE_NONCOPYABLE(ArenaScope);
+    AK_MAKE_NONMOVABLE(ArenaScope);
+
+public:
+    explicit ArenaScope(Arena& arena)
+        : m_arena(arena)
+        , m_mark(arena.mark())
+    {
+    }
+
+    ~ArenaScope() { m_arena.reset_to(m_mark); }
+
+private:
+    Arena& m_arena;
+    Arena::Mark m_mark;
+};
+
+// Lets containers (Vector, HashTable, HashMap) keep their storage in an arena, which has to outlive them.
+// Memory a container lets go of (when it grows, say) only comes back when the arena is reset.
+class ArenaAllocator {
+public:
+    ArenaAllocator(Arena& arena)
+        : m_arena(&arena)
+    {
+    }
+
+    void* allocate(size_t size) { return m_arena->allocate(size); }
+    void deallocate(void*, size_t) { }
+
+    Arena& arena() const { return *m_arena; }
+
+private:
+    Arena* m_arena { nullptr };
+};
+
+}
+
+using AK::Arena;
+using AK::ArenaAllocator;
+using AK::ArenaScope;
@@ -8,6 +8,8 @@
 
 #include <AK/AllOf.h>
 #include <AK/AnyOf.h>
+#include <AK/NumericLimits.h>
+#include <AK/Span.h>
 #include <AK/StdLibExtras.h>
 #include <AK/StringView.h>
 
@@ -137,6 +139,192 @@ consteval auto count_fmt_params(const char (&fmt)[N])
 #endif
 
 namespace AK::Format::Detail {
+
+// A width, precision or argument index from a format string, which can be given right there or refer to an argument.
+struct CompiledFormatArgument {
+    enum class Kind : u8 {
+        None,
+        Value,
+        Index,
+        NextIndex,
+    };
+
+    Kind kind { Kind::None };
+    u32 value { 0 };
+};
+
+// A standard format specification like the one in "{:*<+#08.3x}", taken apart ahead of time. The characters are
+// kept the way they were written, it's up to StandardFormatter to make sense of them.
+struct CompiledFormatSpecifier {
+    char fill { ' ' };
+    char align { 0 };
+    char sign { 0 };
+    char mode { 0 };
+    bool alternative_form { false };
+    bool zero_pad { false };
+    CompiledFormatArgument width;
+    CompiledFormatArgument precision;
+};
+
+// A stretch of literal text from a format string, followed by a replacement field unless it's the last one.
+// Offsets are into the format string, which has to stay around anyway.
+struct CompiledFormatField {
+    u32 literal_start { 0 };
+    u32 literal_length { 0 };
+    bool literal_has_escaped_braces { false };
+
+    bool has_replacement_field { false };
+    CompiledFormatArgument index;
+    u32 flags_start { 0 };
+    u32 flags_length { 0 };
+    // Specifications that aren't standard ones are left for the formatter to parse when it's called.
+    bool has_standard_specifier { false };
+    CompiledFormatSpecifier specifier;
+};
+
+constexpr bool is_format_digit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+constexpr bool consume_format_number(const char* characters, size_t length, size_t& i, u32& value)
+{
+    if (i >= length || !is_format_digit(characters[i]))
+        return false;
+    u64 result = 0;
+    for (; i < length && is_format_digit(characters[i]); ++i) {
+        result = result * 10 + (characters[i] - '0');
+        if (result > NumericLimits<u32>::max())
+            return false;
+    }
+    value = static_cast<u32>(result);
+    return true;
+}
+
+// Parses a width or precision, mirroring StandardFormatter::parse(). Returns false if that would fail.
+constexpr bool compile_format_width(const char* flags, size_t length, size_t& i, CompiledFormatArgument& argument)
+{
+    if (i < length && flags[i] == '{') {
+        ++i;
+        if (consume_format_number(flags, length, i, argument.value))
+            argument.kind = CompiledFormatArgument::Kind::Index;
+        else
+            argument.kind = CompiledFormatArgument::Kind::NextIndex;
+        if (i >= length || flags[i] != '}')
+            return false;
+        ++i;
+        return true;
+    }
+    if (i < length && is_format_digit(flags[i])) {
+        if (!consume_format_number(flags, length, i, argument.value))
+            return false;
+        argument.kind = CompiledFormatArgument::Kind::Value;
+    }
+    return true;
+}
+
+// Takes apart a standard format specification the same way StandardFormatter::parse() would at runtime.
+// Returns false for anything it wouldn't accept, so the formatter gets to parse (and complain about) it itself.
+constexpr bool compile_format_specifier(const char* flags, size_t length, CompiledFormatSpecifier& specifier)
+{
+    auto is_one_of = [](char c, const char* characters) {
+        for (; *characters; ++characters) {
+            if (c == *characters)
+                return true;
+        }
+        return false;
+    };
+
+    size_t i = 0;
+    if (length >= 2 && is_one_of(flags[1], "<^>")) {
+        if (flags[0] == '{' || flags[0] == '}')
+            return false;
+        specifier.fill = flags[i++];
+    }
+    if (i < length && is_one_of(flags[i], "<^>"))
+        specifier.align = flags[i++];
+    if (i < length && is_one_of(flags[i], "-+ "))
+        specifier.sign = flags[i++];
+    if (i < length && flags[i] == '#') {
+        specifier.alternative_form = true;
+        ++i;
+    }
+    if (i < length && flags[i] == '0') {
+        specifier.zero_pad = true;
+        ++i;
+    }
+    if (!compile_format_width(flags, length, i, specifier.width))
+        return false;
+    if (i < length && flags[i] == '.') {
+        ++i;
+        if (!compile_format_width(flags, length, i, specifier.precision))
+            return false;
+    }
+    if (i < length && is_one_of(flags[i], "bBdoxXcspfaA"))
+        specifier.mode = flags[i++];
+    return i == length;
+}
+
+// Splits a format string into fields the same way FormatParser would at runtime. Returns the number of fields used,
+// or 0 if the format string needs more than there are, or is malformed: those are left for the runtime parser.
+constexpr size_t compile_format_string(const char* fmt, size_t length, CompiledFormatField* fields, size_t capacity)
+{
+    size_t count = 0;
+    size_t i = 0;
+    for (;;) {
+        if (count == capacity)
+            return 0;
+        auto& field = fields[count++];
+
+        field.literal_start = i;
+        while (i < length) {
+            auto c = fmt[i];
+            if (c != '{' && c != '}') {
+                ++i;
+                continue;
+            }
+            if (i + 1 < length && fmt[i + 1] == c) {
+                field.literal_has_escaped_braces = true;
+                i += 2;
+                continue;
+            }
+            break;
+        }
+        field.literal_length = i - field.literal_start;
+        if (i == length)
+            return count;
+        if (fmt[i] == '}')
+            return 0;
+
+        ++i;
+        field.has_replacement_field = true;
+        if (consume_format_number(fmt, length, i, field.index.value))
+            field.index.kind = CompiledFormatArgument::Kind::Index;
+        else
+            field.index.kind = CompiledFormatArgument::Kind::NextIndex;
+
+        if (i < length && fmt[i] == ':') {
+            field.flags_start = ++i;
+            size_t level = 1;
+            while (level > 0) {
+                if (i == length)
+                    return 0;
+                if (fmt[i] == '{')
+                    ++level;
+                else if (fmt[i] == '}')
+                    --level;
+                ++i;
+            }
+            field.flags_length = i - field.flags_start - 1;
+        } else {
+            if (i == length || fmt[i] != '}')
+                return 0;
+            field.flags_start = i++;
+        }
+        field.has_standard_specifier = compile_format_specifier(fmt + field.flags_start, field.flags_length, field.specifier);
+    }
+}
+
 template<typename... Args>
 struct CheckedFormatString {
     template<size_t N>
@@ -146,6 +334,11 @@ struct CheckedFormatString {
 #ifdef ENABLE_COMPILETIME_FORMAT_CHECK
         check_format_parameter_consistency<N, sizeof...(Args)>(fmt);
 #endif
+        size_t length = 0;
+        while (length < N && fmt[length] != '\0')
+            ++length;
+        if (length <= NumericLimits<u32>::max())
+            m_compiled_field_count = compile_format_string(fmt, length, m_compiled_fields, compiled_field_capacity);
     }
 
     template<typename T>
@@ -156,6 +349,9 @@ struct CheckedFormatString {
 
     auto view() const { return m_string; }
 
+    // Empty if the format string wasn't known at compile time, or was too complicated to split up ahead of time.
+    Span<const CompiledFormatField> compiled_fields() const { return { m_compiled_fields, m_compiled_field_count }; }
+
 private:
 #ifdef ENABLE_COMPILETIME_FORMAT_CHECK
     template<size_t N, size_t param_count>
@@ -210,7 +406,12 @@ private:
     }
 #endif
 
+    // Every argument being used once makes for a field per argument, plus one for the text after the last one.
+    static constexpr size_t compiled_field_capacity = sizeof...(Args) + 1;
+
     StringView m_string;
+    CompiledFormatField m_compiled_fields[compiled_field_capacity] {};
+    size_t m_compiled_field_count { 0 };
 };
 }
 
@@ -30,32 +30,60 @@ static constexpr size_t use_next_index = NumericLimits<size_t>::max();
 
 // The worst case is that we have the largest 64-bit value formatted as binary number, this would take
 // 65 bytes. Choosing a larger power of two won't hurt and is a bit of mitigation against out-of-bounds accesses.
+// The digits end up at the end of the buffer, so they don't have to be reversed afterwards.
 static constexpr size_t convert_unsigned_to_string(u64 value, Array<u8, 128>& buffer, u8 base, bool upper_case)
 {
     VERIFY(base >= 2 && base <= 16);
 
     constexpr const char* lowercase_lookup = "0123456789abcdef";
     constexpr const char* uppercase_lookup = "0123456789ABCDEF";
-
-    if (value == 0) {
-        buffer[0] = '0';
-        return 1;
+    constexpr const char* decimal_pairs_lookup = "00010203040506070809"
+                                                 "10111213141516171819"
+                                                 "20212223242526272829"
+                                                 "30313233343536373839"
+                                                 "40414243444546474849"
+                                                 "50515253545556575859"
+                                                 "60616263646566676869"
+                                                 "70717273747576777879"
+                                                 "80818283848586878889"
+                                                 "90919293949596979899";
+
+    size_t position = buffer.size();
+
+    if (base == 10) {
+        // Two digits per division, which is what takes the time here.
+        while (value >= 100) {
+            auto pair = (value % 100) * 2;
+            value /= 100;
+            buffer[--position] = decimal_pairs_lookup[pair + 1];
+            buffer[--position] = decimal_pairs_lookup[pair];
+        }
+        if (value >= 10) {
+            buffer[--position] = decimal_pairs_lookup[value * 2 + 1];
+            buffer[--position] = decimal_pairs_lookup[value * 2];
+        } else {
+            buffer[--position] = '0' + value;
+        }
+        return buffer.size() - position;
     }
 
-    size_t used = 0;
-    while (value > 0) {
-        if (upper_case)
-            buffer[used++] = uppercase_lookup[value % base];
-        else
-            buffer[used++] = lowercase_lookup[value % base];
+    const char* lookup = upper_case ? uppercase_lookup : lowercase_lookup;
 
-        value /= base;
+    if (base == 2 || base == 8 || base == 16) {
+        auto shift = base == 2 ? 1 : (base == 8 ? 3 : 4);
+        auto mask = base - 1u;
+        do {
+            buffer[--position] = lookup[value & mask];
+            value >>= shift;
+        } while (value > 0);
+        return buffer.size() - position;
     }
 
-    for (size_t i = 0; i < used / 2; ++i)
-        swap(buffer[i], buffer[used - i - 1]);
-
-    return used;
+    do {
+        buffer[--position] = lookup[value % base];
+        value /= base;
+    } while (value > 0);
+    return buffer.size() - position;
 }
 
 void vformat_impl(TypeErasedFormatParams& params, FormatBuilder& builder, FormatParser& parser)
@@ -75,11 +103,101 @@ void vformat_impl(TypeErasedFormatParams& params, FormatBuilder& builder, Format
     auto& parameter = params.parameters().at(specifier.index);
 
     FormatParser argparser { specifier.flags };
-    parameter.formatter(params, builder, argparser, parameter.value);
+    parameter.formatter(params, builder, argparser, nullptr, parameter.value);
 
     vformat_impl(params, builder, parser);
 }
 
+// Does what vformat_impl() does, but for a format string that's already been split up at compile time.
+void vformat_compiled(TypeErasedFormatParams& params, FormatBuilder& builder, StringView fmtstr, Span<const Format::Detail::CompiledFormatField> fields)
+{
+    for (auto& field : fields) {
+        auto literal = fmtstr.substring_view(field.literal_start, field.literal_length);
+        if (field.literal_has_escaped_braces)
+            builder.put_literal(literal);
+        else
+            builder.builder().append(literal);
+
+        if (!field.has_replacement_field)
+            continue;
+
+        size_t index = field.index.value;
+        if (field.index.kind == Format::Detail::CompiledFormatArgument::Kind::NextIndex)
+            index = params.take_next_index();
+
+        auto& parameter = params.parameters().at(index);
+
+        FormatParser argparser { fmtstr.substring_view(field.flags_start, field.flags_length) };
+        parameter.formatter(params, builder, argparser, field.has_standard_specifier ? &field.specifier : nullptr, parameter.value);
+    }
+}
+
+size_t resolve_compiled_argument(TypeErasedFormatParams& params, const Format::Detail::CompiledFormatArgument& argument)
+{
+    switch (argument.kind) {
+    case Format::Detail::CompiledFormatArgument::Kind::Value:
+        return argument.value;
+    case Format::Detail::CompiledFormatArgument::Kind::Index:
+        return params.parameters().at(argument.value).to_size();
+    case Format::Detail::CompiledFormatArgument::Kind::NextIndex:
+        return params.parameters().at(params.take_next_index()).to_size();
+    default:
+        VERIFY_NOT_REACHED();
+    }
+}
+
+constexpr FormatBuilder::Align align_from_character(char c)
+{
+    if (c == '<')
+        return FormatBuilder::Align::Left;
+    if (c == '^')
+        return FormatBuilder::Align::Center;
+    if (c == '>')
+        return FormatBuilder::Align::Right;
+    return FormatBuilder::Align::Default;
+}
+
+constexpr FormatBuilder::SignMode sign_mode_from_character(char c)
+{
+    if (c == '+')
+        return FormatBuilder::SignMode::Always;
+    if (c == ' ')
+        return FormatBuilder::SignMode::Reserved;
+    return FormatBuilder::SignMode::OnlyIfNeeded;
+}
+
+constexpr StandardFormatter::Mode mode_from_character(char c)
+{
+    switch (c) {
+    case 'b':
+        return StandardFormatter::Mode::Binary;
+    case 'B':
+        return StandardFormatter::Mode::BinaryUppercase;
+    case 'd':
+        return StandardFormatter::Mode::Decimal;
+    case 'o':
+        return StandardFormatter::Mode::Octal;
+    case 'x':
+        return StandardFormatter::Mode::Hexadecimal;
+    case 'X':
+        return StandardFormatter::Mode::HexadecimalUppercase;
+    case 'c':
+        return StandardFormatter::Mode::Character;
+    case 's':
+        return StandardFormatter::Mode::String;
+    case 'p':
+        return StandardFormatter::Mode::Pointer;
+    case 'f':
+        return StandardFormatter::Mode::Float;
+    case 'a':
+        return StandardFormatter::Mode::Hexfloat;
+    case 'A':
+        return StandardFormatter::Mode::HexfloatUppercase;
+    default:
+        return StandardFormatter::Mode::Default;
+    }
+}
+
 } // namespace AK::{anonymous}
 
 FormatParser::FormatParser(StringView input)
@@ -231,6 +349,15 @@ void FormatBuilder::put_u64(
     Array<u8, 128> buffer;
 
     const auto used_by_digits = convert_unsigned_to_string(value, buffer, base, upper_case);
+    const auto digits = StringView { reinterpret_cast<const char*>(buffer.data() + buffer.size() - used_by_digits), used_by_digits };
+
+    // By far the most common case: nothing but the number itself.
+    if (min_width == 0 && !prefix && sign_mode == SignMode::OnlyIfNeeded) {
+        if (is_negative)
+            m_builder.append('-');
+        m_builder.append(digits);
+        return;
+    }
 
     size_t used_by_prefix = 0;
     if (align == Align::Right && zero_pad) {
@@ -279,8 +406,7 @@ void FormatBuilder::put_u64(
         }
     };
     const auto put_digits = [&]() {
-        for (size_t i = 0; i < used_by_digits; ++i)
-            m_builder.append(buffer[i]);
+        m_builder.append(digits);
     };
 
     if (align == Align::Left) {
@@ -339,7 +465,9 @@ void FormatBuilder::put_f64(
     char fill,
     SignMode sign_mode)
 {
-    StringBuilder string_builder;
+    // Without any padding, there's no need to know the length up front and we can write straight to the output.
+    StringBuilder padding_builder;
+    auto& string_builder = min_width > 0 ? padding_builder : m_builder;
     FormatBuilder format_builder { string_builder };
 
     bool is_negative = value < 0.0;
@@ -372,13 +500,20 @@ void FormatBuilder::put_f64(
         }
     }
 
-    put_string(string_builder.string_view(), align, min_width, NumericLimits<size_t>::max(), fill);
+    if (min_width > 0)
+        put_string(padding_builder.string_view(), align, min_width, NumericLimits<size_t>::max(), fill);
 }
 #endif
 
 void vformat(StringBuilder& builder, StringView fmtstr, TypeErasedFormatParams params)
 {
     FormatBuilder fmtbuilder { builder };
+
+    if (auto fields = params.compiled_fields(); !fields.is_empty()) {
+        vformat_compiled(params, fmtbuilder, fmtstr, fields);
+        return;
+    }
+
     FormatParser parser { fmtstr };
 
     vformat_impl(params, fmtbuilder, parser);
@@ -391,19 +526,11 @@ void StandardFormatter::parse(TypeErasedFormatParams& params, FormatParser& pars
         m_fill = parser.consume();
     }
 
-    if (parser.consume_specific('<'))
-        m_align = FormatBuilder::Align::Left;
-    else if (parser.consume_specific('^'))
-        m_align = FormatBuilder::Align::Center;
-    else if (parser.consume_specific('>'))
-        m_align = FormatBuilder::Align::Right;
+    if (parser.next_is(is_any_of("<^>")))
+        m_align = align_from_character(parser.consume());
 
-    if (parser.consume_specific('-'))
-        m_sign_mode = FormatBuilder::SignMode::OnlyIfNeeded;
-    else if (parser.consume_specific('+'))
-        m_sign_mode = FormatBuilder::SignMode::Always;
-    else if (parser.consume_specific(' '))
-        m_sign_mode = FormatBuilder::SignMode::Reserved;
+    if (parser.next_is(is_any_of("-+ ")))
+        m_sign_mode = sign_mode_from_character(parser.consume());
 
     if (parser.consume_specific('#'))
         m_alternative_form = true;
@@ -431,30 +558,8 @@ void StandardFormatter::parse(TypeErasedFormatParams& params, FormatParser& pars
         }
     }
 
-    if (parser.consume_specific('b'))
-        m_mode = Mode::Binary;
-    else if (parser.consume_specific('B'))
-        m_mode = Mode::BinaryUppercase;
-    else if (parser.consume_specific('d'))
-        m_mode = Mode::Decimal;
-    else if (parser.consume_specific('o'))
-        m_mode = Mode::Octal;
-    else if (parser.consume_specific('x'))
-        m_mode = Mode::Hexadecimal;
-    else if (parser.consume_specific('X'))
-        m_mode = Mode::HexadecimalUppercase;
-    else if (parser.consume_specific('c'))
-        m_mode = Mode::Character;
-    else if (parser.consume_specific('s'))
-        m_mode = Mode::String;
-    else if (parser.consume_specific('p'))
-        m_mode = Mode::Pointer;
-    else if (parser.consume_specific('f'))
-        m_mode = Mode::Float;
-    else if (parser.consume_specific('a'))
-        m_mode = Mode::Hexfloat;
-    else if (parser.consume_specific('A'))
-        m_mode = Mode::HexfloatUppercase;
+    if (parser.next_is(is_any_of("bBdoxXcspfaA")))
+        m_mode = mode_from_character(parser.consume());
 
     if (!parser.is_eof())
         dbgln("{} did not consume '{}'", __PRETTY_FUNCTION__, parser.remaining());
@@ -462,6 +567,22 @@ void StandardFormatter::parse(TypeErasedFormatParams& params, FormatParser& pars
     VERIFY(parser.is_eof());
 }
 
+void StandardFormatter::apply(TypeErasedFormatParams& params, const Format::Detail::CompiledFormatSpecifier& specifier)
+{
+    m_fill = specifier.fill;
+    m_align = align_from_character(specifier.align);
+    m_sign_mode = sign_mode_from_character(specifier.sign);
+    m_alternative_form = specifier.alternative_form;
+    m_zero_pad = specifier.zero_pad;
+
+    if (specifier.width.kind != Format::Detail::CompiledFormatArgument::Kind::None)
+        m_width = resolve_compiled_argument(params, specifier.width);
+    if (specifier.precision.kind != Format::Detail::CompiledFormatArgument::Kind::None)
+        m_precision = resolve_compiled_argument(params, specifier.precision);
+
+    m_mode = mode_from_character(specifier.mode);
+}
+
 void Formatter<StringView>::format(FormatBuilder& builder, StringView value)
 {
     if (m_sign_mode != FormatBuilder::SignMode::Default)
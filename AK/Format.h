@@ -24,6 +24,7 @@ namespace AK {
 class TypeErasedFormatParams;
 class FormatParser;
 class FormatBuilder;
+struct StandardFormatter;
 
 template<typename T, typename = void>
 struct Formatter {
@@ -112,7 +113,8 @@ struct TypeErasedParameter {
 
     const void* value;
     Type type;
-    void (*formatter)(TypeErasedFormatParams&, FormatBuilder&, FormatParser&, const void* value);
+    // The specifier is only there if it was taken apart at compile time, otherwise it's up to the parser.
+    void (*formatter)(TypeErasedFormatParams&, FormatBuilder&, FormatParser&, const Format::Detail::CompiledFormatSpecifier*, const void* value);
 };
 
 class FormatParser : public GenericLexer {
@@ -213,17 +215,33 @@ public:
     void set_parameters(Span<const TypeErasedParameter> parameters) { m_parameters = parameters; }
     size_t take_next_index() { return m_next_index++; }
 
+    // The format string these parameters go with, split up at compile time. Empty if it has to be parsed instead.
+    Span<const Format::Detail::CompiledFormatField> compiled_fields() const { return m_compiled_fields; }
+    void set_compiled_fields(Span<const Format::Detail::CompiledFormatField> fields) { m_compiled_fields = fields; }
+
 private:
     Span<const TypeErasedParameter> m_parameters;
+    Span<const Format::Detail::CompiledFormatField> m_compiled_fields;
     size_t m_next_index { 0 };
 };
 
+// Formatters with a parse() of their own don't get to skip it.
+template<typename T>
+inline constexpr bool UsesStandardFormatterParse = IsSame<decltype(&Formatter<T>::parse), void (StandardFormatter::*)(TypeErasedFormatParams&, FormatParser&)>;
+
 template<typename T>
-void __format_value(TypeErasedFormatParams& params, FormatBuilder& builder, FormatParser& parser, const void* value)
+void __format_value(TypeErasedFormatParams& params, FormatBuilder& builder, FormatParser& parser, const Format::Detail::CompiledFormatSpecifier* specifier, const void* value)
 {
     Formatter<T> formatter;
 
-    formatter.parse(params, parser);
+    if constexpr (UsesStandardFormatterParse<T>) {
+        if (specifier)
+            formatter.apply(params, *specifier);
+        else
+            formatter.parse(params, parser);
+    } else {
+        formatter.parse(params, parser);
+    }
     formatter.format(builder, *static_cast<const T*>(value));
 }
 
@@ -238,6 +256,12 @@ public:
         this->set_parameters(m_data);
     }
 
+    explicit VariadicFormatParams(const CheckedFormatString<Parameters...>& fmtstr, const Parameters&... parameters)
+        : VariadicFormatParams(parameters...)
+    {
+        this->set_compiled_fields(fmtstr.compiled_fields());
+    }
+
 private:
     Array<TypeErasedParameter, sizeof...(Parameters)> m_data;
 };
@@ -273,6 +297,8 @@ struct StandardFormatter {
     Optional<size_t> m_precision;
 
     void parse(TypeErasedFormatParams&, FormatParser&);
+    // Does the same as parse(), for a specification that was already parsed at compile time.
+    void apply(TypeErasedFormatParams&, const Format::Detail::CompiledFormatSpecifier&);
 };
 
 template<typename T>
@@ -376,10 +402,10 @@ void vformat(StringBuilder&, StringView fmtstr, TypeErasedFormatParams);
 void vout(FILE*, StringView fmtstr, TypeErasedFormatParams, bool newline = false);
 
 template<typename... Parameters>
-void out(FILE* file, CheckedFormatString<Parameters...>&& fmtstr, const Parameters&... parameters) { vout(file, fmtstr.view(), VariadicFormatParams { parameters... }); }
+void out(FILE* file, CheckedFormatString<Parameters...>&& fmtstr, const Parameters&... parameters) { vout(file, fmtstr.view(), VariadicFormatParams<Parameters...> { fmtstr, parameters... }); }
 
 template<typename... Parameters>
-void outln(FILE* file, CheckedFormatString<Parameters...>&& fmtstr, const Parameters&... parameters) { vout(file, fmtstr.view(), VariadicFormatParams { parameters... }, true); }
+void outln(FILE* file, CheckedFormatString<Parameters...>&& fmtstr, const Parameters&... parameters) { vout(file, fmtstr.view(), VariadicFormatParams<Parameters...> { fmtstr, parameters... }, true); }
 
 inline void outln(FILE* file) { fputc('\n', file); }
 
@@ -421,7 +447,7 @@ void vdbgln(StringView fmtstr, TypeErasedFormatParams);
 template<typename... Parameters>
 void dbgln(CheckedFormatString<Parameters...>&& fmtstr, const Parameters&... parameters)
 {
-    vdbgln(fmtstr.view(), VariadicFormatParams { parameters... });
+    vdbgln(fmtstr.view(), VariadicFormatParams<Parameters...> { fmtstr, parameters... });
 }
 
 inline void dbgln() { dbgln(""); }
@@ -434,7 +460,7 @@ void vdmesgln(StringView fmtstr, TypeErasedFormatParams);
 template<typename... Parameters>
 void dmesgln(CheckedFormatString<Parameters...>&& fmt, const Parameters&... parameters)
 {
-    vdmesgln(fmt.view(), VariadicFormatParams { parameters... });
+    vdmesgln(fmt.view(), VariadicFormatParams<Parameters...> { fmt, parameters... });
 }
 #endif
 
@@ -15,7 +15,9 @@ class ByteBuffer;
 class IPv4Address;
 class JsonArray;
 class JsonObject;
+class JsonPullParser;
 class JsonValue;
+class JsonValueView;
 class StackInfo;
 class String;
 class StringBuilder;
@@ -67,10 +69,12 @@ class CircularQueue;
 template<typename T>
 struct Traits;
 
-template<typename T, typename = Traits<T>>
+struct DefaultAllocator;
+
+template<typename T, typename = Traits<T>, typename = DefaultAllocator>
 class HashTable;
 
-template<typename K, typename V, typename = Traits<K>>
+template<typename K, typename V, typename = Traits<K>, typename = DefaultAllocator>
 class HashMap;
 
 template<typename T>
@@ -109,7 +113,7 @@ class OwnPtr;
 template<typename T>
 class WeakPtr;
 
-template<typename T, size_t inline_capacity = 0>
+template<typename T, size_t inline_capacity = 0, typename = DefaultAllocator>
 class Vector;
 
 }
@@ -135,7 +139,9 @@ using AK::InputStream;
 using AK::IPv4Address;
 using AK::JsonArray;
 using AK::JsonObject;
+using AK::JsonPullParser;
 using AK::JsonValue;
+using AK::JsonValueView;
 using AK::NonnullOwnPtr;
 using AK::NonnullOwnPtrVector;
 using AK::NonnullRefPtr;
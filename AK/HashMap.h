@@ -19,7 +19,7 @@
 
 namespace AK {
 
-template<typename K, typename V, typename KeyTraits>
+template<typename K, typename V, typename KeyTraits, typename Allocator>
 class HashMap {
 private:
     struct Entry {
@@ -35,6 +35,11 @@ private:
 public:
     HashMap() = default;
 
+    explicit HashMap(Allocator allocator)
+        : m_table(move(allocator))
+    {
+    }
+
 #ifndef SERENITY_LIBC_BUILD
     HashMap(std::initializer_list<Entry> list)
     {
@@ -65,7 +70,7 @@ public:
     }
     void remove_one_randomly() { m_table.remove(m_table.begin()); }
 
-    using HashTableType = HashTable<Entry, EntryTraits>;
+    using HashTableType = HashTable<Entry, EntryTraits, Allocator>;
     using IteratorType = typename HashTableType::Iterator;
     using ConstIteratorType = typename HashTableType::ConstIterator;
 
@@ -6,7 +6,9 @@
 
 #pragma once
 
+#include <AK/Allocator.h>
 #include <AK/HashFunctions.h>
+#include <AK/SIMD.h>
 #include <AK/StdLibExtras.h>
 #include <AK/Types.h>
 #include <AK/kmalloc.h>
@@ -18,73 +20,88 @@ enum class HashSetResult {
     ReplacedExistingEntry
 };
 
-template<typename HashTableType, typename T, typename BucketType>
+// Every slot in a HashTable has a control byte describing it: either one of the special values below,
+// or the low 7 bits of the hash of the value stored in it.
+namespace HashTableControl {
+static constexpr u8 empty = 0x80;
+// Marks the end of the table, as well as the unused tail of the single group in tables smaller than a group.
+static constexpr u8 end = 0xff;
+}
+
+template<typename HashTableType, typename T>
 class HashTableIterator {
     friend HashTableType;
 
 public:
-    bool operator==(const HashTableIterator& other) const { return m_bucket == other.m_bucket; }
-    bool operator!=(const HashTableIterator& other) const { return m_bucket != other.m_bucket; }
-    T& operator*() { return *m_bucket->slot(); }
-    T* operator->() { return m_bucket->slot(); }
+    bool operator==(const HashTableIterator& other) const { return m_slot == other.m_slot; }
+    bool operator!=(const HashTableIterator& other) const { return m_slot != other.m_slot; }
+    T& operator*() { return *m_slot; }
+    T* operator->() { return m_slot; }
     void operator++() { skip_to_next(); }
 
 private:
     void skip_to_next()
     {
-        if (!m_bucket)
+        if (!m_slot)
             return;
         do {
-            ++m_bucket;
-            if (m_bucket->used)
-                return;
-        } while (!m_bucket->end);
-        if (m_bucket->end)
-            m_bucket = nullptr;
+            ++m_slot;
+            ++m_control;
+        } while (*m_control == HashTableControl::empty);
+        if (*m_control == HashTableControl::end) {
+            m_slot = nullptr;
+            m_control = nullptr;
+        }
     }
 
-    explicit HashTableIterator(BucketType* bucket)
-        : m_bucket(bucket)
+    HashTableIterator(const u8* control, T* slot)
+        : m_control(control)
+        , m_slot(slot)
     {
     }
 
-    BucketType* m_bucket { nullptr };
+    const u8* m_control { nullptr };
+    T* m_slot { nullptr };
 };
 
-template<typename T, typename TraitsForT>
+// An open addressing hash table that probes a group of 16 slots at a time, using the control bytes
+// to pick out candidate slots before comparing any values (with SSE2, a whole group at once).
+// Instead of leaving tombstones behind, each group counts the values that had to probe past it
+// because it was full, so a removed slot becomes reusable immediately and lookups can stop at
+// the first group that nothing has overflowed from.
+template<typename T, typename TraitsForT, typename Allocator>
 class HashTable {
-    static constexpr size_t load_factor_in_percent = 60;
-
-    struct Bucket {
-        bool used;
-        bool deleted;
-        bool end;
-        alignas(T) u8 storage[sizeof(T)];
-
-        T* slot() { return reinterpret_cast<T*>(storage); }
-        const T* slot() const { return reinterpret_cast<const T*>(storage); }
-    };
+    static constexpr size_t group_size = 16;
+    static constexpr size_t min_capacity = 4;
+    static constexpr u8 overflow_count_saturated = 0xff;
 
 public:
     HashTable() = default;
-    explicit HashTable(size_t capacity) { rehash(capacity); }
+    explicit HashTable(size_t capacity) { rehash(round_up_to_power_of_two(max(capacity, min_capacity))); }
+
+    explicit HashTable(Allocator allocator)
+        : m_allocator(move(allocator))
+    {
+    }
 
     ~HashTable()
     {
-        if (!m_buckets)
+        if (!m_slots)
             return;
 
         for (size_t i = 0; i < m_capacity; ++i) {
-            if (m_buckets[i].used)
-                m_buckets[i].slot()->~T();
+            if (is_used(m_control[i]))
+                m_slots[i].~T();
         }
 
-        kfree(m_buckets);
+        m_allocator.deallocate(m_slots, allocation_size(m_capacity));
     }
 
     HashTable(const HashTable& other)
+        : m_allocator(other.m_allocator)
     {
-        rehash(other.capacity());
+        if (other.capacity())
+            rehash(other.capacity());
         for (auto& it : other)
             set(it);
     }
@@ -97,15 +114,20 @@ public:
     }
 
     HashTable(HashTable&& other) noexcept
-        : m_buckets(other.m_buckets)
+        : m_slots(other.m_slots)
+        , m_control(other.m_control)
+        , m_overflow_counts(other.m_overflow_counts)
         , m_size(other.m_size)
         , m_capacity(other.m_capacity)
-        , m_deleted_count(other.m_deleted_count)
+        , m_group_count(other.m_group_count)
+        , m_allocator(other.m_allocator)
     {
+        other.m_slots = nullptr;
+        other.m_control = nullptr;
+        other.m_overflow_counts = nullptr;
         other.m_size = 0;
         other.m_capacity = 0;
-        other.m_deleted_count = 0;
-        other.m_buckets = nullptr;
+        other.m_group_count = 0;
     }
 
     HashTable& operator=(HashTable&& other) noexcept
@@ -116,10 +138,13 @@ public:
 
     friend void swap(HashTable& a, HashTable& b) noexcept
     {
-        swap(a.m_buckets, b.m_buckets);
+        swap(a.m_slots, b.m_slots);
+        swap(a.m_control, b.m_control);
+        swap(a.m_overflow_counts, b.m_overflow_counts);
         swap(a.m_size, b.m_size);
         swap(a.m_capacity, b.m_capacity);
-        swap(a.m_deleted_count, b.m_deleted_count);
+        swap(a.m_group_count, b.m_group_count);
+        swap(a.m_allocator, b.m_allocator);
     }
 
     [[nodiscard]] bool is_empty() const { return !m_size; }
@@ -137,7 +162,11 @@ public:
     void ensure_capacity(size_t capacity)
     {
         VERIFY(capacity >= size());
-        rehash(capacity * 2);
+        auto new_capacity = max(m_capacity, min_capacity);
+        while (max_size_for_capacity(new_capacity) < capacity)
+            new_capacity *= 2;
+        if (new_capacity != m_capacity)
+            rehash(new_capacity);
     }
 
     bool contains(const T& value) const
@@ -145,66 +174,65 @@ public:
         return find(value) != end();
     }
 
-    using Iterator = HashTableIterator<HashTable, T, Bucket>;
+    using Iterator = HashTableIterator<HashTable, T>;
 
     Iterator begin()
     {
         for (size_t i = 0; i < m_capacity; ++i) {
-            if (m_buckets[i].used)
-                return Iterator(&m_buckets[i]);
+            if (is_used(m_control[i]))
+                return Iterator(&m_control[i], &m_slots[i]);
         }
         return end();
     }
 
     Iterator end()
     {
-        return Iterator(nullptr);
+        return Iterator(nullptr, nullptr);
     }
 
-    using ConstIterator = HashTableIterator<const HashTable, const T, const Bucket>;
+    using ConstIterator = HashTableIterator<const HashTable, const T>;
 
     ConstIterator begin() const
     {
         for (size_t i = 0; i < m_capacity; ++i) {
-            if (m_buckets[i].used)
-                return ConstIterator(&m_buckets[i]);
+            if (is_used(m_control[i]))
+                return ConstIterator(&m_control[i], &m_slots[i]);
         }
         return end();
     }
 
     ConstIterator end() const
     {
-        return ConstIterator(nullptr);
+        return ConstIterator(nullptr, nullptr);
     }
 
     void clear()
     {
-        *this = HashTable();
+        *this = HashTable(m_allocator);
     }
 
+    const Allocator& allocator() const { return m_allocator; }
+
     template<typename U = T>
     HashSetResult set(U&& value)
     {
-        auto& bucket = lookup_for_writing(value);
-        if (bucket.used) {
-            (*bucket.slot()) = forward<U>(value);
+        auto hash = TraitsForT::hash(value);
+        if (auto* slot = lookup_with_hash(hash, [&value](auto& entry) { return TraitsForT::equals(entry, value); })) {
+            *slot = forward<U>(value);
             return HashSetResult::ReplacedExistingEntry;
         }
 
-        new (bucket.slot()) T(forward<U>(value));
-        bucket.used = true;
-        if (bucket.deleted) {
-            bucket.deleted = false;
-            --m_deleted_count;
-        }
-        ++m_size;
+        if (should_grow())
+            rehash(max(m_capacity * 2, min_capacity));
+
+        insert_new(hash, forward<U>(value));
         return HashSetResult::InsertedNewEntry;
     }
 
     template<typename Finder>
     Iterator find(unsigned hash, Finder finder)
     {
-        return Iterator(lookup_with_hash(hash, move(finder)));
+        return iterator_for(lookup_with_hash(hash, move(finder)));
     }
 
     Iterator find(const T& value)
@@ -215,7 +243,10 @@ public:
     template<typename Finder>
     ConstIterator find(unsigned hash, Finder finder) const
     {
-        return ConstIterator(lookup_with_hash(hash, move(finder)));
+        auto* slot = lookup_with_hash(hash, move(finder));
+        if (!slot)
+            return end();
+        return ConstIterator(&m_control[slot - m_slots], slot);
     }
 
     ConstIterator find(const T& value) const
@@ -235,110 +266,156 @@ public:
 
     void remove(Iterator iterator)
     {
-        VERIFY(iterator.m_bucket);
-        auto& bucket = *iterator.m_bucket;
-        VERIFY(bucket.used);
-        VERIFY(!bucket.end);
-        VERIFY(!bucket.deleted);
-        bucket.slot()->~T();
-        bucket.used = false;
-        bucket.deleted = true;
+        VERIFY(iterator.m_slot);
+        size_t index = iterator.m_slot - m_slots;
+        VERIFY(index < m_capacity);
+        VERIFY(is_used(m_control[index]));
+
+        // Everything that had to probe past a full group on its way here no longer has to.
+        auto hash = TraitsForT::hash(m_slots[index]);
+        size_t target_group = index / group_size;
+        for (size_t group = home_group(hash), step = 0; group != target_group;) {
+            VERIFY(m_overflow_counts[group]);
+            if (m_overflow_counts[group] != overflow_count_saturated)
+                --m_overflow_counts[group];
+            group = next_group(group, ++step);
+        }
+
+        m_slots[index].~T();
+        m_control[index] = HashTableControl::empty;
         --m_size;
-        ++m_deleted_count;
     }
 
 private:
-    void insert_during_rehash(T&& value)
+    static bool is_used(u8 control) { return !(control & 0x80); }
+    static u8 tag_for_hash(unsigned hash) { return hash & 0x7f; }
+    size_t home_group(unsigned hash) const { return (hash >> 7) & (m_group_count - 1); }
+    size_t next_group(size_t group, size_t step) const { return (group + step) & (m_group_count - 1); }
+
+    // Returns a bit mask of the slots in the group starting at `control` whose control byte is `byte`.
+    static u32 match_group(const u8* control, u8 byte)
     {
-        auto& bucket = lookup_for_writing(value);
-        new (bucket.slot()) T(move(value));
-        bucket.used = true;
+#ifdef __SSE2__
+        using c8x16 = char __attribute__((vector_size(16)));
+        SIMD::u8x16 group;
+        __builtin_memcpy(&group, control, sizeof(group));
+        SIMD::u8x16 needle = SIMD::u8x16 {} + byte;
+        return __builtin_ia32_pmovmskb128((c8x16)(group == needle));
+#else
+        u32 mask = 0;
+        for (size_t i = 0; i < group_size; ++i) {
+            if (control[i] == byte)
+                mask |= 1u << i;
+        }
+        return mask;
+#endif
     }
 
-    void rehash(size_t new_capacity)
+    static size_t round_up_to_power_of_two(size_t value)
     {
-        new_capacity = max(new_capacity, static_cast<size_t>(4));
-
-        auto* old_buckets = m_buckets;
-        auto old_capacity = m_capacity;
+        size_t result = 1;
+        while (result < value)
+            result *= 2;
+        return result;
+    }
 
-        m_buckets = (Bucket*)kmalloc(sizeof(Bucket) * (new_capacity + 1));
-        __builtin_memset(m_buckets, 0, sizeof(Bucket) * (new_capacity + 1));
-        m_capacity = new_capacity;
-        m_deleted_count = 0;
+    static size_t max_size_for_capacity(size_t capacity) { return capacity - capacity / 8; }
+    static size_t group_count_for_capacity(size_t capacity) { return max(capacity / group_size, static_cast<size_t>(1)); }
 
-        m_buckets[m_capacity].end = true;
+    // Slots, control bytes (plus one for the end marker) and overflow counts, all in one allocation.
+    static size_t allocation_size(size_t capacity)
+    {
+        auto group_count = group_count_for_capacity(capacity);
+        return sizeof(T) * capacity + group_count * group_size + 1 + group_count;
+    }
 
-        if (!old_buckets)
-            return;
+    Iterator iterator_for(T* slot)
+    {
+        if (!slot)
+            return end();
+        return Iterator(&m_control[slot - m_slots], slot);
+    }
 
-        for (size_t i = 0; i < old_capacity; ++i) {
-            auto& old_bucket = old_buckets[i];
-            if (old_bucket.used) {
-                insert_during_rehash(move(*old_bucket.slot()));
-                old_bucket.slot()->~T();
+    template<typename U>
+    void insert_new(unsigned hash, U&& value)
+    {
+        for (size_t group = home_group(hash), step = 0;; group = next_group(group, ++step)) {
+            auto* control = &m_control[group * group_size];
+            if (auto empty_slots = match_group(control, HashTableControl::empty)) {
+                auto index = group * group_size + __builtin_ctz(empty_slots);
+                new (&m_slots[index]) T(forward<U>(value));
+                m_control[index] = tag_for_hash(hash);
+                ++m_size;
+                return;
             }
+            if (m_overflow_counts[group] != overflow_count_saturated)
+                ++m_overflow_counts[group];
         }
-
-        kfree(old_buckets);
     }
 
-    template<typename Finder>
-    Bucket* lookup_with_hash(unsigned hash, Finder finder) const
+    void rehash(size_t new_capacity)
     {
-        if (is_empty())
-            return nullptr;
+        VERIFY(new_capacity >= min_capacity && !(new_capacity & (new_capacity - 1)));
 
-        for (;;) {
-            auto& bucket = m_buckets[hash % m_capacity];
+        auto* old_slots = m_slots;
+        auto* old_control = m_control;
+        auto old_capacity = m_capacity;
 
-            if (bucket.used && finder(*bucket.slot()))
-                return &bucket;
+        m_group_count = group_count_for_capacity(new_capacity);
+        size_t control_size = m_group_count * group_size + 1;
+        auto* storage = (u8*)m_allocator.allocate(allocation_size(new_capacity));
+        m_slots = reinterpret_cast<T*>(storage);
+        m_control = storage + sizeof(T) * new_capacity;
+        m_overflow_counts = m_control + control_size;
+        __builtin_memset(m_control, HashTableControl::empty, new_capacity);
+        __builtin_memset(m_control + new_capacity, HashTableControl::end, control_size - new_capacity);
+        __builtin_memset(m_overflow_counts, 0, m_group_count);
+        m_capacity = new_capacity;
+        m_size = 0;
 
-            if (!bucket.used && !bucket.deleted)
-                return nullptr;
+        if (!old_slots)
+            return;
 
-            hash = double_hash(hash);
+        for (size_t i = 0; i < old_capacity; ++i) {
+            if (is_used(old_control[i])) {
+                insert_new(TraitsForT::hash(old_slots[i]), move(old_slots[i]));
+                old_slots[i].~T();
+            }
         }
-    }
 
-    const Bucket* lookup_for_reading(const T& value) const
-    {
-        return lookup_with_hash(TraitsForT::hash(value), [&value](auto& entry) { return TraitsForT::equals(entry, value); });
+        m_allocator.deallocate(old_slots, allocation_size(old_capacity));
     }
 
-    Bucket& lookup_for_writing(const T& value)
+    template<typename Finder>
+    T* lookup_with_hash(unsigned hash, Finder finder) const
     {
-        if (should_grow())
-            rehash(capacity() * 2);
-
-        auto hash = TraitsForT::hash(value);
-        Bucket* first_empty_bucket = nullptr;
-        for (;;) {
-            auto& bucket = m_buckets[hash % m_capacity];
-
-            if (bucket.used && TraitsForT::equals(*bucket.slot(), value))
-                return bucket;
-
-            if (!bucket.used) {
-                if (!first_empty_bucket)
-                    first_empty_bucket = &bucket;
+        if (is_empty())
+            return nullptr;
 
-                if (!bucket.deleted)
-                    return *const_cast<Bucket*>(first_empty_bucket);
+        auto tag = tag_for_hash(hash);
+        size_t group = home_group(hash);
+        for (size_t step = 0; step < m_group_count; group = next_group(group, ++step)) {
+            for (auto matches = match_group(&m_control[group * group_size], tag); matches; matches &= matches - 1) {
+                auto index = group * group_size + __builtin_ctz(matches);
+                if (finder(m_slots[index]))
+                    return &m_slots[index];
             }
 
-            hash = double_hash(hash);
+            if (!m_overflow_counts[group])
+                return nullptr;
         }
+        return nullptr;
     }
 
-    [[nodiscard]] size_t used_bucket_count() const { return m_size + m_deleted_count; }
-    [[nodiscard]] bool should_grow() const { return ((used_bucket_count() + 1) * 100) >= (m_capacity * load_factor_in_percent); }
+    [[nodiscard]] bool should_grow() const { return m_size + 1 > max_size_for_capacity(m_capacity); }
 
-    Bucket* m_buckets { nullptr };
+    T* m_slots { nullptr };
+    u8* m_control { nullptr };
+    u8* m_overflow_counts { nullptr };
     size_t m_size { 0 };
     size_t m_capacity { 0 };
-    size_t m_deleted_count { 0 };
+    size_t m_group_count { 0 };
+    [[no_unique_address]] Allocator m_allocator;
 };
 
 }
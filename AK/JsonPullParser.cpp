@@ -0,0 +1,340 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/JsonPullParser.h>
+#include <AK/MemMem.h>
+#include <AK/StringBuilder.h>
+#include <AK/StringUtils.h>
+
+#ifndef KERNEL
+#    include <stdlib.h>
+#endif
+
+namespace AK {
+
+// Finds the next occurrence of any of `needles` in input, starting at offset.
+template<size_t N>
+static size_t find_any_of(const StringView& input, size_t offset, const char (&needles)[N])
+{
+    if (offset >= input.length())
+        return input.length();
+    auto* characters = input.characters_without_null_termination();
+    auto* match = static_cast<const char*>(AK::find_any_of(characters + offset, input.length() - offset, needles, N - 1));
+    return match ? match - characters : input.length();
+}
+
+void JsonPullParser::skip_whitespace()
+{
+    while (m_offset < m_input.length()) {
+        char ch = m_input[m_offset];
+        if (ch != ' ' && ch != '\n' && ch != '\t' && ch != '\r')
+            break;
+        ++m_offset;
+    }
+}
+
+JsonPullParser::Event JsonPullParser::fail()
+{
+    m_state = State::Failed;
+    m_token = {};
+    return m_event = Event::Error;
+}
+
+JsonPullParser::Event JsonPullParser::next()
+{
+    for (;;) {
+        skip_whitespace();
+        switch (m_state) {
+        case State::Failed:
+            return m_event = Event::Error;
+        case State::Done:
+            if (m_offset != m_input.length())
+                return fail();
+            m_token = {};
+            return m_event = Event::End;
+        case State::Value:
+            return parse_value();
+        case State::FirstValueOrArrayEnd:
+            if (peek() == ']')
+                return end_container(false);
+            return parse_value();
+        case State::FirstKeyOrObjectEnd:
+            if (peek() == '}')
+                return end_container(true);
+            return parse_key();
+        case State::Key:
+            return parse_key();
+        case State::AfterValue: {
+            bool in_object = m_nesting.last();
+            char ch = peek();
+            if (ch == (in_object ? '}' : ']'))
+                return end_container(in_object);
+            if (ch != ',')
+                return fail();
+            ++m_offset;
+            m_state = in_object ? State::Key : State::Value;
+            continue;
+        }
+        }
+        VERIFY_NOT_REACHED();
+    }
+}
+
+JsonPullParser::Event JsonPullParser::end_container(bool is_object)
+{
+    m_token_offset = m_offset;
+    m_token = m_input.substring_view(m_offset++, 1);
+    m_nesting.take_last();
+    finish_value();
+    return m_event = is_object ? Event::ObjectEnd : Event::ArrayEnd;
+}
+
+bool JsonPullParser::scan_string()
+{
+    VERIFY(peek() == '"');
+    size_t start = m_offset + 1;
+    size_t offset = start;
+    m_string_has_escapes = false;
+    for (;;) {
+        offset = find_any_of(m_input, offset, "\"\\");
+        if (offset >= m_input.length())
+            return false;
+        if (m_input[offset] == '"')
+            break;
+        // A backslash needs something to escape.
+        if (offset + 1 >= m_input.length())
+            return false;
+        m_string_has_escapes = true;
+        offset += 2;
+    }
+    m_token = m_input.substring_view(start, offset - start);
+    m_offset = offset + 1;
+    return true;
+}
+
+JsonPullParser::Event JsonPullParser::parse_key()
+{
+    m_token_offset = m_offset;
+    if (peek() != '"' || !scan_string())
+        return fail();
+    auto key = m_token;
+    skip_whitespace();
+    if (peek() != ':')
+        return fail();
+    ++m_offset;
+    m_token = key;
+    m_state = State::Value;
+    return m_event = Event::Key;
+}
+
+JsonPullParser::Event JsonPullParser::parse_value()
+{
+    m_token_offset = m_offset;
+    switch (peek()) {
+    case '{':
+        m_token = m_input.substring_view(m_offset++, 1);
+        m_nesting.append(true);
+        m_state = State::FirstKeyOrObjectEnd;
+        return m_event = Event::ObjectStart;
+    case '[':
+        m_token = m_input.substring_view(m_offset++, 1);
+        m_nesting.append(false);
+        m_state = State::FirstValueOrArrayEnd;
+        return m_event = Event::ArrayStart;
+    case '"':
+        if (!scan_string())
+            return fail();
+        finish_value();
+        return m_event = Event::String;
+    case 't':
+        return parse_literal("true", Event::True);
+    case 'f':
+        return parse_literal("false", Event::False);
+    case 'n':
+        return parse_literal("null", Event::Null);
+    case '-':
+    case '0':
+    case '1':
+    case '2':
+    case '3':
+    case '4':
+    case '5':
+    case '6':
+    case '7':
+    case '8':
+    case '9':
+        return parse_number();
+    default:
+        return fail();
+    }
+}
+
+JsonPullParser::Event JsonPullParser::parse_literal(const StringView& literal, Event event)
+{
+    if (!m_input.substring_view(m_offset).starts_with(literal))
+        return fail();
+    m_token = m_input.substring_view(m_offset, literal.length());
+    m_offset += literal.length();
+    finish_value();
+    return m_event = event;
+}
+
+JsonPullParser::Event JsonPullParser::parse_number()
+{
+    size_t start = m_offset;
+    auto consume_digits = [&] {
+        size_t first_digit = m_offset;
+        while (m_offset < m_input.length() && m_input[m_offset] >= '0' && m_input[m_offset] <= '9')
+            ++m_offset;
+        return m_offset != first_digit;
+    };
+
+    if (peek() == '-')
+        ++m_offset;
+    if (!consume_digits())
+        return fail();
+    if (peek() == '.') {
+        ++m_offset;
+        if (!consume_digits())
+            return fail();
+    }
+    if (peek() == 'e' || peek() == 'E') {
+        ++m_offset;
+        if (peek() == '+' || peek() == '-')
+            ++m_offset;
+        if (!consume_digits())
+            return fail();
+    }
+
+    m_token = m_input.substring_view(start, m_offset - start);
+    finish_value();
+    return m_event = Event::Number;
+}
+
+bool JsonPullParser::skip_value()
+{
+    switch (m_event) {
+    case Event::Key:
+        next();
+        return skip_value();
+    case Event::ObjectStart:
+    case Event::ArrayStart:
+        break;
+    case Event::Error:
+    case Event::End:
+        return false;
+    default:
+        return true;
+    }
+
+    // Only strings and brackets matter for finding the end of a container, so jump straight from one to the next.
+    auto target_depth = depth() - 1;
+    for (;;) {
+        m_offset = find_any_of(m_input, m_offset, "\"{}[]");
+        if (m_offset >= m_input.length()) {
+            fail();
+            return false;
+        }
+        switch (m_input[m_offset]) {
+        case '"':
+            if (!scan_string()) {
+                fail();
+                return false;
+            }
+            continue;
+        case '{':
+        case '[':
+            m_nesting.append(m_input[m_offset] == '{');
+            ++m_offset;
+            continue;
+        default: {
+            bool is_object = m_input[m_offset] == '}';
+            if (m_nesting.last() != is_object) {
+                fail();
+                return false;
+            }
+            end_container(is_object);
+            if (depth() == target_depth)
+                return true;
+        }
+        }
+    }
+}
+
+String JsonPullParser::string() const
+{
+    VERIFY(m_event == Event::Key || m_event == Event::String);
+    if (!m_string_has_escapes)
+        return m_token;
+    return unescape(m_token);
+}
+
+String JsonPullParser::unescape(const StringView& input)
+{
+    StringBuilder builder(input.length());
+    for (size_t i = 0; i < input.length(); ++i) {
+        char ch = input[i];
+        if (ch != '\\' || i + 1 == input.length()) {
+            builder.append(ch);
+            continue;
+        }
+        char escaped_ch = input[++i];
+        switch (escaped_ch) {
+        case 'n':
+            builder.append('\n');
+            break;
+        case 'r':
+            builder.append('\r');
+            break;
+        case 't':
+            builder.append('\t');
+            break;
+        case 'b':
+            builder.append('\b');
+            break;
+        case 'f':
+            builder.append('\f');
+            break;
+        case 'u': {
+            auto code_point = StringUtils::convert_to_uint_from_hex(input.substring_view(i + 1, min(static_cast<size_t>(4), input.length() - i - 1)));
+            if (code_point.has_value())
+                builder.append_code_point(code_point.value());
+            else
+                builder.append('?');
+            i += min(static_cast<size_t>(4), input.length() - i - 1);
+            break;
+        }
+        default:
+            builder.append(escaped_ch);
+            break;
+        }
+    }
+    return builder.to_string();
+}
+
+bool JsonPullParser::token_is_integer() const
+{
+    VERIFY(m_event == Event::Number);
+    for (auto ch : m_token) {
+        if (ch == '.' || ch == 'e' || ch == 'E')
+            return false;
+    }
+    return true;
+}
+
+#ifndef KERNEL
+Optional<double> JsonPullParser::double_value() const
+{
+    char buffer[64];
+    if (m_token.length() >= sizeof(buffer))
+        return {};
+    __builtin_memcpy(buffer, m_token.characters_without_null_termination(), m_token.length());
+    buffer[m_token.length()] = '\0';
+    return strtod(buffer, nullptr);
+}
+#endif
+
+}
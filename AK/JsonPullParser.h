@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Optional.h>
+#include <AK/String.h>
+#include <AK/StringView.h>
+#include <AK/Vector.h>
+
+namespace AK {
+
+// Walks a JSON document one token at a time, without building any JsonValues or allocating anything
+// (unless it's nested more than 32 levels deep). Keys and strings are handed out as views into the input.
+class JsonPullParser {
+public:
+    enum class Event : u8 {
+        ObjectStart,
+        ObjectEnd,
+        ArrayStart,
+        ArrayEnd,
+        Key,
+        String,
+        Number,
+        True,
+        False,
+        Null,
+        End,
+        Error,
+    };
+
+    explicit JsonPullParser(const StringView& input)
+        : m_input(input)
+    {
+    }
+
+    Event next();
+    Event event() const { return m_event; }
+
+    // For Key and String, this is what's between the quotes, with any escape sequences left as they are.
+    // For Number, it's the number as written.
+    StringView token() const { return m_token; }
+    bool string_has_escapes() const { return m_string_has_escapes; }
+    // The current Key or String with escape sequences resolved. This only allocates if there are any.
+    String string() const;
+
+    template<typename T>
+    Optional<T> number() const
+    {
+        if (!token_is_integer()) {
+#ifndef KERNEL
+            if (auto value = double_value(); value.has_value())
+                return static_cast<T>(value.value());
+#endif
+            return {};
+        }
+        if (m_token.starts_with('-')) {
+            if (auto value = m_token.to_int<i64>(); value.has_value())
+                return static_cast<T>(value.value());
+            return {};
+        }
+        if (auto value = m_token.to_uint<u64>(); value.has_value())
+            return static_cast<T>(value.value());
+        return {};
+    }
+
+    // Moves past the rest of the value that the current event starts, so that next() returns whatever comes
+    // after it. For a Key, that's the value belonging to it. Anything skipped over is only checked for
+    // balanced brackets, not for being well-formed.
+    bool skip_value();
+
+    size_t depth() const { return m_nesting.size(); }
+    // Where in the input the current event's token starts, and where the parser is now.
+    size_t token_offset() const { return m_token_offset; }
+    size_t offset() const { return m_offset; }
+
+    static String unescape(const StringView&);
+
+private:
+    enum class State : u8 {
+        Value,
+        FirstKeyOrObjectEnd,
+        Key,
+        FirstValueOrArrayEnd,
+        AfterValue,
+        Done,
+        Failed,
+    };
+
+    bool token_is_integer() const;
+#ifndef KERNEL
+    Optional<double> double_value() const;
+#endif
+
+    char peek() const { return m_offset < m_input.length() ? m_input[m_offset] : 0; }
+    void skip_whitespace();
+    bool scan_string();
+    Event parse_value();
+    Event parse_key();
+    Event parse_number();
+    Event parse_literal(const StringView&, Event);
+    Event end_container(bool is_object);
+    Event fail();
+    void finish_value() { m_state = m_nesting.is_empty() ? State::Done : State::AfterValue; }
+
+    StringView m_input;
+    size_t m_offset { 0 };
+    size_t m_token_offset { 0 };
+    StringView m_token;
+    Event m_event { Event::Error };
+    State m_state { State::Value };
+    bool m_string_has_escapes { false };
+    // One entry per object (true) or array (false) we're currently inside of.
+    Vector<bool, 32> m_nesting;
+};
+
+}
+
+using AK::JsonPullParser;
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/JsonValueView.h>
+
+namespace AK {
+
+Optional<JsonValueView> JsonValueView::from_string(const StringView& input)
+{
+    JsonPullParser parser(input);
+    auto event = parser.next();
+    if (event == JsonPullParser::Event::Error || event == JsonPullParser::Event::End)
+        return {};
+    auto start = parser.token_offset();
+    while (event != JsonPullParser::Event::End) {
+        if (event == JsonPullParser::Event::Error)
+            return {};
+        event = parser.next();
+    }
+    return JsonValueView { input.substring_view(start).trim_whitespace(TrimMode::Right) };
+}
+
+JsonValueView JsonValueView::value_at_parser(JsonPullParser& parser) const
+{
+    auto start = parser.token_offset();
+    if (!parser.skip_value())
+        return {};
+    return JsonValueView { m_raw.substring_view(start, parser.offset() - start) };
+}
+
+JsonValueView JsonValueView::get(const StringView& key) const
+{
+    if (!is_object())
+        return {};
+    JsonPullParser parser(m_raw);
+    parser.next();
+    while (parser.next() == JsonPullParser::Event::Key) {
+        bool matches = parser.string_has_escapes() ? parser.string() == key : parser.token() == key;
+        parser.next();
+        if (matches)
+            return value_at_parser(parser);
+        if (!parser.skip_value())
+            break;
+    }
+    return {};
+}
+
+JsonValueView JsonValueView::at(size_t index) const
+{
+    if (!is_array())
+        return {};
+    JsonPullParser parser(m_raw);
+    parser.next();
+    for (size_t i = 0;; ++i) {
+        auto event = parser.next();
+        if (event == JsonPullParser::Event::ArrayEnd || event == JsonPullParser::Event::Error)
+            break;
+        if (i == index)
+            return value_at_parser(parser);
+        if (!parser.skip_value())
+            break;
+    }
+    return {};
+}
+
+size_t JsonValueView::size() const
+{
+    size_t size = 0;
+    if (is_object())
+        for_each_member([&](auto, auto) { ++size; });
+    else if (is_array())
+        for_each_value([&](auto) { ++size; });
+    return size;
+}
+
+Optional<StringView> JsonValueView::as_string_view() const
+{
+    if (!is_string())
+        return {};
+    JsonPullParser parser(m_raw);
+    parser.next();
+    if (parser.string_has_escapes())
+        return {};
+    return parser.token();
+}
+
+String JsonValueView::to_string() const
+{
+    if (m_raw.is_empty())
+        return "null";
+    if (!is_string())
+        return m_raw;
+    JsonPullParser parser(m_raw);
+    parser.next();
+    return parser.string();
+}
+
+JsonValue JsonValueView::materialize() const
+{
+    if (m_raw.is_empty())
+        return JsonValue();
+    return JsonValue::from_string(m_raw).value_or(JsonValue());
+}
+
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/JsonPullParser.h>
+#include <AK/JsonValue.h>
+
+namespace AK {
+
+// A JSON value that's left as text until something actually asks for it. Looking up a member or an element
+// scans the text for it, so this is best for picking a few fields out of a large document, or for walking
+// through one once. The view doesn't own the text it was created from.
+class JsonValueView {
+public:
+    // A view of nothing at all, which is what looking up a missing member or element gives you.
+    // It behaves like null.
+    JsonValueView() = default;
+
+    // Checks that the whole document is well-formed up front, so it doesn't have to be checked again later.
+    static Optional<JsonValueView> from_string(const StringView&);
+
+    StringView raw() const { return m_raw; }
+
+    bool is_null() const { return m_raw.is_empty() || m_raw[0] == 'n'; }
+    bool is_bool() const { return !m_raw.is_empty() && (m_raw[0] == 't' || m_raw[0] == 'f'); }
+    bool is_string() const { return !m_raw.is_empty() && m_raw[0] == '"'; }
+    bool is_number() const { return !m_raw.is_empty() && (m_raw[0] == '-' || (m_raw[0] >= '0' && m_raw[0] <= '9')); }
+    bool is_object() const { return !m_raw.is_empty() && m_raw[0] == '{'; }
+    bool is_array() const { return !m_raw.is_empty() && m_raw[0] == '['; }
+
+    JsonValueView get(const StringView& key) const;
+    JsonValueView at(size_t index) const;
+    size_t size() const;
+
+    // Calls callback(key, value) for every member of an object. The key still has any escape sequences in it.
+    template<typename Callback>
+    void for_each_member(Callback callback) const
+    {
+        if (!is_object())
+            return;
+        JsonPullParser parser(m_raw);
+        parser.next();
+        while (parser.next() == JsonPullParser::Event::Key) {
+            auto key = parser.token();
+            parser.next();
+            auto value = value_at_parser(parser);
+            callback(key, value);
+        }
+    }
+
+    // Calls callback(value) for every element of an array.
+    template<typename Callback>
+    void for_each_value(Callback callback) const
+    {
+        if (!is_array())
+            return;
+        JsonPullParser parser(m_raw);
+        parser.next();
+        for (;;) {
+            auto event = parser.next();
+            if (event == JsonPullParser::Event::ArrayEnd || event == JsonPullParser::Event::Error)
+                break;
+            callback(value_at_parser(parser));
+        }
+    }
+
+    // Strings don't need to be unescaped to be looked at as long as they don't contain any escape sequences.
+    Optional<StringView> as_string_view() const;
+    String to_string() const;
+
+    bool to_bool(bool default_value = false) const
+    {
+        if (!is_bool())
+            return default_value;
+        return m_raw[0] == 't';
+    }
+
+    template<typename T>
+    T to_number(T default_value = 0) const
+    {
+        if (!is_number())
+            return default_value;
+        JsonPullParser parser(m_raw);
+        parser.next();
+        return parser.number<T>().value_or(default_value);
+    }
+
+    i32 to_i32(i32 default_value = 0) const { return to_number<i32>(default_value); }
+    i64 to_i64(i64 default_value = 0) const { return to_number<i64>(default_value); }
+    u32 to_u32(u32 default_value = 0) const { return to_number<u32>(default_value); }
+    u64 to_u64(u64 default_value = 0) const { return to_number<u64>(default_value); }
+
+    // Parses the text into a regular JsonValue.
+    JsonValue materialize() const;
+
+private:
+    explicit JsonValueView(const StringView& raw)
+        : m_raw(raw)
+    {
+    }
+
+    // Returns the value the parser has just seen the start of, and moves the parser past it.
+    JsonValueView value_at_parser(JsonPullParser&) const;
+
+    StringView m_raw;
+};
+
+}
+
+using AK::JsonValueView;
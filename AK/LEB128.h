@@ -72,7 +72,7 @@ struct LEB128 {
             ++num_bytes;
         } while (byte & (1 << 7));
 
-        if (num_bytes * 7 < sizeof(UValueType) * 4 && (byte & 0x40)) {
+        if (num_bytes * 7 < sizeof(UValueType) * 8 && (byte & 0x40)) {
             // sign extend
             result |= ((UValueType)(-1) << (num_bytes * 7));
         }
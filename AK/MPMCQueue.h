@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/Noncopyable.h>
+#include <AK/Optional.h>
+#include <AK/Platform.h>
+#include <AK/StdLibExtras.h>
+#include <AK/Types.h>
+
+namespace AK {
+
+// A bounded queue that any number of threads can enqueue into and dequeue from at the same time, without
+// taking a lock. This is Dmitry Vyukov's bounded MPMC queue: every slot has a sequence number that says
+// whose turn it is, so claiming a slot takes a single compare-exchange and nobody waits on anyone else
+// unless the queue is full or empty.
+template<typename T, size_t Capacity>
+class MPMCQueue {
+    AK_MAKE_NONCOPYABLE(MPMCQueue);
+    AK_MAKE_NONMOVABLE(MPMCQueue);
+
+    static_assert(Capacity > 1 && (Capacity & (Capacity - 1)) == 0, "MPMCQueue capacity must be a power of two");
+
+public:
+    MPMCQueue()
+    {
+        for (size_t i = 0; i < Capacity; ++i)
+            m_slots[i].sequence.store(i, AK::memory_order_relaxed);
+    }
+
+    ~MPMCQueue()
+    {
+        while (try_dequeue().has_value())
+            ;
+    }
+
+    constexpr size_t capacity() const { return Capacity; }
+
+    // Only a hint while other threads are using the queue.
+    size_t size() const
+    {
+        auto tail = m_enqueue_position.load(AK::memory_order_acquire);
+        auto head = m_dequeue_position.load(AK::memory_order_acquire);
+        return tail > head ? tail - head : 0;
+    }
+    bool is_empty() const { return size() == 0; }
+
+    // Leaves value alone and returns false if the queue is full.
+    template<typename U = T>
+    [[nodiscard]] bool try_enqueue(U&& value)
+    {
+        auto position = m_enqueue_position.load(AK::memory_order_relaxed);
+        Slot* slot;
+        for (;;) {
+            slot = &m_slots[position & (Capacity - 1)];
+            auto sequence = slot->sequence.load(AK::memory_order_acquire);
+            auto difference = static_cast<ssize_t>(sequence - position);
+            if (difference == 0) {
+                if (m_enqueue_position.compare_exchange_strong(position, position + 1, AK::memory_order_relaxed))
+                    break;
+            } else if (difference < 0) {
+                // Whoever had this slot a lap ago hasn't dequeued it yet.
+                return false;
+            } else {
+                position = m_enqueue_position.load(AK::memory_order_relaxed);
+            }
+        }
+        new (slot->storage) T(forward<U>(value));
+        slot->sequence.store(position + 1, AK::memory_order_release);
+        return true;
+    }
+
+    Optional<T> try_dequeue()
+    {
+        auto position = m_dequeue_position.load(AK::memory_order_relaxed);
+        Slot* slot;
+        for (;;) {
+            slot = &m_slots[position & (Capacity - 1)];
+            auto sequence = slot->sequence.load(AK::memory_order_acquire);
+            auto difference = static_cast<ssize_t>(sequence - (position + 1));
+            if (difference == 0) {
+                if (m_dequeue_position.compare_exchange_strong(position, position + 1, AK::memory_order_relaxed))
+                    break;
+            } else if (difference < 0) {
+                // Nobody has enqueued anything into this slot yet.
+                return {};
+            } else {
+                position = m_dequeue_position.load(AK::memory_order_relaxed);
+            }
+        }
+        auto& value = *reinterpret_cast<T*>(slot->storage);
+        Optional<T> result = move(value);
+        value.~T();
+        // Hand the slot over to whoever enqueues into it on the next lap.
+        slot->sequence.store(position + Capacity, AK::memory_order_release);
+        return result;
+    }
+
+private:
+    struct Slot {
+        Atomic<size_t> sequence { 0 };
+        alignas(T) u8 storage[sizeof(T)];
+    };
+
+    alignas(CACHE_LINE_SIZE) Atomic<size_t> m_enqueue_position { 0 };
+    alignas(CACHE_LINE_SIZE) Atomic<size_t> m_dequeue_position { 0 };
+    alignas(CACHE_LINE_SIZE) Slot m_slots[Capacity];
+};
+
+}
+
+using AK::MPMCQueue;
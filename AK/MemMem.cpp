@@ -0,0 +1,425 @@
+/*
+ * Copyright (c) 2020-2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/MemMem.h>
+#include <AK/Platform.h>
+#include <AK/SIMD.h>
+#include <AK/StdLibExtras.h>
+
+// The kernel doesn't save the vector registers on entry, so it has to make do with the plain loops.
+#if (ARCH(I386) || ARCH(X86_64)) && !defined(KERNEL)
+#    define HAVE_X86_VECTOR_IMPLEMENTATIONS
+#    include <cpuid.h>
+#endif
+
+namespace AK {
+
+static const void* memchr_scalar(const u8* haystack, u8 needle, size_t length)
+{
+    for (size_t i = 0; i < length; ++i) {
+        if (haystack[i] == needle)
+            return haystack + i;
+    }
+    return nullptr;
+}
+
+static const void* memrchr_scalar(const u8* haystack, u8 needle, size_t length)
+{
+    for (size_t i = length; i > 0; --i) {
+        if (haystack[i - 1] == needle)
+            return haystack + i - 1;
+    }
+    return nullptr;
+}
+
+static const void* find_any_of_scalar(const u8* haystack, size_t length, const u8* needles, size_t needle_count)
+{
+    if (needle_count == 1)
+        return memchr_scalar(haystack, needles[0], length);
+
+    bool is_needle[256] {};
+    for (size_t i = 0; i < needle_count; ++i)
+        is_needle[needles[i]] = true;
+    for (size_t i = 0; i < length; ++i) {
+        if (is_needle[haystack[i]])
+            return haystack + i;
+    }
+    return nullptr;
+}
+
+static const void* bitap_bitwise(const void* haystack, size_t haystack_length, const void* needle, size_t needle_length)
+{
+    VERIFY(needle_length < 32);
+
+    u64 lookup = 0xfffffffe;
+
+    constexpr size_t mask_length = (size_t)((u8)-1) + 1;
+    u64 needle_mask[mask_length];
+
+    for (size_t i = 0; i < mask_length; ++i)
+        needle_mask[i] = 0xffffffff;
+
+    for (size_t i = 0; i < needle_length; ++i)
+        needle_mask[((const u8*)needle)[i]] &= ~(0x00000001 << i);
+
+    for (size_t i = 0; i < haystack_length; ++i) {
+        lookup |= needle_mask[((const u8*)haystack)[i]];
+        lookup <<= 1;
+
+        if (!(lookup & (0x00000001 << needle_length)))
+            return ((const u8*)haystack) + i - needle_length + 1;
+    }
+
+    return nullptr;
+}
+
+// Returns the offset of the first match, or haystack_length if there is none.
+static size_t memmem_scalar(const u8* haystack, size_t haystack_length, const u8* needle, size_t needle_length)
+{
+    if (haystack_length < needle_length)
+        return haystack_length;
+
+    if (needle_length < 32) {
+        auto* match = static_cast<const u8*>(bitap_bitwise(haystack, haystack_length, needle, needle_length));
+        return match ? match - haystack : haystack_length;
+    }
+
+    Array<Span<const u8>, 1> spans { Span<const u8> { haystack, haystack_length } };
+    return memmem(spans.begin(), spans.end(), { needle, needle_length }).value_or(haystack_length);
+}
+
+#ifdef HAVE_X86_VECTOR_IMPLEMENTATIONS
+
+using c8x16 = char __attribute__((vector_size(16)));
+using c8x32 = char __attribute__((vector_size(32)));
+
+// Looking for more needles than this one vector comparison at a time is slower than the lookup table.
+static constexpr size_t max_vector_needle_count = 8;
+
+// Checking candidates that have the right first and last byte, but don't match, is where the vector versions of
+// memmem() could end up spending quadratic time. If that's starting to happen, we give up and let KMP deal with it.
+static bool should_give_up_on_candidates(size_t compared_bytes, size_t offset)
+{
+    return compared_bytes > 4 * offset + 4 * KiB;
+}
+
+[[gnu::target("sse2")]] static const void* memchr_sse2(const u8* haystack, u8 needle, size_t length)
+{
+    if (length < 16)
+        return memchr_scalar(haystack, needle, length);
+
+    auto needles = SIMD::u8x16 {} + needle;
+    // The last chunk overlaps the one before it, so we don't need a scalar loop for the tail.
+    for (size_t offset = 0; offset < length; offset += 16) {
+        offset = min(offset, length - 16);
+        SIMD::u8x16 chunk;
+        __builtin_memcpy(&chunk, haystack + offset, sizeof(chunk));
+        if (u32 mask = __builtin_ia32_pmovmskb128((c8x16)(chunk == needles)))
+            return haystack + offset + __builtin_ctz(mask);
+    }
+    return nullptr;
+}
+
+[[gnu::target("avx2")]] static const void* memchr_avx2(const u8* haystack, u8 needle, size_t length)
+{
+    if (length < 32)
+        return memchr_sse2(haystack, needle, length);
+
+    auto needles = SIMD::u8x32 {} + needle;
+    for (size_t offset = 0; offset < length; offset += 32) {
+        offset = min(offset, length - 32);
+        SIMD::u8x32 chunk;
+        __builtin_memcpy(&chunk, haystack + offset, sizeof(chunk));
+        if (u32 mask = __builtin_ia32_pmovmskb256((c8x32)(chunk == needles)))
+            return haystack + offset + __builtin_ctz(mask);
+    }
+    return nullptr;
+}
+
+[[gnu::target("sse2")]] static const void* memrchr_sse2(const u8* haystack, u8 needle, size_t length)
+{
+    if (length < 16)
+        return memrchr_scalar(haystack, needle, length);
+
+    auto needles = SIMD::u8x16 {} + needle;
+    for (size_t end = length; end > 0; end -= 16) {
+        end = max(end, static_cast<size_t>(16));
+        SIMD::u8x16 chunk;
+        __builtin_memcpy(&chunk, haystack + end - 16, sizeof(chunk));
+        if (u32 mask = __builtin_ia32_pmovmskb128((c8x16)(chunk == needles)))
+            return haystack + end - 16 + (31 - __builtin_clz(mask));
+    }
+    return nullptr;
+}
+
+[[gnu::target("avx2")]] static const void* memrchr_avx2(const u8* haystack, u8 needle, size_t length)
+{
+    if (length < 32)
+        return memrchr_sse2(haystack, needle, length);
+
+    auto needles = SIMD::u8x32 {} + needle;
+    for (size_t end = length; end > 0; end -= 32) {
+        end = max(end, static_cast<size_t>(32));
+        SIMD::u8x32 chunk;
+        __builtin_memcpy(&chunk, haystack + end - 32, sizeof(chunk));
+        if (u32 mask = __builtin_ia32_pmovmskb256((c8x32)(chunk == needles)))
+            return haystack + end - 32 + (31 - __builtin_clz(mask));
+    }
+    return nullptr;
+}
+
+[[gnu::target("sse2")]] static const void* find_any_of_sse2(const u8* haystack, size_t length, const u8* needles, size_t needle_count)
+{
+    if (needle_count == 1)
+        return memchr_sse2(haystack, needles[0], length);
+    if (length < 16 || needle_count > max_vector_needle_count)
+        return find_any_of_scalar(haystack, length, needles, needle_count);
+
+    SIMD::u8x16 broadcast_needles[max_vector_needle_count];
+    for (size_t i = 0; i < needle_count; ++i)
+        broadcast_needles[i] = SIMD::u8x16 {} + needles[i];
+
+    for (size_t offset = 0; offset < length; offset += 16) {
+        offset = min(offset, length - 16);
+        SIMD::u8x16 chunk;
+        __builtin_memcpy(&chunk, haystack + offset, sizeof(chunk));
+        auto matches = chunk == broadcast_needles[0];
+        for (size_t i = 1; i < needle_count; ++i)
+            matches |= chunk == broadcast_needles[i];
+        if (u32 mask = __builtin_ia32_pmovmskb128((c8x16)matches))
+            return haystack + offset + __builtin_ctz(mask);
+    }
+    return nullptr;
+}
+
+[[gnu::target("avx2")]] static const void* find_any_of_avx2(const u8* haystack, size_t length, const u8* needles, size_t needle_count)
+{
+    if (needle_count == 1)
+        return memchr_avx2(haystack, needles[0], length);
+    if (length < 32 || needle_count > max_vector_needle_count)
+        return find_any_of_sse2(haystack, length, needles, needle_count);
+
+    SIMD::u8x32 broadcast_needles[max_vector_needle_count];
+    for (size_t i = 0; i < needle_count; ++i)
+        broadcast_needles[i] = SIMD::u8x32 {} + needles[i];
+
+    for (size_t offset = 0; offset < length; offset += 32) {
+        offset = min(offset, length - 32);
+        SIMD::u8x32 chunk;
+        __builtin_memcpy(&chunk, haystack + offset, sizeof(chunk));
+        auto matches = chunk == broadcast_needles[0];
+        for (size_t i = 1; i < needle_count; ++i)
+            matches |= chunk == broadcast_needles[i];
+        if (u32 mask = __builtin_ia32_pmovmskb256((c8x32)matches))
+            return haystack + offset + __builtin_ctz(mask);
+    }
+    return nullptr;
+}
+
+// Only the positions where both the first and the last byte of the needle show up are compared in full.
+[[gnu::target("sse2")]] static size_t memmem_sse2(const u8* haystack, size_t haystack_length, const u8* needle, size_t needle_length)
+{
+    size_t candidate_count = haystack_length - needle_length + 1;
+    if (candidate_count < 16)
+        return memmem_scalar(haystack, haystack_length, needle, needle_length);
+
+    auto first_bytes = SIMD::u8x16 {} + needle[0];
+    auto last_bytes = SIMD::u8x16 {} + needle[needle_length - 1];
+    size_t compared_bytes = 0;
+    for (size_t offset = 0; offset < candidate_count; offset += 16) {
+        offset = min(offset, candidate_count - 16);
+        SIMD::u8x16 firsts;
+        SIMD::u8x16 lasts;
+        __builtin_memcpy(&firsts, haystack + offset, sizeof(firsts));
+        __builtin_memcpy(&lasts, haystack + offset + needle_length - 1, sizeof(lasts));
+        u32 mask = __builtin_ia32_pmovmskb128((c8x16)((firsts == first_bytes) & (lasts == last_bytes)));
+        for (; mask; mask &= mask - 1) {
+            size_t candidate = offset + __builtin_ctz(mask);
+            if (!__builtin_memcmp(haystack + candidate + 1, needle + 1, needle_length - 2))
+                return candidate;
+            compared_bytes += needle_length;
+        }
+        if (should_give_up_on_candidates(compared_bytes, offset)) {
+            size_t rest = offset + 16;
+            return rest + memmem_scalar(haystack + rest, haystack_length - rest, needle, needle_length);
+        }
+    }
+    return haystack_length;
+}
+
+[[gnu::target("avx2")]] static size_t memmem_avx2(const u8* haystack, size_t haystack_length, const u8* needle, size_t needle_length)
+{
+    size_t candidate_count = haystack_length - needle_length + 1;
+    if (candidate_count < 32)
+        return memmem_sse2(haystack, haystack_length, needle, needle_length);
+
+    auto first_bytes = SIMD::u8x32 {} + needle[0];
+    auto last_bytes = SIMD::u8x32 {} + needle[needle_length - 1];
+    size_t compared_bytes = 0;
+    for (size_t offset = 0; offset < candidate_count; offset += 32) {
+        offset = min(offset, candidate_count - 32);
+        SIMD::u8x32 firsts;
+        SIMD::u8x32 lasts;
+        __builtin_memcpy(&firsts, haystack + offset, sizeof(firsts));
+        __builtin_memcpy(&lasts, haystack + offset + needle_length - 1, sizeof(lasts));
+        u32 mask = __builtin_ia32_pmovmskb256((c8x32)((firsts == first_bytes) & (lasts == last_bytes)));
+        for (; mask; mask &= mask - 1) {
+            size_t candidate = offset + __builtin_ctz(mask);
+            if (!__builtin_memcmp(haystack + candidate + 1, needle + 1, needle_length - 2))
+                return candidate;
+            compared_bytes += needle_length;
+        }
+        if (should_give_up_on_candidates(compared_bytes, offset)) {
+            size_t rest = offset + 32;
+            return rest + memmem_scalar(haystack + rest, haystack_length - rest, needle, needle_length);
+        }
+    }
+    return haystack_length;
+}
+
+#endif
+
+struct Implementation {
+    MemorySearchImplementation type;
+    const void* (*memchr)(const u8*, u8, size_t);
+    const void* (*memrchr)(const u8*, u8, size_t);
+    const void* (*find_any_of)(const u8*, size_t, const u8*, size_t);
+    // Only called with needles of at least two bytes that fit in the haystack.
+    size_t (*memmem)(const u8*, size_t, const u8*, size_t);
+};
+
+static constexpr Implementation s_scalar_implementation { MemorySearchImplementation::Scalar, memchr_scalar, memrchr_scalar, find_any_of_scalar, memmem_scalar };
+#ifdef HAVE_X86_VECTOR_IMPLEMENTATIONS
+static constexpr Implementation s_sse2_implementation { MemorySearchImplementation::SSE2, memchr_sse2, memrchr_sse2, find_any_of_sse2, memmem_sse2 };
+static constexpr Implementation s_avx2_implementation { MemorySearchImplementation::AVX2, memchr_avx2, memrchr_avx2, find_any_of_avx2, memmem_avx2 };
+#endif
+
+static const Implementation* s_implementation;
+
+static bool cpu_supports(MemorySearchImplementation type)
+{
+    if (type == MemorySearchImplementation::Scalar)
+        return true;
+#ifdef HAVE_X86_VECTOR_IMPLEMENTATIONS
+    unsigned eax, ebx, ecx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+        return false;
+    if (type == MemorySearchImplementation::SSE2)
+        return edx & bit_SSE2;
+
+    // The CPU having AVX2 isn't enough, the OS also has to be saving the upper halves of the registers for us.
+    if (!(ecx & bit_OSXSAVE) || !(ecx & bit_AVX))
+        return false;
+    u32 xcr0_low, xcr0_high;
+    asm volatile("xgetbv"
+                 : "=a"(xcr0_low), "=d"(xcr0_high)
+                 : "c"(0));
+    if ((xcr0_low & 0x6) != 0x6)
+        return false;
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+        return false;
+    return ebx & bit_AVX2;
+#else
+    return false;
+#endif
+}
+
+static const Implementation& implementation_for(MemorySearchImplementation type)
+{
+    switch (type) {
+#ifdef HAVE_X86_VECTOR_IMPLEMENTATIONS
+    case MemorySearchImplementation::AVX2:
+        return s_avx2_implementation;
+    case MemorySearchImplementation::SSE2:
+        return s_sse2_implementation;
+#endif
+    default:
+        return s_scalar_implementation;
+    }
+}
+
+static const Implementation& implementation()
+{
+    // Several threads may race to get here first, but they'll all come up with the same answer.
+    if (!s_implementation) {
+        if (cpu_supports(MemorySearchImplementation::AVX2))
+            s_implementation = &implementation_for(MemorySearchImplementation::AVX2);
+        else if (cpu_supports(MemorySearchImplementation::SSE2))
+            s_implementation = &implementation_for(MemorySearchImplementation::SSE2);
+        else
+            s_implementation = &s_scalar_implementation;
+    }
+    return *s_implementation;
+}
+
+MemorySearchImplementation memory_search_implementation()
+{
+    return implementation().type;
+}
+
+bool set_memory_search_implementation(MemorySearchImplementation type)
+{
+    if (!cpu_supports(type) || implementation_for(type).type != type)
+        return false;
+    s_implementation = &implementation_for(type);
+    return true;
+}
+
+Optional<size_t> memmem_optional(const void* haystack, size_t haystack_length, const void* needle, size_t needle_length)
+{
+    if (needle_length == 0)
+        return 0;
+
+    if (haystack_length < needle_length)
+        return {};
+
+    if (haystack_length == needle_length) {
+        if (__builtin_memcmp(haystack, needle, haystack_length) == 0)
+            return 0;
+        return {};
+    }
+
+    auto* haystack_bytes = static_cast<const u8*>(haystack);
+    if (needle_length == 1) {
+        auto* match = implementation().memchr(haystack_bytes, *static_cast<const u8*>(needle), haystack_length);
+        if (!match)
+            return {};
+        return static_cast<const u8*>(match) - haystack_bytes;
+    }
+
+    auto offset = implementation().memmem(haystack_bytes, haystack_length, static_cast<const u8*>(needle), needle_length);
+    if (offset == haystack_length)
+        return {};
+    return offset;
+}
+
+const void* memmem(const void* haystack, size_t haystack_length, const void* needle, size_t needle_length)
+{
+    auto offset = memmem_optional(haystack, haystack_length, needle, needle_length);
+    if (offset.has_value())
+        return ((const u8*)haystack) + offset.value();
+
+    return nullptr;
+}
+
+const void* memchr(const void* haystack, u8 needle, size_t haystack_length)
+{
+    return implementation().memchr(static_cast<const u8*>(haystack), needle, haystack_length);
+}
+
+const void* memrchr(const void* haystack, u8 needle, size_t haystack_length)
+{
+    return implementation().memrchr(static_cast<const u8*>(haystack), needle, haystack_length);
+}
+
+const void* find_any_of(const void* haystack, size_t haystack_length, const void* needles, size_t needle_count)
+{
+    if (needle_count == 0)
+        return nullptr;
+    return implementation().find_any_of(static_cast<const u8*>(haystack), haystack_length, static_cast<const u8*>(needles), needle_count);
+}
+
+}
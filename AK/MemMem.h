@@ -8,40 +8,13 @@
 
 #include <AK/Array.h>
 #include <AK/Assertions.h>
+#include <AK/Optional.h>
 #include <AK/Span.h>
 #include <AK/Types.h>
 #include <AK/Vector.h>
 
 namespace AK {
 
-namespace {
-const static void* bitap_bitwise(const void* haystack, size_t haystack_length, const void* needle, size_t needle_length)
-{
-    VERIFY(needle_length < 32);
-
-    u64 lookup = 0xfffffffe;
-
-    constexpr size_t mask_length = (size_t)((u8)-1) + 1;
-    u64 needle_mask[mask_length];
-
-    for (size_t i = 0; i < mask_length; ++i)
-        needle_mask[i] = 0xffffffff;
-
-    for (size_t i = 0; i < needle_length; ++i)
-        needle_mask[((const u8*)needle)[i]] &= ~(0x00000001 << i);
-
-    for (size_t i = 0; i < haystack_length; ++i) {
-        lookup |= needle_mask[((const u8*)haystack)[i]];
-        lookup <<= 1;
-
-        if (!(lookup & (0x00000001 << needle_length)))
-            return ((const u8*)haystack) + i - needle_length + 1;
-    }
-
-    return nullptr;
-}
-}
-
 template<typename HaystackIterT>
 static inline Optional<size_t> memmem(const HaystackIterT& haystack_begin, const HaystackIterT& haystack_end, Span<const u8> needle) requires(requires { (*haystack_begin).data(); (*haystack_begin).size(); })
 {
@@ -100,39 +73,28 @@ static inline Optional<size_t> memmem(const HaystackIterT& haystack_begin, const
     return {};
 }
 
-static inline Optional<size_t> memmem_optional(const void* haystack, size_t haystack_length, const void* needle, size_t needle_length)
-{
-    if (needle_length == 0)
-        return 0;
+// The functions below look at 16 (SSE2) or 32 (AVX2) bytes at a time if the CPU supports it, and fall back to
+// plain loops otherwise. Which one to use is figured out the first time any of them are called.
 
-    if (haystack_length < needle_length)
-        return {};
+const void* memmem(const void* haystack, size_t haystack_length, const void* needle, size_t needle_length);
+Optional<size_t> memmem_optional(const void* haystack, size_t haystack_length, const void* needle, size_t needle_length);
 
-    if (haystack_length == needle_length) {
-        if (__builtin_memcmp(haystack, needle, haystack_length) == 0)
-            return 0;
-        return {};
-    }
+const void* memchr(const void* haystack, u8 needle, size_t haystack_length);
+const void* memrchr(const void* haystack, u8 needle, size_t haystack_length);
 
-    if (needle_length < 32) {
-        auto ptr = bitap_bitwise(haystack, haystack_length, needle, needle_length);
-        if (ptr)
-            return static_cast<size_t>((FlatPtr)ptr - (FlatPtr)haystack);
-        return {};
-    }
+// Finds the first byte in haystack that's equal to any of the needles.
+const void* find_any_of(const void* haystack, size_t haystack_length, const void* needles, size_t needle_count);
 
-    // Fallback to KMP.
-    Array<Span<const u8>, 1> spans { Span<const u8> { (const u8*)haystack, haystack_length } };
-    return memmem(spans.begin(), spans.end(), { (const u8*)needle, needle_length });
-}
+enum class MemorySearchImplementation {
+    Scalar,
+    SSE2,
+    AVX2,
+};
 
-static inline const void* memmem(const void* haystack, size_t haystack_length, const void* needle, size_t needle_length)
-{
-    auto offset = memmem_optional(haystack, haystack_length, needle, needle_length);
-    if (offset.has_value())
-        return ((const u8*)haystack) + offset.value();
+MemorySearchImplementation memory_search_implementation();
 
-    return nullptr;
-}
+// Only meant for testing the slower implementations on machines that would otherwise never use them.
+// Returns false if the CPU doesn't support the requested implementation.
+bool set_memory_search_implementation(MemorySearchImplementation);
 
 }
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Span.h>
+#include <AK/StdLibExtras.h>
+#include <AK/Vector.h>
+
+namespace AK {
+
+namespace Detail {
+
+// Runs shorter than this are extended with insertion sort before merging anything.
+static constexpr size_t merge_sort_min_run = 32;
+
+// Merges the sorted ranges [0, middle) and [middle, size), taking from the left one first when elements are equal.
+// Only the left range is moved out to buffer, which is where it gets merged back into place from.
+template<typename T, typename LessThan>
+void merge_adjacent(AK::Span<T> elements, size_t middle, LessThan& less_than, Vector<T>& buffer)
+{
+    if (middle == 0 || middle == elements.size())
+        return;
+    // Quite common with partially sorted input, and saves us doing anything at all.
+    if (!less_than(elements[middle], elements[middle - 1]))
+        return;
+
+    buffer.clear_with_capacity();
+    buffer.ensure_capacity(middle);
+    for (size_t i = 0; i < middle; ++i)
+        buffer.unchecked_append(move(elements[i]));
+
+    size_t left = 0;
+    size_t right = middle;
+    size_t out = 0;
+    while (left < middle && right < elements.size()) {
+        if (less_than(elements[right], buffer[left]))
+            elements[out++] = move(elements[right++]);
+        else
+            elements[out++] = move(buffer[left++]);
+    }
+    while (left < middle)
+        elements[out++] = move(buffer[left++]);
+}
+
+// Extends the sorted range [0, sorted) to [0, size) by inserting the rest one by one, after any equal elements.
+template<typename T, typename LessThan>
+void binary_insertion_sort(AK::Span<T> elements, size_t sorted, LessThan& less_than)
+{
+    for (size_t i = max(sorted, static_cast<size_t>(1)); i < elements.size(); ++i) {
+        size_t low = 0;
+        size_t high = i;
+        while (low < high) {
+            size_t middle = low + (high - low) / 2;
+            if (less_than(elements[i], elements[middle]))
+                high = middle;
+            else
+                low = middle + 1;
+        }
+        if (low == i)
+            continue;
+        T value = move(elements[i]);
+        for (size_t j = i; j > low; --j)
+            elements[j] = move(elements[j - 1]);
+        elements[low] = move(value);
+    }
+}
+
+// Finds the run at the start of elements, making it ascending if it was strictly descending.
+template<typename T, typename LessThan>
+size_t find_run(AK::Span<T> elements, LessThan& less_than)
+{
+    if (elements.size() < 2)
+        return elements.size();
+    size_t end = 2;
+    if (less_than(elements[1], elements[0])) {
+        // Only strictly descending runs can be reversed without reordering equal elements.
+        while (end < elements.size() && less_than(elements[end], elements[end - 1]))
+            ++end;
+        for (size_t i = 0; i < end / 2; ++i)
+            swap(elements[i], elements[end - i - 1]);
+    } else {
+        while (end < elements.size() && !less_than(elements[end], elements[end - 1]))
+            ++end;
+    }
+    return end;
+}
+
+}
+
+// A stable sort: equal elements stay in the order they were in. This is a natural merge sort along the lines of
+// Timsort (without galloping), so input that's already partially sorted, ascending or descending, is cheap to sort.
+// Needs room for up to half of the elements while merging.
+template<typename T, typename LessThan>
+void merge_sort(Span<T> elements, LessThan less_than)
+{
+    if (elements.size() < 2)
+        return;
+
+    struct Run {
+        size_t start;
+        size_t size;
+    };
+    Vector<Run, 64> runs;
+    Vector<T> buffer;
+
+    auto merge_runs_at = [&](size_t index) {
+        auto& left = runs[index];
+        auto& right = runs[index + 1];
+        Detail::merge_adjacent(elements.slice(left.start, left.size + right.size), left.size, less_than, buffer);
+        left.size += right.size;
+        runs.remove(index + 1);
+    };
+
+    for (size_t start = 0; start < elements.size();) {
+        auto rest = elements.slice(start);
+        size_t run_size = Detail::find_run(rest, less_than);
+        if (run_size < Detail::merge_sort_min_run) {
+            size_t extended_size = min(Detail::merge_sort_min_run, rest.size());
+            Detail::binary_insertion_sort(rest.trim(extended_size), run_size, less_than);
+            run_size = extended_size;
+        }
+        runs.append({ start, run_size });
+        start += run_size;
+
+        // Keep the run sizes on the stack shrinking at least as fast as the Fibonacci numbers, so merges stay
+        // balanced and the stack stays short.
+        while (runs.size() > 1) {
+            size_t n = runs.size() - 1;
+            if (n >= 2 && runs[n - 2].size <= runs[n - 1].size + runs[n].size) {
+                merge_runs_at(runs[n - 2].size < runs[n].size ? n - 2 : n - 1);
+            } else if (runs[n - 1].size <= runs[n].size) {
+                merge_runs_at(n - 1);
+            } else {
+                break;
+            }
+        }
+    }
+
+    while (runs.size() > 1)
+        merge_runs_at(runs.size() - 2);
+}
+
+template<typename Collection, typename LessThan>
+void merge_sort(Collection& collection, LessThan less_than)
+{
+    merge_sort(collection.span(), move(less_than));
+}
+
+template<typename Collection>
+void merge_sort(Collection& collection)
+{
+    merge_sort(collection.span(), [](auto& a, auto& b) { return a < b; });
+}
+
+}
+
+using AK::merge_sort;
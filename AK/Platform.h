@@ -45,6 +45,12 @@
 #endif
 #define NO_SANITIZE_ADDRESS [[gnu::no_sanitize_address]]
 
+// Things different threads keep writing to should be at least this far apart, so they don't keep taking
+// the same cache line away from each other.
+#ifndef CACHE_LINE_SIZE
+#    define CACHE_LINE_SIZE 64
+#endif
+
 #ifndef __serenity__
 #    include <unistd.h>
 #    define PAGE_SIZE sysconf(_SC_PAGESIZE)
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <AK/StdLibExtras.h>
+#include <AK/Types.h>
 
 namespace AK {
 
@@ -124,31 +125,152 @@ void single_pivot_quick_sort(Iterator start, Iterator end, LessThan less_than)
     }
 }
 
+namespace Detail {
+
+// Ranges this small are quicker to sort by insertion than by partitioning them any further.
+static constexpr size_t introsort_insertion_sort_threshold = 16;
+
+template<typename Collection, typename LessThan>
+void insertion_sort(Collection& col, size_t start, size_t end, LessThan& less_than)
+{
+    for (size_t i = start + 1; i < end; ++i) {
+        for (size_t j = i; j > start && less_than(col[j], col[j - 1]); --j)
+            swap(col[j], col[j - 1]);
+    }
+}
+
+template<typename Collection, typename LessThan>
+void sift_down(Collection& col, size_t start, size_t root, size_t size, LessThan& less_than)
+{
+    for (;;) {
+        size_t child = 2 * root + 1;
+        if (child >= size)
+            return;
+        if (child + 1 < size && less_than(col[start + child], col[start + child + 1]))
+            ++child;
+        if (!less_than(col[start + root], col[start + child]))
+            return;
+        swap(col[start + root], col[start + child]);
+        root = child;
+    }
+}
+
+template<typename Collection, typename LessThan>
+void heap_sort(Collection& col, size_t start, size_t end, LessThan& less_than)
+{
+    size_t size = end - start;
+    for (size_t i = size / 2; i > 0; --i)
+        sift_down(col, start, i - 1, size, less_than);
+    for (size_t i = size; i > 1; --i) {
+        swap(col[start], col[start + i - 1]);
+        sift_down(col, start, 0, i - 1, less_than);
+    }
+}
+
+template<typename Collection, typename LessThan>
+void introsort(Collection& col, size_t start, size_t end, LessThan& less_than, size_t depth_limit)
+{
+    while (end - start > introsort_insertion_sort_threshold) {
+        // We've been getting bad pivots for a while now, so the input is probably out to get us.
+        if (depth_limit == 0) {
+            heap_sort(col, start, end, less_than);
+            return;
+        }
+        --depth_limit;
+
+        // Move the median of the first, middle and last element to the front to use as the pivot.
+        size_t middle = start + (end - start) / 2;
+        if (less_than(col[middle], col[start]))
+            swap(col[middle], col[start]);
+        if (less_than(col[end - 1], col[middle]))
+            swap(col[end - 1], col[middle]);
+        if (less_than(col[middle], col[start]))
+            swap(col[middle], col[start]);
+        swap(col[start], col[middle]);
+
+        // Both sides stop at elements equal to the pivot, so lots of duplicates still split down the middle.
+        // The bounds checks keep us in range even if less_than isn't a strict weak ordering.
+        size_t i = start;
+        size_t j = end;
+        for (;;) {
+            do {
+                ++i;
+            } while (i < end && less_than(col[i], col[start]));
+            do {
+                --j;
+            } while (j > start && less_than(col[start], col[j]));
+            if (i >= j)
+                break;
+            swap(col[i], col[j]);
+        }
+        swap(col[start], col[j]);
+
+        // Recur into the shorter part to keep the stack depth at most log(n).
+        if (j - start < end - (j + 1)) {
+            introsort(col, start, j, less_than, depth_limit);
+            start = j + 1;
+        } else {
+            introsort(col, j + 1, end, less_than, depth_limit);
+            end = j;
+        }
+    }
+    insertion_sort(col, start, end, less_than);
+}
+
+template<typename Iterator>
+class IteratorRange {
+public:
+    explicit IteratorRange(Iterator start)
+        : m_start(start)
+    {
+    }
+
+    decltype(auto) operator[](size_t index) { return *(m_start + index); }
+
+private:
+    Iterator m_start;
+};
+
+}
+
+// Sorts col[start, end) in O(n log n) time, even in the worst case. Equal elements may end up in any order.
+// Only needs to swap elements, so it also works with collections that hand out proxies rather than references.
+template<typename Collection, typename LessThan>
+void introsort(Collection& col, size_t start, size_t end, LessThan less_than)
+{
+    if (end - start <= 1)
+        return;
+    size_t depth_limit = 2 * (sizeof(size_t) * 8 - __builtin_clzl(end - start));
+    Detail::introsort(col, start, end, less_than, depth_limit);
+}
+
 template<typename Iterator>
 void quick_sort(Iterator start, Iterator end)
 {
-    single_pivot_quick_sort(start, end, [](auto& a, auto& b) { return a < b; });
+    Detail::IteratorRange range { start };
+    introsort(range, 0, end - start, [](auto& a, auto& b) { return a < b; });
 }
 
 template<typename Iterator, typename LessThan>
 void quick_sort(Iterator start, Iterator end, LessThan less_than)
 {
-    single_pivot_quick_sort(start, end, move(less_than));
+    Detail::IteratorRange range { start };
+    introsort(range, 0, end - start, move(less_than));
 }
 
 template<typename Collection, typename LessThan>
 void quick_sort(Collection& collection, LessThan less_than)
 {
-    dual_pivot_quick_sort(collection, 0, collection.size() - 1, move(less_than));
+    introsort(collection, 0, collection.size(), move(less_than));
 }
 
 template<typename Collection>
 void quick_sort(Collection& collection)
 {
-    dual_pivot_quick_sort(collection, 0, collection.size() - 1,
-        [](auto& a, auto& b) { return a < b; });
+    introsort(collection, 0, collection.size(), [](auto& a, auto& b) { return a < b; });
 }
 
 }
 
+using AK::introsort;
 using AK::quick_sort;
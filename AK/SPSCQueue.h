@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/Noncopyable.h>
+#include <AK/Optional.h>
+#include <AK/Platform.h>
+#include <AK/StdLibExtras.h>
+#include <AK/Types.h>
+
+namespace AK {
+
+// A bounded queue that one thread enqueues into while another one dequeues from it, without either of them
+// taking a lock or having to wait for the other. Only ever use it from those two threads at a time.
+template<typename T, size_t Capacity>
+class SPSCQueue {
+    AK_MAKE_NONCOPYABLE(SPSCQueue);
+    AK_MAKE_NONMOVABLE(SPSCQueue);
+
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "SPSCQueue capacity must be a power of two");
+
+public:
+    SPSCQueue() = default;
+
+    ~SPSCQueue()
+    {
+        auto tail = m_tail.load(AK::memory_order_relaxed);
+        for (auto head = m_head.load(AK::memory_order_relaxed); head != tail; ++head)
+            slot(head).~T();
+    }
+
+    constexpr size_t capacity() const { return Capacity; }
+
+    // Only exact when called from the producer or consumer while the other one isn't doing anything.
+    size_t size() const { return m_tail.load(AK::memory_order_acquire) - m_head.load(AK::memory_order_acquire); }
+    bool is_empty() const { return size() == 0; }
+
+    // Producer only. Leaves value alone and returns false if the queue is full.
+    template<typename U = T>
+    [[nodiscard]] bool try_enqueue(U&& value)
+    {
+        auto tail = m_tail.load(AK::memory_order_relaxed);
+        if (tail - m_producer_cached_head == Capacity) {
+            m_producer_cached_head = m_head.load(AK::memory_order_acquire);
+            if (tail - m_producer_cached_head == Capacity)
+                return false;
+        }
+        new (&slot(tail)) T(forward<U>(value));
+        m_tail.store(tail + 1, AK::memory_order_release);
+        return true;
+    }
+
+    // Consumer only.
+    Optional<T> try_dequeue()
+    {
+        auto head = m_head.load(AK::memory_order_relaxed);
+        if (head == m_consumer_cached_tail) {
+            m_consumer_cached_tail = m_tail.load(AK::memory_order_acquire);
+            if (head == m_consumer_cached_tail)
+                return {};
+        }
+        auto& value = slot(head);
+        Optional<T> result = move(value);
+        value.~T();
+        m_head.store(head + 1, AK::memory_order_release);
+        return result;
+    }
+
+private:
+    T& slot(size_t index) { return *reinterpret_cast<T*>(&m_storage[(index & (Capacity - 1)) * sizeof(T)]); }
+
+    // Both sides keep their own index and a stale copy of the other one's on a cache line of their own, and only
+    // look at the other side's when the copy says the queue is full (or empty).
+    alignas(CACHE_LINE_SIZE) Atomic<size_t> m_tail { 0 };
+    size_t m_producer_cached_head { 0 };
+
+    alignas(CACHE_LINE_SIZE) Atomic<size_t> m_head { 0 };
+    size_t m_consumer_cached_tail { 0 };
+
+    alignas(CACHE_LINE_SIZE) alignas(T) u8 m_storage[Capacity * sizeof(T)];
+};
+
+}
+
+using AK::SPSCQueue;
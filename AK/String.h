@@ -252,7 +252,7 @@ public:
     template<typename... Parameters>
     [[nodiscard]] static String formatted(CheckedFormatString<Parameters...>&& fmtstr, const Parameters&... parameters)
     {
-        return vformatted(fmtstr.view(), VariadicFormatParams { parameters... });
+        return vformatted(fmtstr.view(), VariadicFormatParams<Parameters...> { fmtstr, parameters... });
     }
 
     template<typename T>
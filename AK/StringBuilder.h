@@ -33,7 +33,7 @@ public:
     template<typename... Parameters>
     void appendff(CheckedFormatString<Parameters...>&& fmtstr, const Parameters&... parameters)
     {
-        vformat(*this, fmtstr.view(), VariadicFormatParams { parameters... });
+        vformat(*this, fmtstr.view(), VariadicFormatParams<Parameters...> { fmtstr, parameters... });
     }
 
     [[nodiscard]] String build() const;
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Atomic.h>
 #include <AK/Debug.h>
 #include <AK/FlyString.h>
 #include <AK/HashTable.h>
@@ -12,6 +13,10 @@
 #include <AK/StringImpl.h>
 #include <AK/kmalloc.h>
 
+#if !defined(KERNEL) && !defined(NO_TLS)
+#    include <pthread.h>
+#endif
+
 #if STRINGIMPL_DEBUG
 unsigned g_stringimpl_count;
 static HashTable<StringImpl*>* g_all_live_stringimpls;
@@ -29,6 +34,11 @@ void dump_all_stringimpls()
 
 namespace AK {
 
+static inline size_t allocation_size_for_stringimpl(size_t length)
+{
+    return sizeof(StringImpl) + (sizeof(char) * length) + sizeof(char);
+}
+
 static StringImpl* s_the_empty_stringimpl = nullptr;
 
 StringImpl& StringImpl::the_empty_stringimpl()
@@ -40,6 +50,66 @@ StringImpl& StringImpl::the_empty_stringimpl()
     return *s_the_empty_stringimpl;
 }
 
+static StringImpl* s_single_byte_stringimpls[256];
+
+// Like the empty string, every string of a single byte is shared and never destroyed.
+StringImpl& StringImpl::the_single_byte_stringimpl(char ch)
+{
+    auto** slot = &s_single_byte_stringimpls[static_cast<u8>(ch)];
+    if (auto* stringimpl = atomic_load(slot, memory_order_acquire))
+        return *stringimpl;
+
+    // Fill in the new string before publishing it, so that other threads never see it half-constructed.
+    auto* new_stringimpl = new (kmalloc(allocation_size_for_stringimpl(1))) StringImpl(ConstructWithInlineBuffer, 1);
+    new_stringimpl->m_inline_buffer[0] = ch;
+    new_stringimpl->m_inline_buffer[1] = '\0';
+
+    StringImpl* expected = nullptr;
+    if (atomic_compare_exchange_strong(slot, expected, new_stringimpl, memory_order_acq_rel))
+        return *new_stringimpl;
+
+    // Someone else got there first, use theirs.
+    new_stringimpl->~StringImpl();
+    kfree(new_stringimpl);
+    return *expected;
+}
+
+#ifndef KERNEL
+// Short strings (identifiers, JSON keys, tag and header names) tend to get created over and over,
+// so each thread keeps a reference to the ones it created most recently and hands those out again.
+static constexpr size_t short_string_cache_size = 256;
+static constexpr size_t max_short_string_length = 23;
+#    ifdef NO_TLS
+static StringImpl* s_short_string_cache[short_string_cache_size];
+#    else
+static __thread StringImpl* s_short_string_cache[short_string_cache_size];
+static __thread bool s_short_string_cache_registered;
+
+static void release_short_string_cache(void* cache)
+{
+    for (auto*& stringimpl : Span<StringImpl*>(static_cast<StringImpl**>(cache), short_string_cache_size)) {
+        if (stringimpl)
+            stringimpl->unref();
+        stringimpl = nullptr;
+    }
+    s_short_string_cache_registered = false;
+}
+
+// Hands the cache of the calling thread over to a pthread key, whose destructor drops the cached references when the thread exits.
+static void register_short_string_cache()
+{
+    static pthread_key_t s_key = [] {
+        pthread_key_t key;
+        int rc = pthread_key_create(&key, release_short_string_cache);
+        VERIFY(rc == 0);
+        return key;
+    }();
+    pthread_setspecific(s_key, s_short_string_cache);
+    s_short_string_cache_registered = true;
+}
+#    endif
+#endif
+
 StringImpl::StringImpl(ConstructWithInlineBufferTag, size_t length)
     : m_length(length)
 {
@@ -61,11 +131,6 @@ StringImpl::~StringImpl()
 #endif
 }
 
-static inline size_t allocation_size_for_stringimpl(size_t length)
-{
-    return sizeof(StringImpl) + (sizeof(char) * length) + sizeof(char);
-}
-
 NonnullRefPtr<StringImpl> StringImpl::create_uninitialized(size_t length, char*& buffer)
 {
     VERIFY(length);
@@ -95,6 +160,34 @@ RefPtr<StringImpl> StringImpl::create(const char* cstring, size_t length, Should
     if (!length)
         return the_empty_stringimpl();
 
+    if (length == 1)
+        return the_single_byte_stringimpl(cstring[0]);
+
+#ifndef KERNEL
+    if (length <= max_short_string_length) {
+        auto hash = string_hash(cstring, length);
+#    ifndef NO_TLS
+        if (!s_short_string_cache_registered)
+            register_short_string_cache();
+#    endif
+        auto*& cached_stringimpl = s_short_string_cache[hash % short_string_cache_size];
+        if (cached_stringimpl && cached_stringimpl->length() == length && !memcmp(cached_stringimpl->characters(), cstring, length))
+            return *cached_stringimpl;
+
+        char* buffer;
+        auto new_stringimpl = create_uninitialized(length, buffer);
+        memcpy(buffer, cstring, length * sizeof(char));
+        new_stringimpl->m_hash = hash;
+        new_stringimpl->m_has_hash = true;
+
+        if (cached_stringimpl)
+            cached_stringimpl->unref();
+        cached_stringimpl = new_stringimpl.ptr();
+        cached_stringimpl->ref();
+        return new_stringimpl;
+    }
+#endif
+
     char* buffer;
     auto new_stringimpl = create_uninitialized(length, buffer);
     memcpy(buffer, cstring, length * sizeof(char));
@@ -148,6 +241,9 @@ NonnullRefPtr<StringImpl> StringImpl::to_lowercase() const
     return const_cast<StringImpl&>(*this);
 
 slow_path:
+    if (m_length == 1)
+        return the_single_byte_stringimpl(to_ascii_lowercase(characters()[0]));
+
     char* buffer;
     auto lowercased = create_uninitialized(m_length, buffer);
     for (size_t i = 0; i < m_length; ++i)
@@ -164,6 +260,9 @@ NonnullRefPtr<StringImpl> StringImpl::to_uppercase() const
     return const_cast<StringImpl&>(*this);
 
 slow_path:
+    if (m_length == 1)
+        return the_single_byte_stringimpl(to_ascii_uppercase(characters()[0]));
+
     char* buffer;
     auto uppercased = create_uninitialized(m_length, buffer);
     for (size_t i = 0; i < m_length; ++i)
@@ -35,6 +35,7 @@ public:
     }
 
     static StringImpl& the_empty_stringimpl();
+    static StringImpl& the_single_byte_stringimpl(char);
 
     ~StringImpl();
 
@@ -4,10 +4,9 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
-#include <AK/AnyOf.h>
 #include <AK/ByteBuffer.h>
-#include <AK/Find.h>
 #include <AK/FlyString.h>
+#include <AK/MemMem.h>
 #include <AK/Memory.h>
 #include <AK/String.h>
 #include <AK/StringView.h>
@@ -155,11 +154,7 @@ bool StringView::matches(const StringView& mask, CaseSensitivity case_sensitivit
 
 bool StringView::contains(char needle) const
 {
-    for (char current : *this) {
-        if (current == needle)
-            return true;
-    }
-    return false;
+    return find_first_of(needle).has_value();
 }
 
 bool StringView::contains(const StringView& needle, CaseSensitivity case_sensitivity) const
@@ -236,33 +231,22 @@ bool StringView::operator==(const String& string) const
 
 Optional<size_t> StringView::find_first_of(char c) const
 {
-    if (const auto location = AK::find(begin(), end(), c); location != end()) {
-        return location.index();
-    }
+    if (auto* location = static_cast<const char*>(AK::memchr(m_characters, c, m_length)))
+        return location - m_characters;
     return {};
 }
 
 Optional<size_t> StringView::find_first_of(const StringView& view) const
 {
-    if (const auto location = AK::find_if(begin(), end(),
-            [&](const auto c) {
-                return any_of(view.begin(), view.end(),
-                    [&](const auto view_char) {
-                        return c == view_char;
-                    });
-            });
-        location != end()) {
-        return location.index();
-    }
+    if (auto* location = static_cast<const char*>(AK::find_any_of(m_characters, m_length, view.m_characters, view.m_length)))
+        return location - m_characters;
     return {};
 }
 
 Optional<size_t> StringView::find_last_of(char c) const
 {
-    for (size_t pos = m_length; pos != 0; --pos) {
-        if (m_characters[pos - 1] == c)
-            return pos - 1;
-    }
+    if (auto* location = static_cast<const char*>(AK::memrchr(m_characters, c, m_length)))
+        return location - m_characters;
     return {};
 }
 
@@ -280,7 +264,7 @@ Optional<size_t> StringView::find_last_of(const StringView& view) const
 
 Optional<size_t> StringView::find(char c) const
 {
-    return find(StringView { &c, 1 });
+    return find_first_of(c);
 }
 
 Optional<size_t> StringView::find(const StringView& view) const
@@ -0,0 +1,406 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Assertions.h>
+#include <AK/MemMem.h>
+#include <AK/Platform.h>
+#include <AK/SIMD.h>
+#include <AK/Utf8.h>
+
+// Same as in MemMem.cpp: the kernel doesn't save the vector registers on entry.
+#if (ARCH(I386) || ARCH(X86_64)) && !defined(KERNEL)
+#    define HAVE_X86_VECTOR_IMPLEMENTATIONS
+#endif
+
+namespace AK {
+
+// Each of these handles the run of ASCII at the start of its input, and returns how long it was.
+
+static size_t ascii_prefix_length_scalar(const u8* bytes, size_t length)
+{
+    size_t offset = 0;
+    for (; offset + sizeof(u64) <= length; offset += sizeof(u64)) {
+        u64 word;
+        __builtin_memcpy(&word, bytes + offset, sizeof(word));
+        if (word & 0x8080808080808080)
+            break;
+    }
+    while (offset < length && bytes[offset] < 0x80)
+        ++offset;
+    return offset;
+}
+
+template<typename CodeUnit>
+static size_t widen_ascii_scalar(const u8* input, size_t length, CodeUnit* output)
+{
+    size_t offset = 0;
+    for (; offset < length && input[offset] < 0x80; ++offset)
+        output[offset] = input[offset];
+    return offset;
+}
+
+template<typename CodeUnit>
+static size_t narrow_ascii_scalar(const CodeUnit* input, size_t length, u8* output)
+{
+    size_t offset = 0;
+    for (; offset < length && input[offset] < 0x80; ++offset)
+        output[offset] = static_cast<u8>(input[offset]);
+    return offset;
+}
+
+static size_t count_code_points_scalar(const u8* bytes, size_t length)
+{
+    size_t count = 0;
+    for (size_t i = 0; i < length; ++i) {
+        if ((bytes[i] & 0xc0) != 0x80)
+            ++count;
+    }
+    return count;
+}
+
+#ifdef HAVE_X86_VECTOR_IMPLEMENTATIONS
+
+using c8x16 = char __attribute__((vector_size(16)));
+using c8x32 = char __attribute__((vector_size(32)));
+using u16x32 = u16 __attribute__((vector_size(64)));
+using u32x16 = u32 __attribute__((vector_size(64)));
+using u32x32 = u32 __attribute__((vector_size(128)));
+
+// Where a chunk has something other than ASCII in it, the vector versions leave the rest to the scalar one, which
+// stops at the right byte.
+
+[[gnu::target("sse2")]] static size_t ascii_prefix_length_sse2(const u8* bytes, size_t length)
+{
+    size_t offset = 0;
+    for (; offset + 16 <= length; offset += 16) {
+        SIMD::u8x16 chunk;
+        __builtin_memcpy(&chunk, bytes + offset, sizeof(chunk));
+        if (u32 mask = __builtin_ia32_pmovmskb128((c8x16)chunk))
+            return offset + __builtin_ctz(mask);
+    }
+    return offset + ascii_prefix_length_scalar(bytes + offset, length - offset);
+}
+
+[[gnu::target("avx2")]] static size_t ascii_prefix_length_avx2(const u8* bytes, size_t length)
+{
+    size_t offset = 0;
+    for (; offset + 32 <= length; offset += 32) {
+        SIMD::u8x32 chunk;
+        __builtin_memcpy(&chunk, bytes + offset, sizeof(chunk));
+        if (u32 mask = __builtin_ia32_pmovmskb256((c8x32)chunk))
+            return offset + __builtin_ctz(mask);
+    }
+    return offset + ascii_prefix_length_sse2(bytes + offset, length - offset);
+}
+
+// Continuation bytes are the only ones in [0x80, 0xc0), which is [-128, -64) when they're signed.
+[[gnu::target("sse2")]] static size_t count_code_points_sse2(const u8* bytes, size_t length)
+{
+    size_t count = 0;
+    size_t offset = 0;
+    for (; offset + 16 <= length; offset += 16) {
+        SIMD::i8x16 chunk;
+        __builtin_memcpy(&chunk, bytes + offset, sizeof(chunk));
+        count += __builtin_popcount(__builtin_ia32_pmovmskb128((c8x16)(chunk >= -64)));
+    }
+    return count + count_code_points_scalar(bytes + offset, length - offset);
+}
+
+[[gnu::target("avx2")]] static size_t count_code_points_avx2(const u8* bytes, size_t length)
+{
+    size_t count = 0;
+    size_t offset = 0;
+    for (; offset + 32 <= length; offset += 32) {
+        SIMD::i8x32 chunk;
+        __builtin_memcpy(&chunk, bytes + offset, sizeof(chunk));
+        count += __builtin_popcount(__builtin_ia32_pmovmskb256((c8x32)(chunk >= -64)));
+    }
+    return count + count_code_points_sse2(bytes + offset, length - offset);
+}
+
+template<typename CodeUnit>
+[[gnu::target("sse2")]] static size_t widen_ascii_sse2(const u8* input, size_t length, CodeUnit* output)
+{
+    using Wide = Conditional<sizeof(CodeUnit) == 2, SIMD::u16x16, u32x16>;
+    size_t offset = 0;
+    for (; offset + 16 <= length; offset += 16) {
+        SIMD::u8x16 chunk;
+        __builtin_memcpy(&chunk, input + offset, sizeof(chunk));
+        if (__builtin_ia32_pmovmskb128((c8x16)chunk))
+            break;
+        auto wide = __builtin_convertvector(chunk, Wide);
+        __builtin_memcpy(output + offset, &wide, sizeof(wide));
+    }
+    return offset + widen_ascii_scalar(input + offset, length - offset, output + offset);
+}
+
+template<typename CodeUnit>
+[[gnu::target("avx2")]] static size_t widen_ascii_avx2(const u8* input, size_t length, CodeUnit* output)
+{
+    using Wide = Conditional<sizeof(CodeUnit) == 2, u16x32, u32x32>;
+    size_t offset = 0;
+    for (; offset + 32 <= length; offset += 32) {
+        SIMD::u8x32 chunk;
+        __builtin_memcpy(&chunk, input + offset, sizeof(chunk));
+        if (__builtin_ia32_pmovmskb256((c8x32)chunk))
+            break;
+        auto wide = __builtin_convertvector(chunk, Wide);
+        __builtin_memcpy(output + offset, &wide, sizeof(wide));
+    }
+    return offset + widen_ascii_scalar(input + offset, length - offset, output + offset);
+}
+
+template<typename CodeUnit>
+[[gnu::target("sse2")]] static size_t narrow_ascii_sse2(const CodeUnit* input, size_t length, u8* output)
+{
+    using Wide = Conditional<sizeof(CodeUnit) == 2, SIMD::u16x16, u32x16>;
+    size_t offset = 0;
+    for (; offset + 16 <= length; offset += 16) {
+        Wide chunk;
+        __builtin_memcpy(&chunk, input + offset, sizeof(chunk));
+        // Comparing gives us all ones for the code units that aren't ASCII, which survive being narrowed to bytes.
+        if (__builtin_ia32_pmovmskb128((c8x16)__builtin_convertvector(chunk > 0x7f, SIMD::i8x16)))
+            break;
+        auto narrow = __builtin_convertvector(chunk, SIMD::u8x16);
+        __builtin_memcpy(output + offset, &narrow, sizeof(narrow));
+    }
+    return offset + narrow_ascii_scalar(input + offset, length - offset, output + offset);
+}
+
+template<typename CodeUnit>
+[[gnu::target("avx2")]] static size_t narrow_ascii_avx2(const CodeUnit* input, size_t length, u8* output)
+{
+    using Wide = Conditional<sizeof(CodeUnit) == 2, u16x32, u32x32>;
+    size_t offset = 0;
+    for (; offset + 32 <= length; offset += 32) {
+        Wide chunk;
+        __builtin_memcpy(&chunk, input + offset, sizeof(chunk));
+        if (__builtin_ia32_pmovmskb256((c8x32)__builtin_convertvector(chunk > 0x7f, SIMD::i8x32)))
+            break;
+        auto narrow = __builtin_convertvector(chunk, SIMD::u8x32);
+        __builtin_memcpy(output + offset, &narrow, sizeof(narrow));
+    }
+    return offset + narrow_ascii_scalar(input + offset, length - offset, output + offset);
+}
+
+#endif
+
+struct Utf8Implementation {
+    size_t (*ascii_prefix_length)(const u8*, size_t);
+    size_t (*count_code_points)(const u8*, size_t);
+    size_t (*widen_ascii_to_utf16)(const u8*, size_t, u16*);
+    size_t (*widen_ascii_to_utf32)(const u8*, size_t, u32*);
+    size_t (*narrow_ascii_from_utf16)(const u16*, size_t, u8*);
+    size_t (*narrow_ascii_from_utf32)(const u32*, size_t, u8*);
+};
+
+static constexpr Utf8Implementation s_scalar_implementation { ascii_prefix_length_scalar, count_code_points_scalar, widen_ascii_scalar<u16>, widen_ascii_scalar<u32>, narrow_ascii_scalar<u16>, narrow_ascii_scalar<u32> };
+#ifdef HAVE_X86_VECTOR_IMPLEMENTATIONS
+static constexpr Utf8Implementation s_sse2_implementation { ascii_prefix_length_sse2, count_code_points_sse2, widen_ascii_sse2<u16>, widen_ascii_sse2<u32>, narrow_ascii_sse2<u16>, narrow_ascii_sse2<u32> };
+static constexpr Utf8Implementation s_avx2_implementation { ascii_prefix_length_avx2, count_code_points_avx2, widen_ascii_avx2<u16>, widen_ascii_avx2<u32>, narrow_ascii_avx2<u16>, narrow_ascii_avx2<u32> };
+#endif
+
+// Goes along with whatever the memory search functions picked, so that set_memory_search_implementation() lets the
+// tests exercise every variant here too.
+static const Utf8Implementation& implementation()
+{
+    switch (memory_search_implementation()) {
+#ifdef HAVE_X86_VECTOR_IMPLEMENTATIONS
+    case MemorySearchImplementation::AVX2:
+        return s_avx2_implementation;
+    case MemorySearchImplementation::SSE2:
+        return s_sse2_implementation;
+#endif
+    default:
+        return s_scalar_implementation;
+    }
+}
+
+// Returns 0 for bytes that can't start a sequence.
+static size_t sequence_length(u8 leading_byte)
+{
+    if (leading_byte < 0x80)
+        return 1;
+    if ((leading_byte & 0xe0) == 0xc0)
+        return 2;
+    if ((leading_byte & 0xf0) == 0xe0)
+        return 3;
+    if ((leading_byte & 0xf8) == 0xf0)
+        return 4;
+    return 0;
+}
+
+// Decodes the multibyte sequence at offset, and moves offset past it.
+static u32 decode_sequence(const u8* bytes, size_t length, size_t& offset)
+{
+    auto leading_byte = bytes[offset];
+    auto code_point_length = sequence_length(leading_byte);
+    VERIFY(code_point_length > 1 && code_point_length <= length - offset);
+    u32 code_point = leading_byte & (0x7f >> code_point_length);
+    for (size_t i = 1; i < code_point_length; ++i)
+        code_point = (code_point << 6) | (bytes[offset + i] & 0x3f);
+    offset += code_point_length;
+    return code_point;
+}
+
+static size_t encode_code_point(u32 code_point, u8* output)
+{
+    if (code_point < 0x80) {
+        output[0] = code_point;
+        return 1;
+    }
+    if (code_point < 0x800) {
+        output[0] = 0xc0 | (code_point >> 6);
+        output[1] = 0x80 | (code_point & 0x3f);
+        return 2;
+    }
+    if (code_point > 0x10ffff)
+        code_point = 0xfffd;
+    if (code_point < 0x10000) {
+        output[0] = 0xe0 | (code_point >> 12);
+        output[1] = 0x80 | ((code_point >> 6) & 0x3f);
+        output[2] = 0x80 | (code_point & 0x3f);
+        return 3;
+    }
+    output[0] = 0xf0 | (code_point >> 18);
+    output[1] = 0x80 | ((code_point >> 12) & 0x3f);
+    output[2] = 0x80 | ((code_point >> 6) & 0x3f);
+    output[3] = 0x80 | (code_point & 0x3f);
+    return 4;
+}
+
+size_t ascii_prefix_length(ReadonlyBytes bytes)
+{
+    return implementation().ascii_prefix_length(bytes.data(), bytes.size());
+}
+
+bool validate_utf8(ReadonlyBytes bytes, size_t& valid_bytes)
+{
+    auto& implementation = AK::implementation();
+    auto* data = bytes.data();
+    size_t length = bytes.size();
+    size_t offset = 0;
+    while (offset < length) {
+        if (data[offset] < 0x80) {
+            // Don't bother with the vector loop for a lone space between two words of some other script.
+            ++offset;
+            if (offset < length && data[offset] < 0x80)
+                offset += implementation.ascii_prefix_length(data + offset, length - offset);
+            continue;
+        }
+        auto code_point_length = sequence_length(data[offset]);
+        if (code_point_length == 0 || code_point_length > length - offset) {
+            valid_bytes = offset;
+            return false;
+        }
+        for (size_t i = 1; i < code_point_length; ++i) {
+            if ((data[offset + i] & 0xc0) != 0x80) {
+                valid_bytes = offset;
+                return false;
+            }
+        }
+        offset += code_point_length;
+    }
+    valid_bytes = length;
+    return true;
+}
+
+size_t count_utf8_code_points(ReadonlyBytes bytes)
+{
+    return implementation().count_code_points(bytes.data(), bytes.size());
+}
+
+size_t transcode_utf8_to_utf32(ReadonlyBytes input, u32* output)
+{
+    auto& implementation = AK::implementation();
+    auto* data = input.data();
+    size_t length = input.size();
+    size_t offset = 0;
+    size_t written = 0;
+    while (offset < length) {
+        if (data[offset] < 0x80) {
+            auto ascii_length = implementation.widen_ascii_to_utf32(data + offset, length - offset, output + written);
+            offset += ascii_length;
+            written += ascii_length;
+            continue;
+        }
+        output[written++] = decode_sequence(data, length, offset);
+    }
+    return written;
+}
+
+size_t transcode_utf8_to_utf16(ReadonlyBytes input, u16* output)
+{
+    auto& implementation = AK::implementation();
+    auto* data = input.data();
+    size_t length = input.size();
+    size_t offset = 0;
+    size_t written = 0;
+    while (offset < length) {
+        if (data[offset] < 0x80) {
+            auto ascii_length = implementation.widen_ascii_to_utf16(data + offset, length - offset, output + written);
+            offset += ascii_length;
+            written += ascii_length;
+            continue;
+        }
+        auto code_point = decode_sequence(data, length, offset);
+        if (code_point > 0x10ffff) {
+            output[written++] = 0xfffd;
+        } else if (code_point >= 0x10000) {
+            // Always comes from four bytes, so there's room for both halves of the surrogate pair.
+            code_point -= 0x10000;
+            output[written++] = 0xd800 | (code_point >> 10);
+            output[written++] = 0xdc00 | (code_point & 0x3ff);
+        } else {
+            output[written++] = code_point;
+        }
+    }
+    return written;
+}
+
+size_t transcode_utf32_to_utf8(Span<const u32> input, u8* output)
+{
+    auto& implementation = AK::implementation();
+    auto* data = input.data();
+    size_t length = input.size();
+    size_t offset = 0;
+    size_t written = 0;
+    while (offset < length) {
+        if (data[offset] < 0x80) {
+            auto ascii_length = implementation.narrow_ascii_from_utf32(data + offset, length - offset, output + written);
+            offset += ascii_length;
+            written += ascii_length;
+            continue;
+        }
+        written += encode_code_point(data[offset++], output + written);
+    }
+    return written;
+}
+
+size_t transcode_utf16_to_utf8(Span<const u16> input, u8* output)
+{
+    auto& implementation = AK::implementation();
+    auto* data = input.data();
+    size_t length = input.size();
+    size_t offset = 0;
+    size_t written = 0;
+    while (offset < length) {
+        if (data[offset] < 0x80) {
+            auto ascii_length = implementation.narrow_ascii_from_utf16(data + offset, length - offset, output + written);
+            offset += ascii_length;
+            written += ascii_length;
+            continue;
+        }
+        u32 code_point = data[offset++];
+        bool is_high_surrogate = code_point >= 0xd800 && code_point < 0xdc00;
+        if (is_high_surrogate && offset < length && data[offset] >= 0xdc00 && data[offset] < 0xe000)
+            code_point = 0x10000 + ((code_point - 0xd800) << 10) + (data[offset++] - 0xdc00);
+        written += encode_code_point(code_point, output + written);
+    }
+    return written;
+}
+
+}
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Span.h>
+#include <AK/Types.h>
+
+namespace AK {
+
+// Bulk operations on UTF-8 text. Almost everything we read is ASCII, so these skip over runs of it 16 (SSE2) or
+// 32 (AVX2) bytes at a time where the CPU supports it, following memory_search_implementation(), and only look
+// at multibyte sequences one by one.
+
+// How many bytes at the start of bytes are ASCII.
+size_t ascii_prefix_length(ReadonlyBytes bytes);
+inline bool is_ascii(ReadonlyBytes bytes) { return ascii_prefix_length(bytes) == bytes.size(); }
+
+// Checks that bytes is made up of complete sequences with a valid leading byte and the right number of continuation
+// bytes, which is exactly what Utf8CodepointIterator relies on. valid_bytes is set to the length of the longest
+// prefix that passes.
+bool validate_utf8(ReadonlyBytes bytes, size_t& valid_bytes);
+
+// Only meaningful for bytes that validate_utf8() accepts.
+size_t count_utf8_code_points(ReadonlyBytes bytes);
+
+// The transcoders expect input that validate_utf8() accepts (or any UTF-16/UTF-32), and return how many code units
+// they wrote to output. There has to be room for one code unit per input byte when decoding UTF-8, and three
+// (from UTF-16) or four (from UTF-32) bytes per code unit when encoding it. Code points that can't be represented
+// come out as U+FFFD, while unpaired surrogates in UTF-16 are encoded as if they were code points.
+size_t transcode_utf8_to_utf32(ReadonlyBytes input, u32* output);
+size_t transcode_utf8_to_utf16(ReadonlyBytes input, u16* output);
+size_t transcode_utf32_to_utf8(Span<const u32> input, u8* output);
+size_t transcode_utf16_to_utf8(Span<const u16> input, u8* output);
+
+}
+
+using AK::ascii_prefix_length;
+using AK::count_utf8_code_points;
+using AK::is_ascii;
+using AK::transcode_utf16_to_utf8;
+using AK::transcode_utf32_to_utf8;
+using AK::transcode_utf8_to_utf16;
+using AK::transcode_utf8_to_utf32;
+using AK::validate_utf8;
@@ -6,6 +6,7 @@
 
 #include <AK/Assertions.h>
 #include <AK/Format.h>
+#include <AK/Utf8.h>
 #include <AK/Utf8View.h>
 
 namespace AK {
@@ -93,35 +94,12 @@ static inline bool decode_first_byte(
 
 bool Utf8View::validate(size_t& valid_bytes) const
 {
-    valid_bytes = 0;
-    for (auto ptr = begin_ptr(); ptr < end_ptr(); ptr++) {
-        size_t code_point_length_in_bytes;
-        u32 value;
-        bool first_byte_makes_sense = decode_first_byte(*ptr, code_point_length_in_bytes, value);
-        if (!first_byte_makes_sense)
-            return false;
-
-        for (size_t i = 1; i < code_point_length_in_bytes; i++) {
-            ptr++;
-            if (ptr >= end_ptr())
-                return false;
-            if (*ptr >> 6 != 2)
-                return false;
-        }
-
-        valid_bytes += code_point_length_in_bytes;
-    }
-
-    return true;
+    return validate_utf8(m_string.bytes(), valid_bytes);
 }
 
 size_t Utf8View::calculate_length() const
 {
-    size_t length = 0;
-    for ([[maybe_unused]] auto code_point : *this) {
-        ++length;
-    }
-    return length;
+    return count_utf8_code_points(m_string.bytes());
 }
 
 bool Utf8View::starts_with(const Utf8View& start) const
@@ -148,20 +126,8 @@ Utf8CodepointIterator::Utf8CodepointIterator(const unsigned char* ptr, size_t le
 {
 }
 
-bool Utf8CodepointIterator::operator==(const Utf8CodepointIterator& other) const
+Utf8CodepointIterator& Utf8CodepointIterator::advance_past_multibyte_sequence()
 {
-    return m_ptr == other.m_ptr && m_length == other.m_length;
-}
-
-bool Utf8CodepointIterator::operator!=(const Utf8CodepointIterator& other) const
-{
-    return !(*this == other);
-}
-
-Utf8CodepointIterator& Utf8CodepointIterator::operator++()
-{
-    VERIFY(m_length > 0);
-
     size_t code_point_length_in_bytes = 0;
     u32 value;
     bool first_byte_makes_sense = decode_first_byte(*m_ptr, code_point_length_in_bytes, value);
@@ -185,10 +151,8 @@ size_t Utf8CodepointIterator::code_point_length_in_bytes() const
     return code_point_length_in_bytes;
 }
 
-u32 Utf8CodepointIterator::operator*() const
+u32 Utf8CodepointIterator::decode_multibyte_sequence() const
 {
-    VERIFY(m_length > 0);
-
     u32 code_point_value_so_far = 0;
     size_t code_point_length_in_bytes = 0;
 
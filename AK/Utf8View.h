@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Assertions.h>
 #include <AK/StringView.h>
 #include <AK/Types.h>
 
@@ -20,10 +21,28 @@ public:
     Utf8CodepointIterator() = default;
     ~Utf8CodepointIterator() = default;
 
-    bool operator==(const Utf8CodepointIterator&) const;
-    bool operator!=(const Utf8CodepointIterator&) const;
-    Utf8CodepointIterator& operator++();
-    u32 operator*() const;
+    bool operator==(const Utf8CodepointIterator& other) const { return m_ptr == other.m_ptr && m_length == other.m_length; }
+    bool operator!=(const Utf8CodepointIterator& other) const { return !(*this == other); }
+
+    // Most of what we iterate over is ASCII, so that much is handled right here.
+    Utf8CodepointIterator& operator++()
+    {
+        VERIFY(m_length > 0);
+        if (*m_ptr < 0x80) {
+            ++m_ptr;
+            --m_length;
+            return *this;
+        }
+        return advance_past_multibyte_sequence();
+    }
+
+    u32 operator*() const
+    {
+        VERIFY(m_length > 0);
+        if (*m_ptr < 0x80)
+            return *m_ptr;
+        return decode_multibyte_sequence();
+    }
 
     ssize_t operator-(const Utf8CodepointIterator& other) const
     {
@@ -35,6 +54,9 @@ public:
 
 private:
     Utf8CodepointIterator(const unsigned char*, size_t);
+    Utf8CodepointIterator& advance_past_multibyte_sequence();
+    u32 decode_multibyte_sequence() const;
+
     const unsigned char* m_ptr { nullptr };
     size_t m_length;
 };
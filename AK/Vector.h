@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Allocator.h>
 #include <AK/Assertions.h>
 #include <AK/Find.h>
 #include <AK/Forward.h>
@@ -30,7 +31,7 @@
 
 namespace AK {
 
-template<typename T, size_t inline_capacity>
+template<typename T, size_t inline_capacity, typename Allocator>
 class Vector {
 public:
     using value_type = T;
@@ -40,6 +41,12 @@ public:
     {
     }
 
+    explicit Vector(Allocator allocator)
+        : m_capacity(inline_capacity)
+        , m_allocator(move(allocator))
+    {
+    }
+
     ~Vector()
     {
         clear();
@@ -58,6 +65,7 @@ public:
         : m_size(other.m_size)
         , m_capacity(other.m_capacity)
         , m_outline_buffer(other.m_outline_buffer)
+        , m_allocator(other.m_allocator)
     {
         if constexpr (inline_capacity > 0) {
             if (!m_outline_buffer) {
@@ -73,6 +81,7 @@ public:
     }
 
     Vector(const Vector& other)
+        : m_allocator(other.m_allocator)
     {
         ensure_capacity(other.size());
         TypedTransfer<T>::copy(data(), other.data(), other.size());
@@ -98,6 +107,7 @@ public:
             m_size = other.m_size;
             m_capacity = other.m_capacity;
             m_outline_buffer = other.m_outline_buffer;
+            m_allocator = other.m_allocator;
             if constexpr (inline_capacity > 0) {
                 if (!m_outline_buffer) {
                     for (size_t i = 0; i < m_size; ++i) {
@@ -117,7 +127,7 @@ public:
     {
         clear_with_capacity();
         if (m_outline_buffer) {
-            kfree(m_outline_buffer);
+            m_allocator.deallocate(m_outline_buffer, m_capacity * sizeof(T));
             m_outline_buffer = nullptr;
         }
         reset_capacity();
@@ -564,7 +574,7 @@ public:
         if (m_capacity >= needed_capacity)
             return true;
         size_t new_capacity = needed_capacity;
-        auto* new_buffer = (T*)kmalloc(new_capacity * sizeof(T));
+        auto* new_buffer = (T*)m_allocator.allocate(new_capacity * sizeof(T));
         if (new_buffer == nullptr)
             return false;
 
@@ -577,7 +587,7 @@ public:
             }
         }
         if (m_outline_buffer)
-            kfree(m_outline_buffer);
+            m_allocator.deallocate(m_outline_buffer, m_capacity * sizeof(T));
         m_outline_buffer = new_buffer;
         m_capacity = new_capacity;
         return true;
@@ -650,6 +660,8 @@ public:
     ConstIterator end() const { return ConstIterator::end(*this); }
     Iterator end() { return Iterator::end(*this); }
 
+    const Allocator& allocator() const { return m_allocator; }
+
     template<typename TUnaryPredicate>
     ConstIterator find_if(TUnaryPredicate&& finder) const
     {
@@ -711,6 +723,7 @@ private:
 
     alignas(T) unsigned char m_inline_buffer_storage[sizeof(T) * inline_capacity];
     T* m_outline_buffer { nullptr };
+    [[no_unique_address]] Allocator m_allocator;
 };
 
 }
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Types.h>
+
+// This is the layout of /proc/processes. Each read starts with a ProcessStatisticsHeader.
+// The first read through a file description (since_generation == 0) describes every process;
+// after seeking back to the start, a read only describes the processes that changed since the
+// previous read through that same description.
+//
+// The header is followed by changed_process_count ProcessStatisticsEntry records, each one
+// followed by its thread_count ThreadStatisticsEntry records, and finally by an
+// UnchangedProcessStatisticsEntry for each of the unchanged_process_count processes that are
+// still around but didn't change otherwise. Processes that are in neither list have gone away.
+//
+// Strings are NUL-terminated and truncated to fit.
+
+struct ProcessStatisticsHeader {
+    u64 generation;
+    u64 since_generation;
+    u32 changed_process_count;
+    u32 unchanged_process_count;
+};
+
+enum ProcessStatisticsFlags : u32 {
+    ProcessStatisticsFlagKernel = 1 << 0,
+    ProcessStatisticsFlagDumpable = 1 << 1,
+};
+
+struct ProcessStatisticsEntry {
+    u32 pid;
+    u32 pgid;
+    u32 pgp;
+    u32 sid;
+    u32 uid;
+    u32 gid;
+    u32 ppid;
+    u32 nfds;
+    u32 flags;
+    u32 thread_count;
+    u64 amount_virtual;
+    u64 amount_resident;
+    u64 amount_dirty_private;
+    u64 amount_clean_inode;
+    u64 amount_shared;
+    u64 amount_purgeable_volatile;
+    u64 amount_purgeable_nonvolatile;
+    char name[64];
+    char tty[32];
+    char veil[16];
+    char pledge[256];
+    char executable[256];
+};
+
+// What can change about a process without any of its threads doing anything: its memory usage
+// goes down when its pages get compressed or swapped out, and its terminal's foreground process
+// group gets picked by others.
+struct UnchangedProcessStatisticsEntry {
+    u32 pid;
+    u32 pgid;
+    u64 amount_virtual;
+    u64 amount_resident;
+    u64 amount_dirty_private;
+    u64 amount_clean_inode;
+    u64 amount_shared;
+    u64 amount_purgeable_volatile;
+    u64 amount_purgeable_nonvolatile;
+};
+
+struct ThreadStatisticsEntry {
+    u32 tid;
+    u32 times_scheduled;
+    u32 ticks_user;
+    u32 ticks_kernel;
+    u32 cpu;
+    u32 priority;
+    u32 syscall_count;
+    u32 inode_faults;
+    u32 zero_faults;
+    u32 cow_faults;
+    u32 file_read_bytes;
+    u32 file_write_bytes;
+    u32 unix_socket_read_bytes;
+    u32 unix_socket_write_bytes;
+    u32 ipv4_socket_read_bytes;
+    u32 ipv4_socket_write_bytes;
+    char state[32];
+    char name[64];
+};
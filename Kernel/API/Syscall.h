@@ -177,7 +177,8 @@ namespace Kernel {
     S(anon_create)                \
     S(msyscall)                   \
     S(readv)                      \
-    S(emuctl)
+    S(emuctl)                     \
+    S(swapon)
 
 namespace Syscall {
 
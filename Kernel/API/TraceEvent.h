@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/EnumBits.h>
+#include <AK/Types.h>
+
+enum class TraceCategory : u32 {
+    None = 0,
+    Scheduler = 1 << 0,
+    PageFault = 1 << 1,
+    BlockIO = 1 << 2,
+    Syscall = 1 << 3,
+    All = Scheduler | PageFault | BlockIO | Syscall,
+};
+
+AK_ENUM_BITWISE_OPERATORS(TraceCategory);
+
+enum class TraceEventType : u16 {
+    Invalid = 0,
+    // Synthesized by the reader when a per-CPU buffer overflowed.
+    EventsLost,
+    ContextSwitch,
+    PageFault,
+    BlockIOSubmit,
+    BlockIOComplete,
+    SyscallEnter,
+    SyscallExit,
+};
+
+struct [[gnu::packed]] TraceEventsLostEvent {
+    u32 count;
+};
+
+struct [[gnu::packed]] TraceContextSwitchEvent {
+    u32 next_pid;
+    u32 next_tid;
+    u32 previous_state;
+};
+
+struct [[gnu::packed]] TracePageFaultEvent {
+    FlatPtr vaddr;
+    u16 code;
+};
+
+struct [[gnu::packed]] TraceBlockIOEvent {
+    u32 major;
+    u32 minor;
+    u64 block_index;
+    u32 block_count;
+    u8 is_write;
+    u8 result;
+};
+
+struct [[gnu::packed]] TraceSyscallEvent {
+    u32 function;
+    FlatPtr value;
+};
+
+// Every record read from /dev/trace has this exact size and layout.
+struct [[gnu::packed]] TraceEvent {
+    u64 timestamp_ns { 0 };
+    TraceEventType type { TraceEventType::Invalid };
+    u16 cpu { 0 };
+    u32 pid { 0 };
+    u32 tid { 0 };
+    union {
+        TraceEventsLostEvent events_lost;
+        TraceContextSwitchEvent context_switch;
+        TracePageFaultEvent page_fault;
+        TraceBlockIOEvent block_io;
+        TraceSyscallEvent syscall;
+    } data {};
+};
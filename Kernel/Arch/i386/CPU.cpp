@@ -1189,6 +1189,7 @@ UNMAP_AFTER_INIT void Processor::early_initialize(u32 cpu)
     m_current_thread = nullptr;
     m_scheduler_data = nullptr;
     m_mm_data = nullptr;
+    m_trace_event_buffer = nullptr;
     m_info = nullptr;
 
     m_halt_requested = false;
@@ -119,6 +119,7 @@ public:
         UserSupervisor = 1 << 2,
         WriteThrough = 1 << 3,
         CacheDisabled = 1 << 4,
+        Accessed = 1 << 5,
         Global = 1 << 8,
         NoExecute = 0x8000000000000000ULL,
     };
@@ -138,6 +139,9 @@ public:
     bool is_cache_disabled() const { return raw() & CacheDisabled; }
     void set_cache_disabled(bool b) { set_bit(CacheDisabled, b); }
 
+    bool is_accessed() const { return raw() & Accessed; }
+    void set_accessed(bool b) { set_bit(Accessed, b); }
+
     bool is_global() const { return raw() & Global; }
     void set_global(bool b) { set_bit(Global, b); }
 
@@ -569,6 +573,7 @@ static_assert(GDT_SELECTOR_CODE0 + 24 == GDT_SELECTOR_DATA3); // SS3 = CS0 + 32
 class ProcessorInfo;
 class SchedulerPerProcessorData;
 struct MemoryManagerData;
+class TraceEventBuffer;
 struct ProcessorMessageEntry;
 
 struct ProcessorMessage {
@@ -648,6 +653,7 @@ class Processor {
     ProcessorInfo* m_info;
     MemoryManagerData* m_mm_data;
     SchedulerPerProcessorData* m_scheduler_data;
+    TraceEventBuffer* m_trace_event_buffer;
     Thread* m_current_thread;
     Thread* m_idle_thread;
 
@@ -779,6 +785,16 @@ public:
         return *m_mm_data;
     }
 
+    ALWAYS_INLINE void set_trace_event_buffer(TraceEventBuffer& trace_event_buffer)
+    {
+        m_trace_event_buffer = &trace_event_buffer;
+    }
+
+    ALWAYS_INLINE TraceEventBuffer* trace_event_buffer() const
+    {
+        return m_trace_event_buffer;
+    }
+
     ALWAYS_INLINE void set_idle_thread(Thread& idle_thread)
     {
         m_idle_thread = &idle_thread;
@@ -121,6 +121,8 @@ protected:
 
     RequestResult get_request_result() const;
 
+    virtual void did_complete(RequestResult) { }
+
 private:
     void sub_request_finished(AsyncDeviceRequest&);
     void request_finished();
@@ -5,6 +5,7 @@
  */
 
 #include <Kernel/Devices/BlockDevice.h>
+#include <Kernel/TraceManager.h>
 
 namespace Kernel {
 
@@ -21,9 +22,15 @@ AsyncBlockDeviceRequest::AsyncBlockDeviceRequest(Device& block_device, RequestTy
 
 void AsyncBlockDeviceRequest::start()
 {
+    TraceManager::add_block_io_event(TraceEventType::BlockIOSubmit, *this, m_block_device);
     m_block_device.start_request(*this);
 }
 
+void AsyncBlockDeviceRequest::did_complete(RequestResult result)
+{
+    TraceManager::add_block_io_event(TraceEventType::BlockIOComplete, *this, m_block_device, result);
+}
+
 BlockDevice::~BlockDevice()
 {
 }
@@ -42,6 +42,9 @@ public:
     }
 
 private:
+    // ^AsyncDeviceRequest
+    virtual void did_complete(RequestResult) override;
+
     BlockDevice& m_block_device;
     const RequestType m_request_type;
     const u64 m_block_index;
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/Devices/TraceDevice.h>
+#include <Kernel/Process.h>
+#include <Kernel/TraceManager.h>
+#include <LibC/errno_numbers.h>
+#include <LibC/sys/ioctl_numbers.h>
+
+namespace Kernel {
+
+UNMAP_AFTER_INIT TraceDevice::TraceDevice()
+    : CharacterDevice(1, 10)
+{
+}
+
+UNMAP_AFTER_INIT TraceDevice::~TraceDevice()
+{
+}
+
+KResultOr<size_t> TraceDevice::read(FileDescription&, u64, UserOrKernelBuffer& buffer, size_t size)
+{
+    // Readers only ever receive whole events, and never block: an empty read means "nothing right now".
+    constexpr size_t events_per_chunk = 32;
+    TraceEvent events[events_per_chunk];
+    size_t nread = 0;
+    while (size - nread >= sizeof(TraceEvent)) {
+        auto max_count = min(events_per_chunk, (size - nread) / sizeof(TraceEvent));
+        auto count = TraceManager::consume_events(events, max_count);
+        if (count == 0)
+            break;
+        auto bytes = count * sizeof(TraceEvent);
+        if (!buffer.write(events, nread, bytes))
+            return EFAULT;
+        nread += bytes;
+    }
+    return nread;
+}
+
+KResultOr<size_t> TraceDevice::write(FileDescription&, u64, const UserOrKernelBuffer&, size_t)
+{
+    return EINVAL;
+}
+
+int TraceDevice::ioctl(FileDescription&, unsigned request, FlatPtr arg)
+{
+    switch (request) {
+    case TRACE_IOCTL_GET_CATEGORIES: {
+        auto* out = (u32*)arg;
+        u32 value = static_cast<u32>(TraceManager::enabled_categories());
+        if (!copy_to_user(out, &value))
+            return -EFAULT;
+        return 0;
+    }
+    case TRACE_IOCTL_SET_CATEGORIES:
+        if (!Process::current()->is_superuser())
+            return -EPERM;
+        return TraceManager::set_enabled_categories(static_cast<TraceCategory>(arg));
+    default:
+        return -EINVAL;
+    };
+}
+
+}
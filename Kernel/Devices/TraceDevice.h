@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <Kernel/Devices/CharacterDevice.h>
+
+namespace Kernel {
+
+class TraceDevice final : public CharacterDevice {
+    AK_MAKE_ETERNAL
+public:
+    TraceDevice();
+    virtual ~TraceDevice() override;
+
+    // ^Device
+    virtual mode_t required_mode() const override { return 0400; }
+    virtual String device_name() const override { return "trace"; }
+
+private:
+    // ^CharacterDevice
+    virtual KResultOr<size_t> read(FileDescription&, u64, UserOrKernelBuffer&, size_t) override;
+    virtual KResultOr<size_t> write(FileDescription&, u64, const UserOrKernelBuffer&, size_t) override;
+    virtual bool can_read(const FileDescription&, size_t) const override { return true; }
+    virtual bool can_write(const FileDescription&, size_t) const override { return false; }
+    virtual int ioctl(FileDescription&, unsigned request, FlatPtr arg) override;
+    virtual const char* class_name() const override { return "TraceDevice"; }
+};
+
+}
@@ -9,6 +9,7 @@
 #include <AK/JsonObjectSerializer.h>
 #include <AK/JsonValue.h>
 #include <AK/ScopeGuard.h>
+#include <Kernel/API/ProcessStatistics.h>
 #include <Kernel/Arch/x86/CPU.h>
 #include <Kernel/Arch/x86/ProcessorInfo.h>
 #include <Kernel/CommandLine.h>
@@ -41,6 +42,7 @@
 #include <Kernel/UBSanitizer.h>
 #include <Kernel/VM/AnonymousVMObject.h>
 #include <Kernel/VM/MemoryManager.h>
+#include <Kernel/VM/SwapSpace.h>
 #include <LibC/errno_numbers.h>
 
 namespace Kernel {
@@ -64,6 +66,7 @@ enum ProcFileType {
     __FI_Root_Start,
     FI_Root_df,
     FI_Root_all,
+    FI_Root_processes,
     FI_Root_memstat,
     FI_Root_cpuinfo,
     FI_Root_dmesg,
@@ -232,6 +235,7 @@ static inline bool is_persistent_inode(const InodeIdentifier& identifier)
 
 struct ProcFSInodeData : public FileDescriptionData {
     RefPtr<KBufferImpl> buffer;
+    u64 statistics_generation { 0 };
 };
 
 NonnullRefPtr<ProcFS> ProcFS::create()
@@ -329,6 +333,10 @@ static bool procfs$pid_vm(InodeIdentifier identifier, KBufferBuilder& builder)
                     pagemap_builder.append('N');
                 else if (page->is_shared_zero_page() || page->is_lazy_committed_page())
                     pagemap_builder.append('Z');
+                else if (page->is_compressed_page())
+                    pagemap_builder.append('C');
+                else if (page->is_swapped_page())
+                    pagemap_builder.append('S');
                 else
                     pagemap_builder.append('P');
             }
@@ -723,6 +731,9 @@ static bool procfs$memstat(InodeIdentifier, KBufferBuilder& builder)
 
     auto super_physical_total = MM.super_physical_pages();
     auto super_physical_used = MM.super_physical_pages_used();
+
+    auto compressed_pages = MM.compressed_pages();
+    auto compressed_bytes = MM.compressed_bytes();
     mm_lock.unlock();
 
     JsonObjectSerializer<KBufferBuilder> json { builder };
@@ -735,6 +746,20 @@ static bool procfs$memstat(InodeIdentifier, KBufferBuilder& builder)
     json.add("user_physical_uncommitted", user_physical_pages_uncommitted);
     json.add("super_physical_allocated", super_physical_used);
     json.add("super_physical_available", super_physical_total - super_physical_used);
+    json.add("compressed_pages", compressed_pages);
+    json.add("compressed_bytes", compressed_bytes);
+    // Expressed in percent, i.e. 250 means the compressed pages take up 2.5 times less memory.
+    json.add("compression_ratio", compressed_bytes ? (static_cast<u64>(compressed_pages) * PAGE_SIZE * 100) / compressed_bytes : 0);
+    json.add("compressed_page_faults", MM.compressed_page_faults());
+    json.add("compression_failures", MM.compression_failures());
+    // The swap_ins and swap_outs counters only ever go up, so that rates can be derived from consecutive reads.
+    json.add("swap_total", SwapSpace::is_enabled() ? SwapSpace::the().slot_count() : 0);
+    json.add("swap_used", SwapSpace::is_enabled() ? SwapSpace::the().used_slot_count() : 0);
+    json.add("swap_outs", MM.swap_outs());
+    json.add("swap_ins", MM.swap_ins());
+    json.add("swap_in_faults", MM.swap_in_faults());
+    json.add("swap_readahead_pages", MM.swap_readahead_pages());
+    json.add("swap_out_failures", MM.swap_out_failures());
     json.add("kmalloc_call_count", stats.kmalloc_call_count);
     json.add("kfree_call_count", stats.kfree_call_count);
     slab_alloc_stats([&json](size_t slab_size, size_t num_allocated, size_t num_free) {
@@ -839,6 +864,158 @@ static bool procfs$all(InodeIdentifier, KBufferBuilder& builder)
     return true;
 }
 
+template<size_t Size>
+static void copy_to_fixed_string(char (&destination)[Size], const StringView& source)
+{
+    auto length = min(source.length(), Size - 1);
+    memcpy(destination, source.characters_without_null_termination(), length);
+    memset(destination + length, 0, Size - length);
+}
+
+static bool procfs$processes_since(u64& since_generation, KBufferBuilder& builder)
+{
+    ScopedSpinLock lock(g_scheduler_lock);
+
+    // Anything that changes from here on gets stamped with the new generation, and makes it into the next read.
+    auto generation = g_statistics_generation.fetch_add(1) + 1;
+
+    auto has_changed = [&](const Process& process) {
+        if (since_generation == 0 || process.statistics_generation() >= since_generation)
+            return true;
+        bool changed = false;
+        process.for_each_thread([&](const Thread& thread) {
+            if (thread.statistics_generation() < since_generation)
+                return IterationDecision::Continue;
+            changed = true;
+            return IterationDecision::Break;
+        });
+        return changed;
+    };
+
+    auto processes = Process::all_processes();
+    Vector<const Process*> changed_processes;
+    Vector<const Process*> unchanged_processes;
+    auto sort_process = [&](const Process& process) {
+        if (has_changed(process))
+            changed_processes.append(&process);
+        else
+            unchanged_processes.append(&process);
+    };
+    sort_process(*Scheduler::colonel());
+    for (auto& process : processes)
+        sort_process(process);
+
+    ProcessStatisticsHeader header {};
+    header.generation = generation;
+    header.since_generation = since_generation;
+    header.changed_process_count = changed_processes.size();
+    header.unchanged_process_count = unchanged_processes.size();
+    builder.append_bytes({ &header, sizeof(header) });
+
+    for (auto* process : changed_processes) {
+        ProcessStatisticsEntry entry {};
+        entry.pid = process->pid().value();
+        entry.pgid = process->tty() ? process->tty()->pgid().value() : 0;
+        entry.pgp = process->pgid().value();
+        entry.sid = process->sid().value();
+        entry.uid = process->uid();
+        entry.gid = process->gid();
+        entry.ppid = process->ppid().value();
+        entry.nfds = process->number_of_open_file_descriptors();
+        if (process->is_kernel_process())
+            entry.flags |= ProcessStatisticsFlagKernel;
+        if (process->is_dumpable())
+            entry.flags |= ProcessStatisticsFlagDumpable;
+        entry.amount_virtual = process->space().amount_virtual();
+        entry.amount_resident = process->space().amount_resident();
+        entry.amount_dirty_private = process->space().amount_dirty_private();
+        entry.amount_clean_inode = process->space().amount_clean_inode();
+        entry.amount_shared = process->space().amount_shared();
+        entry.amount_purgeable_volatile = process->space().amount_purgeable_volatile();
+        entry.amount_purgeable_nonvolatile = process->space().amount_purgeable_nonvolatile();
+        copy_to_fixed_string(entry.name, process->name());
+        copy_to_fixed_string(entry.tty, process->tty() ? process->tty()->tty_name() : "notty");
+        copy_to_fixed_string(entry.executable, process->executable() ? process->executable()->absolute_path() : "");
+
+        if (process->is_user_process()) {
+            StringBuilder pledge_builder;
+
+#define __ENUMERATE_PLEDGE_PROMISE(promise)       \
+    if (process->has_promised(Pledge::promise)) { \
+        pledge_builder.append(#promise " ");      \
+    }
+            ENUMERATE_PLEDGE_PROMISES
+#undef __ENUMERATE_PLEDGE_PROMISE
+
+            copy_to_fixed_string(entry.pledge, pledge_builder.string_view());
+
+            switch (process->veil_state()) {
+            case VeilState::None:
+                copy_to_fixed_string(entry.veil, "None");
+                break;
+            case VeilState::Dropped:
+                copy_to_fixed_string(entry.veil, "Dropped");
+                break;
+            case VeilState::Locked:
+                copy_to_fixed_string(entry.veil, "Locked");
+                break;
+            }
+        }
+
+        Vector<ThreadStatisticsEntry> threads;
+        process->for_each_thread([&](const Thread& thread) {
+            ThreadStatisticsEntry thread_entry {};
+            thread_entry.tid = thread.tid().value();
+            thread_entry.times_scheduled = thread.times_scheduled();
+            thread_entry.ticks_user = thread.ticks_in_user();
+            thread_entry.ticks_kernel = thread.ticks_in_kernel();
+            thread_entry.cpu = thread.cpu();
+            thread_entry.priority = thread.priority();
+            thread_entry.syscall_count = thread.syscall_count();
+            thread_entry.inode_faults = thread.inode_faults();
+            thread_entry.zero_faults = thread.zero_faults();
+            thread_entry.cow_faults = thread.cow_faults();
+            thread_entry.file_read_bytes = thread.file_read_bytes();
+            thread_entry.file_write_bytes = thread.file_write_bytes();
+            thread_entry.unix_socket_read_bytes = thread.unix_socket_read_bytes();
+            thread_entry.unix_socket_write_bytes = thread.unix_socket_write_bytes();
+            thread_entry.ipv4_socket_read_bytes = thread.ipv4_socket_read_bytes();
+            thread_entry.ipv4_socket_write_bytes = thread.ipv4_socket_write_bytes();
+            copy_to_fixed_string(thread_entry.state, thread.state_string());
+            copy_to_fixed_string(thread_entry.name, thread.name());
+            threads.append(thread_entry);
+            return IterationDecision::Continue;
+        });
+
+        entry.thread_count = threads.size();
+        builder.append_bytes({ &entry, sizeof(entry) });
+        builder.append_bytes({ threads.data(), threads.size() * sizeof(ThreadStatisticsEntry) });
+    }
+
+    for (auto* process : unchanged_processes) {
+        UnchangedProcessStatisticsEntry entry {};
+        entry.pid = process->pid().value();
+        entry.pgid = process->tty() ? process->tty()->pgid().value() : 0;
+        entry.amount_virtual = process->space().amount_virtual();
+        entry.amount_resident = process->space().amount_resident();
+        entry.amount_dirty_private = process->space().amount_dirty_private();
+        entry.amount_clean_inode = process->space().amount_clean_inode();
+        entry.amount_shared = process->space().amount_shared();
+        entry.amount_purgeable_volatile = process->space().amount_purgeable_volatile();
+        entry.amount_purgeable_nonvolatile = process->space().amount_purgeable_nonvolatile();
+        builder.append_bytes({ &entry, sizeof(entry) });
+    }
+
+    since_generation = generation;
+    return true;
+}
+
+static bool procfs$processes(InodeIdentifier, KBufferBuilder& builder)
+{
+    u64 since_generation = 0;
+    return procfs$processes_since(since_generation, builder);
+}
+
 struct SysVariable {
     String name;
     enum class Type : u8 {
@@ -1105,14 +1282,19 @@ KResult ProcFSInode::refresh_data(FileDescription& description) const
 
     if (!cached_data)
         cached_data = new ProcFSInodeData;
-    auto& buffer = static_cast<ProcFSInodeData&>(*cached_data).buffer;
+    auto& inode_data = static_cast<ProcFSInodeData&>(*cached_data);
+    auto& buffer = inode_data.buffer;
     if (buffer) {
         // If we're reusing the buffer, reset the size to 0 first. This
         // ensures we don't accidentally leak previously written data.
         buffer->set_size(0);
     }
     KBufferBuilder builder(buffer, true);
-    if (!read_callback(identifier(), builder))
+    // /proc/processes only describes what changed since the previous read through the same description.
+    bool success = read_callback == procfs$processes
+        ? procfs$processes_since(inode_data.statistics_generation, builder)
+        : read_callback(identifier(), builder);
+    if (!success)
         return ENOENT;
     // We don't use builder.build() here, which would steal our buffer
     // and turn it into an OwnPtr. Instead, just flush to the buffer so
@@ -1689,6 +1871,7 @@ ProcFS::ProcFS()
     m_entries.resize(FI_MaxStaticFileIndex);
     m_entries[FI_Root_df] = { "df", FI_Root_df, false, procfs$df };
     m_entries[FI_Root_all] = { "all", FI_Root_all, false, procfs$all };
+    m_entries[FI_Root_processes] = { "processes", FI_Root_processes, false, procfs$processes };
     m_entries[FI_Root_memstat] = { "memstat", FI_Root_memstat, false, procfs$memstat };
     m_entries[FI_Root_cpuinfo] = { "cpuinfo", FI_Root_cpuinfo, false, procfs$cpuinfo };
     m_entries[FI_Root_dmesg] = { "dmesg", FI_Root_dmesg, true, procfs$dmesg };
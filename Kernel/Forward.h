@@ -8,8 +8,10 @@
 
 namespace Kernel {
 
+class AnonymousVMObject;
 class BlockDevice;
 class CharacterDevice;
+class CompressedPage;
 class CoreDump;
 class Custody;
 class Device;
@@ -43,6 +45,8 @@ class Scheduler;
 class SchedulerPerProcessorData;
 class Socket;
 class Space;
+class SwapSpace;
+class SwappedPage;
 template<typename BaseType>
 class SpinLock;
 class RecursiveSpinLock;
@@ -34,7 +34,7 @@ public:
         // FIXME: This is really not the way to go about it, but vformat expects a
         //        StringBuilder. Why does this class exist anyways?
         StringBuilder builder;
-        vformat(builder, fmtstr.view(), AK::VariadicFormatParams { parameters... });
+        vformat(builder, fmtstr.view(), AK::VariadicFormatParams<Parameters...> { fmtstr, parameters... });
         append_bytes(builder.string_view().bytes());
     }
 
@@ -703,6 +703,7 @@ bool Process::remove_thread(Thread& thread)
     VERIFY(thread_cnt_before != 0);
     ScopedSpinLock thread_list_lock(m_thread_list_lock);
     m_thread_list.remove(thread);
+    did_change_statistics();
     return thread_cnt_before == 1;
 }
 
@@ -712,6 +713,7 @@ bool Process::add_thread(Thread& thread)
     bool is_first = m_thread_count.fetch_add(1, AK::MemoryOrder::memory_order_relaxed) == 0;
     ScopedSpinLock thread_list_lock(m_thread_list_lock);
     m_thread_list.append(thread);
+    did_change_statistics();
     return is_first;
 }
 
@@ -342,6 +342,7 @@ public:
     KResultOr<int> sys$rmdir(Userspace<const char*> pathname, size_t path_length);
     KResultOr<int> sys$mount(Userspace<const Syscall::SC_mount_params*>);
     KResultOr<int> sys$umount(Userspace<const char*> mountpoint, size_t mountpoint_length);
+    KResultOr<int> sys$swapon(Userspace<const char*> path, size_t path_length, size_t size);
     KResultOr<int> sys$chmod(Userspace<const char*> pathname, size_t path_length, mode_t);
     KResultOr<int> sys$fchmod(int fd, mode_t);
     KResultOr<int> sys$chown(Userspace<const Syscall::SC_chown_params*>);
@@ -420,6 +421,11 @@ public:
     const Vector<String>& arguments() const { return m_arguments; };
     const Vector<String>& environment() const { return m_environment; };
 
+    // Bumped when the process gains or loses a thread, or gets disowned. Whatever else it reports changes along
+    // with one of its threads, except for its memory usage, which /proc/processes reports on every read.
+    u64 statistics_generation() const { return m_statistics_generation; }
+    void did_change_statistics() { m_statistics_generation = g_statistics_generation.load(); }
+
     int number_of_open_file_descriptors() const;
     int max_open_file_descriptors() const
     {
@@ -577,6 +583,7 @@ private:
     Vector<FileDescriptionAndFlags> m_fds;
 
     mutable RecursiveSpinLock m_thread_list_lock;
+    u64 m_statistics_generation { 0 };
 
     const bool m_is_kernel_process;
     bool m_dead { false };
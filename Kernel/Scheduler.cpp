@@ -15,6 +15,7 @@
 #include <Kernel/Scheduler.h>
 #include <Kernel/Time/TimeManagement.h>
 #include <Kernel/TimerQueue.h>
+#include <Kernel/TraceManager.h>
 
 // Remove this once SMP is stable and can be enabled by default
 #define SCHEDULE_ON_ALL_PROCESSORS 0
@@ -365,6 +366,8 @@ bool Scheduler::context_switch(Thread* thread)
     }
     thread->set_state(Thread::Running);
 
+    TraceManager::add_context_switch_event(from_thread, *thread);
+
     proc.switch_context(from_thread, thread);
 
     // NOTE: from_thread at this point reflects the thread we were
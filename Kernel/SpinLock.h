@@ -31,6 +31,19 @@ public:
         return prev_flags;
     }
 
+    // Gives up instead of waiting if someone else holds the lock. The flags are only filled in on success.
+    [[nodiscard]] ALWAYS_INLINE bool try_lock(u32& prev_flags)
+    {
+        u32 flags;
+        Processor::current().enter_critical(flags);
+        if (m_lock.exchange(1, AK::memory_order_acquire) != 0) {
+            Processor::current().leave_critical(flags);
+            return false;
+        }
+        prev_flags = flags;
+        return true;
+    }
+
     ALWAYS_INLINE void unlock(u32 prev_flags)
     {
         VERIFY(is_locked());
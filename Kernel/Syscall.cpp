@@ -9,6 +9,7 @@
 #include <Kernel/Panic.h>
 #include <Kernel/Process.h>
 #include <Kernel/ThreadTracer.h>
+#include <Kernel/TraceManager.h>
 #include <Kernel/VM/MemoryManager.h>
 
 namespace Kernel {
@@ -191,12 +192,16 @@ NEVER_INLINE void syscall_handler(TrapFrame* trap)
     auto arg2 = regs.ecx;
     auto arg3 = regs.ebx;
 
+    TraceManager::add_syscall_event(TraceEventType::SyscallEnter, function, arg1);
+
     auto result = Syscall::handle(regs, function, arg1, arg2, arg3);
     if (result.is_error())
         regs.eax = result.error();
     else
         regs.eax = result.value();
 
+    TraceManager::add_syscall_event(TraceEventType::SyscallExit, function, regs.eax);
+
     process.big_lock().unlock();
 
     if (auto tracer = process.tracer(); tracer && tracer->is_tracing_syscalls()) {
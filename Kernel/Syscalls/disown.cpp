@@ -18,6 +18,7 @@ KResultOr<int> Process::sys$disown(ProcessID pid)
         return ECHILD;
     ProtectedDataMutationScope scope(*process);
     process->m_ppid = 0;
+    process->did_change_statistics();
     process->disowned_by_waiter(*this);
     return 0;
 }
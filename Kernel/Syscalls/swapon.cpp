@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/FileSystem/FileDescription.h>
+#include <Kernel/FileSystem/VirtualFileSystem.h>
+#include <Kernel/Process.h>
+#include <Kernel/VM/SwapSpace.h>
+
+namespace Kernel {
+
+KResultOr<int> Process::sys$swapon(Userspace<const char*> user_path, size_t path_length, size_t size)
+{
+    if (!is_superuser())
+        return EPERM;
+
+    REQUIRE_NO_PROMISES;
+
+    auto path = get_syscall_path_argument(user_path, path_length);
+    if (path.is_error())
+        return path.error();
+
+    auto description_or_error = VFS::the().open(path.value(), O_RDWR, 0, current_directory());
+    if (description_or_error.is_error())
+        return description_or_error.error();
+    auto description = description_or_error.release_value();
+
+    auto metadata = description->metadata();
+    if (metadata.is_regular_file()) {
+        // Swap files are used as they are, so they can't grow, and a size of 0 means "all of it".
+        auto file_size = static_cast<u64>(metadata.size);
+        if (size == 0)
+            size = min(file_size, static_cast<u64>(NumericLimits<size_t>::max()));
+        else if (size > file_size)
+            return EINVAL;
+    } else if (description->file().is_block_device()) {
+        // Block devices don't know their own size, so we have to be told.
+        if (size == 0)
+            return EINVAL;
+    } else {
+        return ENODEV;
+    }
+
+    auto result = SwapSpace::enable(move(description), size);
+    if (result.is_error())
+        return result;
+
+    dbgln("swapon: {} is now used for swap", path.value());
+    return 0;
+}
+
+}
@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/Process.h>
+#include <Kernel/Tasks/PageReclaimerTask.h>
+#include <Kernel/Time/TimeManagement.h>
+#include <Kernel/VM/MemoryManager.h>
+#include <Kernel/VM/SwapSpace.h>
+
+namespace Kernel {
+
+void PageReclaimerTask::spawn()
+{
+    RefPtr<Thread> reclaimer_thread;
+    Process::create_kernel_process(reclaimer_thread, "PageReclaimerTask", [] {
+        dbgln("PageReclaimerTask is running");
+        for (;;) {
+            // Once we start, keep going until there's plenty of free memory again, so that we don't end up
+            // trickling pages out one batch at a time while we hover around the low watermark.
+            if (SwapSpace::is_enabled() && MM.is_low_on_user_physical_pages()) {
+                while (!MM.has_plenty_of_user_physical_pages()) {
+                    if (MM.swap_out_cold_user_pages() == 0)
+                        break;
+                }
+            }
+            (void)Thread::current()->sleep(Time::from_milliseconds(100));
+        }
+    });
+}
+
+}
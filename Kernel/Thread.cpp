@@ -27,6 +27,8 @@
 
 namespace Kernel {
 
+Atomic<u64, AK::MemoryOrder::memory_order_relaxed> g_statistics_generation { 1 };
+
 SpinLock<u8> Thread::g_tid_map_lock;
 READONLY_AFTER_INIT HashMap<ThreadID, Thread*>* Thread::g_tid_map;
 
@@ -426,6 +428,7 @@ bool Thread::tick()
         ++m_process->m_ticks_in_user;
         ++m_ticks_in_user;
     }
+    did_change_statistics();
     return --m_ticks_left;
 }
 
@@ -869,6 +872,8 @@ void Thread::set_state(State new_state, u8 stop_signal)
     if (new_state == m_state)
         return;
 
+    did_change_statistics();
+
     {
         ScopedSpinLock thread_lock(m_lock);
         previous_state = m_state;
@@ -35,6 +35,9 @@ namespace Kernel {
 
 extern RecursiveSpinLock s_mm_lock;
 
+// Bumped on every read of /proc/processes, so readers can ask for what changed since their last read.
+extern Atomic<u64, AK::MemoryOrder::memory_order_relaxed> g_statistics_generation;
+
 enum class DispatchSignalResult {
     Deferred = 0,
     Yield,
@@ -971,6 +974,10 @@ public:
 
     KResult make_thread_specific_region(Badge<Process>);
 
+    // Everything a thread's statistics report only changes while it's running, or when its state changes.
+    u64 statistics_generation() const { return m_statistics_generation; }
+    void did_change_statistics() { m_statistics_generation = g_statistics_generation.load(); }
+
     unsigned syscall_count() const { return m_syscall_count; }
     void did_syscall() { ++m_syscall_count; }
     unsigned inode_faults() const { return m_inode_faults; }
@@ -1224,6 +1231,7 @@ private:
     bool m_handling_page_fault { false };
     PreviousMode m_previous_mode { PreviousMode::UserMode };
 
+    u64 m_statistics_generation { 0 };
     unsigned m_syscall_count { 0 };
     unsigned m_inode_faults { 0 };
     unsigned m_zero_faults { 0 };
@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/Arch/x86/CPU.h>
+#include <Kernel/TraceEventBuffer.h>
+
+namespace Kernel {
+
+TraceEventBuffer::TraceEventBuffer(NonnullOwnPtr<KBuffer> buffer)
+    : m_buffer(move(buffer))
+{
+}
+
+OwnPtr<TraceEventBuffer> TraceEventBuffer::try_create_with_size(size_t buffer_size)
+{
+    auto buffer = KBuffer::try_create_with_size(buffer_size, Region::Access::Read | Region::Access::Write, "Trace events", AllocationStrategy::AllocateNow);
+    if (!buffer)
+        return {};
+    return adopt_own(*new TraceEventBuffer(buffer.release_nonnull()));
+}
+
+void TraceEventBuffer::append(const TraceEvent& event)
+{
+    VERIFY_INTERRUPTS_DISABLED();
+    auto head = m_head.load(AK::MemoryOrder::memory_order_relaxed);
+    auto tail = m_tail.load(AK::MemoryOrder::memory_order_acquire);
+    if (head - tail >= capacity()) {
+        m_lost.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+        return;
+    }
+    at(head) = event;
+    m_head.store(head + 1, AK::MemoryOrder::memory_order_release);
+}
+
+size_t TraceEventBuffer::consume(TraceEvent* events, size_t max_count)
+{
+    auto tail = m_tail.load(AK::MemoryOrder::memory_order_relaxed);
+    auto head = m_head.load(AK::MemoryOrder::memory_order_acquire);
+    size_t count = min(head - tail, max_count);
+    for (size_t i = 0; i < count; ++i)
+        events[i] = at(tail + i);
+    m_tail.store(tail + count, AK::MemoryOrder::memory_order_release);
+    return count;
+}
+
+}
@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <Kernel/API/TraceEvent.h>
+#include <Kernel/KBuffer.h>
+
+namespace Kernel {
+
+// A fixed-size ring of TraceEvents owned by a single processor.
+// Only the owning processor appends (with interrupts disabled), while
+// readers (serialized by TraceDevice) consume from the other end.
+// When the ring is full new events are dropped and counted instead of
+// overwriting unread ones, so the writer never has to wait for a reader.
+class TraceEventBuffer {
+public:
+    static OwnPtr<TraceEventBuffer> try_create_with_size(size_t buffer_size);
+
+    void append(const TraceEvent&);
+
+    // Moves up to `max_count` events into `events` and returns how many were moved.
+    size_t consume(TraceEvent* events, size_t max_count);
+
+    u32 take_lost_count() { return m_lost.exchange(0, AK::MemoryOrder::memory_order_relaxed); }
+
+    size_t capacity() const { return m_buffer->size() / sizeof(TraceEvent); }
+    bool is_empty() const { return m_head.load(AK::MemoryOrder::memory_order_acquire) == m_tail.load(AK::MemoryOrder::memory_order_relaxed); }
+
+private:
+    explicit TraceEventBuffer(NonnullOwnPtr<KBuffer>);
+
+    TraceEvent& at(size_t index) { return reinterpret_cast<TraceEvent*>(m_buffer->data())[index % capacity()]; }
+
+    Atomic<size_t> m_head { 0 };
+    Atomic<size_t> m_tail { 0 };
+    Atomic<u32> m_lost { 0 };
+    NonnullOwnPtr<KBuffer> m_buffer;
+};
+
+}
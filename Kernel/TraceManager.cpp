@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/Lock.h>
+#include <Kernel/Time/TimeManagement.h>
+#include <Kernel/TraceEventBuffer.h>
+#include <Kernel/TraceManager.h>
+
+namespace Kernel {
+
+static constexpr size_t trace_buffer_size_per_processor = 256 * KiB;
+
+TraceCategory g_enabled_trace_categories { TraceCategory::None };
+
+static Lock s_trace_lock { "TraceManager" };
+
+KResult TraceManager::set_enabled_categories(TraceCategory categories)
+{
+    Locker locker(s_trace_lock);
+
+    if (categories != TraceCategory::None) {
+        // Buffers are allocated on first use and never freed, so that a
+        // tracepoint racing with disabling never touches freed memory.
+        bool allocation_failed = false;
+        Processor::for_each([&](Processor& processor) {
+            if (processor.trace_event_buffer())
+                return IterationDecision::Continue;
+            auto buffer = TraceEventBuffer::try_create_with_size(trace_buffer_size_per_processor);
+            if (!buffer) {
+                allocation_failed = true;
+                return IterationDecision::Break;
+            }
+            processor.set_trace_event_buffer(*buffer.leak_ptr());
+            return IterationDecision::Continue;
+        });
+        if (allocation_failed)
+            return ENOMEM;
+    }
+
+    g_enabled_trace_categories = categories & TraceCategory::All;
+    return KSuccess;
+}
+
+size_t TraceManager::consume_events(TraceEvent* events, size_t max_count)
+{
+    Locker locker(s_trace_lock);
+
+    size_t count = 0;
+    Processor::for_each([&](Processor& processor) {
+        auto* buffer = processor.trace_event_buffer();
+        if (!buffer)
+            return IterationDecision::Continue;
+        if (count == max_count)
+            return IterationDecision::Break;
+        if (auto lost = buffer->take_lost_count()) {
+            auto& event = events[count++];
+            event = {};
+            event.type = TraceEventType::EventsLost;
+            event.cpu = processor.get_id();
+            event.data.events_lost.count = lost;
+        }
+        count += buffer->consume(events + count, max_count - count);
+        return IterationDecision::Continue;
+    });
+    return count;
+}
+
+void TraceManager::record(TraceEvent& event, Thread* thread)
+{
+    InterruptDisabler disabler;
+    auto& processor = Processor::current();
+    auto* buffer = processor.trace_event_buffer();
+    if (!buffer)
+        return;
+    event.timestamp_ns = TimeManagement::the().monotonic_time().to_nanoseconds();
+    event.cpu = processor.get_id();
+    if (thread) {
+        event.pid = thread->pid().value();
+        event.tid = thread->tid().value();
+    }
+    buffer->append(event);
+}
+
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <Kernel/API/TraceEvent.h>
+#include <Kernel/Arch/x86/CPU.h>
+#include <Kernel/Devices/BlockDevice.h>
+#include <Kernel/KResult.h>
+#include <Kernel/Thread.h>
+
+namespace Kernel {
+
+// Read on every tracepoint, so keep it a plain word: a disabled
+// tracepoint costs one load and one well-predicted branch.
+extern TraceCategory g_enabled_trace_categories;
+
+class TraceManager {
+public:
+    static KResult set_enabled_categories(TraceCategory);
+    static TraceCategory enabled_categories() { return g_enabled_trace_categories; }
+
+    // Drains events from all per-CPU buffers into `events`, returns the number of events written.
+    static size_t consume_events(TraceEvent* events, size_t max_count);
+
+    ALWAYS_INLINE static bool is_enabled(TraceCategory category)
+    {
+        return has_flag(g_enabled_trace_categories, category);
+    }
+
+    ALWAYS_INLINE static void add_context_switch_event(Thread* from_thread, Thread& to_thread)
+    {
+        if (!is_enabled(TraceCategory::Scheduler)) [[likely]]
+            return;
+        TraceEvent event;
+        event.type = TraceEventType::ContextSwitch;
+        event.data.context_switch.next_pid = to_thread.pid().value();
+        event.data.context_switch.next_tid = to_thread.tid().value();
+        event.data.context_switch.previous_state = from_thread ? from_thread->state() : Thread::Invalid;
+        record(event, from_thread);
+    }
+
+    ALWAYS_INLINE static void add_page_fault_event(PageFault const& fault)
+    {
+        if (!is_enabled(TraceCategory::PageFault)) [[likely]]
+            return;
+        TraceEvent event;
+        event.type = TraceEventType::PageFault;
+        event.data.page_fault.vaddr = fault.vaddr().get();
+        event.data.page_fault.code = fault.code();
+        record(event);
+    }
+
+    ALWAYS_INLINE static void add_block_io_event(TraceEventType type, AsyncBlockDeviceRequest const& request, Device const& device, AsyncDeviceRequest::RequestResult result = AsyncDeviceRequest::Pending)
+    {
+        if (!is_enabled(TraceCategory::BlockIO)) [[likely]]
+            return;
+        TraceEvent event;
+        event.type = type;
+        event.data.block_io.major = device.major();
+        event.data.block_io.minor = device.minor();
+        event.data.block_io.block_index = request.block_index();
+        event.data.block_io.block_count = request.block_count();
+        event.data.block_io.is_write = request.request_type() == AsyncBlockDeviceRequest::Write;
+        event.data.block_io.result = result;
+        record(event);
+    }
+
+    ALWAYS_INLINE static void add_syscall_event(TraceEventType type, FlatPtr function, FlatPtr value)
+    {
+        if (!is_enabled(TraceCategory::Syscall)) [[likely]]
+            return;
+        TraceEvent event;
+        event.type = type;
+        event.data.syscall.function = function;
+        event.data.syscall.value = value;
+        record(event);
+    }
+
+private:
+    static void record(TraceEvent&, Thread* = Thread::current());
+};
+
+}
@@ -10,9 +10,12 @@
 #include <Kernel/VM/AnonymousVMObject.h>
 #include <Kernel/VM/MemoryManager.h>
 #include <Kernel/VM/PhysicalPage.h>
+#include <Kernel/VM/ScatterGatherList.h>
 
 namespace Kernel {
 
+static constexpr size_t swap_readahead_page_count = 8;
+
 RefPtr<VMObject> AnonymousVMObject::clone()
 {
     // We need to acquire our lock so we copy a sane state
@@ -83,6 +86,7 @@ AnonymousVMObject::AnonymousVMObject(size_t size, AllocationStrategy strategy)
     : VMObject(size)
     , m_volatile_ranges_cache({ 0, page_count() })
     , m_unused_committed_pages(strategy == AllocationStrategy::Reserve ? page_count() : 0)
+    , m_evictable(true)
 {
     if (strategy == AllocationStrategy::AllocateNow) {
         // Allocate all pages right now. We know we can get all because we committed the amount needed
@@ -128,6 +132,9 @@ AnonymousVMObject::AnonymousVMObject(const AnonymousVMObject& other)
     , m_unused_committed_pages(other.m_unused_committed_pages)
     , m_cow_map()                                                      // do *not* clone this
     , m_shared_committed_cow_pages(other.m_shared_committed_cow_pages) // share the pool
+    , m_evictable(other.m_evictable)
+    , m_compressed_pages(other.m_compressed_pages) // compressed pages are immutable, so we can share them
+    , m_swapped_pages(other.m_swapped_pages)       // ...and so are swapped out ones
 {
     // We can't really "copy" a spinlock. But we're holding it. Clear in the clone
     VERIFY(other.m_lock.is_locked());
@@ -193,6 +200,10 @@ int AnonymousVMObject::purge_impl()
                 VERIFY(!phys_page->is_lazy_committed_page());
                 ++purged_in_range;
             }
+            if (phys_page && phys_page->is_compressed_page())
+                m_compressed_pages.remove(i);
+            else if (phys_page && phys_page->is_swapped_page())
+                m_swapped_pages.remove(i);
             phys_page = MM.shared_zero_page();
         }
 
@@ -429,6 +440,48 @@ size_t AnonymousVMObject::cow_pages() const
     return m_cow_map.count_slow(true);
 }
 
+bool AnonymousVMObject::can_evict_page(size_t page_index)
+{
+    VERIFY(m_lock.is_locked());
+    auto& page = m_physical_pages[page_index];
+    if (!page || page->is_shared_zero_page() || page->is_lazy_committed_page() || page->is_compressed_page() || page->is_swapped_page())
+        return false;
+    // Pages that are shared with a clone, or that someone else is holding on to, stay where they are.
+    if (page->ref_count() != 1 || (!m_cow_map.is_null() && m_cow_map.get(page_index)))
+        return false;
+    // Volatile pages are cheaper to purge than to compress or write out.
+    return is_nonvolatile(page_index);
+}
+
+void AnonymousVMObject::add_compressed_page(size_t page_index, NonnullRefPtr<CompressedPage> compressed_page)
+{
+    VERIFY(m_lock.is_locked());
+    VERIFY(m_physical_pages[page_index]->is_compressed_page());
+    m_compressed_pages.set(page_index, move(compressed_page));
+}
+
+void AnonymousVMObject::add_swapped_page(size_t page_index, NonnullRefPtr<SwappedPage> swapped_page)
+{
+    VERIFY(m_lock.is_locked());
+    VERIFY(m_physical_pages[page_index]->is_swapped_page());
+    m_swapped_pages.set(page_index, move(swapped_page));
+}
+
+void AnonymousVMObject::restore_page_being_swapped_out(const PageBeingSwappedOut& page)
+{
+    ScopedSpinLock lock(m_lock);
+    auto& page_slot = m_physical_pages[page.page_index];
+    auto swapped_page = m_swapped_pages.get(page.page_index);
+    // The page might have been purged in the meantime, in which case there's nothing to restore.
+    if (!page_slot->is_swapped_page() || !swapped_page.has_value() || swapped_page.value() != page.swapped_page.ptr())
+        return;
+    page_slot = page.page;
+    m_swapped_pages.remove(page.page_index);
+    for_each_region([&](auto& region) {
+        region.remap_vmobject_page_range(page.page_index, 1);
+    });
+}
+
 bool AnonymousVMObject::is_nonvolatile(size_t page_index)
 {
     if (m_volatile_ranges_cache_dirty)
@@ -487,4 +540,163 @@ PageFaultResponse AnonymousVMObject::handle_cow_fault(size_t page_index, Virtual
     return PageFaultResponse::Continue;
 }
 
+PageFaultResponse AnonymousVMObject::handle_compressed_fault(size_t page_index)
+{
+    VERIFY_INTERRUPTS_DISABLED();
+
+    // Holding the paging lock keeps the compressor away from us while we allocate a page.
+    Locker locker(m_paging_lock);
+
+    RefPtr<PhysicalPage> page;
+    bool is_cow = false;
+    {
+        ScopedSpinLock lock(m_lock);
+        if (!m_physical_pages[page_index]->is_compressed_page()) {
+            dbgln_if(PAGE_FAULT_DEBUG, "    >> Compressed page was already brought back in. Fine with me!");
+            return PageFaultResponse::Continue;
+        }
+        is_cow = !m_cow_map.is_null() && m_cow_map.get(page_index);
+        if (is_cow && m_shared_committed_cow_pages && is_nonvolatile(page_index))
+            page = m_shared_committed_cow_pages->allocate_one();
+    }
+
+    if (!page) {
+        page = MM.allocate_user_physical_page(MemoryManager::ShouldZeroFill::No);
+        if (page.is_null()) {
+            dmesgln("MM: handle_compressed_fault was unable to allocate a physical page");
+            return PageFaultResponse::OutOfMemory;
+        }
+    }
+
+    ScopedSpinLock lock(m_lock);
+    auto& page_slot = m_physical_pages[page_index];
+    if (!page_slot->is_compressed_page())
+        return PageFaultResponse::Continue;
+
+    auto compressed_page = m_compressed_pages.get(page_index);
+    VERIFY(compressed_page.has_value());
+    auto* page_data = MM.quickmap_page(*page);
+    bool success = compressed_page.value()->decompress_into({ page_data, PAGE_SIZE });
+    MM.unquickmap_page();
+    VERIFY(success);
+
+    dbgln_if(PAGE_FAULT_DEBUG, "      >> DECOMPRESSED {} ({} bytes)", page->paddr(), compressed_page.value()->size());
+    m_compressed_pages.remove(page_index);
+    page_slot = move(page);
+    // The clone we may have shared the compressed page with gets its own copy, too.
+    if (is_cow)
+        set_should_cow(page_index, false);
+    ++MM.m_compressed_page_faults;
+    return PageFaultResponse::Continue;
+}
+
+PageFaultResponse AnonymousVMObject::handle_swapped_fault(size_t page_index)
+{
+    VERIFY(!s_mm_lock.own_lock());
+
+    // Holding the paging lock keeps the page reclaimer away from us while we read pages back in.
+    Locker locker(m_paging_lock);
+
+    struct PageToSwapIn {
+        size_t page_index { 0 };
+        NonnullRefPtr<SwappedPage> swapped_page;
+    };
+    Vector<PageToSwapIn, swap_readahead_page_count> pages_to_swap_in;
+    RefPtr<PhysicalPage> committed_cow_page;
+    bool is_cow = false;
+    {
+        ScopedSpinLock lock(m_lock);
+        if (!m_physical_pages[page_index]->is_swapped_page()) {
+            dbgln_if(PAGE_FAULT_DEBUG, "    >> Swapped page was already brought back in. Fine with me!");
+            return PageFaultResponse::Continue;
+        }
+        auto swapped_page = m_swapped_pages.get(page_index);
+        VERIFY(swapped_page.has_value());
+        pages_to_swap_in.append({ page_index, *swapped_page.value() });
+
+        is_cow = !m_cow_map.is_null() && m_cow_map.get(page_index);
+        if (is_cow && m_shared_committed_cow_pages && is_nonvolatile(page_index))
+            committed_cow_page = m_shared_committed_cow_pages->allocate_one();
+
+        // Pages are written out in batches, so the pages after this one are likely to be in the slots right
+        // after it, and to be needed soon as well. Read those in while we're at it, unless memory is tight.
+        if (!MM.is_low_on_user_physical_pages()) {
+            for (size_t i = page_index + 1; i < page_count() && pages_to_swap_in.size() < swap_readahead_page_count; ++i) {
+                if (!m_physical_pages[i] || !m_physical_pages[i]->is_swapped_page() || (!m_cow_map.is_null() && m_cow_map.get(i)))
+                    break;
+                auto neighbour = m_swapped_pages.get(i);
+                VERIFY(neighbour.has_value());
+                if (neighbour.value()->slot() != pages_to_swap_in.first().swapped_page->slot() + pages_to_swap_in.size())
+                    break;
+                pages_to_swap_in.append({ i, *neighbour.value() });
+            }
+        }
+    }
+
+    NonnullRefPtrVector<PhysicalPage> pages;
+    pages.ensure_capacity(pages_to_swap_in.size());
+    if (committed_cow_page)
+        pages.unchecked_append(committed_cow_page.release_nonnull());
+    while (pages.size() < pages_to_swap_in.size()) {
+        auto page = MM.allocate_user_physical_page(MemoryManager::ShouldZeroFill::No);
+        if (page.is_null())
+            break;
+        pages.unchecked_append(page.release_nonnull());
+    }
+    if (pages.is_empty()) {
+        dmesgln("MM: handle_swapped_fault was unable to allocate a physical page");
+        return PageFaultResponse::OutOfMemory;
+    }
+    pages_to_swap_in.shrink(pages.size());
+
+    auto& swap_space = SwapSpace::the();
+    {
+        // This also makes us wait for the page reclaimer to finish writing these out, if it's still at it.
+        Locker io_locker(swap_space.io_lock());
+        auto scatter_list = ScatterGatherList::create(pages, "Swap in");
+        if (!scatter_list) {
+            dmesgln("MM: handle_swapped_fault was unable to map pages to read into");
+            return PageFaultResponse::OutOfMemory;
+        }
+        auto result = swap_space.read_slots(pages_to_swap_in.first().swapped_page->slot(), scatter_list->dma_region(), pages.size());
+        if (result.is_error()) {
+            dmesgln("MM: handle_swapped_fault had error ({}) while reading!", result.error());
+            return PageFaultResponse::ShouldCrash;
+        }
+    }
+
+    ScopedSpinLock mm_lock(s_mm_lock);
+    ScopedSpinLock lock(m_lock);
+    size_t swapped_in_count = 0;
+    for (size_t i = 0; i < pages_to_swap_in.size(); ++i) {
+        auto& page_to_swap_in = pages_to_swap_in[i];
+        auto& page_slot = m_physical_pages[page_to_swap_in.page_index];
+        auto swapped_page = m_swapped_pages.get(page_to_swap_in.page_index);
+        // Someone may have purged the page, or the reclaimer failed to write it out and put it back.
+        if (!page_slot->is_swapped_page() || !swapped_page.has_value() || swapped_page.value() != page_to_swap_in.swapped_page.ptr())
+            continue;
+
+        dbgln_if(PAGE_FAULT_DEBUG, "      >> SWAPPED IN {} from slot {}", pages[i].paddr(), page_to_swap_in.swapped_page->slot());
+        page_slot = pages[i];
+        m_swapped_pages.remove(page_to_swap_in.page_index);
+        ++swapped_in_count;
+    }
+    // The clone we may have shared the swapped page with gets its own copy, too.
+    if (is_cow && m_physical_pages[page_index].ptr() == &pages[0])
+        set_should_cow(page_index, false);
+
+    // The faulting page gets mapped by our caller, but nobody else is going to map the ones we read ahead.
+    if (pages_to_swap_in.size() > 1) {
+        for_each_region([&](auto& region) {
+            region.remap_vmobject_page_range(page_index + 1, pages_to_swap_in.size() - 1);
+        });
+    }
+
+    ++MM.m_swap_in_faults;
+    MM.m_swap_ins += swapped_in_count;
+    if (swapped_in_count > 1)
+        MM.m_swap_readahead_pages += swapped_in_count - 1;
+    return PageFaultResponse::Continue;
+}
+
 }
@@ -6,10 +6,13 @@
 
 #pragma once
 
+#include <AK/HashMap.h>
 #include <Kernel/PhysicalAddress.h>
 #include <Kernel/VM/AllocationStrategy.h>
+#include <Kernel/VM/CompressedPage.h>
 #include <Kernel/VM/PageFaultResponse.h>
 #include <Kernel/VM/PurgeablePageRanges.h>
+#include <Kernel/VM/SwapSpace.h>
 #include <Kernel/VM/VMObject.h>
 
 namespace Kernel {
@@ -32,6 +35,14 @@ public:
     bool should_cow(size_t page_index, bool) const;
     void set_should_cow(size_t page_index, bool);
 
+    bool is_evictable() const { return m_evictable; }
+    bool can_evict_page(size_t page_index);
+    void add_compressed_page(size_t page_index, NonnullRefPtr<CompressedPage>);
+    PageFaultResponse handle_compressed_fault(size_t page_index);
+    void add_swapped_page(size_t page_index, NonnullRefPtr<SwappedPage>);
+    void restore_page_being_swapped_out(const PageBeingSwappedOut&);
+    PageFaultResponse handle_swapped_fault(size_t page_index);
+
     void register_purgeable_page_ranges(PurgeablePageRanges&);
     void unregister_purgeable_page_ranges(PurgeablePageRanges&);
 
@@ -133,6 +144,11 @@ private:
 
     // We share a pool of committed cow-pages with clones
     RefPtr<CommittedCowPages> m_shared_committed_cow_pages;
+
+    // Only memory we allocated ourselves may be compressed or swapped out, not someone's physical range.
+    bool m_evictable { false };
+    HashMap<size_t, NonnullRefPtr<CompressedPage>> m_compressed_pages;
+    HashMap<size_t, NonnullRefPtr<SwappedPage>> m_swapped_pages;
 };
 
 }
@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/Heap/kmalloc.h>
+#include <Kernel/StdLib.h>
+#include <Kernel/VM/CompressedPage.h>
+#include <Kernel/VM/MemoryManager.h>
+
+namespace Kernel {
+
+// The encoding is a sequence of LZ4-style blocks: a token byte holding the literal length in its
+// high nibble and the match length (minus min_match_length) in its low nibble, each extended with
+// 255-valued bytes when they saturate, followed by the literals and a 16-bit little-endian match
+// offset. The final block has literals only.
+
+static constexpr size_t min_match_length = 4;
+static constexpr size_t hash_table_bits = 10;
+
+static inline u32 read_u32(const u8* data)
+{
+    u32 value;
+    memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+static inline size_t hash_sequence(const u8* data)
+{
+    return (read_u32(data) * 2654435761u) >> (32 - hash_table_bits);
+}
+
+static bool write_length(Bytes output, size_t& output_offset, size_t length)
+{
+    for (; length >= 255; length -= 255) {
+        if (output_offset >= output.size())
+            return false;
+        output[output_offset++] = 255;
+    }
+    if (output_offset >= output.size())
+        return false;
+    output[output_offset++] = length;
+    return true;
+}
+
+static bool write_block(ReadonlyBytes literals, size_t match_offset, size_t match_length, Bytes output, size_t& output_offset)
+{
+    if (output_offset >= output.size())
+        return false;
+
+    auto& token = output[output_offset++];
+    token = min(literals.size(), (size_t)15) << 4;
+    if (literals.size() >= 15 && !write_length(output, output_offset, literals.size() - 15))
+        return false;
+
+    if (output_offset + literals.size() > output.size())
+        return false;
+    memcpy(output.data() + output_offset, literals.data(), literals.size());
+    output_offset += literals.size();
+
+    if (match_length == 0)
+        return true;
+
+    if (output_offset + 2 > output.size())
+        return false;
+    output[output_offset++] = match_offset & 0xff;
+    output[output_offset++] = match_offset >> 8;
+
+    match_length -= min_match_length;
+    token |= min(match_length, (size_t)15);
+    if (match_length >= 15 && !write_length(output, output_offset, match_length - 15))
+        return false;
+    return true;
+}
+
+// Too big for the kernel stack, so everyone compressing a page shares this. That only happens with the MM lock held.
+static struct {
+    u16 hash_table[1 << hash_table_bits];
+    u8 output[CompressedPage::max_size];
+} s_scratch;
+
+static size_t compress_block(ReadonlyBytes input, Bytes output, u16 (&hash_table)[1 << hash_table_bits])
+{
+    static_assert(PAGE_SIZE <= NumericLimits<u16>::max());
+    memset(hash_table, 0, sizeof(hash_table));
+
+    size_t input_offset = 0;
+    size_t literals_start = 0;
+    size_t output_offset = 0;
+    while (input_offset + min_match_length <= input.size()) {
+        auto hash = hash_sequence(input.data() + input_offset);
+        size_t candidate = hash_table[hash];
+        hash_table[hash] = input_offset;
+
+        if (candidate >= input_offset || read_u32(input.data() + candidate) != read_u32(input.data() + input_offset)) {
+            ++input_offset;
+            continue;
+        }
+
+        size_t match_length = min_match_length;
+        while (input_offset + match_length < input.size() && input[candidate + match_length] == input[input_offset + match_length])
+            ++match_length;
+
+        auto literals = input.slice(literals_start, input_offset - literals_start);
+        if (!write_block(literals, input_offset - candidate, match_length, output, output_offset))
+            return 0;
+        input_offset += match_length;
+        literals_start = input_offset;
+    }
+
+    if (!write_block(input.slice(literals_start), 0, 0, output, output_offset))
+        return 0;
+    return output_offset;
+}
+
+static bool read_length(ReadonlyBytes input, size_t& input_offset, size_t& length)
+{
+    for (;;) {
+        if (input_offset >= input.size())
+            return false;
+        u8 byte = input[input_offset++];
+        length += byte;
+        if (byte != 255)
+            return true;
+    }
+}
+
+static bool decompress_block(ReadonlyBytes input, Bytes output)
+{
+    size_t input_offset = 0;
+    size_t output_offset = 0;
+    while (input_offset < input.size()) {
+        u8 token = input[input_offset++];
+
+        size_t literal_length = token >> 4;
+        if (literal_length == 15 && !read_length(input, input_offset, literal_length))
+            return false;
+        if (input_offset + literal_length > input.size() || output_offset + literal_length > output.size())
+            return false;
+        memcpy(output.data() + output_offset, input.data() + input_offset, literal_length);
+        input_offset += literal_length;
+        output_offset += literal_length;
+
+        if (input_offset == input.size())
+            break;
+
+        if (input_offset + 2 > input.size())
+            return false;
+        size_t match_offset = input[input_offset] | (input[input_offset + 1] << 8);
+        input_offset += 2;
+
+        size_t match_length = token & 0xf;
+        if (match_length == 15 && !read_length(input, input_offset, match_length))
+            return false;
+        match_length += min_match_length;
+
+        if (match_offset == 0 || match_offset > output_offset || output_offset + match_length > output.size())
+            return false;
+        // Matches may overlap the bytes they produce, so this has to go byte by byte.
+        for (size_t i = 0; i < match_length; ++i, ++output_offset)
+            output[output_offset] = output[output_offset - match_offset];
+    }
+    return output_offset == output.size();
+}
+
+RefPtr<CompressedPage> CompressedPage::try_compress(ReadonlyBytes page)
+{
+    VERIFY(s_mm_lock.own_lock());
+    VERIFY(page.size() == PAGE_SIZE);
+    auto compressed_size = compress_block(page, { s_scratch.output, sizeof(s_scratch.output) }, s_scratch.hash_table);
+    if (compressed_size == 0)
+        return {};
+    return create({ s_scratch.output, compressed_size });
+}
+
+NonnullRefPtr<CompressedPage> CompressedPage::create(ReadonlyBytes compressed_data)
+{
+    return adopt_ref(*new CompressedPage(compressed_data));
+}
+
+CompressedPage::CompressedPage(ReadonlyBytes compressed_data)
+    : m_data(static_cast<u8*>(kmalloc(compressed_data.size())))
+    , m_size(compressed_data.size())
+{
+    memcpy(m_data, compressed_data.data(), m_size);
+    MM.did_create_compressed_page({}, m_size);
+}
+
+CompressedPage::~CompressedPage()
+{
+    MM.did_destroy_compressed_page({}, m_size);
+    kfree(m_data);
+}
+
+bool CompressedPage::decompress_into(Bytes page) const
+{
+    VERIFY(page.size() == PAGE_SIZE);
+    return decompress_block({ m_data, m_size }, page);
+}
+
+}
@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/RefCounted.h>
+#include <AK/RefPtr.h>
+#include <AK/Span.h>
+#include <Kernel/Arch/x86/CPU.h>
+
+namespace Kernel {
+
+// The contents of an anonymous page that was evicted from physical memory, compressed with a
+// small LZ77 variant. These are immutable, so a forked VMObject can share them with its parent.
+class CompressedPage : public RefCounted<CompressedPage> {
+    AK_MAKE_NONCOPYABLE(CompressedPage);
+    AK_MAKE_NONMOVABLE(CompressedPage);
+
+public:
+    // Pages that don't shrink to at least this size aren't worth the CPU time to decompress later.
+    static constexpr size_t max_size = PAGE_SIZE * 3 / 4;
+
+    // Returns null if the page doesn't fit in max_size bytes. Must be called with the MM lock held.
+    static RefPtr<CompressedPage> try_compress(ReadonlyBytes page);
+    static NonnullRefPtr<CompressedPage> create(ReadonlyBytes compressed_data);
+    ~CompressedPage();
+
+    size_t size() const { return m_size; }
+    bool decompress_into(Bytes page) const;
+
+private:
+    CompressedPage(ReadonlyBytes compressed_data);
+
+    u8* m_data { nullptr };
+    size_t m_size { 0 };
+};
+
+}
@@ -7,19 +7,24 @@
 #include <AK/Assertions.h>
 #include <AK/Memory.h>
 #include <AK/StringView.h>
+#include <AK/TemporaryChange.h>
 #include <Kernel/Arch/x86/CPU.h>
 #include <Kernel/CMOS.h>
+#include <Kernel/Debug.h>
 #include <Kernel/FileSystem/Inode.h>
 #include <Kernel/Heap/kmalloc.h>
 #include <Kernel/Multiboot.h>
 #include <Kernel/Process.h>
 #include <Kernel/StdLib.h>
+#include <Kernel/TraceManager.h>
 #include <Kernel/VM/AnonymousVMObject.h>
 #include <Kernel/VM/ContiguousVMObject.h>
 #include <Kernel/VM/MemoryManager.h>
 #include <Kernel/VM/PageDirectory.h>
 #include <Kernel/VM/PhysicalRegion.h>
+#include <Kernel/VM/ScatterGatherList.h>
 #include <Kernel/VM/SharedInodeVMObject.h>
+#include <Kernel/VM/SwapSpace.h>
 
 extern u8* start_of_kernel_image;
 extern u8* end_of_kernel_image;
@@ -46,6 +51,9 @@ namespace Kernel {
 static MemoryManager* s_the;
 RecursiveSpinLock s_mm_lock;
 
+static constexpr size_t cold_page_compression_batch_size = 32;
+static constexpr size_t swap_out_batch_size = 64;
+
 MemoryManager& MM
 {
     return *s_the;
@@ -64,8 +72,8 @@ UNMAP_AFTER_INIT MemoryManager::MemoryManager()
     write_cr3(kernel_page_directory().cr3());
     protect_kernel_image();
 
-    // We're temporarily "committing" to two pages that we need to allocate below
-    if (!commit_user_physical_pages(2))
+    // We're temporarily "committing" to four pages that we need to allocate below
+    if (!commit_user_physical_pages(4))
         VERIFY_NOT_REACHED();
 
     m_shared_zero_page = allocate_committed_user_physical_page();
@@ -77,6 +85,13 @@ UNMAP_AFTER_INIT MemoryManager::MemoryManager()
     // By using a tag we don't have to query the VMObject for every page
     // whether it was committed or not
     m_lazy_committed_page = allocate_committed_user_physical_page();
+
+    // Same deal for anonymous pages that have been compressed out of physical memory.
+    // These are never actually mapped; touching one faults it back in.
+    m_compressed_page = allocate_committed_user_physical_page();
+
+    // ...and for ones that have been written out to swap.
+    m_swapped_page = allocate_committed_user_physical_page();
 }
 
 UNMAP_AFTER_INIT MemoryManager::~MemoryManager()
@@ -448,6 +463,7 @@ PageFaultResponse MemoryManager::handle_page_fault(const PageFault& fault)
         return PageFaultResponse::ShouldCrash;
     }
     dbgln_if(PAGE_FAULT_DEBUG, "MM: CPU[{}] handle_page_fault({:#04x}) at {}", Processor::id(), fault.code(), fault.vaddr());
+    TraceManager::add_page_fault_event(fault);
     auto* region = find_region_from_vaddr(fault.vaddr());
     if (!region) {
         return PageFaultResponse::ShouldCrash;
@@ -529,8 +545,12 @@ bool MemoryManager::commit_user_physical_pages(size_t page_count)
 {
     VERIFY(page_count > 0);
     ScopedSpinLock lock(s_mm_lock);
-    if (m_user_physical_pages_uncommitted < page_count)
-        return false;
+    if (m_user_physical_pages_uncommitted < page_count) {
+        // Compressed pages go back to the uncommitted pool, so this may get us there.
+        compress_cold_user_pages(page_count - m_user_physical_pages_uncommitted);
+        if (m_user_physical_pages_uncommitted < page_count)
+            return false;
+    }
 
     m_user_physical_pages_uncommitted -= page_count;
     m_user_physical_pages_committed += page_count;
@@ -627,6 +647,11 @@ RefPtr<PhysicalPage> MemoryManager::allocate_user_physical_page(ShouldZeroFill s
             }
             return IterationDecision::Continue;
         });
+        if (!page && compress_cold_user_pages(1)) {
+            page = find_free_user_physical_page(false);
+            purged_pages = true;
+            VERIFY(page);
+        }
         if (!page) {
             dmesgln("MM: no user physical pages available");
             return {};
@@ -644,6 +669,120 @@ RefPtr<PhysicalPage> MemoryManager::allocate_user_physical_page(ShouldZeroFill s
     return page;
 }
 
+size_t MemoryManager::compress_cold_user_pages(size_t page_count)
+{
+    VERIFY(s_mm_lock.own_lock());
+
+    // Compressing pages may allocate kernel heap, which may in turn need more pages.
+    if (m_compressing_pages)
+        return 0;
+    TemporaryChange compressing_change(m_compressing_pages, true);
+
+    // Reclaim a whole batch while we're at it, so we don't end up scanning on every single allocation.
+    page_count = max(page_count, cold_page_compression_batch_size);
+
+    // This approximates LRU order with the accessed bits: the first pass only compresses pages that
+    // nobody touched since the last time we scanned, and clears the accessed bits of all the others.
+    // Only if that didn't free up enough memory do we take another pass over the same pages.
+    size_t compressed_page_count = 0;
+    for (int pass = 0; pass < 2 && compressed_page_count < page_count; ++pass) {
+        for (auto& region : m_user_regions) {
+            compressed_page_count += region.compress_cold_pages({}, page_count - compressed_page_count);
+            if (compressed_page_count >= page_count)
+                break;
+        }
+    }
+
+    if (compressed_page_count > 0)
+        dbgln("MM: Compressed {} cold pages to relieve memory pressure", compressed_page_count);
+    return compressed_page_count;
+}
+
+size_t MemoryManager::swap_out_cold_user_pages()
+{
+    VERIFY(!s_mm_lock.own_lock());
+    if (!SwapSpace::is_enabled())
+        return 0;
+
+    auto& swap_space = SwapSpace::the();
+    // Holding this while we write makes anyone faulting on one of these pages wait until it's out.
+    Locker io_locker(swap_space.io_lock());
+
+    // The pages in a batch go to consecutive slots, so that we can write them out all at once,
+    // and read neighbouring pages back in along with the one someone faulted on.
+    size_t batch_size = swap_out_batch_size;
+    auto first_slot = swap_space.allocate_slots(batch_size);
+    if (!first_slot.has_value())
+        return 0;
+
+    Vector<PageBeingSwappedOut> batch;
+    batch.ensure_capacity(batch_size);
+    {
+        ScopedSpinLock lock(s_mm_lock);
+        size_t region_count = 0;
+        for ([[maybe_unused]] auto& region : m_user_regions)
+            ++region_count;
+        if (m_swap_clock_hand >= region_count)
+            m_swap_clock_hand = 0;
+
+        // Sweep over the regions like a clock hand, picking up where we left off last time. Pages that
+        // were accessed since the previous sweep only get their accessed bit cleared, so it can take
+        // another full sweep after the first one to find enough pages nobody has touched in a while.
+        for (int sweep = 0; sweep < 3 && batch.size() < batch_size; ++sweep) {
+            size_t region_index = 0;
+            for (auto& region : m_user_regions) {
+                if (batch.size() >= batch_size)
+                    break;
+                if (sweep == 0 && region_index < m_swap_clock_hand) {
+                    ++region_index;
+                    continue;
+                }
+                region.swap_out_cold_pages({}, batch, batch_size, first_slot.value());
+                m_swap_clock_hand = ++region_index;
+            }
+        }
+    }
+
+    if (batch.size() < batch_size)
+        swap_space.free_slots(first_slot.value() + batch.size(), batch_size - batch.size());
+    if (batch.is_empty())
+        return 0;
+
+    NonnullRefPtrVector<PhysicalPage> pages;
+    pages.ensure_capacity(batch.size());
+    for (auto& page : batch)
+        pages.unchecked_append(page.page);
+
+    KResult result = ENOMEM;
+    if (auto scatter_list = ScatterGatherList::create(move(pages), "Swap out"))
+        result = swap_space.write_slots(first_slot.value(), scatter_list->dma_region(), batch.size());
+
+    if (result.is_error()) {
+        dmesgln("MM: Failed to write {} pages out to swap: {}", batch.size(), result.error());
+        ScopedSpinLock lock(s_mm_lock);
+        for (auto& page : batch)
+            page.vmobject->restore_page_being_swapped_out(page);
+        ++m_swap_out_failures;
+        return 0;
+    }
+
+    m_swap_outs += batch.size();
+    dbgln_if(SWAP_DEBUG, "MM: Swapped out {} cold pages to slots {}-{}", batch.size(), first_slot.value(), first_slot.value() + batch.size() - 1);
+    return batch.size();
+}
+
+void MemoryManager::did_create_compressed_page(Badge<CompressedPage>, size_t size)
+{
+    ++m_compressed_pages;
+    m_compressed_bytes += size;
+}
+
+void MemoryManager::did_destroy_compressed_page(Badge<CompressedPage>, size_t size)
+{
+    --m_compressed_pages;
+    m_compressed_bytes -= size;
+}
+
 void MemoryManager::deallocate_supervisor_physical_page(const PhysicalPage& page)
 {
     ScopedSpinLock lock(s_mm_lock);
@@ -157,6 +157,28 @@ public:
     unsigned super_physical_pages() const { return m_super_physical_pages; }
     unsigned super_physical_pages_used() const { return m_super_physical_pages_used; }
 
+    unsigned compressed_pages() const { return m_compressed_pages; }
+    size_t compressed_bytes() const { return m_compressed_bytes; }
+    unsigned compressed_page_faults() const { return m_compressed_page_faults; }
+    unsigned compression_failures() const { return m_compression_failures; }
+
+    void did_create_compressed_page(Badge<CompressedPage>, size_t size);
+    void did_destroy_compressed_page(Badge<CompressedPage>, size_t size);
+
+    u64 swap_outs() const { return m_swap_outs; }
+    u64 swap_ins() const { return m_swap_ins; }
+    unsigned swap_in_faults() const { return m_swap_in_faults; }
+    u64 swap_readahead_pages() const { return m_swap_readahead_pages; }
+    unsigned swap_out_failures() const { return m_swap_out_failures; }
+
+    // The page reclaimer starts swapping out cold pages when we're low on free pages,
+    // and keeps at it until we have plenty again.
+    bool is_low_on_user_physical_pages() const { return m_user_physical_pages_uncommitted < m_user_physical_pages / 16; }
+    bool has_plenty_of_user_physical_pages() const { return m_user_physical_pages_uncommitted >= m_user_physical_pages / 8; }
+
+    // Writes out a single batch of cold anonymous pages to swap, returning how many pages that freed up.
+    size_t swap_out_cold_user_pages();
+
     template<typename Callback>
     static void for_each_vmobject(Callback callback)
     {
@@ -173,6 +195,8 @@ public:
 
     PhysicalPage& shared_zero_page() { return *m_shared_zero_page; }
     PhysicalPage& lazy_committed_page() { return *m_lazy_committed_page; }
+    PhysicalPage& compressed_page() { return *m_compressed_page; }
+    PhysicalPage& swapped_page() { return *m_swapped_page; }
 
     PageDirectory& kernel_page_directory() { return *m_kernel_page_directory; }
 
@@ -200,6 +224,7 @@ private:
     static Region* find_region_from_vaddr(VirtualAddress);
 
     RefPtr<PhysicalPage> find_free_user_physical_page(bool);
+    size_t compress_cold_user_pages(size_t page_count);
     u8* quickmap_page(PhysicalPage&);
     void unquickmap_page();
 
@@ -214,6 +239,8 @@ private:
 
     RefPtr<PhysicalPage> m_shared_zero_page;
     RefPtr<PhysicalPage> m_lazy_committed_page;
+    RefPtr<PhysicalPage> m_compressed_page;
+    RefPtr<PhysicalPage> m_swapped_page;
 
     Atomic<unsigned, AK::MemoryOrder::memory_order_relaxed> m_user_physical_pages { 0 };
     Atomic<unsigned, AK::MemoryOrder::memory_order_relaxed> m_user_physical_pages_used { 0 };
@@ -222,6 +249,19 @@ private:
     Atomic<unsigned, AK::MemoryOrder::memory_order_relaxed> m_super_physical_pages { 0 };
     Atomic<unsigned, AK::MemoryOrder::memory_order_relaxed> m_super_physical_pages_used { 0 };
 
+    Atomic<unsigned, AK::MemoryOrder::memory_order_relaxed> m_compressed_pages { 0 };
+    Atomic<size_t, AK::MemoryOrder::memory_order_relaxed> m_compressed_bytes { 0 };
+    Atomic<unsigned, AK::MemoryOrder::memory_order_relaxed> m_compressed_page_faults { 0 };
+    Atomic<unsigned, AK::MemoryOrder::memory_order_relaxed> m_compression_failures { 0 };
+    bool m_compressing_pages { false };
+
+    Atomic<u64, AK::MemoryOrder::memory_order_relaxed> m_swap_outs { 0 };
+    Atomic<u64, AK::MemoryOrder::memory_order_relaxed> m_swap_ins { 0 };
+    Atomic<unsigned, AK::MemoryOrder::memory_order_relaxed> m_swap_in_faults { 0 };
+    Atomic<u64, AK::MemoryOrder::memory_order_relaxed> m_swap_readahead_pages { 0 };
+    Atomic<unsigned, AK::MemoryOrder::memory_order_relaxed> m_swap_out_failures { 0 };
+    size_t m_swap_clock_hand { 0 };
+
     NonnullRefPtrVector<PhysicalRegion> m_user_physical_regions;
     NonnullRefPtrVector<PhysicalRegion> m_super_physical_regions;
 
@@ -277,4 +317,14 @@ inline bool PhysicalPage::is_lazy_committed_page() const
     return this == &MM.lazy_committed_page();
 }
 
+inline bool PhysicalPage::is_compressed_page() const
+{
+    return this == &MM.compressed_page();
+}
+
+inline bool PhysicalPage::is_swapped_page() const
+{
+    return this == &MM.swapped_page();
+}
+
 }
@@ -5,6 +5,7 @@
  */
 
 #include <AK/Memory.h>
+#include <AK/ScopeGuard.h>
 #include <AK/StringView.h>
 #include <Kernel/Debug.h>
 #include <Kernel/FileSystem/Inode.h>
@@ -16,6 +17,7 @@
 #include <Kernel/VM/PageDirectory.h>
 #include <Kernel/VM/Region.h>
 #include <Kernel/VM/SharedInodeVMObject.h>
+#include <Kernel/VM/SwapSpace.h>
 
 namespace Kernel {
 
@@ -191,7 +193,7 @@ size_t Region::amount_resident() const
     size_t bytes = 0;
     for (size_t i = 0; i < page_count(); ++i) {
         auto* page = physical_page(i);
-        if (page && !page->is_shared_zero_page() && !page->is_lazy_committed_page())
+        if (page && !page->is_shared_zero_page() && !page->is_lazy_committed_page() && !page->is_compressed_page() && !page->is_swapped_page())
             bytes += PAGE_SIZE;
     }
     return bytes;
@@ -202,7 +204,7 @@ size_t Region::amount_shared() const
     size_t bytes = 0;
     for (size_t i = 0; i < page_count(); ++i) {
         auto* page = physical_page(i);
-        if (page && page->ref_count() > 1 && !page->is_shared_zero_page() && !page->is_lazy_committed_page())
+        if (page && page->ref_count() > 1 && !page->is_shared_zero_page() && !page->is_lazy_committed_page() && !page->is_compressed_page() && !page->is_swapped_page())
             bytes += PAGE_SIZE;
     }
     return bytes;
@@ -249,7 +251,7 @@ bool Region::map_individual_page_impl(size_t page_index)
     if (!pte)
         return false;
     auto* page = physical_page(page_index);
-    if (!page || (!is_readable() && !is_writable())) {
+    if (!page || page->is_compressed_page() || page->is_swapped_page() || (!is_readable() && !is_writable())) {
         pte->clear();
     } else {
         pte->set_cache_disabled(!m_cacheable);
@@ -420,6 +422,14 @@ PageFaultResponse Region::handle_fault(const PageFault& fault, ScopedSpinLock<Re
             remap_vmobject_page(page_index_in_vmobject);
             return PageFaultResponse::Continue;
         }
+        if (page_slot->is_compressed_page()) {
+            dbgln_if(PAGE_FAULT_DEBUG, "NP(compressed) fault in Region({})[{}] at {}", this, page_index_in_region, fault.vaddr());
+            return handle_compressed_fault(page_index_in_region);
+        }
+        if (page_slot->is_swapped_page()) {
+            dbgln_if(PAGE_FAULT_DEBUG, "NP(swapped) fault in Region({})[{}] at {}", this, page_index_in_region, fault.vaddr());
+            return handle_swapped_fault(page_index_in_region, mm_lock);
+        }
 #ifdef MAP_SHARED_ZERO_PAGE_LAZILY
         if (fault.is_read()) {
             page_slot = MM.shared_zero_page();
@@ -503,6 +513,151 @@ PageFaultResponse Region::handle_cow_fault(size_t page_index_in_region)
     return response;
 }
 
+PageFaultResponse Region::handle_compressed_fault(size_t page_index_in_region)
+{
+    VERIFY_INTERRUPTS_DISABLED();
+    VERIFY(vmobject().is_anonymous());
+
+    auto page_index_in_vmobject = translate_to_vmobject_page(page_index_in_region);
+    auto response = static_cast<AnonymousVMObject&>(vmobject()).handle_compressed_fault(page_index_in_vmobject);
+    if (response != PageFaultResponse::Continue)
+        return response;
+    if (!remap_vmobject_page(page_index_in_vmobject)) {
+        dmesgln("MM: handle_compressed_fault was unable to allocate a page table to map {}", physical_page(page_index_in_region)->paddr());
+        return PageFaultResponse::OutOfMemory;
+    }
+    return PageFaultResponse::Continue;
+}
+
+PageFaultResponse Region::handle_swapped_fault(size_t page_index_in_region, ScopedSpinLock<RecursiveSpinLock>& mm_lock)
+{
+    VERIFY_INTERRUPTS_DISABLED();
+    VERIFY(vmobject().is_anonymous());
+
+    // Keep the VMObject alive while we're not holding the MM lock.
+    NonnullRefPtr<AnonymousVMObject> vmobject = static_cast<AnonymousVMObject&>(this->vmobject());
+    auto page_index_in_vmobject = translate_to_vmobject_page(page_index_in_region);
+
+    // Reading the page back in may block, so release the MM lock temporarily
+    mm_lock.unlock();
+    VERIFY(!s_mm_lock.own_lock());
+    auto response = vmobject->handle_swapped_fault(page_index_in_vmobject);
+    mm_lock.lock();
+
+    if (response != PageFaultResponse::Continue)
+        return response;
+    if (!remap_vmobject_page(page_index_in_vmobject)) {
+        dmesgln("MM: handle_swapped_fault was unable to allocate a page table to map {}", physical_page(page_index_in_region)->paddr());
+        return PageFaultResponse::OutOfMemory;
+    }
+    return PageFaultResponse::Continue;
+}
+
+// Evicting pages happens with the MM lock held, so the VMObject's lock is only ever tried, never waited for:
+// whoever holds it might be waiting for the MM lock in turn. Eviction simply moves on to the next region.
+bool Region::can_evict_pages() const
+{
+    VERIFY(s_mm_lock.own_lock());
+    if (!m_page_directory || !vmobject().is_anonymous() || vmobject().is_shared_by_multiple_regions())
+        return false;
+
+    auto& vmobject = static_cast<const AnonymousVMObject&>(this->vmobject());
+    // Don't get in the way of anyone in the middle of paging this object (that might be us.)
+    return vmobject.is_evictable() && !vmobject.m_paging_lock.is_locked();
+}
+
+RefPtr<PhysicalPage> Region::evict_cold_page(size_t page_index_in_region, PhysicalPage& placeholder)
+{
+    auto& vmobject = static_cast<AnonymousVMObject&>(this->vmobject());
+    VERIFY(vmobject.m_lock.is_locked());
+    auto page_index_in_vmobject = translate_to_vmobject_page(page_index_in_region);
+    if (!vmobject.can_evict_page(page_index_in_vmobject))
+        return {};
+
+    {
+        ScopedSpinLock page_lock(m_page_directory->get_lock());
+        auto* pte = MM.pte(*m_page_directory, vaddr_from_page_index(page_index_in_region));
+        if (!pte || !pte->is_present())
+            return {};
+        // Give recently used pages a second chance.
+        if (pte->is_accessed()) {
+            pte->set_accessed(false);
+            return {};
+        }
+    }
+
+    auto& page_slot = physical_page_slot(page_index_in_region);
+    RefPtr<PhysicalPage> page = move(page_slot);
+    page_slot = placeholder;
+
+    // Unmap the page before reading it, so that anyone writing to it from now on faults and waits for us.
+    remap_vmobject_page(page_index_in_vmobject);
+    return page;
+}
+
+void Region::swap_out_cold_pages(Badge<MemoryManager>, Vector<PageBeingSwappedOut>& batch, size_t batch_size, u32 first_slot)
+{
+    if (!can_evict_pages())
+        return;
+
+    auto& vmobject = static_cast<AnonymousVMObject&>(this->vmobject());
+    for (size_t i = 0; i < page_count() && batch.size() < batch_size; ++i) {
+        u32 prev_flags;
+        if (!vmobject.m_lock.try_lock(prev_flags))
+            return;
+        ScopeGuard unlock_guard([&] { vmobject.m_lock.unlock(prev_flags); });
+        auto page = evict_cold_page(i, MM.swapped_page());
+        if (!page)
+            continue;
+        auto page_index_in_vmobject = translate_to_vmobject_page(i);
+        auto swapped_page = SwappedPage::create(first_slot + batch.size());
+        vmobject.add_swapped_page(page_index_in_vmobject, swapped_page);
+        batch.unchecked_append({ vmobject, page_index_in_vmobject, page.release_nonnull(), move(swapped_page) });
+    }
+}
+
+size_t Region::compress_cold_pages(Badge<MemoryManager>, size_t max_page_count)
+{
+    if (!can_evict_pages())
+        return 0;
+
+    auto& vmobject = static_cast<AnonymousVMObject&>(this->vmobject());
+    size_t compressed_page_count = 0;
+    for (size_t i = 0; i < page_count() && compressed_page_count < max_page_count; ++i) {
+        u32 prev_flags;
+        if (!vmobject.m_lock.try_lock(prev_flags))
+            break;
+        ScopeGuard unlock_guard([&] { vmobject.m_lock.unlock(prev_flags); });
+        if (compress_page(i))
+            ++compressed_page_count;
+    }
+    return compressed_page_count;
+}
+
+bool Region::compress_page(size_t page_index_in_region)
+{
+    auto& vmobject = static_cast<AnonymousVMObject&>(this->vmobject());
+    auto page_index_in_vmobject = translate_to_vmobject_page(page_index_in_region);
+
+    auto page = evict_cold_page(page_index_in_region, MM.compressed_page());
+    if (!page)
+        return false;
+
+    auto* page_data = MM.quickmap_page(*page);
+    auto compressed_page = CompressedPage::try_compress({ page_data, PAGE_SIZE });
+    MM.unquickmap_page();
+
+    if (!compressed_page) {
+        ++MM.m_compression_failures;
+        physical_page_slot(page_index_in_region) = move(page);
+        remap_vmobject_page(page_index_in_vmobject);
+        return false;
+    }
+
+    vmobject.add_compressed_page(page_index_in_vmobject, compressed_page.release_nonnull());
+    return true;
+}
+
 PageFaultResponse Region::handle_inode_fault(size_t page_index_in_region, ScopedSpinLock<RecursiveSpinLock>& mm_lock)
 {
     VERIFY_INTERRUPTS_DISABLED();
@@ -22,6 +22,7 @@ namespace Kernel {
 
 class Inode;
 class VMObject;
+struct PageBeingSwappedOut;
 
 enum class ShouldFlushTLB {
     No,
@@ -217,6 +218,9 @@ public:
 
     bool remap_vmobject_page_range(size_t page_index, size_t page_count);
 
+    size_t compress_cold_pages(Badge<MemoryManager>, size_t max_page_count);
+    void swap_out_cold_pages(Badge<MemoryManager>, Vector<PageBeingSwappedOut>& batch, size_t batch_size, u32 first_slot);
+
     bool is_volatile(VirtualAddress vaddr, size_t size) const;
     enum class SetVolatileError {
         Success = 0,
@@ -249,6 +253,12 @@ private:
     PageFaultResponse handle_cow_fault(size_t page_index);
     PageFaultResponse handle_inode_fault(size_t page_index, ScopedSpinLock<RecursiveSpinLock>&);
     PageFaultResponse handle_zero_fault(size_t page_index);
+    PageFaultResponse handle_compressed_fault(size_t page_index);
+    PageFaultResponse handle_swapped_fault(size_t page_index, ScopedSpinLock<RecursiveSpinLock>&);
+
+    bool can_evict_pages() const;
+    RefPtr<PhysicalPage> evict_cold_page(size_t page_index, PhysicalPage& placeholder);
+    bool compress_page(size_t page_index);
 
     bool map_individual_page_impl(size_t page_index);
 
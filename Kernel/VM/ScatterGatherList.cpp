@@ -10,13 +10,22 @@ namespace Kernel {
 
 NonnullRefPtr<ScatterGatherList> ScatterGatherList::create(AsyncBlockDeviceRequest& request, NonnullRefPtrVector<PhysicalPage> allocated_pages, size_t device_block_size)
 {
-    return adopt_ref(*new ScatterGatherList(request, allocated_pages, device_block_size));
+    return adopt_ref(*new ScatterGatherList(allocated_pages, page_round_up((request.block_count() * device_block_size)), "AHCI Scattered DMA"));
 }
 
-ScatterGatherList::ScatterGatherList(AsyncBlockDeviceRequest& request, NonnullRefPtrVector<PhysicalPage> allocated_pages, size_t device_block_size)
-    : m_vm_object(AnonymousVMObject::create_with_physical_pages(allocated_pages))
+RefPtr<ScatterGatherList> ScatterGatherList::create(NonnullRefPtrVector<PhysicalPage> pages, StringView region_name)
 {
-    m_dma_region = MM.allocate_kernel_region_with_vmobject(m_vm_object, page_round_up((request.block_count() * device_block_size)), "AHCI Scattered DMA", Region::Access::Read | Region::Access::Write, Region::Cacheable::Yes);
+    auto size = pages.size() * PAGE_SIZE;
+    auto list = adopt_ref(*new ScatterGatherList(move(pages), size, region_name));
+    if (!list->m_dma_region)
+        return {};
+    return list;
+}
+
+ScatterGatherList::ScatterGatherList(NonnullRefPtrVector<PhysicalPage> pages, size_t size, StringView region_name)
+    : m_vm_object(AnonymousVMObject::create_with_physical_pages(pages))
+{
+    m_dma_region = MM.allocate_kernel_region_with_vmobject(m_vm_object, size, region_name, Region::Access::Read | Region::Access::Write, Region::Cacheable::Yes);
 }
 
 }
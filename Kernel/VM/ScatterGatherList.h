@@ -19,12 +19,13 @@ namespace Kernel {
 class ScatterGatherList : public RefCounted<ScatterGatherList> {
 public:
     static NonnullRefPtr<ScatterGatherList> create(AsyncBlockDeviceRequest&, NonnullRefPtrVector<PhysicalPage> allocated_pages, size_t device_block_size);
+    static RefPtr<ScatterGatherList> create(NonnullRefPtrVector<PhysicalPage> pages, StringView region_name);
     const VMObject& vmobject() const { return m_vm_object; }
     VirtualAddress dma_region() const { return m_dma_region->vaddr(); }
     size_t scatters_count() const { return m_vm_object->physical_pages().size(); }
 
 private:
-    ScatterGatherList(AsyncBlockDeviceRequest&, NonnullRefPtrVector<PhysicalPage> allocated_pages, size_t device_block_size);
+    ScatterGatherList(NonnullRefPtrVector<PhysicalPage> pages, size_t size, StringView region_name);
     NonnullRefPtr<AnonymousVMObject> m_vm_object;
     OwnPtr<Region> m_dma_region;
 };
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/FileSystem/FileDescription.h>
+#include <Kernel/VM/MemoryManager.h>
+#include <Kernel/VM/SwapSpace.h>
+
+namespace Kernel {
+
+static SwapSpace* s_the;
+static SpinLock<u8> s_enable_lock;
+
+// Not much point in bothering with anything smaller than this.
+static constexpr size_t min_slot_count = 16;
+
+KResult SwapSpace::enable(NonnullRefPtr<FileDescription> description, size_t size)
+{
+    auto slot_count = size / PAGE_SIZE;
+    if (slot_count < min_slot_count || slot_count > NumericLimits<u32>::max())
+        return EINVAL;
+
+    auto* swap_space = new SwapSpace(move(description), slot_count);
+    if (!swap_space || swap_space->m_used_slots.size() != slot_count) {
+        delete swap_space;
+        return ENOMEM;
+    }
+
+    {
+        ScopedSpinLock lock(s_enable_lock);
+        if (!s_the) {
+            s_the = swap_space;
+            swap_space = nullptr;
+        }
+    }
+
+    if (swap_space) {
+        delete swap_space;
+        return EBUSY;
+    }
+
+    dmesgln("SwapSpace: Enabled {} KiB of swap", slot_count * PAGE_SIZE / KiB);
+    return KSuccess;
+}
+
+bool SwapSpace::is_enabled()
+{
+    return s_the != nullptr;
+}
+
+SwapSpace& SwapSpace::the()
+{
+    VERIFY(s_the);
+    return *s_the;
+}
+
+SwapSpace::SwapSpace(NonnullRefPtr<FileDescription> description, size_t slot_count)
+    : m_description(move(description))
+    , m_slot_count(slot_count)
+    , m_used_slots(slot_count, false)
+{
+}
+
+Optional<u32> SwapSpace::allocate_slots(size_t& page_count)
+{
+    VERIFY(page_count > 0);
+    ScopedSpinLock lock(m_slots_lock);
+    size_t found_count = 0;
+    auto first_slot = m_used_slots.find_longest_range_of_unset_bits(page_count, found_count);
+    if (!first_slot.has_value())
+        return {};
+    m_used_slots.set_range(first_slot.value(), found_count, true);
+    m_used_slot_count += found_count;
+    page_count = found_count;
+    return static_cast<u32>(first_slot.value());
+}
+
+void SwapSpace::free_slots(u32 first_slot, size_t count)
+{
+    ScopedSpinLock lock(m_slots_lock);
+    VERIFY(first_slot + count <= m_slot_count);
+    VERIFY(m_used_slots.count_in_range(first_slot, count, true) == count);
+    m_used_slots.set_range(first_slot, count, false);
+    m_used_slot_count -= count;
+}
+
+KResult SwapSpace::write_slots(u32 first_slot, VirtualAddress vaddr, size_t page_count)
+{
+    return do_io(true, first_slot, vaddr, page_count);
+}
+
+KResult SwapSpace::read_slots(u32 first_slot, VirtualAddress vaddr, size_t page_count)
+{
+    return do_io(false, first_slot, vaddr, page_count);
+}
+
+KResult SwapSpace::do_io(bool is_write, u32 first_slot, VirtualAddress vaddr, size_t page_count)
+{
+    VERIFY(m_io_lock.is_locked());
+    VERIFY(first_slot + page_count <= m_slot_count);
+
+    auto buffer = UserOrKernelBuffer::for_kernel_buffer(vaddr.as_ptr());
+    u64 offset = static_cast<u64>(first_slot) * PAGE_SIZE;
+    size_t size = page_count * PAGE_SIZE;
+    auto& file = m_description->file();
+
+    // Block devices hand us at most a page at a time, so keep going until we have everything.
+    size_t nprocessed = 0;
+    while (nprocessed < size) {
+        auto chunk = buffer.offset(nprocessed);
+        auto result = is_write
+            ? file.write(*m_description, offset + nprocessed, chunk, size - nprocessed)
+            : file.read(*m_description, offset + nprocessed, chunk, size - nprocessed);
+        if (result.is_error()) {
+            // Whoever we're doing this for has no way of trying again later, so don't let a signal stop us.
+            if (result.error() == -EINTR)
+                continue;
+            return result.error();
+        }
+        if (result.value() == 0)
+            return EIO;
+        nprocessed += result.value();
+    }
+    return KSuccess;
+}
+
+NonnullRefPtr<SwappedPage> SwappedPage::create(u32 slot)
+{
+    return adopt_ref(*new SwappedPage(slot));
+}
+
+SwappedPage::SwappedPage(u32 slot)
+    : m_slot(slot)
+{
+}
+
+SwappedPage::~SwappedPage()
+{
+    SwapSpace::the().free_slots(m_slot, 1);
+}
+
+}
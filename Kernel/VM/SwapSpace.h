@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Bitmap.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/RefCounted.h>
+#include <Kernel/Forward.h>
+#include <Kernel/KResult.h>
+#include <Kernel/Lock.h>
+#include <Kernel/SpinLock.h>
+#include <Kernel/VirtualAddress.h>
+
+namespace Kernel {
+
+// A swap file or partition, divided into page-sized slots that cold anonymous pages are written out to.
+// There's at most one of these, and once enabled it stays around until shutdown.
+class SwapSpace {
+public:
+    static KResult enable(NonnullRefPtr<FileDescription>, size_t size);
+    static bool is_enabled();
+    static SwapSpace& the();
+
+    size_t slot_count() const { return m_slot_count; }
+    size_t used_slot_count() const { return m_used_slot_count; }
+
+    // Allocates up to page_count contiguous slots, so a batch of pages can be written out with as few
+    // requests as possible. On success, page_count is updated to the number of slots we actually got.
+    Optional<u32> allocate_slots(size_t& page_count);
+    void free_slots(u32 first_slot, size_t count);
+
+    // Anyone reading a slot back in has to hold this, which makes them wait for writes in progress.
+    Lock& io_lock() { return m_io_lock; }
+
+    KResult write_slots(u32 first_slot, VirtualAddress, size_t page_count);
+    KResult read_slots(u32 first_slot, VirtualAddress, size_t page_count);
+
+private:
+    SwapSpace(NonnullRefPtr<FileDescription>, size_t slot_count);
+
+    KResult do_io(bool is_write, u32 first_slot, VirtualAddress, size_t page_count);
+
+    NonnullRefPtr<FileDescription> m_description;
+    size_t m_slot_count { 0 };
+    size_t m_used_slot_count { 0 };
+    Bitmap m_used_slots;
+    SpinLock<u8> m_slots_lock;
+    Lock m_io_lock { "SwapSpace" };
+};
+
+// An anonymous page that lives in a swap slot rather than in physical memory.
+// These are immutable, so a forked VMObject can share them with its parent.
+class SwappedPage : public RefCounted<SwappedPage> {
+    AK_MAKE_NONCOPYABLE(SwappedPage);
+    AK_MAKE_NONMOVABLE(SwappedPage);
+
+public:
+    static NonnullRefPtr<SwappedPage> create(u32 slot);
+    ~SwappedPage();
+
+    u32 slot() const { return m_slot; }
+
+private:
+    explicit SwappedPage(u32 slot);
+
+    u32 m_slot { 0 };
+};
+
+// A page on its way out to swap: it's already been replaced in its VMObject, but stays
+// alive until it's been written out, or put back in case writing it out failed.
+struct PageBeingSwappedOut {
+    NonnullRefPtr<AnonymousVMObject> vmobject;
+    size_t page_index { 0 };
+    NonnullRefPtr<PhysicalPage> page;
+    NonnullRefPtr<SwappedPage> swapped_page;
+};
+
+}
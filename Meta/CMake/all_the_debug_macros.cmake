@@ -5,6 +5,7 @@ set(THREAD_DEBUG ON)
 set(LOCK_DEBUG ON)
 set(SIGNAL_DEBUG ON)
 set(BMP_DEBUG ON)
+set(BYTECODE_DEBUG ON)
 set(WAITBLOCK_DEBUG ON)
 set(WAITQUEUE_DEBUG ON)
 set(MULTIPROCESSOR_DEBUG ON)
@@ -156,6 +157,7 @@ set(RTL8139_DEBUG ON)
 set(SB16_DEBUG ON)
 set(SH_DEBUG ON)
 set(STORAGE_DEVICE_DEBUG ON)
+set(SWAP_DEBUG ON)
 set(TCP_DEBUG ON)
 set(TERMCAP_DEBUG ON)
 set(TERMINAL_DEBUG ON)
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/String.h>
+#include <AK/StringBuilder.h>
+
+static constexpr int line_count = 100000;
+
+// Formats line_count lines with append_line(builder, i), and reports how many bytes that came to.
+template<typename AppendLine>
+static void benchmark_format(AppendLine append_line)
+{
+    u64 bytes_formatted = 0;
+    StringBuilder builder;
+    for (int i = 0; i < line_count; ++i) {
+        builder.clear();
+        append_line(builder, i);
+        bytes_formatted += builder.length();
+    }
+    Test::set_benchmark_bytes_processed(bytes_formatted);
+    EXPECT(bytes_formatted > 0);
+}
+
+// Each of these comes in two flavours: with the format string known at compile time, and with it passed
+// as a StringView, which means it has to be parsed on every call like it always used to be.
+
+BENCHMARK_CASE(integers_compiled)
+{
+    benchmark_format([](auto& builder, int i) { builder.appendff("{} {} {}", i, i * 7, -i); });
+}
+
+BENCHMARK_CASE(integers_parsed)
+{
+    benchmark_format([](auto& builder, int i) { builder.appendff(StringView { "{} {} {}" }, i, i * 7, -i); });
+}
+
+BENCHMARK_CASE(hex_with_padding_compiled)
+{
+    benchmark_format([](auto& builder, int i) { builder.appendff("{:#010x} {:>8}", i, i); });
+}
+
+BENCHMARK_CASE(hex_with_padding_parsed)
+{
+    benchmark_format([](auto& builder, int i) { builder.appendff(StringView { "{:#010x} {:>8}" }, i, i); });
+}
+
+BENCHMARK_CASE(log_line_compiled)
+{
+    benchmark_format([](auto& builder, int i) { builder.appendff("Process {}({}:{}) did something with {} at {:p}", "Shell", i, i + 1, "a file", reinterpret_cast<void*>(i)); });
+}
+
+BENCHMARK_CASE(log_line_parsed)
+{
+    benchmark_format([](auto& builder, int i) { builder.appendff(StringView { "Process {}({}:{}) did something with {} at {:p}" }, "Shell", i, i + 1, "a file", reinterpret_cast<void*>(i)); });
+}
+
+BENCHMARK_CASE(floats_compiled)
+{
+    benchmark_format([](auto& builder, int i) { builder.appendff("{} {:.2}", i / 8.0, i * 0.01); });
+}
+
+BENCHMARK_CASE(floats_parsed)
+{
+    benchmark_format([](auto& builder, int i) { builder.appendff(StringView { "{} {:.2}" }, i / 8.0, i * 0.01); });
+}
+
+BENCHMARK_CASE(string_formatted)
+{
+    benchmark_format([](auto& builder, int i) { builder.append(String::formatted("{}: {}", i, "value")); });
+}
@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/HashTable.h>
+#include <AK/String.h>
+#include <AK/Vector.h>
+
+// The double hashed, tombstone based open addressing table HashTable used to be, cut down to the bits
+// the benchmarks below use, so the two can be compared against each other.
+template<typename T, typename TraitsForT = Traits<T>>
+class LegacyHashTable {
+    static constexpr size_t load_factor_in_percent = 60;
+
+    struct Bucket {
+        bool used;
+        bool deleted;
+        alignas(T) u8 storage[sizeof(T)];
+
+        T* slot() { return reinterpret_cast<T*>(storage); }
+    };
+
+public:
+    LegacyHashTable() = default;
+    ~LegacyHashTable()
+    {
+        for (size_t i = 0; i < m_capacity; ++i) {
+            if (m_buckets[i].used)
+                m_buckets[i].slot()->~T();
+        }
+        kfree(m_buckets);
+    }
+
+    size_t size() const { return m_size; }
+
+    void set(const T& value)
+    {
+        auto& bucket = lookup_for_writing(value);
+        if (bucket.used) {
+            *bucket.slot() = value;
+            return;
+        }
+        new (bucket.slot()) T(value);
+        bucket.used = true;
+        if (bucket.deleted) {
+            bucket.deleted = false;
+            --m_deleted_count;
+        }
+        ++m_size;
+    }
+
+    bool contains(const T& value) const { return lookup(value); }
+
+    bool remove(const T& value)
+    {
+        auto* bucket = lookup(value);
+        if (!bucket)
+            return false;
+        bucket->slot()->~T();
+        bucket->used = false;
+        bucket->deleted = true;
+        --m_size;
+        ++m_deleted_count;
+        return true;
+    }
+
+private:
+    void rehash(size_t new_capacity)
+    {
+        new_capacity = max(new_capacity, static_cast<size_t>(4));
+        auto* old_buckets = m_buckets;
+        auto old_capacity = m_capacity;
+
+        m_buckets = (Bucket*)kmalloc(sizeof(Bucket) * new_capacity);
+        __builtin_memset(m_buckets, 0, sizeof(Bucket) * new_capacity);
+        m_capacity = new_capacity;
+        m_deleted_count = 0;
+
+        for (size_t i = 0; i < old_capacity; ++i) {
+            auto& old_bucket = old_buckets[i];
+            if (old_bucket.used) {
+                auto& bucket = lookup_for_writing(*old_bucket.slot());
+                new (bucket.slot()) T(move(*old_bucket.slot()));
+                bucket.used = true;
+                old_bucket.slot()->~T();
+            }
+        }
+        kfree(old_buckets);
+    }
+
+    Bucket* lookup(const T& value) const
+    {
+        if (!m_size)
+            return nullptr;
+        for (auto hash = TraitsForT::hash(value);; hash = double_hash(hash)) {
+            auto& bucket = m_buckets[hash % m_capacity];
+            if (bucket.used && TraitsForT::equals(*bucket.slot(), value))
+                return &bucket;
+            if (!bucket.used && !bucket.deleted)
+                return nullptr;
+        }
+    }
+
+    Bucket& lookup_for_writing(const T& value)
+    {
+        if ((m_size + m_deleted_count + 1) * 100 >= m_capacity * load_factor_in_percent)
+            rehash(m_capacity * 2);
+
+        Bucket* first_empty_bucket = nullptr;
+        for (auto hash = TraitsForT::hash(value);; hash = double_hash(hash)) {
+            auto& bucket = m_buckets[hash % m_capacity];
+            if (bucket.used && TraitsForT::equals(*bucket.slot(), value))
+                return bucket;
+            if (!bucket.used) {
+                if (!first_empty_bucket)
+                    first_empty_bucket = &bucket;
+                if (!bucket.deleted)
+                    return *first_empty_bucket;
+            }
+        }
+    }
+
+    Bucket* m_buckets { nullptr };
+    size_t m_size { 0 };
+    size_t m_capacity { 0 };
+    size_t m_deleted_count { 0 };
+};
+
+static constexpr int int_count = 1000000;
+static constexpr int string_count = 100000;
+
+template<typename Table>
+static void benchmark_insert_ints()
+{
+    for (int round = 0; round < 5; ++round) {
+        Table table;
+        for (int i = 0; i < int_count; ++i)
+            table.set(i);
+        EXPECT_EQ(table.size(), static_cast<size_t>(int_count));
+    }
+}
+
+template<typename Table>
+static void benchmark_lookup_ints()
+{
+    Table table;
+    for (int i = 0; i < int_count; ++i)
+        table.set(i * 2);
+
+    // Half of these are hits, half of them misses.
+    size_t found = 0;
+    for (int round = 0; round < 5; ++round) {
+        for (int i = 0; i < int_count * 2; ++i)
+            found += table.contains(i);
+    }
+    EXPECT_EQ(found, static_cast<size_t>(int_count) * 5);
+}
+
+template<typename Table>
+static void benchmark_erase_ints()
+{
+    // Keep the table at a steady size while churning through keys, which is where tombstones hurt.
+    Table table;
+    for (int i = 0; i < int_count / 10; ++i)
+        table.set(i);
+    for (int i = int_count / 10; i < int_count * 5; ++i) {
+        table.set(i);
+        EXPECT(table.remove(i - int_count / 10));
+    }
+    EXPECT_EQ(table.size(), static_cast<size_t>(int_count / 10));
+}
+
+template<typename Table>
+static void benchmark_lookup_strings()
+{
+    Vector<String> strings;
+    for (int i = 0; i < string_count; ++i)
+        strings.append(String::formatted("string number {}", i));
+
+    Table table;
+    for (auto& string : strings)
+        table.set(string);
+
+    for (int round = 0; round < 10; ++round) {
+        for (auto& string : strings)
+            EXPECT(table.contains(string));
+    }
+}
+
+BENCHMARK_CASE(insert_ints)
+{
+    benchmark_insert_ints<HashTable<int>>();
+}
+
+BENCHMARK_CASE(insert_ints_legacy)
+{
+    benchmark_insert_ints<LegacyHashTable<int>>();
+}
+
+BENCHMARK_CASE(lookup_ints)
+{
+    benchmark_lookup_ints<HashTable<int>>();
+}
+
+BENCHMARK_CASE(lookup_ints_legacy)
+{
+    benchmark_lookup_ints<LegacyHashTable<int>>();
+}
+
+BENCHMARK_CASE(erase_ints)
+{
+    benchmark_erase_ints<HashTable<int>>();
+}
+
+BENCHMARK_CASE(erase_ints_legacy)
+{
+    benchmark_erase_ints<LegacyHashTable<int>>();
+}
+
+BENCHMARK_CASE(lookup_strings)
+{
+    benchmark_lookup_strings<HashTable<String>>();
+}
+
+BENCHMARK_CASE(lookup_strings_legacy)
+{
+    benchmark_lookup_strings<LegacyHashTable<String>>();
+}
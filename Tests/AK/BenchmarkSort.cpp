@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/MergeSort.h>
+#include <AK/QuickSort.h>
+#include <AK/Random.h>
+#include <AK/Vector.h>
+
+static constexpr int element_count = 200000;
+
+enum class Input {
+    Random,
+    Sorted,
+    Reversed,
+    ManyDuplicates,
+};
+
+static Vector<int> make_input(Input input)
+{
+    Vector<int> data;
+    data.ensure_capacity(element_count);
+    for (int i = 0; i < element_count; ++i) {
+        switch (input) {
+        case Input::Random:
+            data.unchecked_append(static_cast<int>(get_random<u32>()));
+            break;
+        case Input::Sorted:
+            data.unchecked_append(i);
+            break;
+        case Input::Reversed:
+            data.unchecked_append(element_count - i);
+            break;
+        case Input::ManyDuplicates:
+            data.unchecked_append(static_cast<int>(get_random<u32>() % 16));
+            break;
+        }
+    }
+    return data;
+}
+
+template<typename Sort>
+static void benchmark_sort(Input input, Sort sort)
+{
+    constexpr int rounds = 5;
+    Test::set_benchmark_items_processed(element_count * rounds);
+    auto data = make_input(input);
+    for (int round = 0; round < rounds; ++round) {
+        auto copy = data;
+        sort(copy);
+        bool is_sorted = true;
+        for (size_t i = 1; i < copy.size(); ++i)
+            is_sorted &= copy[i - 1] <= copy[i];
+        EXPECT(is_sorted);
+    }
+}
+
+static void sort_with_introsort(Vector<int>& data)
+{
+    quick_sort(data);
+}
+
+static void sort_with_merge_sort(Vector<int>& data)
+{
+    merge_sort(data);
+}
+
+// What quick_sort() used to be.
+static void sort_with_dual_pivot(Vector<int>& data)
+{
+    dual_pivot_quick_sort(data, 0, data.size() - 1, [](int a, int b) { return a < b; });
+}
+
+BENCHMARK_CASE(introsort_random)
+{
+    benchmark_sort(Input::Random, sort_with_introsort);
+}
+
+BENCHMARK_CASE(introsort_sorted)
+{
+    benchmark_sort(Input::Sorted, sort_with_introsort);
+}
+
+BENCHMARK_CASE(introsort_reversed)
+{
+    benchmark_sort(Input::Reversed, sort_with_introsort);
+}
+
+BENCHMARK_CASE(introsort_many_duplicates)
+{
+    benchmark_sort(Input::ManyDuplicates, sort_with_introsort);
+}
+
+BENCHMARK_CASE(merge_sort_random)
+{
+    benchmark_sort(Input::Random, sort_with_merge_sort);
+}
+
+BENCHMARK_CASE(merge_sort_sorted)
+{
+    benchmark_sort(Input::Sorted, sort_with_merge_sort);
+}
+
+BENCHMARK_CASE(merge_sort_reversed)
+{
+    benchmark_sort(Input::Reversed, sort_with_merge_sort);
+}
+
+BENCHMARK_CASE(merge_sort_many_duplicates)
+{
+    benchmark_sort(Input::ManyDuplicates, sort_with_merge_sort);
+}
+
+BENCHMARK_CASE(dual_pivot_random)
+{
+    benchmark_sort(Input::Random, sort_with_dual_pivot);
+}
+
+BENCHMARK_CASE(dual_pivot_sorted)
+{
+    benchmark_sort(Input::Sorted, sort_with_dual_pivot);
+}
+
+BENCHMARK_CASE(dual_pivot_reversed)
+{
+    benchmark_sort(Input::Reversed, sort_with_dual_pivot);
+}
+
+BENCHMARK_CASE(dual_pivot_many_duplicates)
+{
+    benchmark_sort(Input::ManyDuplicates, sort_with_dual_pivot);
+}
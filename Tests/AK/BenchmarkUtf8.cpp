@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/String.h>
+#include <AK/StringBuilder.h>
+#include <AK/Utf8.h>
+#include <AK/Utf8View.h>
+#include <AK/Vector.h>
+
+static constexpr size_t iterations = 200;
+
+// About a megabyte of mostly ASCII markup, with some text in other scripts mixed in.
+static const String& mostly_ascii_text()
+{
+    static String text = [] {
+        StringBuilder builder;
+        for (int i = 0; i < 8000; ++i) {
+            builder.append("<p class=\"paragraph\">Lorem ipsum dolor sit amet, consectetur adipiscing elit.</p>\n");
+            if (i % 16 == 0)
+                builder.append("<p>Привет, мир! こんにちは世界</p>\n");
+        }
+        return builder.to_string();
+    }();
+    return text;
+}
+
+BENCHMARK_CASE(validate)
+{
+    auto& text = mostly_ascii_text();
+    for (size_t i = 0; i < iterations; ++i)
+        EXPECT(Utf8View(text).validate());
+    Test::set_benchmark_bytes_processed(text.length() * iterations);
+}
+
+BENCHMARK_CASE(length)
+{
+    auto& text = mostly_ascii_text();
+    for (size_t i = 0; i < iterations; ++i)
+        EXPECT(Utf8View(text).length() > 0);
+    Test::set_benchmark_bytes_processed(text.length() * iterations);
+}
+
+BENCHMARK_CASE(iterate)
+{
+    auto& text = mostly_ascii_text();
+    u32 checksum = 0;
+    for (size_t i = 0; i < iterations; ++i) {
+        for (auto code_point : Utf8View(text))
+            checksum += code_point;
+    }
+    EXPECT(checksum > 0);
+    Test::set_benchmark_bytes_processed(text.length() * iterations);
+}
+
+BENCHMARK_CASE(transcode_to_utf32)
+{
+    auto& text = mostly_ascii_text();
+    Vector<u32> utf32;
+    utf32.resize(text.length());
+    for (size_t i = 0; i < iterations; ++i)
+        EXPECT(transcode_utf8_to_utf32(text.bytes(), utf32.data()) > 0);
+    Test::set_benchmark_bytes_processed(text.length() * iterations);
+}
+
+BENCHMARK_CASE(transcode_to_utf16_and_back)
+{
+    auto& text = mostly_ascii_text();
+    Vector<u16> utf16;
+    utf16.resize(text.length());
+    Vector<u8> utf8;
+    utf8.resize(text.length() * 3);
+    for (size_t i = 0; i < iterations; ++i) {
+        auto utf16_length = transcode_utf8_to_utf16(text.bytes(), utf16.data());
+        EXPECT_EQ(transcode_utf16_to_utf8(utf16.span().trim(utf16_length), utf8.data()), text.length());
+    }
+    Test::set_benchmark_bytes_processed(text.length() * iterations * 2);
+}
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/Arena.h>
+#include <AK/HashMap.h>
+#include <AK/String.h>
+#include <AK/Vector.h>
+
+TEST_CASE(allocations_are_aligned)
+{
+    Arena arena;
+    for (size_t size = 1; size < 100; ++size) {
+        auto* ptr = arena.allocate(size);
+        EXPECT_EQ(reinterpret_cast<FlatPtr>(ptr) % Arena::default_alignment, 0u);
+    }
+    auto* ptr = arena.allocate(3, 64);
+    EXPECT_EQ(reinterpret_cast<FlatPtr>(ptr) % 64, 0u);
+}
+
+TEST_CASE(large_allocations)
+{
+    Arena arena(64, 128);
+    auto* small = static_cast<u8*>(arena.allocate(16));
+    auto* large = static_cast<u8*>(arena.allocate(10000));
+    __builtin_memset(large, 0xaa, 10000);
+    __builtin_memset(small, 0x55, 16);
+    EXPECT_EQ(large[0], 0xaa);
+    EXPECT_EQ(large[9999], 0xaa);
+    EXPECT_EQ(arena.allocated_bytes(), 10016u);
+}
+
+TEST_CASE(reset_to_mark)
+{
+    Arena arena(64, 64);
+    EXPECT_EQ(arena.make<int>(1), 1);
+    auto mark = arena.mark();
+    auto bytes_at_mark = arena.allocated_bytes();
+
+    auto* first_after_mark = arena.allocate(8);
+    for (size_t i = 0; i < 100; ++i)
+        (void)arena.allocate(32);
+
+    arena.reset_to(mark);
+    EXPECT_EQ(arena.allocated_bytes(), bytes_at_mark);
+    EXPECT_EQ(arena.allocate(8), first_after_mark);
+}
+
+TEST_CASE(reset_reuses_last_chunk)
+{
+    Arena arena(64, 64);
+    for (size_t i = 0; i < 10; ++i)
+        (void)arena.allocate(48);
+    arena.reset();
+    EXPECT_EQ(arena.allocated_bytes(), 0u);
+    auto* first = arena.allocate(8);
+    arena.reset();
+    EXPECT_EQ(arena.allocate(8), first);
+}
+
+TEST_CASE(arena_scope)
+{
+    Arena arena;
+    (void)arena.allocate(8);
+    {
+        ArenaScope scope(arena);
+        for (size_t i = 0; i < 1000; ++i)
+            (void)arena.allocate(64);
+        EXPECT(arena.allocated_bytes() > 64000u);
+    }
+    EXPECT_EQ(arena.allocated_bytes(), 8u);
+}
+
+TEST_CASE(vector_in_arena)
+{
+    Arena arena;
+    Vector<int, 0, ArenaAllocator> vector(arena);
+    for (int i = 0; i < 1000; ++i)
+        vector.append(i);
+    EXPECT_EQ(vector.size(), 1000u);
+    for (int i = 0; i < 1000; ++i)
+        EXPECT_EQ(vector[i], i);
+    EXPECT_EQ(&vector.allocator().arena(), &arena);
+
+    auto copy = vector;
+    EXPECT_EQ(copy.size(), 1000u);
+    EXPECT_EQ(&copy.allocator().arena(), &arena);
+
+    auto moved = move(vector);
+    EXPECT_EQ(moved.size(), 1000u);
+    EXPECT(vector.is_empty());
+}
+
+TEST_CASE(hash_map_in_arena)
+{
+    Arena arena;
+    HashMap<int, String, Traits<int>, ArenaAllocator> map(arena);
+    for (int i = 0; i < 1000; ++i)
+        map.set(i, String::number(i));
+    EXPECT_EQ(map.size(), 1000u);
+    for (int i = 0; i < 1000; i += 2)
+        map.remove(i);
+    EXPECT_EQ(map.size(), 500u);
+    EXPECT_EQ(map.get(3).value(), "3");
+    EXPECT(!map.get(4).has_value());
+
+    map.clear();
+    EXPECT(map.is_empty());
+    map.set(42, "42");
+    EXPECT_EQ(map.get(42).value(), "42");
+}
+
+TEST_CASE(default_allocator_takes_no_space)
+{
+    static_assert(sizeof(Vector<int>) == 3 * sizeof(void*));
+    static_assert(sizeof(Vector<int, 0, ArenaAllocator>) == 4 * sizeof(void*));
+}
@@ -289,3 +289,63 @@ TEST_CASE(long_long_regression)
 
     EXPECT_EQ(builder.string_view(), "81985529216486895");
 }
+
+TEST_CASE(format_integers_in_every_base)
+{
+    EXPECT_EQ(String::formatted("{}", 0), "0");
+    EXPECT_EQ(String::formatted("{}", 9), "9");
+    EXPECT_EQ(String::formatted("{}", 10), "10");
+    EXPECT_EQ(String::formatted("{}", 99), "99");
+    EXPECT_EQ(String::formatted("{}", 100), "100");
+    EXPECT_EQ(String::formatted("{}", -1000), "-1000");
+    EXPECT_EQ(String::formatted("{}", NumericLimits<u64>::max()), "18446744073709551615");
+    EXPECT_EQ(String::formatted("{:b}", 0), "0");
+    EXPECT_EQ(String::formatted("{:b}", 10), "1010");
+    EXPECT_EQ(String::formatted("{:o}", 511), "777");
+    EXPECT_EQ(String::formatted("{:x}", NumericLimits<u64>::max()), "ffffffffffffffff");
+    EXPECT_EQ(String::formatted("{:X}", 0xbeef), "BEEF");
+    EXPECT_EQ(String::formatted("{:#b}", 5), "0b101");
+    EXPECT_EQ(String::formatted("{:+}", 5), "+5");
+    EXPECT_EQ(String::formatted("{: }", 5), " 5");
+}
+
+TEST_CASE(format_strings_are_split_up_at_compile_time)
+{
+    AK::CheckedFormatString<int, int> format_string { "a{}b{:x}c" };
+    auto fields = format_string.compiled_fields();
+    EXPECT_EQ(fields.size(), 3u);
+    EXPECT(fields[0].has_replacement_field);
+    EXPECT(fields[1].has_standard_specifier);
+    EXPECT_EQ(fields[1].specifier.mode, 'x');
+    EXPECT(!fields[2].has_replacement_field);
+    EXPECT_EQ(fields[2].literal_length, 1u);
+
+    // More fields than arguments, which is left for the runtime parser.
+    AK::CheckedFormatString<int> repeated_format_string { "{0}{0}{0}" };
+    EXPECT(repeated_format_string.compiled_fields().is_empty());
+    EXPECT_EQ(String::formatted("{0}{0}{0}", 1), "111");
+
+    AK::CheckedFormatString<int> unchecked_format_string { StringView { "{}" } };
+    EXPECT(unchecked_format_string.compiled_fields().is_empty());
+}
+
+#define EXPECT_COMPILED_AND_PARSED_EQ(fmt, ...) \
+    EXPECT_EQ(String::formatted(fmt, __VA_ARGS__), String::formatted(StringView { fmt }, __VA_ARGS__))
+
+TEST_CASE(compiled_format_strings_match_parsed_ones)
+{
+    EXPECT_COMPILED_AND_PARSED_EQ("{{{}}}", 1);
+    EXPECT_COMPILED_AND_PARSED_EQ("{{}}{}{{", "x");
+    EXPECT_COMPILED_AND_PARSED_EQ("{:*^9}", "mid");
+    EXPECT_COMPILED_AND_PARSED_EQ("{:>+5d}", 42);
+    EXPECT_COMPILED_AND_PARSED_EQ("{:#010x}", 0xcafe);
+    EXPECT_COMPILED_AND_PARSED_EQ("{:#o}", 8);
+    EXPECT_COMPILED_AND_PARSED_EQ("{:{}}", 7, 4);
+    EXPECT_COMPILED_AND_PARSED_EQ("{:.{}}", "abcdef", 3);
+    EXPECT_COMPILED_AND_PARSED_EQ("{1:>{0}}|{0}", 6, "ab");
+    EXPECT_COMPILED_AND_PARSED_EQ("{:c}{:c}", 'h', 105);
+    EXPECT_COMPILED_AND_PARSED_EQ("{:p}", reinterpret_cast<void*>(0x1234));
+    EXPECT_COMPILED_AND_PARSED_EQ("{:.3}|{:8.2}|{:<8}", 1.2345, -2.5, 0.5);
+    EXPECT_COMPILED_AND_PARSED_EQ("{:*<10}", C { 7 });
+    EXPECT_COMPILED_AND_PARSED_EQ("{} {:d} {:s}", true, false, true);
+}
@@ -173,3 +173,102 @@ TEST_CASE(basic_contains)
     EXPECT_EQ(table.remove(1), true);
     EXPECT_EQ(table.contains(1), false);
 }
+
+TEST_CASE(remove_from_full_group)
+{
+    struct IntCollisionTraits : public GenericTraits<int> {
+        static unsigned hash(int) { return 0; }
+    };
+
+    // Everything lands in the same group, so all but the first 16 values have to probe past it.
+    HashTable<int, IntCollisionTraits> table;
+    for (int i = 0; i < 64; ++i)
+        EXPECT_EQ(table.set(i), AK::HashSetResult::InsertedNewEntry);
+
+    for (int i = 0; i < 16; i += 2)
+        EXPECT_EQ(table.remove(i), true);
+
+    EXPECT_EQ(table.size(), 56u);
+    for (int i = 0; i < 64; ++i)
+        EXPECT_EQ(table.contains(i), i >= 16 || i % 2);
+}
+
+TEST_CASE(reinsert_into_freed_slots)
+{
+    struct IntCollisionTraits : public GenericTraits<int> {
+        static unsigned hash(int value) { return value % 3; }
+    };
+
+    HashTable<int, IntCollisionTraits> table;
+    for (int i = 0; i < 48; ++i)
+        EXPECT_EQ(table.set(i), AK::HashSetResult::InsertedNewEntry);
+
+    auto capacity = table.capacity();
+
+    for (int i = 0; i < 48; i += 4)
+        EXPECT_EQ(table.remove(i), true);
+    for (int i = 0; i < 48; i += 4)
+        EXPECT_EQ(table.set(i), AK::HashSetResult::InsertedNewEntry);
+    for (int i = 0; i < 48; ++i)
+        EXPECT_EQ(table.set(i), AK::HashSetResult::ReplacedExistingEntry);
+
+    EXPECT_EQ(table.size(), 48u);
+    EXPECT_EQ(table.capacity(), capacity);
+    for (int i = 0; i < 48; ++i)
+        EXPECT(table.contains(i));
+    EXPECT(!table.contains(48));
+}
+
+TEST_CASE(rehash_with_many_collisions)
+{
+    struct IntCollisionTraits : public GenericTraits<int> {
+        static unsigned hash(int value) { return value & 7; }
+    };
+
+    HashTable<int, IntCollisionTraits> table;
+    for (int i = 0; i < 2000; ++i)
+        EXPECT_EQ(table.set(i), AK::HashSetResult::InsertedNewEntry);
+
+    EXPECT_EQ(table.size(), 2000u);
+    for (int i = 0; i < 2000; ++i)
+        EXPECT(table.contains(i));
+
+    for (int i = 0; i < 2000; i += 2)
+        EXPECT_EQ(table.remove(i), true);
+
+    // A copy is rebuilt from scratch, so it has to end up with the same contents.
+    auto copy = table;
+    EXPECT_EQ(copy.size(), 1000u);
+    for (int i = 0; i < 2000; ++i)
+        EXPECT_EQ(copy.contains(i), i % 2 == 1);
+}
+
+TEST_CASE(iterate_after_mixed_removals)
+{
+    HashTable<int> table;
+    for (int i = 0; i < 1000; ++i)
+        table.set(i);
+    for (int i = 0; i < 1000; i += 3)
+        table.remove(i);
+    for (int i = 0; i < 1000; i += 6)
+        table.set(i);
+    for (int i = 1; i < 1000; i += 5)
+        table.remove(i);
+
+    auto is_expected = [](int i) { return (i % 3 != 0 || i % 6 == 0) && i % 5 != 1; };
+
+    size_t expected_count = 0;
+    for (int i = 0; i < 1000; ++i) {
+        if (is_expected(i))
+            ++expected_count;
+    }
+
+    size_t count = 0;
+    for (auto value : table) {
+        EXPECT(is_expected(value));
+        ++count;
+    }
+
+    EXPECT_EQ(table.size(), expected_count);
+    EXPECT_EQ(count, expected_count);
+}
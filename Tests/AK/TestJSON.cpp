@@ -9,7 +9,9 @@
 #include <AK/HashMap.h>
 #include <AK/JsonArray.h>
 #include <AK/JsonObject.h>
+#include <AK/JsonPullParser.h>
 #include <AK/JsonValue.h>
+#include <AK/JsonValueView.h>
 #include <AK/String.h>
 #include <AK/StringBuilder.h>
 
@@ -98,3 +100,118 @@ TEST_CASE(json_duplicate_keys)
     json.set("test", "baz");
     EXPECT_EQ(json.to_string(), "{\"test\":\"baz\"}");
 }
+
+TEST_CASE(json_pull_parser)
+{
+    using Event = JsonPullParser::Event;
+    JsonPullParser parser(R"({ "name": "hello\"", "values": [1, -2, 3.5, true, null], "empty": {} })");
+
+    EXPECT(parser.next() == Event::ObjectStart);
+    EXPECT(parser.next() == Event::Key);
+    EXPECT_EQ(parser.token(), "name");
+    EXPECT(parser.next() == Event::String);
+    EXPECT(parser.string_has_escapes());
+    EXPECT_EQ(parser.string(), "hello\"");
+    EXPECT(parser.next() == Event::Key);
+    EXPECT(parser.next() == Event::ArrayStart);
+    EXPECT_EQ(parser.depth(), 2u);
+    EXPECT(parser.next() == Event::Number);
+    EXPECT_EQ(parser.number<u32>().value(), 1u);
+    EXPECT(parser.next() == Event::Number);
+    EXPECT_EQ(parser.number<i32>().value(), -2);
+    EXPECT(parser.next() == Event::Number);
+    EXPECT_EQ(parser.number<double>().value(), 3.5);
+    EXPECT(parser.next() == Event::True);
+    EXPECT(parser.next() == Event::Null);
+    EXPECT(parser.next() == Event::ArrayEnd);
+    EXPECT(parser.next() == Event::Key);
+    EXPECT_EQ(parser.token(), "empty");
+    EXPECT(parser.next() == Event::ObjectStart);
+    EXPECT(parser.next() == Event::ObjectEnd);
+    EXPECT(parser.next() == Event::ObjectEnd);
+    EXPECT(parser.next() == Event::End);
+}
+
+TEST_CASE(json_pull_parser_skip_value)
+{
+    using Event = JsonPullParser::Event;
+    JsonPullParser parser(R"([{ "a": [1, {"b": "]}"}], "c": 2 }, 3])");
+
+    EXPECT(parser.next() == Event::ArrayStart);
+    EXPECT(parser.next() == Event::ObjectStart);
+    EXPECT(parser.skip_value());
+    EXPECT(parser.next() == Event::Number);
+    EXPECT_EQ(parser.token(), "3");
+    EXPECT(parser.next() == Event::ArrayEnd);
+    EXPECT(parser.next() == Event::End);
+}
+
+TEST_CASE(json_pull_parser_errors)
+{
+    auto fails = [](const StringView& input) {
+        JsonPullParser parser(input);
+        for (;;) {
+            auto event = parser.next();
+            if (event == JsonPullParser::Event::Error)
+                return true;
+            if (event == JsonPullParser::Event::End)
+                return false;
+        }
+    };
+    EXPECT(fails("{"));
+    EXPECT(fails("[1,]"));
+    EXPECT(fails("{\"a\" 1}"));
+    EXPECT(fails("[1 2]"));
+    EXPECT(fails("\"unterminated"));
+    EXPECT(fails("1 2"));
+    EXPECT(fails("-"));
+    EXPECT(!fails(" [ 1e10, -0.5E-3 ] "));
+}
+
+TEST_CASE(json_pull_parser_truncated_escapes)
+{
+    using Event = JsonPullParser::Event;
+    auto fails = [](const StringView& input) {
+        JsonPullParser parser(input);
+        for (;;) {
+            auto event = parser.next();
+            if (event == Event::Error)
+                return true;
+            if (event == Event::End)
+                return false;
+        }
+    };
+    auto fails_to_skip = [](const StringView& input) {
+        JsonPullParser parser(input);
+        if (parser.next() == Event::Error)
+            return true;
+        return !parser.skip_value();
+    };
+    for (auto input : { "\"\\"sv, "\"abc\\"sv, "{\"a\":\"\\"sv, "[\"\\"sv }) {
+        EXPECT(fails(input));
+        EXPECT(fails_to_skip(input));
+    }
+}
+
+TEST_CASE(json_value_view)
+{
+    auto view = JsonValueView::from_string(R"( {"pid": 42, "name": "Ter\u00e4", "stack": [1, 2, 3], "nested": {"ok": true}} )");
+    EXPECT(view.has_value());
+    EXPECT(view->is_object());
+    EXPECT_EQ(view->size(), 4u);
+    EXPECT_EQ(view->get("pid").to_i32(), 42);
+    EXPECT_EQ(view->get("name").to_string(), "Terä");
+    EXPECT(!view->get("name").as_string_view().has_value());
+    EXPECT_EQ(view->get("stack").at(0).raw(), "1");
+    EXPECT_EQ(view->get("stack").size(), 3u);
+    EXPECT_EQ(view->get("stack").at(2).to_u32(), 3u);
+    EXPECT(view->get("stack").at(3).is_null());
+    EXPECT(view->get("nested").get("ok").to_bool());
+    EXPECT(view->get("missing").is_null());
+
+    auto materialized = view->get("nested").materialize();
+    EXPECT(materialized.is_object());
+    EXPECT(materialized.as_object().get("ok").to_bool());
+
+    EXPECT(!JsonValueView::from_string("[1, 2").has_value());
+}
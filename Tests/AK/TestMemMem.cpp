@@ -66,3 +66,95 @@ TEST_CASE(kmp_two_chunks)
     EXPECT_EQ(result_2.value_or(9), 4u);
     EXPECT(!result_3.has_value());
 }
+
+template<typename Callback>
+static void for_each_memory_search_implementation(Callback callback)
+{
+    auto original_implementation = AK::memory_search_implementation();
+    for (auto implementation : { AK::MemorySearchImplementation::Scalar, AK::MemorySearchImplementation::SSE2, AK::MemorySearchImplementation::AVX2 }) {
+        if (AK::set_memory_search_implementation(implementation))
+            callback();
+    }
+    EXPECT(AK::set_memory_search_implementation(original_implementation));
+}
+
+TEST_CASE(memchr_and_memrchr)
+{
+    for_each_memory_search_implementation([] {
+        Array<u8, 100> haystack {};
+        for (size_t length = 0; length <= 70; ++length) {
+            for (size_t start = 0; start < 4; ++start) {
+                EXPECT_EQ(AK::memchr(haystack.data() + start, 1, length), nullptr);
+                EXPECT_EQ(AK::memrchr(haystack.data() + start, 1, length), nullptr);
+                for (size_t first = 0; first < length; ++first) {
+                    haystack[start + first] = 1;
+                    haystack[start + length - 1] = 1;
+                    EXPECT_EQ(AK::memchr(haystack.data() + start, 1, length), &haystack[start + first]);
+                    EXPECT_EQ(AK::memrchr(haystack.data() + start, 1, length), &haystack[start + length - 1]);
+                    haystack[start + first] = 0;
+                    haystack[start + length - 1] = 0;
+                }
+                // Anything past the end doesn't count.
+                haystack[start + length] = 1;
+                EXPECT_EQ(AK::memchr(haystack.data() + start, 1, length), nullptr);
+                haystack[start + length] = 0;
+            }
+        }
+    });
+}
+
+TEST_CASE(find_any_of)
+{
+    for_each_memory_search_implementation([] {
+        StringView haystack = "the quick brown fox jumps over the lazy dog, and then the lazy dog gets up"sv;
+        auto find = [&](StringView needles) -> Optional<size_t> {
+            auto* match = static_cast<const char*>(AK::find_any_of(haystack.characters_without_null_termination(), haystack.length(), needles.characters_without_null_termination(), needles.length()));
+            if (!match)
+                return {};
+            return match - haystack.characters_without_null_termination();
+        };
+        EXPECT_EQ(find("q").value(), 4u);
+        EXPECT_EQ(find("xz").value(), 18u);
+        EXPECT_EQ(find(",").value(), 43u);
+        EXPECT_EQ(find("pu").value(), 5u);
+        EXPECT_EQ(find("!?,.;:").value(), 43u);
+        EXPECT_EQ(find("0123456789,").value(), 43u);
+        EXPECT(!find("").has_value());
+        EXPECT(!find("!?.;:").has_value());
+        EXPECT(!find("0123456789ABCDEF").has_value());
+    });
+}
+
+TEST_CASE(memmem_every_position)
+{
+    for_each_memory_search_implementation([] {
+        Array<u8, 200> haystack {};
+        for (size_t needle_length = 2; needle_length < 50; needle_length += 7) {
+            Array<u8, 50> needle {};
+            for (size_t i = 0; i < needle_length; ++i)
+                needle[i] = 1 + i % 3;
+            for (size_t position = 0; position + needle_length <= haystack.size(); position += 5) {
+                __builtin_memcpy(haystack.data() + position, needle.data(), needle_length);
+                EXPECT_EQ(AK::memmem_optional(haystack.data(), haystack.size(), needle.data(), needle_length).value_or(999), position);
+                __builtin_memset(haystack.data() + position, 0, needle_length);
+            }
+            EXPECT(!AK::memmem_optional(haystack.data(), haystack.size(), needle.data(), needle_length).has_value());
+        }
+    });
+}
+
+TEST_CASE(memmem_many_near_misses)
+{
+    for_each_memory_search_implementation([] {
+        // Every position starts and ends like the needle, but only the very last one is a match.
+        Vector<u8> haystack;
+        haystack.resize(64 * KiB);
+        __builtin_memset(haystack.data(), 'a', haystack.size());
+        Array<u8, 40> needle;
+        __builtin_memset(needle.data(), 'a', needle.size());
+        needle[20] = 'b';
+        EXPECT(!AK::memmem_optional(haystack.data(), haystack.size(), needle.data(), needle.size()).has_value());
+        haystack[haystack.size() - 20] = 'b';
+        EXPECT_EQ(AK::memmem_optional(haystack.data(), haystack.size(), needle.data(), needle.size()).value(), haystack.size() - needle.size());
+    });
+}
@@ -7,9 +7,12 @@
 #include <LibTest/TestCase.h>
 
 #include <AK/Checked.h>
+#include <AK/MergeSort.h>
 #include <AK/Noncopyable.h>
 #include <AK/QuickSort.h>
+#include <AK/Random.h>
 #include <AK/StdLibExtras.h>
+#include <AK/Vector.h>
 
 TEST_CASE(sorts_without_copy)
 {
@@ -98,3 +101,101 @@ TEST_CASE(maximum_stack_depth)
 
     delete[] data;
 }
+
+TEST_CASE(introsort_adversarial_inputs)
+{
+    Vector<int> data;
+    auto check = [&](auto make_value) {
+        data.clear();
+        for (int i = 0; i < 10000; ++i)
+            data.append(make_value(i));
+        size_t comparisons = 0;
+        quick_sort(data, [&](int a, int b) {
+            ++comparisons;
+            return a < b;
+        });
+        for (size_t i = 1; i < data.size(); ++i)
+            EXPECT(data[i - 1] <= data[i]);
+        // n log n would be around 133000, quadratic behavior would be around 50 million.
+        EXPECT(comparisons < 1'000'000);
+    };
+
+    check([](int i) { return i; });
+    check([](int i) { return -i; });
+    check([](int) { return 42; });
+    check([](int i) { return i % 3; });
+    check([](int i) { return i % 2 ? i : 10000 - i; });
+    // The classic median-of-three killer for the first/middle/last pivot choice.
+    check([](int i) { return i % 2 ? i : i / 2; });
+}
+
+TEST_CASE(introsort_non_strict_comparison)
+{
+    // Not a strict weak ordering, but we shouldn't run off either end of the array because of it.
+    Vector<int> data;
+    for (int i = 0; i < 1000; ++i)
+        data.append(i % 7);
+    quick_sort(data, [](int a, int b) { return a <= b; });
+    EXPECT_EQ(data.size(), 1000u);
+}
+
+TEST_CASE(quick_sort_iterators)
+{
+    Vector<int> data;
+    for (int i = 0; i < 100; ++i)
+        data.append((i * 37) % 100);
+    quick_sort(data.begin(), data.end());
+    for (int i = 0; i < 100; ++i)
+        EXPECT_EQ(data[i], i);
+}
+
+TEST_CASE(merge_sort_is_stable)
+{
+    struct Item {
+        int key;
+        int order;
+    };
+    Vector<Item> items;
+    for (int i = 0; i < 5000; ++i)
+        items.append({ static_cast<int>(get_random<u32>() % 50), i });
+    // A descending run, an ascending run and a bunch of equal keys at the end.
+    for (int i = 0; i < 100; ++i)
+        items.append({ 100 - i, 5000 + i });
+    for (int i = 0; i < 100; ++i)
+        items.append({ i, 5100 + i });
+    for (int i = 0; i < 100; ++i)
+        items.append({ 7, 5200 + i });
+
+    merge_sort(items, [](auto& a, auto& b) { return a.key < b.key; });
+
+    for (size_t i = 1; i < items.size(); ++i) {
+        EXPECT(items[i - 1].key <= items[i].key);
+        if (items[i - 1].key == items[i].key)
+            EXPECT(items[i - 1].order < items[i].order);
+    }
+}
+
+TEST_CASE(merge_sort_without_copy)
+{
+    struct NoCopy {
+        AK_MAKE_NONCOPYABLE(NoCopy);
+
+    public:
+        NoCopy() = default;
+        NoCopy(NoCopy&&) = default;
+
+        NoCopy& operator=(NoCopy&&) = default;
+
+        int value { 0 };
+    };
+
+    Vector<NoCopy> items;
+    for (int i = 0; i < 1000; ++i) {
+        NoCopy item;
+        item.value = (i * 7919) % 1000;
+        items.append(move(item));
+    }
+    merge_sort(items, [](auto& a, auto& b) { return a.value < b.value; });
+    for (int i = 0; i < 1000; ++i)
+        EXPECT_EQ(items[i].value, i);
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/SPSCQueue.h>
+#include <AK/String.h>
+
+TEST_CASE(basic)
+{
+    SPSCQueue<int, 4> ints;
+    EXPECT(ints.is_empty());
+    EXPECT(!ints.try_dequeue().has_value());
+
+    EXPECT(ints.try_enqueue(1));
+    EXPECT(ints.try_enqueue(2));
+    EXPECT(ints.try_enqueue(3));
+    EXPECT(ints.try_enqueue(4));
+    EXPECT_EQ(ints.size(), 4u);
+    EXPECT(!ints.try_enqueue(5));
+
+    EXPECT_EQ(ints.try_dequeue().value(), 1);
+    EXPECT(ints.try_enqueue(5));
+    EXPECT_EQ(ints.try_dequeue().value(), 2);
+    EXPECT_EQ(ints.try_dequeue().value(), 3);
+    EXPECT_EQ(ints.try_dequeue().value(), 4);
+    EXPECT_EQ(ints.try_dequeue().value(), 5);
+    EXPECT(ints.is_empty());
+    EXPECT(!ints.try_dequeue().has_value());
+}
+
+TEST_CASE(wraps_around_many_times)
+{
+    SPSCQueue<int, 8> ints;
+    int next_in = 0;
+    int next_out = 0;
+    for (int round = 0; round < 1000; ++round) {
+        for (int i = 0; i < 5; ++i)
+            EXPECT(ints.try_enqueue(next_in++));
+        for (int i = 0; i < 5; ++i)
+            EXPECT_EQ(ints.try_dequeue().value(), next_out++);
+    }
+    EXPECT(ints.is_empty());
+}
+
+TEST_CASE(complex_type)
+{
+    SPSCQueue<String, 2> strings;
+    EXPECT(strings.try_enqueue("ABC"));
+    String def = "DEF";
+    EXPECT(strings.try_enqueue(def));
+    String ghi = "GHI";
+    EXPECT(!strings.try_enqueue(move(ghi)));
+    // A failed enqueue leaves the value alone.
+    EXPECT_EQ(ghi, "GHI");
+
+    EXPECT_EQ(strings.try_dequeue().value(), "ABC");
+    EXPECT_EQ(strings.try_dequeue().value(), "DEF");
+}
+
+struct DestructorCounter {
+    static unsigned s_live_count;
+    DestructorCounter() { ++s_live_count; }
+    DestructorCounter(const DestructorCounter&) { ++s_live_count; }
+    DestructorCounter(DestructorCounter&&) { ++s_live_count; }
+    ~DestructorCounter() { --s_live_count; }
+};
+unsigned DestructorCounter::s_live_count = 0;
+
+TEST_CASE(destroys_what_is_left)
+{
+    {
+        SPSCQueue<DestructorCounter, 4> queue;
+        EXPECT(queue.try_enqueue(DestructorCounter {}));
+        EXPECT(queue.try_enqueue(DestructorCounter {}));
+        EXPECT(queue.try_enqueue(DestructorCounter {}));
+        EXPECT_EQ(DestructorCounter::s_live_count, 3u);
+        EXPECT(queue.try_dequeue().has_value());
+        EXPECT_EQ(DestructorCounter::s_live_count, 2u);
+    }
+    EXPECT_EQ(DestructorCounter::s_live_count, 0u);
+}
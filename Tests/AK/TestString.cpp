@@ -10,6 +10,7 @@
 #include <AK/String.h>
 #include <AK/StringBuilder.h>
 #include <cstring>
+#include <pthread.h>
 
 TEST_CASE(construct_empty)
 {
@@ -24,6 +25,43 @@ TEST_CASE(construct_empty)
     EXPECT(String("").impl() == String::empty().impl());
 }
 
+TEST_CASE(short_strings_are_shared)
+{
+    EXPECT(String("x").impl() == String("x").impl());
+    EXPECT(String("x").impl() != String("y").impl());
+    EXPECT(String("X").to_lowercase().impl() == String("x").impl());
+
+    String first = "short";
+    String second = "short";
+    EXPECT(first.impl() == second.impl());
+    EXPECT_EQ(second, "short");
+
+    // Strings that happen to land on the same cache entry must not get mixed up.
+    Vector<String> strings;
+    for (int i = 0; i < 1000; ++i)
+        strings.append(String::number(i * 7919));
+    for (int i = 0; i < 1000; ++i)
+        EXPECT_EQ(strings[i], String::number(i * 7919));
+}
+
+TEST_CASE(short_strings_are_released_at_thread_exit)
+{
+    String string;
+    pthread_t thread;
+    auto rc = pthread_create(
+        &thread, nullptr, [](void* string) -> void* {
+            *static_cast<String*>(string) = "from a thread";
+            return nullptr;
+        },
+        &string);
+    EXPECT_EQ(rc, 0);
+    EXPECT_EQ(pthread_join(thread, nullptr), 0);
+
+    // The exited thread's cache must no longer hold on to the string.
+    EXPECT_EQ(string, "from a thread");
+    EXPECT_EQ(string.impl()->ref_count(), 1u);
+}
+
 TEST_CASE(construct_contents)
 {
     String test_string = "ABCDEF";
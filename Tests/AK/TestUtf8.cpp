@@ -6,7 +6,12 @@
 
 #include <LibTest/TestCase.h>
 
+#include <AK/MemMem.h>
+#include <AK/String.h>
+#include <AK/StringBuilder.h>
+#include <AK/Utf8.h>
 #include <AK/Utf8View.h>
+#include <AK/Vector.h>
 
 TEST_CASE(decode_ascii)
 {
@@ -67,3 +72,135 @@ TEST_CASE(validate_invalid_ut8)
     EXPECT(!utf8_4.validate(valid_bytes));
     EXPECT(valid_bytes == 0);
 }
+
+template<typename Callback>
+static void for_each_memory_search_implementation(Callback callback)
+{
+    auto original_implementation = AK::memory_search_implementation();
+    for (auto implementation : { AK::MemorySearchImplementation::Scalar, AK::MemorySearchImplementation::SSE2, AK::MemorySearchImplementation::AVX2 }) {
+        if (AK::set_memory_search_implementation(implementation))
+            callback();
+    }
+    EXPECT(AK::set_memory_search_implementation(original_implementation));
+}
+
+// Long enough to go through a few vector chunks, with the interesting bit anywhere in them.
+static String pad_with_ascii(size_t before, const StringView& middle, size_t after)
+{
+    StringBuilder builder;
+    for (size_t i = 0; i < before; ++i)
+        builder.append('a' + i % 26);
+    builder.append(middle);
+    for (size_t i = 0; i < after; ++i)
+        builder.append('z' - i % 26);
+    return builder.to_string();
+}
+
+TEST_CASE(ascii_prefix_length)
+{
+    for_each_memory_search_implementation([] {
+        for (size_t before = 0; before < 70; ++before) {
+            auto string = pad_with_ascii(before, "\xc3\xa9", 40);
+            EXPECT_EQ(ascii_prefix_length(string.bytes()), before);
+            EXPECT(!is_ascii(string.bytes()));
+            EXPECT(is_ascii(string.bytes().trim(before)));
+        }
+    });
+}
+
+TEST_CASE(validate_invalid_utf8_after_ascii)
+{
+    for_each_memory_search_implementation([] {
+        for (size_t before = 0; before < 70; ++before) {
+            size_t valid_bytes;
+            auto valid = pad_with_ascii(before, "\xd0\x9f\xf0\x9f\x98\x80", 40);
+            EXPECT(Utf8View(valid).validate(valid_bytes));
+            EXPECT_EQ(valid_bytes, valid.length());
+
+            auto stray_continuation_byte = pad_with_ascii(before, "\xd0\x9f\x80", 40);
+            EXPECT(!Utf8View(stray_continuation_byte).validate(valid_bytes));
+            EXPECT_EQ(valid_bytes, before + 2);
+
+            auto truncated = pad_with_ascii(before, "\xf0\x9f\x98", 0);
+            EXPECT(!Utf8View(truncated).validate(valid_bytes));
+            EXPECT_EQ(valid_bytes, before);
+
+            auto invalid_leading_byte = pad_with_ascii(before, "\xf8\x80\x80\x80\x80", 40);
+            EXPECT(!Utf8View(invalid_leading_byte).validate(valid_bytes));
+            EXPECT_EQ(valid_bytes, before);
+        }
+    });
+}
+
+TEST_CASE(length)
+{
+    for_each_memory_search_implementation([] {
+        for (size_t before = 0; before < 70; ++before) {
+            auto string = pad_with_ascii(before, "Привет, мир! 😀 こんにちは世界", before);
+            Utf8View view { string };
+            size_t iterated_length = 0;
+            for ([[maybe_unused]] auto code_point : view)
+                ++iterated_length;
+            EXPECT_EQ(view.length(), iterated_length);
+            EXPECT_EQ(count_utf8_code_points(string.bytes()), before * 2 + 22);
+        }
+    });
+}
+
+TEST_CASE(transcode_utf8_to_utf32_and_back)
+{
+    for_each_memory_search_implementation([] {
+        for (size_t before = 0; before < 70; ++before) {
+            auto string = pad_with_ascii(before, "γειά σου κόσμος 😀", 40);
+
+            Vector<u32> utf32;
+            utf32.resize(string.length());
+            utf32.resize(transcode_utf8_to_utf32(string.bytes(), utf32.data()));
+
+            Vector<u32> expected;
+            for (auto code_point : Utf8View(string))
+                expected.append(code_point);
+            EXPECT_EQ(utf32, expected);
+
+            Vector<u8> utf8;
+            utf8.resize(utf32.size() * 4);
+            auto utf8_length = transcode_utf32_to_utf8(utf32.span(), utf8.data());
+            EXPECT_EQ(StringView(utf8.data(), utf8_length), string);
+        }
+    });
+}
+
+TEST_CASE(transcode_utf8_to_utf16_and_back)
+{
+    for_each_memory_search_implementation([] {
+        for (size_t before = 0; before < 70; ++before) {
+            auto string = pad_with_ascii(before, "Привет 😀!", 40);
+
+            Vector<u16> utf16;
+            utf16.resize(string.length());
+            utf16.resize(transcode_utf8_to_utf16(string.bytes(), utf16.data()));
+            EXPECT_EQ(utf16.size(), before + 10 + 40);
+            EXPECT_EQ(utf16[before], 0x41fu);
+            EXPECT_EQ(utf16[before + 7], 0xd83du);
+            EXPECT_EQ(utf16[before + 8], 0xde00u);
+            EXPECT_EQ(utf16[before + 9], (u16)'!');
+
+            Vector<u8> utf8;
+            utf8.resize(utf16.size() * 3);
+            auto utf8_length = transcode_utf16_to_utf8(utf16.span(), utf8.data());
+            EXPECT_EQ(StringView(utf8.data(), utf8_length), string);
+        }
+    });
+}
+
+TEST_CASE(transcode_unpaired_surrogates_and_out_of_range_code_points)
+{
+    u16 utf16[] = { 'a', 0xdc00, 0xd800, 'b' };
+    u8 utf8[sizeof(utf16) / sizeof(u16) * 3];
+    auto utf8_length = transcode_utf16_to_utf8({ utf16, 4 }, utf8);
+    EXPECT_EQ(StringView(utf8, utf8_length), "a\xed\xb0\x80\xed\xa0\x80" "b");
+
+    u32 utf32[] = { 0x110000, 'c' };
+    utf8_length = transcode_utf32_to_utf8({ utf32, 2 }, utf8);
+    EXPECT_EQ(StringView(utf8, utf8_length), "\xef\xbf\xbd" "c");
+}
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/OwnPtr.h>
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Interpreter.h>
+#include <LibJS/Lexer.h>
+#include <LibJS/Parser.h>
+#include <LibJS/Runtime/GlobalObject.h>
+
+// Every script runs once through the AST interpreter and once with the bytecode interpreter, which it has to be
+// fully supported by for the comparison to mean anything.
+
+static constexpr StringView recursion_script = R"(
+function fib(n) { return n < 2 ? n : fib(n - 1) + fib(n - 2); }
+fib(20);
+)";
+
+static constexpr StringView loop_script = R"(
+let sum = 0;
+for (let i = 0; i < 200000; i++) {
+    if (i % 3 === 0)
+        continue;
+    sum = (sum + i * 7) % 1000003;
+}
+)";
+
+static constexpr StringView property_access_script = R"(
+let point = { x: 0, y: 0 };
+let values = [1, 2, 3, 4, 5, 6, 7, 8];
+for (let i = 0; i < 50000; i++) {
+    point.x += values[i % 8];
+    point.y = point.x - point["y"];
+}
+)";
+
+static void run_script(StringView source, bool use_bytecode)
+{
+    auto vm = JS::VM::create();
+    OwnPtr<JS::Bytecode::Interpreter> bytecode_interpreter;
+    if (use_bytecode)
+        bytecode_interpreter = make<JS::Bytecode::Interpreter>(*vm);
+    auto interpreter = JS::Interpreter::create<JS::GlobalObject>(*vm);
+
+    auto parser = JS::Parser(JS::Lexer(source));
+    auto program = parser.parse_program();
+    VERIFY(!parser.has_errors());
+    if (use_bytecode)
+        EXPECT(program->bytecode_block());
+
+    interpreter->run(interpreter->global_object(), *program);
+    EXPECT(!vm->exception());
+}
+
+BENCHMARK_CASE(recursion_ast)
+{
+    run_script(recursion_script, false);
+}
+
+BENCHMARK_CASE(recursion_bytecode)
+{
+    run_script(recursion_script, true);
+}
+
+BENCHMARK_CASE(loop_ast)
+{
+    run_script(loop_script, false);
+}
+
+BENCHMARK_CASE(loop_bytecode)
+{
+    run_script(loop_script, true);
+}
+
+BENCHMARK_CASE(property_access_ast)
+{
+    run_script(property_access_script, false);
+}
+
+BENCHMARK_CASE(property_access_bytecode)
+{
+    run_script(property_access_script, true);
+}
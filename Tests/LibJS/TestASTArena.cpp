@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/OwnPtr.h>
+#include <LibJS/AST.h>
+#include <LibJS/Lexer.h>
+#include <LibJS/Parser.h>
+#include <pthread.h>
+
+static OwnPtr<JS::Parser> make_parser()
+{
+    return make<JS::Parser>(JS::Lexer("let x = 1;"));
+}
+
+TEST_CASE(parsers_destroyed_in_creation_order)
+{
+    EXPECT(!JS::ASTArena::current());
+
+    auto first = make_parser();
+    auto* first_arena = JS::ASTArena::current();
+    auto second = make_parser();
+    auto* second_arena = JS::ASTArena::current();
+    EXPECT(first_arena);
+    EXPECT(second_arena);
+    EXPECT_NE(first_arena, second_arena);
+
+    first = nullptr;
+    EXPECT_EQ(JS::ASTArena::current(), second_arena);
+    second->parse_program();
+
+    second = nullptr;
+    EXPECT(!JS::ASTArena::current());
+}
+
+TEST_CASE(parsers_destroyed_out_of_order)
+{
+    auto first = make_parser();
+    auto* first_arena = JS::ASTArena::current();
+    auto second = make_parser();
+    auto third = make_parser();
+    auto* third_arena = JS::ASTArena::current();
+
+    second = nullptr;
+    EXPECT_EQ(JS::ASTArena::current(), third_arena);
+    third = nullptr;
+    EXPECT_EQ(JS::ASTArena::current(), first_arena);
+    first = nullptr;
+    EXPECT(!JS::ASTArena::current());
+}
+
+static void* current_arena_on_new_thread(void*)
+{
+    return JS::ASTArena::current();
+}
+
+TEST_CASE(arenas_are_per_thread)
+{
+    auto parser = make_parser();
+    EXPECT(JS::ASTArena::current());
+
+    pthread_t thread;
+    EXPECT_EQ(pthread_create(&thread, nullptr, current_arena_on_new_thread, nullptr), 0);
+    void* arena_on_thread = reinterpret_cast<void*>(1);
+    EXPECT_EQ(pthread_join(thread, &arena_on_thread), 0);
+    EXPECT(!arena_on_thread);
+}
@@ -13,6 +13,7 @@
 #include <LibCore/ArgsParser.h>
 #include <LibCore/DirIterator.h>
 #include <LibCore/File.h>
+#include <LibJS/Bytecode/Interpreter.h>
 #include <LibJS/Interpreter.h>
 #include <LibJS/Lexer.h>
 #include <LibJS/Parser.h>
@@ -30,6 +31,7 @@
 RefPtr<JS::VM> vm;
 
 static bool collect_on_every_allocation = false;
+static bool parse_lazily = false;
 static String currently_running_test;
 
 struct ParserError {
@@ -230,6 +232,7 @@ static Result<NonnullRefPtr<JS::Program>, ParserError> parse_file(const String&
     file->close();
 
     auto parser = JS::Parser(JS::Lexer(test_file_string));
+    parser.set_parse_function_bodies_lazily(parse_lazily);
     auto program = parser.parse_program();
 
     if (parser.has_errors()) {
@@ -679,6 +682,7 @@ int main(int argc, char** argv)
         false;
 #endif
     bool test262_parser_tests = false;
+    bool run_bytecode = false;
     const char* specified_test_root = nullptr;
 
     Core::ArgsParser args_parser;
@@ -700,6 +704,8 @@ int main(int argc, char** argv)
     });
     args_parser.add_option(collect_on_every_allocation, "Collect garbage after every allocation", "collect-often", 'g');
     args_parser.add_option(test262_parser_tests, "Run test262 parser tests", "test262-parser-tests", 0);
+    args_parser.add_option(run_bytecode, "Run the bytecode where possible", "run-bytecode", 'b');
+    args_parser.add_option(parse_lazily, "Only parse function bodies once they're called", "lazy-parse", 0);
     args_parser.add_positional_argument(specified_test_root, "Tests root directory", "path", Core::ArgsParser::Required::No);
     args_parser.parse(argc, argv);
 
@@ -740,6 +746,9 @@ int main(int argc, char** argv)
     }
 
     vm = JS::VM::create();
+    OwnPtr<JS::Bytecode::Interpreter> bytecode_interpreter;
+    if (run_bytecode)
+        bytecode_interpreter = make<JS::Bytecode::Interpreter>(*vm);
 
     Test::Counts result_counts;
     if (test262_parser_tests)
@@ -747,6 +756,7 @@ int main(int argc, char** argv)
     else
         result_counts = TestRunner(test_root, print_times, print_progress).run();
 
+    bytecode_interpreter = nullptr;
     vm = nullptr;
 
     return result_counts.tests_failed > 0 ? 1 : 0;
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/Atomic.h>
+#include <AK/MPMCQueue.h>
+#include <AK/NonnullRefPtrVector.h>
+#include <AK/SPSCQueue.h>
+#include <AK/Vector.h>
+#include <LibThread/ParallelSort.h>
+#include <LibThread/Thread.h>
+#include <LibThread/ThreadPool.h>
+#include <sched.h>
+
+static constexpr size_t items_per_producer = 100000;
+
+TEST_CASE(spsc_queue_across_threads)
+{
+    SPSCQueue<size_t, 64> queue;
+    auto producer = LibThread::Thread::construct([&]() -> intptr_t {
+        for (size_t i = 0; i < items_per_producer; ++i) {
+            while (!queue.try_enqueue(i))
+                sched_yield();
+        }
+        return 0;
+    });
+    producer->start();
+
+    bool in_order = true;
+    for (size_t expected = 0; expected < items_per_producer;) {
+        auto value = queue.try_dequeue();
+        if (!value.has_value()) {
+            sched_yield();
+            continue;
+        }
+        in_order &= value.value() == expected++;
+    }
+    EXPECT(in_order);
+    [[maybe_unused]] auto result = producer->join();
+}
+
+TEST_CASE(mpmc_queue_across_threads)
+{
+    static constexpr size_t producer_count = 4;
+    static constexpr size_t consumer_count = 4;
+    MPMCQueue<size_t, 256> queue;
+    Atomic<size_t> consumed_count { 0 };
+    Atomic<u64> consumed_sum { 0 };
+
+    NonnullRefPtrVector<LibThread::Thread> threads;
+    for (size_t producer = 0; producer < producer_count; ++producer) {
+        threads.append(LibThread::Thread::construct([&]() -> intptr_t {
+            for (size_t i = 1; i <= items_per_producer; ++i) {
+                while (!queue.try_enqueue(i))
+                    sched_yield();
+            }
+            return 0;
+        }));
+    }
+    for (size_t consumer = 0; consumer < consumer_count; ++consumer) {
+        threads.append(LibThread::Thread::construct([&]() -> intptr_t {
+            while (consumed_count.load() < producer_count * items_per_producer) {
+                auto value = queue.try_dequeue();
+                if (!value.has_value()) {
+                    sched_yield();
+                    continue;
+                }
+                consumed_sum += value.value();
+                ++consumed_count;
+            }
+            return 0;
+        }));
+    }
+    for (auto& thread : threads)
+        thread.start();
+    for (auto& thread : threads)
+        [[maybe_unused]] auto result = thread.join();
+
+    EXPECT_EQ(consumed_count.load(), producer_count * items_per_producer);
+    EXPECT_EQ(consumed_sum.load(), producer_count * (items_per_producer * (items_per_producer + 1) / 2));
+    EXPECT(queue.is_empty());
+}
+
+TEST_CASE(thread_pool_runs_every_job)
+{
+    LibThread::ThreadPool pool(4);
+    Atomic<size_t> count { 0 };
+    for (size_t i = 0; i < 10000; ++i)
+        pool.submit([&] { ++count; });
+    pool.wait_for_all();
+    EXPECT_EQ(count.load(), 10000u);
+}
+
+TEST_CASE(thread_pool_jobs_submitting_jobs)
+{
+    LibThread::ThreadPool pool(4);
+    Atomic<size_t> count { 0 };
+    // Enough of them to overflow the workers' own queues, which makes them run some jobs right away.
+    for (size_t i = 0; i < 100; ++i) {
+        pool.submit([&] {
+            for (size_t j = 0; j < 1000; ++j)
+                pool.submit([&] { ++count; });
+        });
+    }
+    pool.wait_for_all();
+    EXPECT_EQ(count.load(), 100000u);
+}
+
+TEST_CASE(parallel_sort_on_the_pool)
+{
+    Vector<u32> values;
+    u32 state = 1;
+    for (size_t i = 0; i < 200000; ++i) {
+        state = state * 1103515245 + 12345;
+        values.append(state >> 8);
+    }
+    LibThread::parallel_sort(values, [](u32 a, u32 b) { return a < b; });
+    bool is_sorted = true;
+    for (size_t i = 1; i < values.size(); ++i)
+        is_sorted &= values[i - 1] <= values[i];
+    EXPECT(is_sorted);
+}
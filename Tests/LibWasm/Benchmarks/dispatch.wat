@@ -0,0 +1,59 @@
+;; Alternates between indirect calls through a table and br_table jumps, like an interpreter loop would.
+(module
+  (type $binary (func (param i32 i32) (result i32)))
+  (table 4 funcref)
+  (elem (i32.const 0) $add $sub $xor $mul)
+  (func $add (type $binary) local.get 0 local.get 1 i32.add)
+  (func $sub (type $binary) local.get 0 local.get 1 i32.sub)
+  (func $xor (type $binary) local.get 0 local.get 1 i32.xor)
+  (func $mul (type $binary) local.get 0 local.get 1 i32.const 1 i32.or i32.mul)
+  (func $dispatch (export "dispatch") (param $n i32) (result i32) (local $i i32) (local $accumulator i32)
+    block $done
+      loop $next
+        local.get $i
+        local.get $n
+        i32.ge_u
+        br_if $done
+        local.get $accumulator
+        local.get $i
+        local.get $i
+        i32.const 3
+        i32.and
+        call_indirect (type $binary)
+        local.set $accumulator
+        block $default
+          block $case2
+            block $case1
+              block $case0
+                local.get $i
+                i32.const 5
+                i32.rem_u
+                br_table $case0 $case1 $case2 $default
+              end
+              local.get $accumulator
+              i32.const 7
+              i32.rotl
+              local.set $accumulator
+              br $default
+            end
+            local.get $accumulator
+            i32.const 0x5bd1e995
+            i32.add
+            local.set $accumulator
+            br $default
+          end
+          local.get $accumulator
+          i32.const 3
+          i32.shr_u
+          local.get $accumulator
+          i32.xor
+          local.set $accumulator
+        end
+        local.get $i
+        i32.const 1
+        i32.add
+        local.set $i
+        br $next
+      end
+    end
+    local.get $accumulator))
@@ -0,0 +1,44 @@
+;; Mixes n outputs of a xorshift64 generator into an FNV-1a style hash, which is all i64 arithmetic.
+(module
+  (func $hash (export "hash") (param $n i32) (result i64) (local $state i64) (local $hash i64)
+    i64.const 0x9E3779B97F4A7C15
+    local.set $state
+    i64.const 0xcbf29ce484222325
+    local.set $hash
+    block $done
+      loop $next
+        local.get $n
+        i32.eqz
+        br_if $done
+        local.get $state
+        local.get $state
+        i64.const 13
+        i64.shl
+        i64.xor
+        local.tee $state
+        local.get $state
+        i64.const 7
+        i64.shr_u
+        i64.xor
+        local.tee $state
+        local.get $state
+        i64.const 17
+        i64.shl
+        i64.xor
+        local.set $state
+        local.get $hash
+        local.get $state
+        i64.xor
+        i64.const 0x100000001b3
+        i64.mul
+        i64.const 5
+        i64.rotl
+        local.set $hash
+        local.get $n
+        i32.const 1
+        i32.sub
+        local.set $n
+        br $next
+      end
+    end
+    local.get $hash))
@@ -0,0 +1,104 @@
+;; Counts the points of a size by size grid over [-2, 0.5] x [-1.25, 1.25] that stay bounded for max_iterations.
+(module
+  (func $mandelbrot (export "mandelbrot") (param $size i32) (param $max_iterations i32) (result i32)
+    (local $x i32) (local $y i32) (local $iteration i32) (local $count i32)
+    (local $cr f64) (local $ci f64) (local $zr f64) (local $zi f64) (local $zr2 f64) (local $zi2 f64)
+    block $done
+      loop $rows
+        local.get $y
+        local.get $size
+        i32.ge_s
+        br_if $done
+        local.get $y
+        f64.convert_i32_s
+        f64.const 2.5
+        f64.mul
+        local.get $size
+        f64.convert_i32_s
+        f64.div
+        f64.const 1.25
+        f64.sub
+        local.set $ci
+        i32.const 0
+        local.set $x
+        block $row_done
+          loop $columns
+            local.get $x
+            local.get $size
+            i32.ge_s
+            br_if $row_done
+            local.get $x
+            f64.convert_i32_s
+            f64.const 2.5
+            f64.mul
+            local.get $size
+            f64.convert_i32_s
+            f64.div
+            f64.const 2
+            f64.sub
+            local.set $cr
+            f64.const 0
+            local.tee $zr
+            local.set $zi
+            i32.const 0
+            local.set $iteration
+            block $escaped
+              loop $iterate
+                local.get $iteration
+                local.get $max_iterations
+                i32.ge_s
+                if
+                  local.get $count
+                  i32.const 1
+                  i32.add
+                  local.set $count
+                  br $escaped
+                end
+                local.get $zr
+                local.get $zr
+                f64.mul
+                local.tee $zr2
+                local.get $zi
+                local.get $zi
+                f64.mul
+                local.tee $zi2
+                f64.add
+                f64.const 4
+                f64.gt
+                br_if $escaped
+                f64.const 2
+                local.get $zr
+                f64.mul
+                local.get $zi
+                f64.mul
+                local.get $ci
+                f64.add
+                local.set $zi
+                local.get $zr2
+                local.get $zi2
+                f64.sub
+                local.get $cr
+                f64.add
+                local.set $zr
+                local.get $iteration
+                i32.const 1
+                i32.add
+                local.set $iteration
+                br $iterate
+              end
+            end
+            local.get $x
+            i32.const 1
+            i32.add
+            local.set $x
+            br $columns
+          end
+        end
+        local.get $y
+        i32.const 1
+        i32.add
+        local.set $y
+        br $rows
+      end
+    end
+    local.get $count))
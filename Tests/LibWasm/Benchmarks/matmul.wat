@@ -0,0 +1,165 @@
+;; Multiplies two n by n matrices of f64s stored in linear memory and returns the sum of the product's elements.
+(module
+  (memory 1)
+  (func $matmul (export "matmul") (param $n i32) (result f64)
+    (local $i i32) (local $j i32) (local $k i32) (local $a i32) (local $b i32) (local $c i32) (local $pages i32)
+    (local $sum f64) (local $total f64)
+    ;; a, b and c each take n * n * 8 bytes.
+    local.get $n
+    local.get $n
+    i32.mul
+    i32.const 3
+    i32.shl
+    local.tee $b
+    local.get $b
+    i32.add
+    local.tee $c
+    local.get $b
+    i32.add
+    i32.const 65535
+    i32.add
+    i32.const 16
+    i32.shr_u
+    memory.size
+    i32.sub
+    local.tee $pages
+    i32.const 0
+    i32.gt_s
+    if
+      local.get $pages
+      memory.grow
+      i32.const -1
+      i32.eq
+      if
+        unreachable
+      end
+    end
+    ;; a[i][j] = ((i * n + j) % 13) / 4, b[i][j] = ((i + 2 * j) % 11) - 3
+    i32.const 0
+    local.set $i
+    loop $fill_rows
+      i32.const 0
+      local.set $j
+      loop $fill_columns
+        local.get $i
+        local.get $n
+        i32.mul
+        local.get $j
+        i32.add
+        i32.const 3
+        i32.shl
+        local.tee $k
+        local.get $i
+        local.get $n
+        i32.mul
+        local.get $j
+        i32.add
+        i32.const 13
+        i32.rem_u
+        f64.convert_i32_u
+        f64.const 0.25
+        f64.mul
+        f64.store
+        local.get $k
+        local.get $b
+        i32.add
+        local.get $i
+        local.get $j
+        i32.const 1
+        i32.shl
+        i32.add
+        i32.const 11
+        i32.rem_u
+        f64.convert_i32_u
+        f64.const 3
+        f64.sub
+        f64.store
+        local.get $j
+        i32.const 1
+        i32.add
+        local.tee $j
+        local.get $n
+        i32.lt_u
+        br_if $fill_columns
+      end
+      local.get $i
+      i32.const 1
+      i32.add
+      local.tee $i
+      local.get $n
+      i32.lt_u
+      br_if $fill_rows
+    end
+    i32.const 0
+    local.set $i
+    loop $rows
+      i32.const 0
+      local.set $j
+      loop $columns
+        f64.const 0
+        local.set $sum
+        i32.const 0
+        local.set $k
+        loop $dot
+          local.get $sum
+          local.get $i
+          local.get $n
+          i32.mul
+          local.get $k
+          i32.add
+          i32.const 3
+          i32.shl
+          f64.load
+          local.get $k
+          local.get $n
+          i32.mul
+          local.get $j
+          i32.add
+          i32.const 3
+          i32.shl
+          local.get $b
+          i32.add
+          f64.load
+          f64.mul
+          f64.add
+          local.set $sum
+          local.get $k
+          i32.const 1
+          i32.add
+          local.tee $k
+          local.get $n
+          i32.lt_u
+          br_if $dot
+        end
+        local.get $i
+        local.get $n
+        i32.mul
+        local.get $j
+        i32.add
+        i32.const 3
+        i32.shl
+        local.get $c
+        i32.add
+        local.get $sum
+        f64.store
+        local.get $total
+        local.get $sum
+        f64.add
+        local.set $total
+        local.get $j
+        i32.const 1
+        i32.add
+        local.tee $j
+        local.get $n
+        i32.lt_u
+        br_if $columns
+      end
+      local.get $i
+      i32.const 1
+      i32.add
+      local.tee $i
+      local.get $n
+      i32.lt_u
+      br_if $rows
+    end
+    local.get $total))
@@ -0,0 +1,95 @@
+;; Counts the primes below n with a sieve of Eratosthenes kept in linear memory, one byte per number.
+(module
+  (memory 1)
+  (func $sieve (export "sieve") (param $n i32) (result i32) (local $i i32) (local $j i32) (local $count i32)
+    ;; Make room for n bytes.
+    local.get $n
+    i32.const 65535
+    i32.add
+    i32.const 16
+    i32.shr_u
+    memory.size
+    i32.sub
+    local.tee $i
+    i32.const 0
+    i32.gt_s
+    if
+      local.get $i
+      memory.grow
+      i32.const -1
+      i32.eq
+      if
+        unreachable
+      end
+    end
+    i32.const 0
+    local.set $i
+    block $cleared
+      loop $clear
+        local.get $i
+        local.get $n
+        i32.ge_u
+        br_if $cleared
+        local.get $i
+        i32.const 0
+        i32.store8
+        local.get $i
+        i32.const 1
+        i32.add
+        local.set $i
+        br $clear
+      end
+    end
+    i32.const 2
+    local.set $i
+    block $done
+      loop $next
+        local.get $i
+        local.get $n
+        i32.ge_u
+        br_if $done
+        local.get $i
+        i32.load8_u
+        i32.eqz
+        if
+          local.get $count
+          i32.const 1
+          i32.add
+          local.set $count
+          ;; Only cross off multiples when i * i doesn't overflow past n.
+          local.get $i
+          local.get $n
+          local.get $i
+          i32.div_u
+          i32.le_u
+          if
+            local.get $i
+            local.get $i
+            i32.mul
+            local.set $j
+            block $crossed
+              loop $cross
+                local.get $j
+                local.get $n
+                i32.ge_u
+                br_if $crossed
+                local.get $j
+                i32.const 1
+                i32.store8
+                local.get $j
+                local.get $i
+                i32.add
+                local.set $j
+                br $cross
+              end
+            end
+          end
+        end
+        local.get $i
+        i32.const 1
+        i32.add
+        local.set $i
+        br $next
+      end
+    end
+    local.get $count))
@@ -125,7 +125,7 @@ private:
         busy = 0;
         idle = 0;
 
-        auto all_processes = Core::ProcessStatisticsReader::get_all(m_proc_all);
+        auto all_processes = Core::ProcessStatisticsReader::get_all(m_proc_processes);
         if (!all_processes.has_value() || all_processes.value().is_empty())
             return false;
 
@@ -177,7 +177,7 @@ private:
     unsigned m_last_cpu_busy { 0 };
     unsigned m_last_cpu_idle { 0 };
     String m_tooltip;
-    RefPtr<Core::File> m_proc_all;
+    Core::ProcessStatisticsReader::ProcessesFile m_proc_processes;
     RefPtr<Core::File> m_proc_mem;
 };
 
@@ -247,7 +247,7 @@ int main(int argc, char** argv)
         return 1;
     }
 
-    if (unveil("/proc/all", "r") < 0) {
+    if (unveil("/proc/processes", "r") < 0) {
         perror("unveil");
         return 1;
     }
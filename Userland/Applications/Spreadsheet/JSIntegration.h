@@ -56,6 +56,9 @@ public:
 
 private:
     virtual void visit_edges(Visitor&) override;
+    // The sheets come and go without the heap hearing about it.
+    virtual bool has_write_barrier() const override { return false; }
+
     Workbook& m_workbook;
 };
 
@@ -31,7 +31,7 @@ MemoryStatsWidget::MemoryStatsWidget(GraphWidget& graph)
     VERIFY(!s_the);
     s_the = this;
 
-    set_fixed_height(110);
+    set_fixed_height(140);
 
     set_layout<GUI::VerticalBoxLayout>();
     layout()->set_margins({ 0, 8, 0, 0 });
@@ -52,6 +52,8 @@ MemoryStatsWidget::MemoryStatsWidget(GraphWidget& graph)
     m_user_physical_pages_label = build_widgets_for_label("Physical memory:");
     m_user_physical_pages_committed_label = build_widgets_for_label("Committed memory:");
     m_supervisor_physical_pages_label = build_widgets_for_label("Supervisor physical:");
+    m_compressed_pages_label = build_widgets_for_label("Compressed memory:");
+    m_swap_label = build_widgets_for_label("Swap:");
     m_kmalloc_space_label = build_widgets_for_label("Kernel heap:");
     m_kmalloc_count_label = build_widgets_for_label("Calls kmalloc:");
     m_kfree_count_label = build_widgets_for_label("Calls kfree:");
@@ -94,6 +96,10 @@ void MemoryStatsWidget::refresh()
     unsigned user_physical_uncommitted = json.get("user_physical_uncommitted").to_u32();
     unsigned super_physical_alloc = json.get("super_physical_allocated").to_u32();
     unsigned super_physical_free = json.get("super_physical_available").to_u32();
+    unsigned compressed_pages = json.get("compressed_pages").to_u32();
+    unsigned compressed_bytes = json.get("compressed_bytes").to_u32();
+    unsigned swap_total = json.get("swap_total").to_u32();
+    unsigned swap_used = json.get("swap_used").to_u32();
     unsigned kmalloc_call_count = json.get("kmalloc_call_count").to_u32();
     unsigned kfree_call_count = json.get("kfree_call_count").to_u32();
 
@@ -109,6 +115,11 @@ void MemoryStatsWidget::refresh()
     m_user_physical_pages_label->set_text(String::formatted("{}K/{}K", page_count_to_kb(physical_pages_in_use), page_count_to_kb(physical_pages_total)));
     m_user_physical_pages_committed_label->set_text(String::formatted("{}K", page_count_to_kb(user_physical_committed)));
     m_supervisor_physical_pages_label->set_text(String::formatted("{}K/{}K", page_count_to_kb(super_physical_alloc), page_count_to_kb(supervisor_pages_total)));
+    if (compressed_bytes > 0)
+        m_compressed_pages_label->set_text(String::formatted("{}K in {}K ({:.1}x)", page_count_to_kb(compressed_pages), bytes_to_kb(compressed_bytes), (float)compressed_pages * 4096 / compressed_bytes));
+    else
+        m_compressed_pages_label->set_text("0K");
+    m_swap_label->set_text(String::formatted("{}K/{}K", page_count_to_kb(swap_used), page_count_to_kb(swap_total)));
     m_kmalloc_count_label->set_text(String::formatted("{}", kmalloc_call_count));
     m_kfree_count_label->set_text(String::formatted("{}", kfree_call_count));
     m_kmalloc_difference_label->set_text(String::formatted("{:+}", kmalloc_call_count - kfree_call_count));
@@ -26,6 +26,8 @@ private:
     RefPtr<GUI::Label> m_user_physical_pages_label;
     RefPtr<GUI::Label> m_user_physical_pages_committed_label;
     RefPtr<GUI::Label> m_supervisor_physical_pages_label;
+    RefPtr<GUI::Label> m_compressed_pages_label;
+    RefPtr<GUI::Label> m_swap_label;
     RefPtr<GUI::Label> m_kmalloc_space_label;
     RefPtr<GUI::Label> m_kmalloc_count_label;
     RefPtr<GUI::Label> m_kfree_count_label;
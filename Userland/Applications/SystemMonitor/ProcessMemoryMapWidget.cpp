@@ -34,6 +34,10 @@ public:
                 color = Color::from_rgb(0xc0c0ff);
             else if (c == 'P') // Physical (a resident page)
                 color = Color::Black;
+            else if (c == 'C') // Compressed (an anonymous page that was compressed out of physical memory.)
+                color = Color::from_rgb(0x808080);
+            else if (c == 'S') // Swapped (an anonymous page that was written out to swap.)
+                color = Color::from_rgb(0xc0c0c0);
             else
                 VERIFY_NOT_REACHED();
 
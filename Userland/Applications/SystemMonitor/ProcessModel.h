@@ -10,6 +10,7 @@
 #include <AK/NonnullOwnPtrVector.h>
 #include <AK/String.h>
 #include <AK/Vector.h>
+#include <LibCore/ProcessStatisticsReader.h>
 #include <LibGUI/Model.h>
 #include <unistd.h>
 
@@ -126,6 +127,6 @@ private:
     HashMap<int, NonnullOwnPtr<Thread>> m_threads;
     NonnullOwnPtrVector<CpuInfo> m_cpus;
     Vector<int> m_tids;
-    RefPtr<Core::File> m_proc_all;
+    Core::ProcessStatisticsReader::ProcessesFile m_proc_processes;
     GUI::Icon m_kernel_process_icon;
 };
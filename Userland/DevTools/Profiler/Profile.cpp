@@ -9,6 +9,7 @@
 #include "ProfileModel.h"
 #include "SamplesModel.h"
 #include <AK/HashTable.h>
+#include <AK/JsonValueView.h>
 #include <AK/LexicalPath.h>
 #include <AK/MappedFile.h>
 #include <AK/NonnullOwnPtrVector.h>
@@ -201,30 +202,26 @@ Result<NonnullOwnPtr<Profile>, String> Profile::load_from_perfcore_file(const St
     if (!file->open(Core::OpenMode::ReadOnly))
         return String::formatted("Unable to open {}, error: {}", path, file->error_string());
 
-    auto json = JsonValue::from_string(file->read_all());
-    if (!json.has_value() || !json.value().is_object())
+    // Profiles can get big, so don't build a JsonValue for every event and stack frame; just pick out what we need.
+    auto file_contents = file->read_all();
+    auto json = JsonValueView::from_string({ file_contents.data(), file_contents.size() });
+    if (!json.has_value() || !json->is_object())
         return String { "Invalid perfcore format (not a JSON object)" };
 
-    auto& object = json.value().as_object();
-
     auto file_or_error = MappedFile::map("/boot/Kernel");
     OwnPtr<ELF::Image> kernel_elf;
     if (!file_or_error.is_error())
         kernel_elf = make<ELF::Image>(file_or_error.value()->bytes());
 
-    auto events_value = object.get_ptr("events");
-    if (!events_value || !events_value->is_array())
+    auto perf_events = json->get("events");
+    if (!perf_events.is_array())
         return String { "Malformed profile (events is not an array)" };
 
-    auto& perf_events = events_value->as_array();
-
     NonnullOwnPtrVector<Process> all_processes;
     HashMap<pid_t, Process*> current_processes;
     Vector<Event> events;
 
-    for (auto& perf_event_value : perf_events.values()) {
-        auto& perf_event = perf_event_value.as_object();
-
+    perf_events.for_each_value([&](JsonValueView perf_event) {
         Event event;
 
         event.timestamp = perf_event.get("timestamp").to_number<u64>();
@@ -246,11 +243,11 @@ Result<NonnullOwnPtr<Profile>, String> Profile::load_from_perfcore_file(const St
             auto it = current_processes.find(event.pid);
             if (it != current_processes.end())
                 it->value->library_metadata.handle_mmap(event.ptr, event.size, event.name);
-            continue;
+            return;
         } else if (event.type == "munmap"sv) {
             event.ptr = perf_event.get("ptr").to_number<FlatPtr>();
             event.size = perf_event.get("size").to_number<size_t>();
-            continue;
+            return;
         } else if (event.type == "process_create"sv) {
             event.parent_pid = perf_event.get("parent_pid").to_number<FlatPtr>();
             event.executable = perf_event.get("executable").to_string();
@@ -263,7 +260,7 @@ Result<NonnullOwnPtr<Profile>, String> Profile::load_from_perfcore_file(const St
 
             current_processes.set(sampled_process->pid, sampled_process);
             all_processes.append(move(sampled_process));
-            continue;
+            return;
         } else if (event.type == "process_exec"sv) {
             event.executable = perf_event.get("executable").to_string();
 
@@ -279,32 +276,34 @@ Result<NonnullOwnPtr<Profile>, String> Profile::load_from_perfcore_file(const St
 
             current_processes.set(sampled_process->pid, sampled_process);
             all_processes.append(move(sampled_process));
-            continue;
+            return;
         } else if (event.type == "process_exit"sv) {
             auto old_process = current_processes.get(event.pid).value();
             old_process->end_valid = event.timestamp - 1;
 
             current_processes.remove(event.pid);
-            continue;
+            return;
         } else if (event.type == "thread_create"sv) {
             event.parent_tid = perf_event.get("parent_tid").to_i32();
             auto it = current_processes.find(event.pid);
             if (it != current_processes.end())
                 it->value->handle_thread_create(event.tid, event.timestamp);
-            continue;
+            return;
         } else if (event.type == "thread_exit"sv) {
             auto it = current_processes.find(event.pid);
             if (it != current_processes.end())
                 it->value->handle_thread_exit(event.tid, event.timestamp);
-            continue;
+            return;
         }
 
-        auto* stack = perf_event.get_ptr("stack");
-        VERIFY(stack);
-        auto& stack_array = stack->as_array();
-        for (ssize_t i = stack_array.values().size() - 1; i >= 0; --i) {
-            auto& frame = stack_array.at(i);
-            auto ptr = frame.to_number<u32>();
+        auto stack = perf_event.get("stack");
+        VERIFY(stack.is_array());
+        Vector<u32, 64> stack_addresses;
+        stack.for_each_value([&](JsonValueView frame) {
+            stack_addresses.append(frame.to_number<u32>());
+        });
+        for (ssize_t i = stack_addresses.size() - 1; i >= 0; --i) {
+            auto ptr = stack_addresses[i];
             u32 offset = 0;
             FlyString object_name;
             String symbol;
@@ -333,13 +332,13 @@ Result<NonnullOwnPtr<Profile>, String> Profile::load_from_perfcore_file(const St
         }
 
         if (event.frames.size() < 2)
-            continue;
+            return;
 
         FlatPtr innermost_frame_address = event.frames.at(1).address;
         event.in_kernel = innermost_frame_address >= 0xc0000000;
 
         events.append(move(event));
-    }
+    });
 
     if (events.is_empty())
         return String { "No events captured (targeted process was never on CPU)" };
@@ -89,6 +89,16 @@ int purge(int mode)
     __RETURN_WITH_ERRNO(rc, rc, -1);
 }
 
+int swapon(const char* path, size_t size)
+{
+    if (!path) {
+        errno = EFAULT;
+        return -1;
+    }
+    int rc = syscall(SC_swapon, path, strlen(path), size);
+    __RETURN_WITH_ERRNO(rc, rc, -1);
+}
+
 int perf_event(int type, uintptr_t arg1, FlatPtr arg2)
 {
     int rc = syscall(SC_perf_event, type, arg1, arg2);
@@ -75,6 +75,8 @@ int futex(uint32_t* userspace_address, int futex_op, uint32_t value, const struc
 
 int purge(int mode);
 
+int swapon(const char* path, size_t size);
+
 enum {
     PERF_EVENT_SAMPLE,
     PERF_EVENT_MALLOC,
@@ -34,15 +34,9 @@ cont:
 
 size_t strcspn(const char* s, const char* reject)
 {
-    for (auto* p = s;;) {
-        char c = *p++;
-        auto* rp = reject;
-        char rc;
-        do {
-            if ((rc = *rp++) == c)
-                return p - 1 - s;
-        } while (rc);
-    }
+    size_t length = strlen(s);
+    auto* match = static_cast<const char*>(AK::find_any_of(s, length, reject, strlen(reject)));
+    return match ? match - s : length;
 }
 
 size_t strlen(const char* str)
@@ -233,13 +227,12 @@ char* strchrnul(const char* str, int c)
 
 void* memchr(const void* ptr, int c, size_t size)
 {
-    char ch = c;
-    auto* cptr = (const char*)ptr;
-    for (size_t i = 0; i < size; ++i) {
-        if (cptr[i] == ch)
-            return const_cast<char*>(cptr + i);
-    }
-    return nullptr;
+    return const_cast<void*>(AK::memchr(ptr, c, size));
+}
+
+void* memrchr(const void* ptr, int c, size_t size)
+{
+    return const_cast<void*>(AK::memrchr(ptr, c, size));
 }
 
 char* strrchr(const char* str, int ch)
@@ -374,28 +367,12 @@ char* strsignal(int signum)
 
 char* strstr(const char* haystack, const char* needle)
 {
-    char nch;
-    char hch;
-
-    if ((nch = *needle++) != 0) {
-        size_t len = strlen(needle);
-        do {
-            do {
-                if ((hch = *haystack++) == 0)
-                    return nullptr;
-            } while (hch != nch);
-        } while (strncmp(haystack, needle, len) != 0);
-        --haystack;
-    }
-    return const_cast<char*>(haystack);
+    return const_cast<char*>(static_cast<const char*>(AK::memmem(haystack, strlen(haystack), needle, strlen(needle))));
 }
 
 char* strpbrk(const char* s, const char* accept)
 {
-    while (*s)
-        if (strchr(accept, *s++))
-            return const_cast<char*>(--s);
-    return nullptr;
+    return const_cast<char*>(static_cast<const char*>(AK::find_any_of(s, strlen(s), accept, strlen(accept))));
 }
 
 char* strtok_r(char* str, const char* delim, char** saved_str)
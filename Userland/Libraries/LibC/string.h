@@ -21,6 +21,7 @@ int memcmp(const void*, const void*, size_t);
 void* memcpy(void*, const void*, size_t);
 void* memmove(void*, const void*, size_t);
 void* memchr(const void*, int c, size_t);
+void* memrchr(const void*, int c, size_t);
 const void* memmem(const void* haystack, size_t, const void* needle, size_t);
 
 void* memset(void*, int, size_t);
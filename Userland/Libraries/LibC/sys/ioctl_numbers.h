@@ -56,6 +56,8 @@ enum IOCtlNumber {
     SIOCDELRT,
     FIBMAP,
     FIONBIO,
+    TRACE_IOCTL_GET_CATEGORIES,
+    TRACE_IOCTL_SET_CATEGORIES,
 };
 
 #define TIOCGPGRP TIOCGPGRP
@@ -88,3 +90,5 @@ enum IOCtlNumber {
 #define SIOCDELRT SIOCDELRT
 #define FIBMAP FIBMAP
 #define FIONBIO FIONBIO
+#define TRACE_IOCTL_GET_CATEGORIES TRACE_IOCTL_GET_CATEGORIES
+#define TRACE_IOCTL_SET_CATEGORIES TRACE_IOCTL_SET_CATEGORIES
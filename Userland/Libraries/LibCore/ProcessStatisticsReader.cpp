@@ -5,104 +5,162 @@
  */
 
 #include <AK/ByteBuffer.h>
-#include <AK/JsonArray.h>
-#include <AK/JsonObject.h>
-#include <AK/JsonValue.h>
+#include <Kernel/API/ProcessStatistics.h>
 #include <LibCore/File.h>
 #include <LibCore/ProcessStatisticsReader.h>
 #include <pwd.h>
 #include <stdio.h>
+#include <string.h>
 
 namespace Core {
 
 HashMap<uid_t, String> ProcessStatisticsReader::s_usernames;
 
-Optional<HashMap<pid_t, Core::ProcessStatistics>> ProcessStatisticsReader::get_all(RefPtr<Core::File>& proc_all_file)
+template<typename T>
+static bool read_record(const ByteBuffer& buffer, size_t& offset, T& record)
 {
-    if (proc_all_file) {
-        if (!proc_all_file->seek(0, Core::SeekMode::SetPosition)) {
-            fprintf(stderr, "ProcessStatisticsReader: Failed to refresh /proc/all: %s\n", proc_all_file->error_string());
+    if (offset + sizeof(T) > buffer.size())
+        return false;
+    memcpy(&record, buffer.data() + offset, sizeof(T));
+    offset += sizeof(T);
+    return true;
+}
+
+template<size_t Size>
+static String from_fixed_string(const char (&string)[Size])
+{
+    return String(string, strnlen(string, Size));
+}
+
+Optional<HashMap<pid_t, Core::ProcessStatistics>> ProcessStatisticsReader::get_all(ProcessesFile& proc_processes)
+{
+    auto& file = proc_processes.file;
+    if (file) {
+        if (!file->seek(0, Core::SeekMode::SetPosition)) {
+            fprintf(stderr, "ProcessStatisticsReader: Failed to refresh /proc/processes: %s\n", file->error_string());
             return {};
         }
     } else {
-        proc_all_file = Core::File::construct("/proc/all");
-        if (!proc_all_file->open(Core::OpenMode::ReadOnly)) {
-            fprintf(stderr, "ProcessStatisticsReader: Failed to open /proc/all: %s\n", proc_all_file->error_string());
+        file = Core::File::construct("/proc/processes");
+        if (!file->open(Core::OpenMode::ReadOnly)) {
+            fprintf(stderr, "ProcessStatisticsReader: Failed to open /proc/processes: %s\n", file->error_string());
             return {};
         }
     }
 
-    HashMap<pid_t, Core::ProcessStatistics> map;
+    auto map = parse_processes(file->read_all(), move(proc_processes.previous_statistics));
+    if (!map.has_value()) {
+        // Start over with a fresh file description, which gives us everything again.
+        proc_processes = {};
+        return {};
+    }
 
-    auto file_contents = proc_all_file->read_all();
-    auto json = JsonValue::from_string(file_contents);
-    if (!json.has_value())
+    proc_processes.previous_statistics = map.value();
+    return map;
+}
+
+Optional<HashMap<pid_t, Core::ProcessStatistics>> ProcessStatisticsReader::parse_processes(const ByteBuffer& file_contents, HashMap<pid_t, Core::ProcessStatistics> previous_statistics)
+{
+    size_t offset = 0;
+    ProcessStatisticsHeader header;
+    if (!read_record(file_contents, offset, header))
         return {};
-    json.value().as_array().for_each([&](auto& value) {
-        const JsonObject& process_object = value.as_object();
+
+    // Unless this is the first read through the file, it only has what changed since the previous read.
+    if (header.since_generation != 0 && previous_statistics.is_empty())
+        return {};
+
+    HashMap<pid_t, Core::ProcessStatistics> map;
+    for (u32 i = 0; i < header.changed_process_count; ++i) {
+        ProcessStatisticsEntry entry;
+        if (!read_record(file_contents, offset, entry))
+            return {};
+
         Core::ProcessStatistics process;
 
         // kernel data first
-        process.pid = process_object.get("pid").to_u32();
-        process.pgid = process_object.get("pgid").to_u32();
-        process.pgp = process_object.get("pgp").to_u32();
-        process.sid = process_object.get("sid").to_u32();
-        process.uid = process_object.get("uid").to_u32();
-        process.gid = process_object.get("gid").to_u32();
-        process.ppid = process_object.get("ppid").to_u32();
-        process.nfds = process_object.get("nfds").to_u32();
-        process.kernel = process_object.get("kernel").to_bool();
-        process.name = process_object.get("name").to_string();
-        process.executable = process_object.get("executable").to_string();
-        process.tty = process_object.get("tty").to_string();
-        process.pledge = process_object.get("pledge").to_string();
-        process.veil = process_object.get("veil").to_string();
-        process.amount_virtual = process_object.get("amount_virtual").to_u32();
-        process.amount_resident = process_object.get("amount_resident").to_u32();
-        process.amount_shared = process_object.get("amount_shared").to_u32();
-        process.amount_dirty_private = process_object.get("amount_dirty_private").to_u32();
-        process.amount_clean_inode = process_object.get("amount_clean_inode").to_u32();
-        process.amount_purgeable_volatile = process_object.get("amount_purgeable_volatile").to_u32();
-        process.amount_purgeable_nonvolatile = process_object.get("amount_purgeable_nonvolatile").to_u32();
-
-        auto& thread_array = process_object.get_ptr("threads")->as_array();
-        process.threads.ensure_capacity(thread_array.size());
-        thread_array.for_each([&](auto& value) {
-            auto& thread_object = value.as_object();
+        process.pid = entry.pid;
+        process.pgid = entry.pgid;
+        process.pgp = entry.pgp;
+        process.sid = entry.sid;
+        process.uid = entry.uid;
+        process.gid = entry.gid;
+        process.ppid = entry.ppid;
+        process.nfds = entry.nfds;
+        process.kernel = entry.flags & ProcessStatisticsFlagKernel;
+        process.name = from_fixed_string(entry.name);
+        process.executable = from_fixed_string(entry.executable);
+        process.tty = from_fixed_string(entry.tty);
+        process.pledge = from_fixed_string(entry.pledge);
+        process.veil = from_fixed_string(entry.veil);
+        process.amount_virtual = entry.amount_virtual;
+        process.amount_resident = entry.amount_resident;
+        process.amount_shared = entry.amount_shared;
+        process.amount_dirty_private = entry.amount_dirty_private;
+        process.amount_clean_inode = entry.amount_clean_inode;
+        process.amount_purgeable_volatile = entry.amount_purgeable_volatile;
+        process.amount_purgeable_nonvolatile = entry.amount_purgeable_nonvolatile;
+
+        process.threads.ensure_capacity(entry.thread_count);
+        for (u32 j = 0; j < entry.thread_count; ++j) {
+            ThreadStatisticsEntry thread_entry;
+            if (!read_record(file_contents, offset, thread_entry))
+                return {};
             Core::ThreadStatistics thread;
-            thread.tid = thread_object.get("tid").to_u32();
-            thread.times_scheduled = thread_object.get("times_scheduled").to_u32();
-            thread.name = thread_object.get("name").to_string();
-            thread.state = thread_object.get("state").to_string();
-            thread.ticks_user = thread_object.get("ticks_user").to_u32();
-            thread.ticks_kernel = thread_object.get("ticks_kernel").to_u32();
-            thread.cpu = thread_object.get("cpu").to_u32();
-            thread.priority = thread_object.get("priority").to_u32();
-            thread.syscall_count = thread_object.get("syscall_count").to_u32();
-            thread.inode_faults = thread_object.get("inode_faults").to_u32();
-            thread.zero_faults = thread_object.get("zero_faults").to_u32();
-            thread.cow_faults = thread_object.get("cow_faults").to_u32();
-            thread.unix_socket_read_bytes = thread_object.get("unix_socket_read_bytes").to_u32();
-            thread.unix_socket_write_bytes = thread_object.get("unix_socket_write_bytes").to_u32();
-            thread.ipv4_socket_read_bytes = thread_object.get("ipv4_socket_read_bytes").to_u32();
-            thread.ipv4_socket_write_bytes = thread_object.get("ipv4_socket_write_bytes").to_u32();
-            thread.file_read_bytes = thread_object.get("file_read_bytes").to_u32();
-            thread.file_write_bytes = thread_object.get("file_write_bytes").to_u32();
+            thread.tid = thread_entry.tid;
+            thread.times_scheduled = thread_entry.times_scheduled;
+            thread.name = from_fixed_string(thread_entry.name);
+            thread.state = from_fixed_string(thread_entry.state);
+            thread.ticks_user = thread_entry.ticks_user;
+            thread.ticks_kernel = thread_entry.ticks_kernel;
+            thread.cpu = thread_entry.cpu;
+            thread.priority = thread_entry.priority;
+            thread.syscall_count = thread_entry.syscall_count;
+            thread.inode_faults = thread_entry.inode_faults;
+            thread.zero_faults = thread_entry.zero_faults;
+            thread.cow_faults = thread_entry.cow_faults;
+            thread.unix_socket_read_bytes = thread_entry.unix_socket_read_bytes;
+            thread.unix_socket_write_bytes = thread_entry.unix_socket_write_bytes;
+            thread.ipv4_socket_read_bytes = thread_entry.ipv4_socket_read_bytes;
+            thread.ipv4_socket_write_bytes = thread_entry.ipv4_socket_write_bytes;
+            thread.file_read_bytes = thread_entry.file_read_bytes;
+            thread.file_write_bytes = thread_entry.file_write_bytes;
             process.threads.append(move(thread));
-        });
+        }
 
         // and synthetic data last
         process.username = username_from_uid(process.uid);
-        map.set(process.pid, process);
-    });
+        map.set(process.pid, move(process));
+    }
+
+    for (u32 i = 0; i < header.unchanged_process_count; ++i) {
+        UnchangedProcessStatisticsEntry entry;
+        if (!read_record(file_contents, offset, entry))
+            return {};
+        auto it = previous_statistics.find(entry.pid);
+        if (it == previous_statistics.end())
+            return {};
+        auto& process = it->value;
+        process.pgid = entry.pgid;
+        process.amount_virtual = entry.amount_virtual;
+        process.amount_resident = entry.amount_resident;
+        process.amount_shared = entry.amount_shared;
+        process.amount_dirty_private = entry.amount_dirty_private;
+        process.amount_clean_inode = entry.amount_clean_inode;
+        process.amount_purgeable_volatile = entry.amount_purgeable_volatile;
+        process.amount_purgeable_nonvolatile = entry.amount_purgeable_nonvolatile;
+        map.set(entry.pid, move(process));
+    }
 
+    if (offset != file_contents.size())
+        return {};
     return map;
 }
 
 Optional<HashMap<pid_t, Core::ProcessStatistics>> ProcessStatisticsReader::get_all()
 {
-    RefPtr<Core::File> proc_all_file;
-    return get_all(proc_all_file);
+    ProcessesFile proc_processes;
+    return get_all(proc_processes);
 }
 
 String ProcessStatisticsReader::username_from_uid(uid_t uid)
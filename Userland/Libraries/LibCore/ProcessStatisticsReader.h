@@ -35,7 +35,7 @@ struct ThreadStatistics {
 };
 
 struct ProcessStatistics {
-    // Keep this in sync with /proc/all.
+    // Keep this in sync with /proc/processes.
     // From the kernel side:
     pid_t pid;
     pid_t pgid;
@@ -67,10 +67,18 @@ struct ProcessStatistics {
 
 class ProcessStatisticsReader {
 public:
-    static Optional<HashMap<pid_t, Core::ProcessStatistics>> get_all(RefPtr<Core::File>&);
+    // Keeps /proc/processes open across refreshes, along with what was read through it the last time,
+    // since later reads only tell us what changed.
+    struct ProcessesFile {
+        RefPtr<Core::File> file;
+        HashMap<pid_t, Core::ProcessStatistics> previous_statistics;
+    };
+
+    static Optional<HashMap<pid_t, Core::ProcessStatistics>> get_all(ProcessesFile&);
     static Optional<HashMap<pid_t, Core::ProcessStatistics>> get_all();
 
 private:
+    static Optional<HashMap<pid_t, Core::ProcessStatistics>> parse_processes(const ByteBuffer&, HashMap<pid_t, Core::ProcessStatistics> previous_statistics);
     static String username_from_uid(uid_t);
     static HashMap<uid_t, String> s_usernames;
 };
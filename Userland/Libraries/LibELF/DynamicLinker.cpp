@@ -25,8 +25,10 @@
 #include <LibELF/DynamicLoader.h>
 #include <LibELF/DynamicObject.h>
 #include <LibELF/Hashes.h>
+#include <LibELF/PrelinkCache.h>
 #include <fcntl.h>
 #include <string.h>
+#include <sys/stat.h>
 #include <sys/types.h>
 #include <syscall.h>
 
@@ -35,6 +37,18 @@ namespace ELF {
 static HashMap<String, NonnullRefPtr<ELF::DynamicLoader>> s_loaders;
 static String s_main_program_name;
 static HashMap<String, NonnullRefPtr<ELF::DynamicObject>> s_global_objects;
+// The same objects as s_global_objects, in the order they were loaded. This is the order global symbol lookups search them in.
+static NonnullRefPtrVector<ELF::DynamicObject> s_global_objects_in_load_order;
+static HashMap<String, PrelinkCache::ObjectIdentity> s_object_identities;
+
+// Global symbol lookups that resolved to an STB_GLOBAL definition. Objects loaded later can never
+// take precedence over those, so entries stay valid for the lifetime of the process.
+// The keys point into the string tables of loaded objects (or s_prelink_cache), which are never unmapped.
+static HashMap<StringView, DynamicObject::SymbolLookupResult> s_global_symbol_cache;
+static __pthread_mutex_t s_global_symbol_cache_lock = __PTHREAD_MUTEX_INITIALIZER;
+
+static String s_prelink_cache_directory;
+static OwnPtr<PrelinkCache> s_prelink_cache;
 
 using EntryPointFunction = int (*)(int, char**, char**);
 using LibCExitFunction = void (*)(int);
@@ -57,16 +71,25 @@ static Result<void*, DlErrorMessage> __dlsym(void* handle, const char* symbol_na
 
 Optional<DynamicObject::SymbolLookupResult> DynamicLinker::lookup_global_symbol(const StringView& name)
 {
+    // NOTE: This can be called concurrently from lazy PLT resolution on multiple threads.
+    __pthread_mutex_lock(&s_global_symbol_cache_lock);
+    ScopeGuard unlock_guard = [] { __pthread_mutex_unlock(&s_global_symbol_cache_lock); };
+
+    if (auto cached_result = s_global_symbol_cache.get(name); cached_result.has_value())
+        return cached_result.value();
+
     Optional<DynamicObject::SymbolLookupResult> weak_result;
 
     auto symbol = DynamicObject::HashSymbol { name };
 
-    for (auto& lib : s_global_objects) {
-        auto res = lib.value->lookup_symbol(symbol);
+    for (auto& lib : s_global_objects_in_load_order) {
+        auto res = lib.lookup_symbol(symbol);
         if (!res.has_value())
             continue;
-        if (res.value().bind == STB_GLOBAL)
+        if (res.value().bind == STB_GLOBAL) {
+            s_global_symbol_cache.set(name, res.value());
             return res;
+        }
         if (res.value().bind == STB_WEAK && !weak_result.has_value())
             weak_result = res;
         // We don't want to allow local symbols to be pulled in to other modules
@@ -74,6 +97,19 @@ Optional<DynamicObject::SymbolLookupResult> DynamicLinker::lookup_global_symbol(
     return weak_result;
 }
 
+static void add_global_object(const String& name, DynamicObject& object)
+{
+    __pthread_mutex_lock(&s_global_symbol_cache_lock);
+    ScopeGuard unlock_guard = [] { __pthread_mutex_unlock(&s_global_symbol_cache_lock); };
+
+    s_global_objects.set(name, object);
+    for (auto& existing_object : s_global_objects_in_load_order) {
+        if (&existing_object == &object)
+            return;
+    }
+    s_global_objects_in_load_order.append(object);
+}
+
 static String get_library_name(String path)
 {
     return LexicalPath(move(path)).basename();
@@ -81,6 +117,12 @@ static String get_library_name(String path)
 
 static Result<NonnullRefPtr<DynamicLoader>, DlErrorMessage> map_library(const String& filename, int fd)
 {
+    struct stat st;
+    if (fstat(fd, &st) == 0) {
+        auto library_name = get_library_name(filename);
+        s_object_identities.set(library_name, { library_name, st.st_ino, st.st_mtime });
+    }
+
     auto result = ELF::DynamicLoader::try_create(fd, filename);
     if (result.is_error()) {
         return result;
@@ -270,20 +312,81 @@ static NonnullRefPtrVector<DynamicLoader> collect_loaders_for_library(const Stri
     return loaders;
 }
 
-static Result<NonnullRefPtr<DynamicLoader>, DlErrorMessage> load_main_library(const String& name, int flags)
+static Optional<Vector<PrelinkCache::ObjectIdentity>> global_object_identities()
+{
+    Vector<PrelinkCache::ObjectIdentity> identities;
+    for (auto& object : s_global_objects_in_load_order) {
+        auto identity = s_object_identities.get(get_library_name(object.filename()));
+        if (!identity.has_value())
+            return {};
+        identities.append(identity.value());
+    }
+    return identities;
+}
+
+static String prelink_cache_path()
+{
+    return String::formatted("{}/{}.prelink", s_prelink_cache_directory, get_library_name(s_main_program_name));
+}
+
+static void load_prelink_cache()
+{
+    auto identities = global_object_identities();
+    if (!identities.has_value())
+        return;
+
+    auto cache = PrelinkCache::try_load_from_file(prelink_cache_path());
+    if (!cache || cache->objects() != identities.value()) {
+        dbgln_if(DYNAMIC_LOAD_DEBUG, "Prelink cache for {} is missing or stale", s_main_program_name);
+        return;
+    }
+
+    for (auto& entry : cache->entries()) {
+        auto& object = s_global_objects_in_load_order[entry.object_index];
+        auto address = object.elf_is_dynamic() ? object.base_address().offset(entry.value) : VirtualAddress { entry.value };
+        s_global_symbol_cache.set(entry.symbol_name, { entry.value, entry.size, address, entry.bind, &object });
+    }
+    dbgln_if(DYNAMIC_LOAD_DEBUG, "Loaded {} symbols from prelink cache for {}", cache->entries().size(), s_main_program_name);
+    s_prelink_cache = move(cache);
+}
+
+static void write_prelink_cache()
+{
+    auto identities = global_object_identities();
+    if (!identities.has_value())
+        return;
+
+    PrelinkCache cache { identities.release_value() };
+    for (auto& it : s_global_symbol_cache) {
+        auto& result = it.value;
+        for (size_t i = 0; i < s_global_objects_in_load_order.size(); ++i) {
+            if (&s_global_objects_in_load_order[i] != result.dynamic_object)
+                continue;
+            cache.add_entry({ it.key, static_cast<u32>(i), result.value, result.size, static_cast<u8>(result.bind) });
+            break;
+        }
+    }
+    if (!cache.write_to_file(prelink_cache_path()))
+        dbgln("Failed to write prelink cache for {}", s_main_program_name);
+}
+
+static Result<NonnullRefPtr<DynamicLoader>, DlErrorMessage> load_main_library(const String& name, int flags, bool use_prelink_cache = false)
 {
     auto main_library_loader = *s_loaders.get(name);
     auto main_library_object = main_library_loader->map();
-    s_global_objects.set(name, *main_library_object);
+    add_global_object(name, *main_library_object);
 
     auto loaders = collect_loaders_for_library(name);
 
     for (auto& loader : loaders) {
         auto dynamic_object = loader.map();
         if (dynamic_object)
-            s_global_objects.set(dynamic_object->filename(), *dynamic_object);
+            add_global_object(dynamic_object->filename(), *dynamic_object);
     }
 
+    if (use_prelink_cache)
+        load_prelink_cache();
+
     for (auto& loader : loaders) {
         bool success = loader.link(flags);
         if (!success) {
@@ -307,6 +410,9 @@ static Result<NonnullRefPtr<DynamicLoader>, DlErrorMessage> load_main_library(co
         }
     }
 
+    if (use_prelink_cache && !s_prelink_cache)
+        write_prelink_cache();
+
     for (auto& loader : loaders) {
         loader.load_stage_4();
     }
@@ -434,9 +540,13 @@ static Result<void*, DlErrorMessage> __dlsym(void* handle, const char* symbol_na
 static void read_environment_variables()
 {
     for (char** env = s_envp; *env; ++env) {
-        if (StringView { *env } == "_LOADER_BREAKPOINT=1") {
+        StringView env_string { *env };
+        if (env_string == "_LOADER_BREAKPOINT=1") {
             s_do_breakpoint_trap_before_entry = true;
         }
+        if (env_string.starts_with("_LOADER_PRELINK_CACHE=")) {
+            s_prelink_cache_directory = env_string.substring_view(22);
+        }
     }
 }
 
@@ -478,7 +588,7 @@ void ELF::DynamicLinker::linker_main(String&& main_program_name, int main_progra
 
     auto entry_point_function = [&main_program_name] {
         auto library_name = get_library_name(main_program_name);
-        auto result = load_main_library(library_name, RTLD_GLOBAL | RTLD_LAZY);
+        auto result = load_main_library(library_name, RTLD_GLOBAL | RTLD_LAZY, !s_prelink_cache_directory.is_empty());
         if (result.is_error()) {
             warnln("{}", result.error().text);
             _exit(1);
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ByteBuffer.h>
+#include <AK/MemoryStream.h>
+#include <AK/ScopeGuard.h>
+#include <LibELF/PrelinkCache.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ELF {
+
+static constexpr u32 prelink_cache_magic = 0x314b4c50; // "PLK1"
+
+static bool read_string(InputMemoryStream& stream, String& string)
+{
+    u32 length = 0;
+    stream >> length;
+    if (stream.has_any_error() || length > stream.remaining())
+        return false;
+    string = StringView { stream.bytes().slice(stream.offset(), length) };
+    return stream.discard_or_error(length);
+}
+
+static void write_string(OutputStream& stream, const String& string)
+{
+    stream << static_cast<u32>(string.length());
+    stream << string.bytes();
+}
+
+OwnPtr<PrelinkCache> PrelinkCache::try_load_from_file(const String& path)
+{
+    int fd = open(path.characters(), O_RDONLY);
+    if (fd < 0)
+        return {};
+    ScopeGuard close_guard = [fd] { close(fd); };
+
+    struct stat st;
+    if (fstat(fd, &st) < 0)
+        return {};
+
+    // The cache decides where symbols resolve to, so never trust one that someone else could have written.
+    if (st.st_uid != geteuid() || (st.st_mode & (S_IWGRP | S_IWOTH)))
+        return {};
+
+    auto buffer = ByteBuffer::create_uninitialized(st.st_size);
+    size_t nread = 0;
+    while (nread < buffer.size()) {
+        auto rc = read(fd, buffer.offset_pointer(nread), buffer.size() - nread);
+        if (rc <= 0)
+            return {};
+        nread += rc;
+    }
+
+    InputMemoryStream stream { buffer };
+    u32 magic = 0;
+    u32 object_count = 0;
+    stream >> magic >> object_count;
+    if (stream.has_any_error() || magic != prelink_cache_magic) {
+        stream.handle_any_error();
+        return {};
+    }
+
+    Vector<ObjectIdentity> objects;
+    for (u32 i = 0; i < object_count; ++i) {
+        ObjectIdentity object;
+        if (!read_string(stream, object.name)) {
+            stream.handle_any_error();
+            return {};
+        }
+        stream >> object.inode >> object.mtime;
+        objects.append(move(object));
+    }
+
+    auto cache = make<PrelinkCache>(move(objects));
+
+    u32 entry_count = 0;
+    stream >> entry_count;
+    for (u32 i = 0; i < entry_count && !stream.has_any_error(); ++i) {
+        Entry entry;
+        if (!read_string(stream, entry.symbol_name))
+            break;
+        u64 value = 0;
+        u64 size = 0;
+        stream >> entry.object_index >> value >> size >> entry.bind;
+        if (entry.object_index >= cache->objects().size())
+            break;
+        entry.value = value;
+        entry.size = size;
+        cache->add_entry(move(entry));
+    }
+
+    if (stream.handle_any_error() || !stream.eof())
+        return {};
+    return cache;
+}
+
+bool PrelinkCache::write_to_file(const String& path) const
+{
+    DuplexMemoryStream stream;
+    stream << prelink_cache_magic << static_cast<u32>(m_objects.size());
+    for (auto& object : m_objects) {
+        write_string(stream, object.name);
+        stream << object.inode << object.mtime;
+    }
+    stream << static_cast<u32>(m_entries.size());
+    for (auto& entry : m_entries) {
+        write_string(stream, entry.symbol_name);
+        stream << entry.object_index << static_cast<u64>(entry.value) << static_cast<u64>(entry.size) << entry.bind;
+    }
+    auto buffer = stream.copy_into_contiguous_buffer();
+
+    // Write to a temporary file first, so concurrent loaders never see a partially written cache.
+    // Its name is predictable, so it must be a new file of our own rather than whatever is already there,
+    // otherwise a symlink planted in a shared cache directory would have us overwrite its target.
+    auto temporary_path = String::formatted("{}.{}", path, getpid());
+    int fd = open(temporary_path.characters(), O_WRONLY | O_CREAT | O_EXCL | O_NOFOLLOW, 0600);
+    if (fd < 0)
+        return false;
+
+    size_t nwritten = 0;
+    while (nwritten < buffer.size()) {
+        auto rc = write(fd, buffer.offset_pointer(nwritten), buffer.size() - nwritten);
+        if (rc <= 0) {
+            close(fd);
+            unlink(temporary_path.characters());
+            return false;
+        }
+        nwritten += rc;
+    }
+    close(fd);
+
+    if (rename(temporary_path.characters(), path.characters()) < 0) {
+        unlink(temporary_path.characters());
+        return false;
+    }
+    return true;
+}
+
+}
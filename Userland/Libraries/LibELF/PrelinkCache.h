@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/OwnPtr.h>
+#include <AK/String.h>
+#include <AK/Vector.h>
+
+namespace ELF {
+
+// An on-disk record of where a program's global symbol lookups resolved the last time it ran.
+// It's only usable for the exact same objects (same inode and mtime) loaded in the exact same
+// order; the dynamic linker falls back to regular symbol lookups otherwise.
+class PrelinkCache {
+public:
+    struct ObjectIdentity {
+        String name;
+        u64 inode { 0 };
+        i64 mtime { 0 };
+
+        bool operator==(const ObjectIdentity& other) const
+        {
+            return name == other.name && inode == other.inode && mtime == other.mtime;
+        }
+    };
+
+    struct Entry {
+        String symbol_name;
+        u32 object_index { 0 };
+        FlatPtr value { 0 };
+        size_t size { 0 };
+        u8 bind { 0 };
+    };
+
+    explicit PrelinkCache(Vector<ObjectIdentity> objects)
+        : m_objects(move(objects))
+    {
+    }
+
+    static OwnPtr<PrelinkCache> try_load_from_file(const String& path);
+    bool write_to_file(const String& path) const;
+
+    const Vector<ObjectIdentity>& objects() const { return m_objects; }
+    const Vector<Entry>& entries() const { return m_entries; }
+    void add_entry(Entry entry) { m_entries.append(move(entry)); }
+
+private:
+    Vector<ObjectIdentity> m_objects;
+    Vector<Entry> m_entries;
+};
+
+}
@@ -4,7 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
-#include <AK/QuickSort.h>
+#include <AK/MergeSort.h>
 #include <LibGUI/AbstractView.h>
 #include <LibGUI/SortingProxyModel.h>
 
@@ -177,9 +177,11 @@ void SortingProxyModel::sort_mapping(Mapping& mapping, int column, SortOrder sor
     for (int i = 0; i < row_count; ++i)
         mapping.source_rows[i] = i;
 
-    quick_sort(mapping.source_rows, [&](auto row1, auto row2) -> bool {
-        bool is_less_than = less_than(source().index(row1, column, mapping.source_parent), source().index(row2, column, mapping.source_parent));
-        return sort_order == SortOrder::Ascending ? is_less_than : !is_less_than;
+    // Rows that compare equal stay in the order the source model has them in.
+    merge_sort(mapping.source_rows, [&](auto row1, auto row2) -> bool {
+        if (sort_order == SortOrder::Descending)
+            swap(row1, row2);
+        return less_than(source().index(row1, column, mapping.source_parent), source().index(row2, column, mapping.source_parent));
     });
 
     for (int i = 0; i < row_count; ++i)
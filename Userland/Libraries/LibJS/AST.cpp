@@ -13,6 +13,8 @@
 #include <AK/TemporaryChange.h>
 #include <LibCrypto/BigInt/SignedBigInteger.h>
 #include <LibJS/AST.h>
+#include <LibJS/Bytecode/Block.h>
+#include <LibJS/Bytecode/Generator.h>
 #include <LibJS/Interpreter.h>
 #include <LibJS/Runtime/Accessor.h>
 #include <LibJS/Runtime/Array.h>
@@ -32,6 +34,62 @@
 
 namespace JS {
 
+static thread_local ASTArena::Scope* s_innermost_ast_arena_scope;
+
+ASTArena* ASTArena::current()
+{
+    return s_innermost_ast_arena_scope ? &s_innermost_ast_arena_scope->arena() : nullptr;
+}
+
+ASTArena::Scope::Scope(NonnullRefPtr<ASTArena> arena)
+    : m_arena(move(arena))
+    , m_outer(s_innermost_ast_arena_scope)
+{
+    if (m_outer)
+        m_outer->m_inner = this;
+    s_innermost_ast_arena_scope = this;
+}
+
+ASTArena::Scope::~Scope()
+{
+    // Parsers don't have to go away in the order they were created in, so this may be anywhere in the stack.
+    if (m_inner)
+        m_inner->m_outer = m_outer;
+    else
+        s_innermost_ast_arena_scope = m_outer;
+    if (m_outer)
+        m_outer->m_inner = m_inner;
+}
+
+// Every node is preceded by a pointer to the arena it came from (or null if it came from the heap), padded out so the node stays suitably aligned.
+static constexpr size_t ast_node_header_size = Arena::default_alignment;
+
+void* ASTNode::operator new(size_t size)
+{
+    auto* arena = ASTArena::current();
+    void* storage;
+    if (arena) {
+        arena->ref();
+        storage = arena->allocate(ast_node_header_size + size);
+    } else {
+        storage = kmalloc(ast_node_header_size + size);
+        VERIFY(storage);
+    }
+    *static_cast<ASTArena**>(storage) = arena;
+    return static_cast<u8*>(storage) + ast_node_header_size;
+}
+
+void ASTNode::operator delete(void* ptr)
+{
+    if (!ptr)
+        return;
+    auto* storage = static_cast<u8*>(ptr) - ast_node_header_size;
+    if (auto* arena = *reinterpret_cast<ASTArena**>(storage))
+        arena->unref();
+    else
+        kfree(storage);
+}
+
 class InterpreterNodeScope {
     AK_MAKE_NONCOPYABLE(InterpreterNodeScope);
     AK_MAKE_NONMOVABLE(InterpreterNodeScope);
@@ -91,6 +149,19 @@ Value Program::execute(Interpreter& interpreter, GlobalObject& global_object) co
     return interpreter.execute_statement(global_object, *this, ScopeType::Block);
 }
 
+const Statement& FunctionNode::body() const
+{
+    if (m_lazy_body)
+        return m_lazy_body->parse(m_parameters);
+    return *m_body;
+}
+
+void FunctionNode::set_lazy_body(NonnullRefPtr<LazyFunctionBody> lazy_body)
+{
+    VERIFY(!m_body);
+    m_lazy_body = move(lazy_body);
+}
+
 Value FunctionDeclaration::execute(Interpreter& interpreter, GlobalObject&) const
 {
     InterpreterNodeScope node_scope { interpreter, *this };
@@ -100,7 +171,7 @@ Value FunctionDeclaration::execute(Interpreter& interpreter, GlobalObject&) cons
 Value FunctionExpression::execute(Interpreter& interpreter, GlobalObject& global_object) const
 {
     InterpreterNodeScope node_scope { interpreter, *this };
-    return ScriptFunction::create(global_object, name(), body(), parameters(), function_length(), interpreter.current_scope(), is_strict_mode() || interpreter.vm().in_strict_mode(), m_is_arrow_function);
+    return ScriptFunction::create(global_object, *this, interpreter.current_scope(), is_strict_mode() || interpreter.vm().in_strict_mode(), m_is_arrow_function);
 }
 
 Value ExpressionStatement::execute(Interpreter& interpreter, GlobalObject& global_object) const
@@ -145,13 +216,13 @@ CallExpression::ThisAndCallee CallExpression::compute_this_and_callee(Interprete
                 return {};
             this_value = &vm.this_value(global_object).as_object();
         } else {
-            auto reference = member_expression.to_reference(interpreter, global_object);
+            auto object_value = member_expression.object().execute(interpreter, global_object);
             if (vm.exception())
                 return {};
-            callee = reference.get(global_object);
+            callee = member_expression.get_property(interpreter, global_object, object_value);
             if (vm.exception())
                 return {};
-            this_value = reference.base().to_object(global_object);
+            this_value = object_value.to_object(global_object);
             if (vm.exception())
                 return {};
         }
@@ -161,6 +232,22 @@ CallExpression::ThisAndCallee CallExpression::compute_this_and_callee(Interprete
     return { &global_object, m_callee->execute(interpreter, global_object) };
 }
 
+void CallExpression::throw_type_error_for_callee(GlobalObject& global_object, Value callee, StringView call_type) const
+{
+    auto& vm = global_object.vm();
+    if (is<Identifier>(*m_callee) || is<MemberExpression>(*m_callee)) {
+        String expression_string;
+        if (is<Identifier>(*m_callee)) {
+            expression_string = static_cast<const Identifier&>(*m_callee).string();
+        } else {
+            expression_string = static_cast<const MemberExpression&>(*m_callee).to_string_approximation();
+        }
+        vm.throw_exception<TypeError>(global_object, ErrorType::IsNotAEvaluatedFrom, callee.to_string_without_side_effects(), call_type, expression_string);
+    } else {
+        vm.throw_exception<TypeError>(global_object, ErrorType::IsNotA, callee.to_string_without_side_effects(), call_type);
+    }
+}
+
 Value CallExpression::execute(Interpreter& interpreter, GlobalObject& global_object) const
 {
     InterpreterNodeScope node_scope { interpreter, *this };
@@ -173,19 +260,7 @@ Value CallExpression::execute(Interpreter& interpreter, GlobalObject& global_obj
 
     if (!callee.is_function()
         || (is<NewExpression>(*this) && (is<NativeFunction>(callee.as_object()) && !static_cast<NativeFunction&>(callee.as_object()).has_constructor()))) {
-        String error_message;
-        auto call_type = is<NewExpression>(*this) ? "constructor" : "function";
-        if (is<Identifier>(*m_callee) || is<MemberExpression>(*m_callee)) {
-            String expression_string;
-            if (is<Identifier>(*m_callee)) {
-                expression_string = static_cast<const Identifier&>(*m_callee).string();
-            } else {
-                expression_string = static_cast<const MemberExpression&>(*m_callee).to_string_approximation();
-            }
-            vm.throw_exception<TypeError>(global_object, ErrorType::IsNotAEvaluatedFrom, callee.to_string_without_side_effects(), call_type, expression_string);
-        } else {
-            vm.throw_exception<TypeError>(global_object, ErrorType::IsNotA, callee.to_string_without_side_effects(), call_type);
-        }
+        throw_type_error_for_callee(global_object, callee, is<NewExpression>(*this) ? "constructor" : "function");
         return {};
     }
 
@@ -371,6 +446,7 @@ Value ForStatement::execute(Interpreter& interpreter, GlobalObject& global_objec
         NonnullRefPtrVector<VariableDeclaration> decls;
         decls.append(*static_cast<const VariableDeclaration*>(m_init.ptr()));
         wrapper->add_variables(decls);
+        wrapper->set_environment_layout(m_head_environment_layout);
         interpreter.enter_scope(*wrapper, ScopeType::Block, global_object);
     }
 
@@ -438,9 +514,8 @@ Value ForStatement::execute(Interpreter& interpreter, GlobalObject& global_objec
     return last_value;
 }
 
-static FlyString variable_from_for_declaration(Interpreter& interpreter, GlobalObject& global_object, const ASTNode& node, RefPtr<BlockStatement> wrapper)
+static const Identifier& variable_from_for_declaration(Interpreter& interpreter, GlobalObject& global_object, const ASTNode& node, RefPtr<BlockStatement> wrapper)
 {
-    FlyString variable_name;
     if (is<VariableDeclaration>(node)) {
         auto& variable_declaration = static_cast<const VariableDeclaration&>(node);
         VERIFY(!variable_declaration.declarations().is_empty());
@@ -449,13 +524,11 @@ static FlyString variable_from_for_declaration(Interpreter& interpreter, GlobalO
             interpreter.enter_scope(*wrapper, ScopeType::Block, global_object);
         }
         variable_declaration.execute(interpreter, global_object);
-        variable_name = variable_declaration.declarations().first().id().string();
-    } else if (is<Identifier>(node)) {
-        variable_name = static_cast<const Identifier&>(node).string();
-    } else {
-        VERIFY_NOT_REACHED();
+        return variable_declaration.declarations().first().id();
     }
-    return variable_name;
+    if (is<Identifier>(node))
+        return static_cast<const Identifier&>(node);
+    VERIFY_NOT_REACHED();
 }
 
 Value ForInStatement::execute(Interpreter& interpreter, GlobalObject& global_object) const
@@ -468,7 +541,7 @@ Value ForInStatement::execute(Interpreter& interpreter, GlobalObject& global_obj
         VERIFY_NOT_REACHED();
     }
     RefPtr<BlockStatement> wrapper;
-    auto variable_name = variable_from_for_declaration(interpreter, global_object, m_lhs, wrapper);
+    auto& variable = variable_from_for_declaration(interpreter, global_object, m_lhs, wrapper);
     auto wrapper_cleanup = ScopeGuard([&] {
         if (wrapper)
             interpreter.exit_scope(*wrapper);
@@ -483,7 +556,7 @@ Value ForInStatement::execute(Interpreter& interpreter, GlobalObject& global_obj
     while (object) {
         auto property_names = object->get_enumerable_own_property_names(Object::PropertyKind::Key);
         for (auto& value : property_names) {
-            interpreter.vm().set_variable(variable_name, value, global_object, has_declaration);
+            interpreter.vm().set_variable(variable.string(), value, global_object, has_declaration, &variable.environment_coordinate());
             if (interpreter.exception())
                 return {};
             last_value = interpreter.execute_statement(global_object, *m_body).value_or(last_value);
@@ -517,7 +590,7 @@ Value ForOfStatement::execute(Interpreter& interpreter, GlobalObject& global_obj
         VERIFY_NOT_REACHED();
     }
     RefPtr<BlockStatement> wrapper;
-    auto variable_name = variable_from_for_declaration(interpreter, global_object, m_lhs, wrapper);
+    auto& variable = variable_from_for_declaration(interpreter, global_object, m_lhs, wrapper);
     auto wrapper_cleanup = ScopeGuard([&] {
         if (wrapper)
             interpreter.exit_scope(*wrapper);
@@ -528,7 +601,7 @@ Value ForOfStatement::execute(Interpreter& interpreter, GlobalObject& global_obj
         return {};
 
     get_iterator_values(global_object, rhs_result, [&](Value value) {
-        interpreter.vm().set_variable(variable_name, value, global_object, has_declaration);
+        interpreter.vm().set_variable(variable.string(), value, global_object, has_declaration, &variable.environment_coordinate());
         last_value = interpreter.execute_statement(global_object, *m_body).value_or(last_value);
         if (interpreter.exception())
             return IterationDecision::Break;
@@ -657,7 +730,7 @@ Reference Expression::to_reference(Interpreter&, GlobalObject&) const
 
 Reference Identifier::to_reference(Interpreter& interpreter, GlobalObject&) const
 {
-    return interpreter.vm().get_reference(string());
+    return interpreter.vm().get_reference(string(), &m_environment_coordinate);
 }
 
 Reference MemberExpression::to_reference(Interpreter& interpreter, GlobalObject& global_object) const
@@ -700,8 +773,8 @@ Value UnaryExpression::execute(Interpreter& interpreter, GlobalObject& global_ob
         }
         // FIXME: standard recommends checking with is_unresolvable but it ALWAYS return false here
         if (reference.is_local_variable() || reference.is_global_variable()) {
-            const auto& name = reference.name();
-            lhs_result = interpreter.vm().get_variable(name.to_string(), global_object).value_or(js_undefined());
+            auto& identifier = static_cast<const Identifier&>(*m_lhs);
+            lhs_result = interpreter.vm().get_variable(identifier.string(), global_object, &identifier.environment_coordinate()).value_or(js_undefined());
             if (interpreter.exception())
                 return {};
         }
@@ -1256,7 +1329,7 @@ Value Identifier::execute(Interpreter& interpreter, GlobalObject& global_object)
 {
     InterpreterNodeScope node_scope { interpreter, *this };
 
-    auto value = interpreter.vm().get_variable(string(), global_object);
+    auto value = interpreter.vm().get_variable(string(), global_object, &m_environment_coordinate);
     if (value.is_empty()) {
         if (!interpreter.exception())
             interpreter.vm().throw_exception<ReferenceError>(global_object, ErrorType::UnknownIdentifier, string());
@@ -1543,10 +1616,10 @@ Value VariableDeclaration::execute(Interpreter& interpreter, GlobalObject& globa
             auto initalizer_result = init->execute(interpreter, global_object);
             if (interpreter.exception())
                 return {};
-            auto variable_name = declarator.id().string();
+            auto& variable = declarator.id();
             if (is<ClassExpression>(*init))
-                update_function_name(initalizer_result, variable_name);
-            interpreter.vm().set_variable(variable_name, initalizer_result, global_object, true);
+                update_function_name(initalizer_result, variable.string());
+            interpreter.vm().set_variable(variable.string(), initalizer_result, global_object, true, &variable.environment_coordinate());
         }
     }
     return {};
@@ -1735,10 +1808,21 @@ Value MemberExpression::execute(Interpreter& interpreter, GlobalObject& global_o
 {
     InterpreterNodeScope node_scope { interpreter, *this };
 
-    auto reference = to_reference(interpreter, global_object);
+    auto object_value = m_object->execute(interpreter, global_object);
     if (interpreter.exception())
         return {};
-    return reference.get(global_object);
+    return get_property(interpreter, global_object, object_value);
+}
+
+Value MemberExpression::get_property(Interpreter& interpreter, GlobalObject& global_object, Value object_value) const
+{
+    if (!is_computed())
+        return m_inline_cache.get_property(global_object, object_value, static_cast<const Identifier&>(*m_property).string());
+
+    auto property_name = computed_property_name(interpreter, global_object);
+    if (!property_name.is_valid())
+        return {};
+    return Reference(object_value, property_name).get(global_object);
 }
 
 void MetaProperty::dump(int indent) const
@@ -1970,9 +2054,15 @@ Value TryStatement::execute(Interpreter& interpreter, GlobalObject& global_objec
         if (m_handler) {
             interpreter.vm().clear_exception();
 
-            HashMap<FlyString, Variable> parameters;
-            parameters.set(m_handler->parameter(), Variable { exception->value(), DeclarationKind::Var });
-            auto* catch_scope = interpreter.heap().allocate<LexicalEnvironment>(global_object, move(parameters), interpreter.vm().call_frame().scope);
+            LexicalEnvironment* catch_scope = nullptr;
+            if (auto& environment_layout = m_handler->environment_layout()) {
+                catch_scope = interpreter.heap().allocate<LexicalEnvironment>(global_object, *environment_layout, interpreter.vm().call_frame().scope);
+                catch_scope->put_to_scope(m_handler->parameter(), Variable { exception->value(), DeclarationKind::Var });
+            } else {
+                HashMap<FlyString, Variable> parameters;
+                parameters.set(m_handler->parameter(), Variable { exception->value(), DeclarationKind::Var });
+                catch_scope = interpreter.heap().allocate<LexicalEnvironment>(global_object, move(parameters), interpreter.vm().call_frame().scope);
+            }
             TemporaryChange<ScopeObject*> scope_change(interpreter.vm().call_frame().scope, catch_scope);
             result = interpreter.execute_statement(global_object, m_handler->body());
         }
@@ -2176,6 +2266,24 @@ Value DebuggerStatement::execute(Interpreter& interpreter, GlobalObject&) const
     return {};
 }
 
+ScopeNode::ScopeNode(SourceRange source_range)
+    : Statement(move(source_range))
+{
+}
+
+ScopeNode::~ScopeNode()
+{
+}
+
+const Bytecode::Block* ScopeNode::bytecode_block() const
+{
+    if (!m_bytecode_generation_attempted) {
+        m_bytecode_generation_attempted = true;
+        m_bytecode_block = Bytecode::Generator::generate(*this);
+    }
+    return m_bytecode_block;
+}
+
 void ScopeNode::add_variables(NonnullRefPtrVector<VariableDeclaration> variables)
 {
     m_variables.append(move(variables));
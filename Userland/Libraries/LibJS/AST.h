@@ -7,13 +7,18 @@
 
 #pragma once
 
+#include <AK/Arena.h>
 #include <AK/FlyString.h>
 #include <AK/HashMap.h>
+#include <AK/HashTable.h>
 #include <AK/NonnullRefPtrVector.h>
+#include <AK/OwnPtr.h>
 #include <AK/RefPtr.h>
 #include <AK/String.h>
 #include <AK/Vector.h>
 #include <LibJS/Forward.h>
+#include <LibJS/Runtime/EnvironmentLayout.h>
+#include <LibJS/Runtime/InlineCache.h>
 #include <LibJS/Runtime/PropertyName.h>
 #include <LibJS/Runtime/Value.h>
 #include <LibJS/SourceRange.h>
@@ -22,6 +27,7 @@ namespace JS {
 
 class VariableDeclaration;
 class FunctionDeclaration;
+class LazyFunctionBody;
 
 template<class T, class... Args>
 static inline NonnullRefPtr<T>
@@ -30,10 +36,49 @@ create_ast_node(SourceRange range, Args&&... args)
     return adopt_ref(*new T(range, forward<Args>(args)...));
 }
 
+// While a Parser is alive, the nodes it creates are carved out of one of these instead of each getting an
+// allocation of their own. Every node keeps its arena alive, so the memory only goes back in one go once the
+// last node from that parse is gone; nodes that are destroyed early don't give anything back before then.
+class ASTArena : public RefCounted<ASTArena> {
+public:
+    static NonnullRefPtr<ASTArena> create() { return adopt_ref(*new ASTArena); }
+
+    static ASTArena* current();
+
+    void* allocate(size_t size) { return m_arena.allocate(size); }
+
+    // Makes an arena the one new nodes on this thread come from, until this goes out of scope.
+    // Scopes form a stack per thread, but may end in any order; each one just takes itself out of the stack.
+    class Scope {
+        AK_MAKE_NONCOPYABLE(Scope);
+        AK_MAKE_NONMOVABLE(Scope);
+
+    public:
+        explicit Scope(NonnullRefPtr<ASTArena>);
+        ~Scope();
+
+        ASTArena& arena() { return m_arena; }
+
+    private:
+        NonnullRefPtr<ASTArena> m_arena;
+        Scope* m_outer { nullptr };
+        Scope* m_inner { nullptr };
+    };
+
+private:
+    ASTArena() = default;
+
+    Arena m_arena { 16 * KiB, 256 * KiB };
+};
+
 class ASTNode : public RefCounted<ASTNode> {
 public:
+    void* operator new(size_t);
+    void operator delete(void*);
+
     virtual ~ASTNode() { }
     virtual Value execute(Interpreter&, GlobalObject&) const = 0;
+    virtual void generate_bytecode(Bytecode::Generator&) const;
     virtual void dump(int indent) const;
 
     const SourceRange& source_range() const { return m_source_range; }
@@ -72,6 +117,7 @@ public:
     {
     }
     Value execute(Interpreter&, GlobalObject&) const override { return {}; }
+    virtual void generate_bytecode(Bytecode::Generator&) const override;
 };
 
 class ErrorStatement final : public Statement {
@@ -92,6 +138,7 @@ public:
     }
 
     virtual Value execute(Interpreter&, GlobalObject&) const override;
+    virtual void generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
 
     const Expression& expression() const { return m_expression; };
@@ -114,8 +161,11 @@ public:
         m_children.append(move(child));
     }
 
+    virtual ~ScopeNode() override;
+
     const NonnullRefPtrVector<Statement>& children() const { return m_children; }
     virtual Value execute(Interpreter&, GlobalObject&) const override;
+    virtual void generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
 
     void add_variables(NonnullRefPtrVector<VariableDeclaration>);
@@ -123,16 +173,26 @@ public:
     const NonnullRefPtrVector<VariableDeclaration>& variables() const { return m_variables; }
     const NonnullRefPtrVector<FunctionDeclaration>& functions() const { return m_functions; }
 
+    // The layout of the environment this scope runs in, if the parser gave it one of its own. For function bodies
+    // that's the function's environment, with the parameters and all.
+    const RefPtr<EnvironmentLayout>& environment_layout() const { return m_environment_layout; }
+    void set_environment_layout(RefPtr<EnvironmentLayout> environment_layout) { m_environment_layout = move(environment_layout); }
+
+    // This scope compiled to bytecode the first time it's asked for, or null if it uses something the bytecode
+    // generator doesn't support (and has to be run by the AST interpreter).
+    const Bytecode::Block* bytecode_block() const;
+
 protected:
-    ScopeNode(SourceRange source_range)
-        : Statement(move(source_range))
-    {
-    }
+    explicit ScopeNode(SourceRange);
 
 private:
     NonnullRefPtrVector<Statement> m_children;
     NonnullRefPtrVector<VariableDeclaration> m_variables;
     NonnullRefPtrVector<FunctionDeclaration> m_functions;
+    RefPtr<EnvironmentLayout> m_environment_layout;
+
+    mutable OwnPtr<Bytecode::Block> m_bytecode_block;
+    mutable bool m_bytecode_generation_attempted { false };
 };
 
 class Program final : public ScopeNode {
@@ -194,13 +254,18 @@ public:
     };
 
     const FlyString& name() const { return m_name; }
-    const Statement& body() const { return *m_body; }
+    // Parses the body first if the parser skipped over it.
+    const Statement& body() const;
     const Vector<Parameter>& parameters() const { return m_parameters; };
     i32 function_length() const { return m_function_length; }
     bool is_strict_mode() const { return m_is_strict_mode; }
 
+    // Set (instead of the body) if the parser only skimmed over the body.
+    const RefPtr<LazyFunctionBody>& lazy_body() const { return m_lazy_body; }
+    void set_lazy_body(NonnullRefPtr<LazyFunctionBody>);
+
 protected:
-    FunctionNode(const FlyString& name, NonnullRefPtr<Statement> body, Vector<Parameter> parameters, i32 function_length, NonnullRefPtrVector<VariableDeclaration> variables, bool is_strict_mode)
+    FunctionNode(const FlyString& name, RefPtr<Statement> body, Vector<Parameter> parameters, i32 function_length, NonnullRefPtrVector<VariableDeclaration> variables, bool is_strict_mode)
         : m_name(name)
         , m_body(move(body))
         , m_parameters(move(parameters))
@@ -223,7 +288,8 @@ protected:
 
 private:
     FlyString m_name;
-    NonnullRefPtr<Statement> m_body;
+    RefPtr<Statement> m_body;
+    RefPtr<LazyFunctionBody> m_lazy_body;
     const Vector<Parameter> m_parameters;
     NonnullRefPtrVector<VariableDeclaration> m_variables;
     const i32 m_function_length;
@@ -236,13 +302,14 @@ class FunctionDeclaration final
 public:
     static bool must_have_name() { return true; }
 
-    FunctionDeclaration(SourceRange source_range, const FlyString& name, NonnullRefPtr<Statement> body, Vector<Parameter> parameters, i32 function_length, NonnullRefPtrVector<VariableDeclaration> variables, bool is_strict_mode = false)
+    FunctionDeclaration(SourceRange source_range, const FlyString& name, RefPtr<Statement> body, Vector<Parameter> parameters, i32 function_length, NonnullRefPtrVector<VariableDeclaration> variables, bool is_strict_mode = false)
         : Declaration(move(source_range))
         , FunctionNode(name, move(body), move(parameters), function_length, move(variables), is_strict_mode)
     {
     }
 
     virtual Value execute(Interpreter&, GlobalObject&) const override;
+    virtual void generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
 };
 
@@ -252,7 +319,7 @@ class FunctionExpression final
 public:
     static bool must_have_name() { return false; }
 
-    FunctionExpression(SourceRange source_range, const FlyString& name, NonnullRefPtr<Statement> body, Vector<Parameter> parameters, i32 function_length, NonnullRefPtrVector<VariableDeclaration> variables, bool is_strict_mode, bool is_arrow_function = false)
+    FunctionExpression(SourceRange source_range, const FlyString& name, RefPtr<Statement> body, Vector<Parameter> parameters, i32 function_length, NonnullRefPtrVector<VariableDeclaration> variables, bool is_strict_mode, bool is_arrow_function = false)
         : Expression(source_range)
         , FunctionNode(name, move(body), move(parameters), function_length, move(variables), is_strict_mode)
         , m_is_arrow_function(is_arrow_function)
@@ -260,6 +327,7 @@ public:
     }
 
     virtual Value execute(Interpreter&, GlobalObject&) const override;
+    virtual void generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
 
     void set_name_if_possible(FlyString new_name)
@@ -272,12 +340,53 @@ public:
     }
     bool cannot_auto_rename() const { return m_cannot_auto_rename; }
     void set_cannot_auto_rename() { m_cannot_auto_rename = true; }
+    bool is_arrow_function() const { return m_is_arrow_function; }
 
 private:
     bool m_cannot_auto_rename { false };
     bool m_is_arrow_function { false };
 };
 
+// The source of a function body the parser has only skimmed over, along with what it knew about the surroundings at
+// the time. The body is parsed properly the first time it's needed, which for most functions is never.
+class LazyFunctionBody : public RefCounted<LazyFunctionBody> {
+public:
+    // One of the scopes around a skipped function body, as the parser saw it once it had parsed all of it.
+    // Identifiers in the body are resolved against these when it gets parsed.
+    struct EnclosingScope : public RefCounted<EnclosingScope> {
+        RefPtr<EnclosingScope> parent;
+        RefPtr<EnvironmentLayout> environment_layout;
+        HashTable<FlyString> dynamically_bound_names;
+        bool may_bind_any_name { false };
+    };
+
+    bool is_strict_mode() const { return m_is_strict_mode; }
+    bool is_parsed() const { return m_body; }
+
+    // Parses the body the first time around. If it has a syntax error, the body does nothing and the error is kept.
+    const Statement& parse(const Vector<FunctionNode::Parameter>&) const;
+    const String& syntax_error() const { return m_syntax_error; }
+
+private:
+    friend class Parser;
+
+    LazyFunctionBody() = default;
+
+    String m_source;
+    String m_filename;
+    size_t m_start_offset { 0 };
+    size_t m_end_offset { 0 };
+    Position m_start;
+    bool m_is_in_strict_mode_context { false };
+    bool m_is_strict_mode { false };
+    bool m_allow_super_property_lookup { false };
+    bool m_allow_super_constructor_call { false };
+    mutable RefPtr<EnclosingScope> m_enclosing_scope;
+
+    mutable RefPtr<Statement> m_body;
+    mutable String m_syntax_error;
+};
+
 class ErrorExpression final : public Expression {
 public:
     explicit ErrorExpression(SourceRange source_range)
@@ -299,6 +408,7 @@ public:
     const Expression* argument() const { return m_argument; }
 
     virtual Value execute(Interpreter&, GlobalObject&) const override;
+    virtual void generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
 
 private:
@@ -320,6 +430,7 @@ public:
     const Statement* alternate() const { return m_alternate; }
 
     virtual Value execute(Interpreter&, GlobalObject&) const override;
+    virtual void generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
 
 private:
@@ -341,6 +452,7 @@ public:
     const Statement& body() const { return *m_body; }
 
     virtual Value execute(Interpreter&, GlobalObject&) const override;
+    virtual void generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
 
 private:
@@ -361,6 +473,7 @@ public:
     const Statement& body() const { return *m_body; }
 
     virtual Value execute(Interpreter&, GlobalObject&) const override;
+    virtual void generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
 
 private:
@@ -404,7 +517,12 @@ public:
     const Expression* update() const { return m_update; }
     const Statement& body() const { return *m_body; }
 
+    // Let and const declarations in the head get an environment of their own.
+    const RefPtr<EnvironmentLayout>& head_environment_layout() const { return m_head_environment_layout; }
+    void set_head_environment_layout(RefPtr<EnvironmentLayout> environment_layout) { m_head_environment_layout = move(environment_layout); }
+
     virtual Value execute(Interpreter&, GlobalObject&) const override;
+    virtual void generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
 
 private:
@@ -412,6 +530,7 @@ private:
     RefPtr<Expression> m_test;
     RefPtr<Expression> m_update;
     NonnullRefPtr<Statement> m_body;
+    RefPtr<EnvironmentLayout> m_head_environment_layout;
 };
 
 class ForInStatement final : public Statement {
@@ -496,6 +615,7 @@ public:
     }
 
     virtual Value execute(Interpreter&, GlobalObject&) const override;
+    virtual void generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
 
 private:
@@ -521,6 +641,7 @@ public:
     }
 
     virtual Value execute(Interpreter&, GlobalObject&) const override;
+    virtual void generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
 
 private:
@@ -549,6 +670,7 @@ public:
     }
 
     virtual Value execute(Interpreter&, GlobalObject&) const override;
+    virtual void generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
 
 private:
@@ -567,6 +689,7 @@ public:
 
     virtual void dump(int indent) const override;
     virtual Value execute(Interpreter&, GlobalObject&) const override;
+    virtual void generate_bytecode(Bytecode::Generator&) const override;
 
 private:
     NonnullRefPtrVector<Expression> m_expressions;
@@ -589,6 +712,7 @@ public:
     }
 
     virtual Value execute(Interpreter&, GlobalObject&) const override;
+    virtual void generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
 
 private:
@@ -604,6 +728,7 @@ public:
     }
 
     virtual Value execute(Interpreter&, GlobalObject&) const override;
+    virtual void generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
 
 private:
@@ -619,6 +744,7 @@ public:
     }
 
     virtual Value execute(Interpreter&, GlobalObject&) const override;
+    virtual void generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
 
 private:
@@ -635,6 +761,7 @@ public:
     }
 
     virtual Value execute(Interpreter&, GlobalObject&) const override;
+    virtual void generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
 
     StringView value() const { return m_value; }
@@ -653,6 +780,7 @@ public:
     }
 
     virtual Value execute(Interpreter&, GlobalObject&) const override;
+    virtual void generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
 };
 
@@ -686,12 +814,18 @@ public:
 
     const FlyString& string() const { return m_string; }
 
+    // Where the variable this refers to lives, if the parser could tell.
+    const EnvironmentCoordinate& environment_coordinate() const { return m_environment_coordinate; }
+    void set_environment_coordinate(EnvironmentCoordinate coordinate) { m_environment_coordinate = move(coordinate); }
+
     virtual Value execute(Interpreter&, GlobalObject&) const override;
+    virtual void generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
     virtual Reference to_reference(Interpreter&, GlobalObject&) const override;
 
 private:
     FlyString m_string;
+    EnvironmentCoordinate m_environment_coordinate;
 };
 
 class ClassMethod final : public ASTNode {
@@ -796,6 +930,7 @@ public:
     {
     }
     virtual Value execute(Interpreter&, GlobalObject&) const override;
+    virtual void generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
 };
 
@@ -814,8 +949,11 @@ public:
     }
 
     virtual Value execute(Interpreter&, GlobalObject&) const override;
+    virtual void generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
 
+    void throw_type_error_for_callee(GlobalObject&, Value callee, StringView call_type) const;
+
 private:
     struct ThisAndCallee {
         Value this_value;
@@ -865,6 +1003,7 @@ public:
     }
 
     virtual Value execute(Interpreter&, GlobalObject&) const override;
+    virtual void generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
 
 private:
@@ -889,6 +1028,7 @@ public:
     }
 
     virtual Value execute(Interpreter&, GlobalObject&) const override;
+    virtual void generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
 
 private:
@@ -941,6 +1081,7 @@ public:
     DeclarationKind declaration_kind() const { return m_declaration_kind; }
 
     virtual Value execute(Interpreter&, GlobalObject&) const override;
+    virtual void generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
 
     const NonnullRefPtrVector<VariableDeclarator>& declarations() const { return m_declarations; }
@@ -997,6 +1138,7 @@ public:
     }
 
     virtual Value execute(Interpreter&, GlobalObject&) const override;
+    virtual void generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
 
 private:
@@ -1014,6 +1156,7 @@ public:
     const Vector<RefPtr<Expression>>& elements() const { return m_elements; }
 
     virtual Value execute(Interpreter&, GlobalObject&) const override;
+    virtual void generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
 
 private:
@@ -1036,6 +1179,7 @@ public:
     }
 
     virtual Value execute(Interpreter&, GlobalObject&) const override;
+    virtual void generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
 
     const NonnullRefPtrVector<Expression>& expressions() const { return m_expressions; }
@@ -1074,6 +1218,7 @@ public:
     }
 
     virtual Value execute(Interpreter&, GlobalObject&) const override;
+    virtual void generate_bytecode(Bytecode::Generator&) const override;
     virtual void dump(int indent) const override;
     virtual Reference to_reference(Interpreter&, GlobalObject&) const override;
 
@@ -1082,6 +1227,8 @@ public:
     const Expression& property() const { return *m_property; }
 
     PropertyName computed_property_name(Interpreter&, GlobalObject&) const;
+    // Evaluates the property name and gets that property of the already evaluated object.
+    Value get_property(Interpreter&, GlobalObject&, Value object_value) const;
 
     String to_string_approximation() const;
 
@@ -1089,6 +1236,7 @@ private:
     NonnullRefPtr<Expression> m_object;
     NonnullRefPtr<Expression> m_property;
     bool m_computed { false };
+    mutable InlineCache m_inline_cache;
 };
 
 class MetaProperty final : public Expression {
@@ -1123,6 +1271,7 @@ public:
 
     virtual void dump(int indent) const override;
     virtual Value execute(Interpreter&, GlobalObject&) const override;
+    virtual void generate_bytecode(Bytecode::Generator&) const override;
 
 private:
     NonnullRefPtr<Expression> m_test;
@@ -1142,12 +1291,16 @@ public:
     const FlyString& parameter() const { return m_parameter; }
     const BlockStatement& body() const { return m_body; }
 
+    const RefPtr<EnvironmentLayout>& environment_layout() const { return m_environment_layout; }
+    void set_environment_layout(RefPtr<EnvironmentLayout> environment_layout) { m_environment_layout = move(environment_layout); }
+
     virtual void dump(int indent) const override;
     virtual Value execute(Interpreter&, GlobalObject&) const override;
 
 private:
     FlyString m_parameter;
     NonnullRefPtr<BlockStatement> m_body;
+    RefPtr<EnvironmentLayout> m_environment_layout;
 };
 
 class TryStatement final : public Statement {
@@ -1185,6 +1338,7 @@ public:
 
     virtual void dump(int indent) const override;
     virtual Value execute(Interpreter&, GlobalObject&) const override;
+    virtual void generate_bytecode(Bytecode::Generator&) const override;
 
 private:
     NonnullRefPtr<Expression> m_argument;
@@ -1236,6 +1390,7 @@ public:
     }
 
     virtual Value execute(Interpreter&, GlobalObject&) const override;
+    virtual void generate_bytecode(Bytecode::Generator&) const override;
 
     const FlyString& target_label() const { return m_target_label; }
 
@@ -1252,6 +1407,7 @@ public:
     }
 
     virtual Value execute(Interpreter&, GlobalObject&) const override;
+    virtual void generate_bytecode(Bytecode::Generator&) const override;
 
     const FlyString& target_label() const { return m_target_label; }
 
@@ -1267,6 +1423,7 @@ public:
     }
 
     virtual Value execute(Interpreter&, GlobalObject&) const override;
+    virtual void generate_bytecode(Bytecode::Generator&) const override;
 };
 
 }
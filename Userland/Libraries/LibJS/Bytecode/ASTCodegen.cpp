@@ -0,0 +1,701 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCrypto/BigInt/SignedBigInteger.h>
+#include <LibJS/AST.h>
+#include <LibJS/Bytecode/Generator.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/Register.h>
+
+namespace JS {
+
+using namespace Bytecode;
+
+void ASTNode::generate_bytecode(Bytecode::Generator& generator) const
+{
+    generator.unsupported(*this);
+}
+
+void ScopeNode::generate_bytecode(Bytecode::Generator& generator) const
+{
+    // Blocks that don't declare anything can make do with the scope around them.
+    bool needs_scope = !variables().is_empty() || !functions().is_empty();
+
+    if (!label().is_null())
+        generator.begin_jump_scope(label(), false);
+    if (needs_scope)
+        generator.emit_enter_scope(*this, ScopeType::Block);
+
+    for (auto& child : children()) {
+        child.generate_bytecode(generator);
+        if (generator.is_unsupported())
+            return;
+    }
+
+    if (needs_scope)
+        generator.emit_leave_scope();
+    if (!label().is_null())
+        generator.end_jump_scope(generator.make_label());
+}
+
+void EmptyStatement::generate_bytecode(Bytecode::Generator&) const
+{
+}
+
+void DebuggerStatement::generate_bytecode(Bytecode::Generator&) const
+{
+}
+
+void FunctionDeclaration::generate_bytecode(Bytecode::Generator&) const
+{
+    // Function declarations are hoisted when entering the scope around them.
+}
+
+void ExpressionStatement::generate_bytecode(Bytecode::Generator& generator) const
+{
+    m_expression->generate_bytecode(generator);
+    if (auto completion_register = generator.completion_register(); completion_register.has_value())
+        generator.emit<Op::Store>(*completion_register);
+}
+
+void IfStatement::generate_bytecode(Bytecode::Generator& generator) const
+{
+    m_predicate->generate_bytecode(generator);
+    auto jump_to_alternate = generator.emit<Op::JumpIfFalse>();
+
+    m_consequent->generate_bytecode(generator);
+    if (!m_alternate) {
+        jump_to_alternate->set_target(generator.make_label());
+        return;
+    }
+
+    auto jump_to_end = generator.emit<Op::Jump>();
+    jump_to_alternate->set_target(generator.make_label());
+    m_alternate->generate_bytecode(generator);
+    jump_to_end->set_target(generator.make_label());
+}
+
+void WhileStatement::generate_bytecode(Bytecode::Generator& generator) const
+{
+    generator.begin_jump_scope(m_label, true);
+
+    auto test_label = generator.make_label();
+    m_test->generate_bytecode(generator);
+    auto jump_to_end = generator.emit<Op::JumpIfFalse>();
+
+    m_body->generate_bytecode(generator);
+    generator.emit<Op::Jump>(test_label);
+
+    auto end_label = generator.make_label();
+    jump_to_end->set_target(end_label);
+    generator.end_jump_scope(end_label, test_label);
+}
+
+void DoWhileStatement::generate_bytecode(Bytecode::Generator& generator) const
+{
+    generator.begin_jump_scope(m_label, true);
+
+    auto body_label = generator.make_label();
+    m_body->generate_bytecode(generator);
+
+    auto test_label = generator.make_label();
+    m_test->generate_bytecode(generator);
+    generator.emit<Op::JumpIfTrue>(body_label);
+
+    generator.end_jump_scope(generator.make_label(), test_label);
+}
+
+void ForStatement::generate_bytecode(Bytecode::Generator& generator) const
+{
+    // Like the AST interpreter, let and const declarations in the head get a scope of their own.
+    RefPtr<BlockStatement> wrapper;
+    if (m_init && is<VariableDeclaration>(*m_init) && static_cast<const VariableDeclaration&>(*m_init).declaration_kind() != DeclarationKind::Var) {
+        wrapper = create_ast_node<BlockStatement>(source_range());
+        NonnullRefPtrVector<VariableDeclaration> declarations;
+        declarations.append(*static_cast<const VariableDeclaration*>(m_init.ptr()));
+        wrapper->add_variables(declarations);
+        wrapper->set_environment_layout(m_head_environment_layout);
+        generator.retain_node(*wrapper);
+        generator.emit_enter_scope(*wrapper, ScopeType::Block);
+    }
+
+    if (m_init)
+        m_init->generate_bytecode(generator);
+
+    generator.begin_jump_scope(m_label, true);
+
+    auto test_label = generator.make_label();
+    Optional<InstructionHandle<Op::Jump>> jump_to_end;
+    if (m_test) {
+        m_test->generate_bytecode(generator);
+        jump_to_end = generator.emit<Op::JumpIfFalse>();
+    }
+
+    m_body->generate_bytecode(generator);
+
+    auto update_label = generator.make_label();
+    if (m_update)
+        m_update->generate_bytecode(generator);
+    generator.emit<Op::Jump>(test_label);
+
+    auto end_label = generator.make_label();
+    if (jump_to_end.has_value())
+        (*jump_to_end)->set_target(end_label);
+    generator.end_jump_scope(end_label, update_label);
+
+    if (wrapper)
+        generator.emit_leave_scope();
+}
+
+void BreakStatement::generate_bytecode(Bytecode::Generator& generator) const
+{
+    generator.emit_break(m_target_label);
+}
+
+void ContinueStatement::generate_bytecode(Bytecode::Generator& generator) const
+{
+    generator.emit_continue(m_target_label);
+}
+
+void ReturnStatement::generate_bytecode(Bytecode::Generator& generator) const
+{
+    if (m_argument)
+        m_argument->generate_bytecode(generator);
+    else
+        generator.emit<Op::LoadImmediate>(js_undefined());
+    generator.emit<Op::Return>();
+}
+
+void ThrowStatement::generate_bytecode(Bytecode::Generator& generator) const
+{
+    m_argument->generate_bytecode(generator);
+    generator.emit<Op::Throw>();
+}
+
+void VariableDeclaration::generate_bytecode(Bytecode::Generator& generator) const
+{
+    for (auto& declarator : m_declarations) {
+        if (auto* init = declarator.init()) {
+            init->generate_bytecode(generator);
+            generator.emit<Op::SetVariable>(declarator.id().string(), declarator.id().environment_coordinate(), Op::SetVariable::Mode::Initialize);
+        }
+    }
+}
+
+void NumericLiteral::generate_bytecode(Bytecode::Generator& generator) const
+{
+    generator.emit<Op::LoadImmediate>(m_value);
+}
+
+void BooleanLiteral::generate_bytecode(Bytecode::Generator& generator) const
+{
+    generator.emit<Op::LoadImmediate>(Value(m_value));
+}
+
+void NullLiteral::generate_bytecode(Bytecode::Generator& generator) const
+{
+    generator.emit<Op::LoadImmediate>(js_null());
+}
+
+void StringLiteral::generate_bytecode(Bytecode::Generator& generator) const
+{
+    generator.emit<Op::NewString>(m_value);
+}
+
+void BigIntLiteral::generate_bytecode(Bytecode::Generator& generator) const
+{
+    generator.emit<Op::NewBigInt>(Crypto::SignedBigInteger::from_base10(m_value.substring(0, m_value.length() - 1)));
+}
+
+void Identifier::generate_bytecode(Bytecode::Generator& generator) const
+{
+    generator.emit<Op::GetVariable>(m_string, m_environment_coordinate);
+}
+
+void ThisExpression::generate_bytecode(Bytecode::Generator& generator) const
+{
+    generator.emit<Op::ResolveThisBinding>();
+}
+
+void FunctionExpression::generate_bytecode(Bytecode::Generator& generator) const
+{
+    generator.emit<Op::NewFunction>(*this);
+}
+
+// Computes lhs OP accumulator.
+static void emit_binary_op(Bytecode::Generator& generator, BinaryOp op, Register lhs)
+{
+    switch (op) {
+    case BinaryOp::Addition:
+        generator.emit<Op::Add>(lhs);
+        return;
+    case BinaryOp::Subtraction:
+        generator.emit<Op::Sub>(lhs);
+        return;
+    case BinaryOp::Multiplication:
+        generator.emit<Op::Mul>(lhs);
+        return;
+    case BinaryOp::Division:
+        generator.emit<Op::Div>(lhs);
+        return;
+    case BinaryOp::Modulo:
+        generator.emit<Op::Mod>(lhs);
+        return;
+    case BinaryOp::Exponentiation:
+        generator.emit<Op::Exp>(lhs);
+        return;
+    case BinaryOp::TypedEquals:
+        generator.emit<Op::TypedEquals>(lhs);
+        return;
+    case BinaryOp::TypedInequals:
+        generator.emit<Op::TypedInequals>(lhs);
+        return;
+    case BinaryOp::AbstractEquals:
+        generator.emit<Op::AbstractEquals>(lhs);
+        return;
+    case BinaryOp::AbstractInequals:
+        generator.emit<Op::AbstractInequals>(lhs);
+        return;
+    case BinaryOp::GreaterThan:
+        generator.emit<Op::GreaterThan>(lhs);
+        return;
+    case BinaryOp::GreaterThanEquals:
+        generator.emit<Op::GreaterThanEquals>(lhs);
+        return;
+    case BinaryOp::LessThan:
+        generator.emit<Op::LessThan>(lhs);
+        return;
+    case BinaryOp::LessThanEquals:
+        generator.emit<Op::LessThanEquals>(lhs);
+        return;
+    case BinaryOp::BitwiseAnd:
+        generator.emit<Op::BitwiseAnd>(lhs);
+        return;
+    case BinaryOp::BitwiseOr:
+        generator.emit<Op::BitwiseOr>(lhs);
+        return;
+    case BinaryOp::BitwiseXor:
+        generator.emit<Op::BitwiseXor>(lhs);
+        return;
+    case BinaryOp::LeftShift:
+        generator.emit<Op::LeftShift>(lhs);
+        return;
+    case BinaryOp::RightShift:
+        generator.emit<Op::RightShift>(lhs);
+        return;
+    case BinaryOp::UnsignedRightShift:
+        generator.emit<Op::UnsignedRightShift>(lhs);
+        return;
+    case BinaryOp::In:
+        generator.emit<Op::In>(lhs);
+        return;
+    case BinaryOp::InstanceOf:
+        generator.emit<Op::InstanceOf>(lhs);
+        return;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+void BinaryExpression::generate_bytecode(Bytecode::Generator& generator) const
+{
+    m_lhs->generate_bytecode(generator);
+    auto lhs_reg = generator.allocate_register();
+    generator.emit<Op::Store>(lhs_reg);
+
+    m_rhs->generate_bytecode(generator);
+    emit_binary_op(generator, m_op, lhs_reg);
+}
+
+// Jumps past the right hand side of a logical expression (or assignment) if the left hand side, which is
+// in the accumulator, already decides the result.
+static InstructionHandle<Op::Jump> emit_short_circuit_jump(Bytecode::Generator& generator, LogicalOp op)
+{
+    switch (op) {
+    case LogicalOp::And:
+        return generator.emit<Op::JumpIfFalse>();
+    case LogicalOp::Or:
+        return generator.emit<Op::JumpIfTrue>();
+    case LogicalOp::NullishCoalescing:
+        return generator.emit<Op::JumpIfNotNullish>();
+    }
+    VERIFY_NOT_REACHED();
+}
+
+void LogicalExpression::generate_bytecode(Bytecode::Generator& generator) const
+{
+    m_lhs->generate_bytecode(generator);
+    auto jump_to_end = emit_short_circuit_jump(generator, m_op);
+    m_rhs->generate_bytecode(generator);
+    jump_to_end->set_target(generator.make_label());
+}
+
+void UnaryExpression::generate_bytecode(Bytecode::Generator& generator) const
+{
+    if (m_op == UnaryOp::Delete) {
+        generator.unsupported(*this);
+        return;
+    }
+
+    if (m_op == UnaryOp::Typeof && is<Identifier>(*m_lhs)) {
+        auto& identifier = static_cast<const Identifier&>(*m_lhs);
+        generator.emit<Op::TypeofVariable>(identifier.string(), identifier.environment_coordinate());
+        return;
+    }
+
+    m_lhs->generate_bytecode(generator);
+
+    switch (m_op) {
+    case UnaryOp::BitwiseNot:
+        generator.emit<Op::BitwiseNot>();
+        return;
+    case UnaryOp::Not:
+        generator.emit<Op::Not>();
+        return;
+    case UnaryOp::Plus:
+        generator.emit<Op::UnaryPlus>();
+        return;
+    case UnaryOp::Minus:
+        generator.emit<Op::UnaryMinus>();
+        return;
+    case UnaryOp::Typeof:
+        generator.emit<Op::Typeof>();
+        return;
+    case UnaryOp::Void:
+        generator.emit<Op::LoadImmediate>(js_undefined());
+        return;
+    case UnaryOp::Delete:
+        break;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+void SequenceExpression::generate_bytecode(Bytecode::Generator& generator) const
+{
+    for (auto& expression : m_expressions)
+        expression.generate_bytecode(generator);
+}
+
+void ConditionalExpression::generate_bytecode(Bytecode::Generator& generator) const
+{
+    m_test->generate_bytecode(generator);
+    auto jump_to_alternate = generator.emit<Op::JumpIfFalse>();
+
+    m_consequent->generate_bytecode(generator);
+    auto jump_to_end = generator.emit<Op::Jump>();
+
+    jump_to_alternate->set_target(generator.make_label());
+    m_alternate->generate_bytecode(generator);
+    jump_to_end->set_target(generator.make_label());
+}
+
+// The target of an assignment or update, with everything evaluated that has to be before reading or writing
+// it: the base object of a member expression and the name of a computed property, which end up in registers.
+class AssignmentTarget {
+public:
+    static Optional<AssignmentTarget> generate(Bytecode::Generator& generator, const Expression& expression)
+    {
+        if (is<Identifier>(expression))
+            return AssignmentTarget { static_cast<const Identifier&>(expression) };
+
+        if (is<MemberExpression>(expression)) {
+            auto& member_expression = static_cast<const MemberExpression&>(expression);
+            if (is<SuperExpression>(member_expression.object())) {
+                generator.unsupported(expression);
+                return {};
+            }
+
+            member_expression.object().generate_bytecode(generator);
+            auto base = generator.allocate_register();
+            generator.emit<Op::Store>(base);
+
+            if (!member_expression.is_computed())
+                return AssignmentTarget { base, static_cast<const Identifier&>(member_expression.property()).string() };
+
+            member_expression.property().generate_bytecode(generator);
+            auto property = generator.allocate_register();
+            generator.emit<Op::Store>(property);
+            return AssignmentTarget { base, property };
+        }
+
+        // Destructuring and the like.
+        generator.unsupported(expression);
+        return {};
+    }
+
+    // Reads the target into the accumulator.
+    void emit_load(Bytecode::Generator& generator) const
+    {
+        if (!m_base.has_value()) {
+            generator.emit<Op::GetVariable>(m_name, m_environment_coordinate);
+        } else if (m_property.has_value()) {
+            generator.emit<Op::Load>(*m_property);
+            generator.emit<Op::GetByValue>(*m_base);
+        } else {
+            generator.emit<Op::Load>(*m_base);
+            generator.emit<Op::GetById>(m_name);
+        }
+    }
+
+    // Writes the accumulator to the target, and leaves it in the accumulator.
+    void emit_store(Bytecode::Generator& generator) const
+    {
+        if (!m_base.has_value())
+            generator.emit<Op::SetVariable>(m_name, m_environment_coordinate, Op::SetVariable::Mode::Assign);
+        else if (m_property.has_value())
+            generator.emit<Op::PutByValue>(*m_base, *m_property);
+        else
+            generator.emit<Op::PutById>(*m_base, m_name);
+    }
+
+private:
+    explicit AssignmentTarget(const Identifier& identifier)
+        : m_name(identifier.string())
+        , m_environment_coordinate(identifier.environment_coordinate())
+    {
+    }
+
+    AssignmentTarget(Register base, FlyString name)
+        : m_base(base)
+        , m_name(move(name))
+    {
+    }
+
+    AssignmentTarget(Register base, Register property)
+        : m_base(base)
+        , m_property(property)
+    {
+    }
+
+    Optional<Register> m_base;
+    Optional<Register> m_property;
+    FlyString m_name;
+    EnvironmentCoordinate m_environment_coordinate;
+};
+
+static Optional<BinaryOp> binary_op_for_assignment(AssignmentOp op)
+{
+    switch (op) {
+    case AssignmentOp::AdditionAssignment:
+        return BinaryOp::Addition;
+    case AssignmentOp::SubtractionAssignment:
+        return BinaryOp::Subtraction;
+    case AssignmentOp::MultiplicationAssignment:
+        return BinaryOp::Multiplication;
+    case AssignmentOp::DivisionAssignment:
+        return BinaryOp::Division;
+    case AssignmentOp::ModuloAssignment:
+        return BinaryOp::Modulo;
+    case AssignmentOp::ExponentiationAssignment:
+        return BinaryOp::Exponentiation;
+    case AssignmentOp::BitwiseAndAssignment:
+        return BinaryOp::BitwiseAnd;
+    case AssignmentOp::BitwiseOrAssignment:
+        return BinaryOp::BitwiseOr;
+    case AssignmentOp::BitwiseXorAssignment:
+        return BinaryOp::BitwiseXor;
+    case AssignmentOp::LeftShiftAssignment:
+        return BinaryOp::LeftShift;
+    case AssignmentOp::RightShiftAssignment:
+        return BinaryOp::RightShift;
+    case AssignmentOp::UnsignedRightShiftAssignment:
+        return BinaryOp::UnsignedRightShift;
+    default:
+        return {};
+    }
+}
+
+static Optional<LogicalOp> logical_op_for_assignment(AssignmentOp op)
+{
+    switch (op) {
+    case AssignmentOp::AndAssignment:
+        return LogicalOp::And;
+    case AssignmentOp::OrAssignment:
+        return LogicalOp::Or;
+    case AssignmentOp::NullishAssignment:
+        return LogicalOp::NullishCoalescing;
+    default:
+        return {};
+    }
+}
+
+void AssignmentExpression::generate_bytecode(Bytecode::Generator& generator) const
+{
+    auto target = AssignmentTarget::generate(generator, m_lhs);
+    if (!target.has_value())
+        return;
+
+    if (m_op == AssignmentOp::Assignment) {
+        m_rhs->generate_bytecode(generator);
+        target->emit_store(generator);
+        return;
+    }
+
+    target->emit_load(generator);
+
+    if (auto logical_op = logical_op_for_assignment(m_op); logical_op.has_value()) {
+        auto jump_to_end = emit_short_circuit_jump(generator, *logical_op);
+        m_rhs->generate_bytecode(generator);
+        target->emit_store(generator);
+        jump_to_end->set_target(generator.make_label());
+        return;
+    }
+
+    auto lhs_reg = generator.allocate_register();
+    generator.emit<Op::Store>(lhs_reg);
+    m_rhs->generate_bytecode(generator);
+    emit_binary_op(generator, binary_op_for_assignment(m_op).value(), lhs_reg);
+    target->emit_store(generator);
+}
+
+void UpdateExpression::generate_bytecode(Bytecode::Generator& generator) const
+{
+    auto target = AssignmentTarget::generate(generator, m_argument);
+    if (!target.has_value())
+        return;
+
+    target->emit_load(generator);
+    generator.emit<Op::ToNumeric>();
+
+    Optional<Register> old_value;
+    if (!m_prefixed) {
+        old_value = generator.allocate_register();
+        generator.emit<Op::Store>(*old_value);
+    }
+
+    if (m_op == UpdateOp::Increment)
+        generator.emit<Op::Increment>();
+    else
+        generator.emit<Op::Decrement>();
+    target->emit_store(generator);
+
+    if (old_value.has_value())
+        generator.emit<Op::Load>(*old_value);
+}
+
+void MemberExpression::generate_bytecode(Bytecode::Generator& generator) const
+{
+    if (is<SuperExpression>(*m_object)) {
+        generator.unsupported(*this);
+        return;
+    }
+
+    m_object->generate_bytecode(generator);
+    if (!is_computed()) {
+        generator.emit<Op::GetById>(static_cast<const Identifier&>(*m_property).string());
+        return;
+    }
+
+    auto object_reg = generator.allocate_register();
+    generator.emit<Op::Store>(object_reg);
+    m_property->generate_bytecode(generator);
+    generator.emit<Op::GetByValue>(object_reg);
+}
+
+void CallExpression::generate_bytecode(Bytecode::Generator& generator) const
+{
+    if (is<SuperExpression>(*m_callee)) {
+        generator.unsupported(*this);
+        return;
+    }
+    for (auto& argument : m_arguments) {
+        if (argument.is_spread) {
+            generator.unsupported(*this);
+            return;
+        }
+    }
+
+    Optional<Register> this_reg;
+    if (!is<NewExpression>(*this) && is<MemberExpression>(*m_callee)) {
+        auto& member_expression = static_cast<const MemberExpression&>(*m_callee);
+        if (is<SuperExpression>(member_expression.object())) {
+            generator.unsupported(*this);
+            return;
+        }
+        member_expression.object().generate_bytecode(generator);
+        this_reg = generator.allocate_register();
+        generator.emit<Op::Store>(*this_reg);
+        if (member_expression.is_computed()) {
+            member_expression.property().generate_bytecode(generator);
+            generator.emit<Op::GetByValue>(*this_reg);
+        } else {
+            generator.emit<Op::GetById>(static_cast<const Identifier&>(member_expression.property()).string());
+        }
+    } else {
+        m_callee->generate_bytecode(generator);
+    }
+    auto callee_reg = generator.allocate_register();
+    generator.emit<Op::Store>(callee_reg);
+
+    Vector<Register> argument_regs;
+    argument_regs.ensure_capacity(m_arguments.size());
+    for (auto& argument : m_arguments) {
+        argument.value->generate_bytecode(generator);
+        auto argument_reg = generator.allocate_register();
+        generator.emit<Op::Store>(argument_reg);
+        argument_regs.unchecked_append(argument_reg);
+    }
+
+    auto call_type = is<NewExpression>(*this) ? Op::Call::CallType::Construct : Op::Call::CallType::Call;
+    generator.emit_with_extra_register_slots<Op::Call>(argument_regs.size(), call_type, callee_reg, this_reg, *this, argument_regs.span());
+}
+
+void ObjectExpression::generate_bytecode(Bytecode::Generator& generator) const
+{
+    generator.emit<Op::NewObject>();
+    auto object_reg = generator.allocate_register();
+    generator.emit<Op::Store>(object_reg);
+
+    for (auto& property : m_properties) {
+        if (property.type() != ObjectProperty::Type::KeyValue) {
+            generator.unsupported(property);
+            return;
+        }
+        property.key().generate_bytecode(generator);
+        auto key_reg = generator.allocate_register();
+        generator.emit<Op::Store>(key_reg);
+        property.value().generate_bytecode(generator);
+        generator.emit<Op::DefineProperty>(object_reg, key_reg, property.is_method());
+    }
+
+    generator.emit<Op::Load>(object_reg);
+}
+
+void ArrayExpression::generate_bytecode(Bytecode::Generator& generator) const
+{
+    Vector<Register> element_regs;
+    element_regs.ensure_capacity(m_elements.size());
+    for (auto& element : m_elements) {
+        if (!element) {
+            // A hole.
+            generator.emit<Op::LoadImmediate>(Value());
+        } else if (is<SpreadExpression>(*element)) {
+            generator.unsupported(*element);
+            return;
+        } else {
+            element->generate_bytecode(generator);
+        }
+        auto element_reg = generator.allocate_register();
+        generator.emit<Op::Store>(element_reg);
+        element_regs.unchecked_append(element_reg);
+    }
+    generator.emit_with_extra_register_slots<Op::NewArray>(element_regs.size(), element_regs.span());
+}
+
+void TemplateLiteral::generate_bytecode(Bytecode::Generator& generator) const
+{
+    generator.emit<Op::NewString>(String::empty());
+    auto string_reg = generator.allocate_register();
+    generator.emit<Op::Store>(string_reg);
+
+    for (auto& expression : m_expressions) {
+        expression.generate_bytecode(generator);
+        generator.emit<Op::ConcatString>(string_reg);
+    }
+
+    generator.emit<Op::Load>(string_reg);
+}
+
+}
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Format.h>
+#include <LibJS/AST.h>
+#include <LibJS/Bytecode/Block.h>
+#include <LibJS/Bytecode/Instruction.h>
+
+namespace JS::Bytecode {
+
+// Every instruction starts on a boundary suitable for any of its members.
+static constexpr size_t instruction_alignment = alignof(void*);
+
+NonnullOwnPtr<Block> Block::create()
+{
+    return adopt_own(*new Block);
+}
+
+Block::~Block()
+{
+    for (size_t offset = 0; offset < m_buffer.size();) {
+        auto& instruction = *reinterpret_cast<Instruction*>(instruction_at(offset));
+        offset += instruction.length();
+        Instruction::destroy(instruction);
+    }
+}
+
+size_t Block::allocate_instruction(size_t size)
+{
+    auto offset = m_buffer.size();
+    m_buffer.resize(offset + align_up_to(size, instruction_alignment));
+    return offset;
+}
+
+void Block::dump() const
+{
+    outln("Block with {} registers:", m_register_count);
+    for (size_t offset = 0; offset < m_buffer.size();) {
+        auto& instruction = *reinterpret_cast<const Instruction*>(m_buffer.data() + offset);
+        outln("[{:4x}] {}", offset, instruction.to_string());
+        offset += instruction.length();
+    }
+}
+
+}
@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/NonnullOwnPtr.h>
+#include <AK/NonnullRefPtrVector.h>
+#include <AK/Span.h>
+#include <AK/Vector.h>
+#include <LibJS/Forward.h>
+
+namespace JS::Bytecode {
+
+template<typename OpType>
+class InstructionHandle;
+
+// The instructions for a program or a function body, and how many registers running them takes.
+class Block {
+    AK_MAKE_NONCOPYABLE(Block);
+    AK_MAKE_NONMOVABLE(Block);
+
+public:
+    static NonnullOwnPtr<Block> create();
+    ~Block();
+
+    ReadonlyBytes instruction_stream() const { return m_buffer.span(); }
+    size_t register_count() const { return m_register_count; }
+
+    void dump() const;
+
+private:
+    friend class Generator;
+    template<typename OpType>
+    friend class InstructionHandle;
+
+    Block() = default;
+
+    // Makes room for an instruction of the given size at the end of the buffer, and returns its offset.
+    size_t allocate_instruction(size_t size);
+    u8* instruction_at(size_t offset) { return m_buffer.data() + offset; }
+
+    Vector<u8> m_buffer;
+    size_t m_register_count { 0 };
+
+    // Nodes the generator made up, which the instructions refer to.
+    NonnullRefPtrVector<ASTNode> m_synthesized_nodes;
+};
+
+}
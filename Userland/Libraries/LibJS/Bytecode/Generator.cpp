@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <LibJS/AST.h>
+#include <LibJS/Bytecode/Generator.h>
+
+namespace JS::Bytecode {
+
+Generator::Generator()
+    : m_block(Block::create())
+{
+}
+
+OwnPtr<Block> Generator::generate(const ScopeNode& node)
+{
+    Generator generator;
+
+    // Programs complete with the value of the last expression statement, functions with undefined unless
+    // they return something.
+    if (is<Program>(node)) {
+        generator.m_completion_register = generator.allocate_register();
+        generator.emit<Op::LoadImmediate>(js_undefined());
+        generator.emit<Op::Store>(*generator.m_completion_register);
+    }
+
+    generator.emit_enter_scope(node, is<Program>(node) ? ScopeType::Block : ScopeType::Function);
+    for (auto& child : node.children()) {
+        child.generate_bytecode(generator);
+        if (generator.is_unsupported())
+            return {};
+    }
+    generator.emit_leave_scope();
+
+    if (generator.m_completion_register.has_value())
+        generator.emit<Op::Load>(*generator.m_completion_register);
+    else
+        generator.emit<Op::LoadImmediate>(js_undefined());
+    generator.emit<Op::Return>();
+
+    generator.m_block->m_register_count = generator.m_next_register;
+    return move(generator.m_block);
+}
+
+Register Generator::allocate_register()
+{
+    return Register(m_next_register++);
+}
+
+void Generator::emit_enter_scope(const ScopeNode& scope_node, ScopeType scope_type)
+{
+    emit<Op::EnterScope>(scope_node, scope_type);
+    ++m_scope_depth;
+}
+
+void Generator::emit_leave_scope()
+{
+    VERIFY(m_scope_depth > 0);
+    emit<Op::LeaveScope>();
+    --m_scope_depth;
+}
+
+void Generator::emit_leave_scopes_until(size_t depth)
+{
+    // Only leaves the scopes at runtime: the code after the jump is still in them.
+    for (auto i = depth; i < m_scope_depth; ++i)
+        emit<Op::LeaveScope>();
+}
+
+void Generator::begin_jump_scope(const FlyString& label, bool is_loop)
+{
+    m_jump_scopes.append({ label, is_loop, m_scope_depth, {}, {} });
+}
+
+void Generator::end_jump_scope(Label break_target, Optional<Label> continue_target)
+{
+    auto jump_scope = m_jump_scopes.take_last();
+    VERIFY(jump_scope.scope_depth == m_scope_depth);
+    for (auto& jump : jump_scope.break_jumps)
+        jump->set_target(break_target);
+    if (!jump_scope.continue_jumps.is_empty()) {
+        VERIFY(continue_target.has_value());
+        for (auto& jump : jump_scope.continue_jumps)
+            jump->set_target(*continue_target);
+    }
+}
+
+Generator::JumpScope* Generator::find_jump_scope(const FlyString& label, bool for_continue)
+{
+    for (ssize_t i = m_jump_scopes.size() - 1; i >= 0; --i) {
+        auto& jump_scope = m_jump_scopes[i];
+        if (label.is_null()) {
+            // Unlabelled break and continue go to the innermost loop.
+            if (jump_scope.is_loop)
+                return &jump_scope;
+            continue;
+        }
+        if (jump_scope.label == label) {
+            if (for_continue && !jump_scope.is_loop)
+                return nullptr;
+            return &jump_scope;
+        }
+    }
+    return nullptr;
+}
+
+void Generator::emit_break(const FlyString& label)
+{
+    auto* jump_scope = find_jump_scope(label, false);
+    if (!jump_scope) {
+        // Probably breaking out of a switch or a labelled statement the generator doesn't handle.
+        m_is_unsupported = true;
+        return;
+    }
+    emit_leave_scopes_until(jump_scope->scope_depth);
+    jump_scope->break_jumps.append(emit<Op::Jump>());
+}
+
+void Generator::emit_continue(const FlyString& label)
+{
+    auto* jump_scope = find_jump_scope(label, true);
+    if (!jump_scope) {
+        m_is_unsupported = true;
+        return;
+    }
+    emit_leave_scopes_until(jump_scope->scope_depth);
+    jump_scope->continue_jumps.append(emit<Op::Jump>());
+}
+
+void Generator::retain_node(NonnullRefPtr<ASTNode> node)
+{
+    m_block->m_synthesized_nodes.append(move(node));
+}
+
+void Generator::unsupported(const ASTNode& node)
+{
+    if (!m_is_unsupported)
+        dbgln_if(BYTECODE_DEBUG, "Bytecode::Generator: {} isn't supported yet, falling back to the AST interpreter", node.class_name());
+    m_is_unsupported = true;
+}
+
+}
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/FlyString.h>
+#include <AK/Noncopyable.h>
+#include <AK/OwnPtr.h>
+#include <AK/Vector.h>
+#include <LibJS/Bytecode/Block.h>
+#include <LibJS/Bytecode/Label.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/Register.h>
+#include <LibJS/Forward.h>
+
+namespace JS::Bytecode {
+
+// Refers to an instruction that may still need patching, such as a jump to a label that hasn't been placed
+// yet. It's an offset rather than a pointer since the buffer moves around while it grows.
+template<typename OpType>
+class InstructionHandle {
+public:
+    InstructionHandle(Block& block, size_t offset)
+        : m_block(&block)
+        , m_offset(offset)
+    {
+    }
+
+    // So that any kind of jump can be patched through a handle to the Jump they all derive from.
+    template<typename DerivedOpType>
+    InstructionHandle(const InstructionHandle<DerivedOpType>& other) requires(IsBaseOf<OpType, DerivedOpType>)
+        : m_block(other.m_block)
+        , m_offset(other.m_offset)
+    {
+    }
+
+    OpType& operator*() { return *reinterpret_cast<OpType*>(m_block->instruction_at(m_offset)); }
+    OpType* operator->() { return &**this; }
+
+private:
+    template<typename OtherOpType>
+    friend class InstructionHandle;
+
+    Block* m_block { nullptr };
+    size_t m_offset { 0 };
+};
+
+// Lowers the AST of a program or function body into a Block. Each node emits its own instructions through
+// ASTNode::generate_bytecode(); nodes that don't know how to do that yet call unsupported(), and then the
+// whole program or function body falls back to the AST interpreter.
+class Generator {
+    AK_MAKE_NONCOPYABLE(Generator);
+    AK_MAKE_NONMOVABLE(Generator);
+
+public:
+    // Returns null if there's anything in the node the generator doesn't handle yet. The node has to outlive
+    // the block, which refers back to parts of it.
+    static OwnPtr<Block> generate(const ScopeNode&);
+
+    Register allocate_register();
+
+    template<typename OpType, typename... Args>
+    InstructionHandle<OpType> emit(Args&&... args)
+    {
+        return emit_with_extra_register_slots<OpType>(0, forward<Args>(args)...);
+    }
+
+    // For ops that keep a variable number of registers behind themselves.
+    template<typename OpType, typename... Args>
+    InstructionHandle<OpType> emit_with_extra_register_slots(size_t extra_register_slots, Args&&... args)
+    {
+        auto size = sizeof(OpType) + extra_register_slots * sizeof(Register);
+        auto offset = m_block->allocate_instruction(size);
+        auto* instruction = new (m_block->instruction_at(offset)) OpType(forward<Args>(args)...);
+        instruction->m_length = m_block->m_buffer.size() - offset;
+        return { *m_block, offset };
+    }
+
+    // The address the next instruction will be emitted at.
+    Label make_label() const { return Label(m_block->m_buffer.size()); }
+
+    void emit_enter_scope(const ScopeNode&, ScopeType);
+    void emit_leave_scope();
+
+    // Loops and labelled blocks, which break and continue statements jump out of. Jumps are collected while
+    // generating the body, and only pointed at their targets once those are known.
+    void begin_jump_scope(const FlyString& label, bool is_loop);
+    void end_jump_scope(Label break_target, Optional<Label> continue_target = {});
+    void emit_break(const FlyString& label);
+    void emit_continue(const FlyString& label);
+
+    // Where the value of each expression statement goes, when generating a program.
+    Optional<Register> completion_register() const { return m_completion_register; }
+
+    // Keeps a node the generator made up alive for as long as the block.
+    void retain_node(NonnullRefPtr<ASTNode>);
+
+    void unsupported(const ASTNode&);
+    bool is_unsupported() const { return m_is_unsupported; }
+
+private:
+    Generator();
+
+    struct JumpScope {
+        FlyString label;
+        bool is_loop { false };
+        size_t scope_depth { 0 };
+        Vector<InstructionHandle<Op::Jump>> break_jumps;
+        Vector<InstructionHandle<Op::Jump>> continue_jumps;
+    };
+
+    JumpScope* find_jump_scope(const FlyString& label, bool for_continue);
+    void emit_leave_scopes_until(size_t depth);
+
+    NonnullOwnPtr<Block> m_block;
+    u32 m_next_register { Register::accumulator_index + 1 };
+    Optional<Register> m_completion_register;
+
+    // How many scopes the instructions emitted so far have entered and not left yet.
+    size_t m_scope_depth { 0 };
+    Vector<JumpScope> m_jump_scopes;
+
+    bool m_is_unsupported { false };
+};
+
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Forward.h>
+#include <AK/Types.h>
+#include <LibJS/Forward.h>
+
+#define ENUMERATE_BYTECODE_OPS(O) \
+    O(AbstractEquals)             \
+    O(AbstractInequals)           \
+    O(Add)                        \
+    O(BitwiseAnd)                 \
+    O(BitwiseNot)                 \
+    O(BitwiseOr)                  \
+    O(BitwiseXor)                 \
+    O(Call)                       \
+    O(ConcatString)               \
+    O(Decrement)                  \
+    O(DefineProperty)             \
+    O(Div)                        \
+    O(EnterScope)                 \
+    O(Exp)                        \
+    O(GetById)                    \
+    O(GetByValue)                 \
+    O(GetVariable)                \
+    O(GreaterThan)                \
+    O(GreaterThanEquals)          \
+    O(In)                         \
+    O(Increment)                  \
+    O(InstanceOf)                 \
+    O(Jump)                       \
+    O(JumpIfFalse)                \
+    O(JumpIfNotNullish)           \
+    O(JumpIfTrue)                 \
+    O(LeaveScope)                 \
+    O(LeftShift)                  \
+    O(LessThan)                   \
+    O(LessThanEquals)             \
+    O(Load)                       \
+    O(LoadImmediate)              \
+    O(Mod)                        \
+    O(Mul)                        \
+    O(NewArray)                   \
+    O(NewBigInt)                  \
+    O(NewFunction)                \
+    O(NewObject)                  \
+    O(NewString)                  \
+    O(Not)                        \
+    O(PutById)                    \
+    O(PutByValue)                 \
+    O(ResolveThisBinding)         \
+    O(Return)                     \
+    O(RightShift)                 \
+    O(SetVariable)                \
+    O(Store)                      \
+    O(Sub)                        \
+    O(Throw)                      \
+    O(ToNumeric)                  \
+    O(TypedEquals)                \
+    O(TypedInequals)              \
+    O(Typeof)                     \
+    O(TypeofVariable)             \
+    O(UnaryMinus)                 \
+    O(UnaryPlus)                  \
+    O(UnsignedRightShift)
+
+namespace JS::Bytecode {
+
+// Every op starts with one of these. Ops live back to back in a Block's buffer, so they're told apart by
+// their type rather than through virtual functions, and the ones with a variable number of operands keep
+// them right behind themselves.
+class Instruction {
+public:
+    enum class Type : u8 {
+#define __BYTECODE_OP(op) \
+    op,
+        ENUMERATE_BYTECODE_OPS(__BYTECODE_OP)
+#undef __BYTECODE_OP
+    };
+
+    Type type() const { return m_type; }
+
+    // The size of the op including any operands that trail it, i.e. the distance to the next one.
+    size_t length() const { return m_length; }
+
+    String to_string() const;
+
+    static void destroy(Instruction&);
+
+protected:
+    explicit Instruction(Type type)
+        : m_type(type)
+    {
+    }
+
+private:
+    friend class Generator;
+
+    Type m_type;
+    u32 m_length { 0 };
+};
+
+}
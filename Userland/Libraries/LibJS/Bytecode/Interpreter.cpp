@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ScopeGuard.h>
+#include <AK/TemporaryChange.h>
+#include <LibJS/AST.h>
+#include <LibJS/Bytecode/Block.h>
+#include <LibJS/Bytecode/Instruction.h>
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Interpreter.h>
+#include <LibJS/Runtime/GlobalObject.h>
+#include <LibJS/Runtime/VM.h>
+
+namespace JS::Bytecode {
+
+Interpreter::Interpreter(VM& vm)
+    : m_vm(vm)
+{
+    VERIFY(!vm.bytecode_interpreter_if_exists());
+    vm.set_bytecode_interpreter({}, this);
+}
+
+Interpreter::~Interpreter()
+{
+    m_vm.set_bytecode_interpreter({}, nullptr);
+}
+
+Value Interpreter::run(const Block& block, GlobalObject& global_object)
+{
+    auto& vm = this->vm();
+    VERIFY(!vm.exception());
+
+    Vector<Value, 32> registers;
+    registers.resize(block.register_count());
+
+    TemporaryChange<GlobalObject*> global_object_change(m_global_object, &global_object);
+    TemporaryChange<Value*> registers_change(m_registers, registers.data());
+    m_register_windows.append(&registers);
+
+    auto entered_scope_count = m_entered_scopes.size();
+
+    auto* instructions = block.instruction_stream().data();
+    size_t pc = 0;
+    for (;;) {
+        auto& instruction = *reinterpret_cast<const Instruction*>(instructions + pc);
+
+        switch (instruction.type()) {
+#define __BYTECODE_OP(op)                                               \
+    case Instruction::Type::op:                                         \
+        static_cast<const Bytecode::Op::op&>(instruction).execute(*this); \
+        break;
+            ENUMERATE_BYTECODE_OPS(__BYTECODE_OP)
+#undef __BYTECODE_OP
+        default:
+            VERIFY_NOT_REACHED();
+        }
+
+        if (vm.exception())
+            break;
+        if (m_pending_jump.has_value()) {
+            pc = m_pending_jump.release_value();
+            continue;
+        }
+        if (m_return_value.has_value())
+            break;
+        pc += instruction.length();
+    }
+
+    // Whether the block returned or threw, it still has to leave whatever scopes it's in.
+    while (m_entered_scopes.size() > entered_scope_count)
+        leave_scope();
+
+    m_register_windows.take_last();
+
+    if (vm.exception()) {
+        m_return_value.clear();
+        return {};
+    }
+    return m_return_value.release_value();
+}
+
+void Interpreter::enter_scope(const ScopeNode& scope_node, ScopeType scope_type)
+{
+    vm().interpreter().enter_scope(scope_node, scope_type, global_object());
+    // The AST interpreter doesn't push the scope if declaring a variable throws.
+    if (!vm().exception())
+        m_entered_scopes.append(&scope_node);
+}
+
+void Interpreter::leave_scope()
+{
+    vm().interpreter().exit_scope(*m_entered_scopes.take_last());
+}
+
+void Interpreter::gather_roots(HashTable<Cell*>& roots)
+{
+    for (auto* registers : m_register_windows) {
+        for (auto& value : *registers) {
+            if (value.is_cell())
+                roots.set(value.as_cell());
+        }
+    }
+    if (m_return_value.has_value() && m_return_value->is_cell())
+        roots.set(m_return_value->as_cell());
+}
+
+}
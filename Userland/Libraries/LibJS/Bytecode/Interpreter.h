@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashTable.h>
+#include <AK/Noncopyable.h>
+#include <AK/Optional.h>
+#include <AK/Vector.h>
+#include <LibJS/Bytecode/Label.h>
+#include <LibJS/Bytecode/Register.h>
+#include <LibJS/Forward.h>
+#include <LibJS/Runtime/Value.h>
+
+namespace JS::Bytecode {
+
+class Block;
+
+// While one of these exists, programs and functions run on bytecode rather than on the AST, except for those
+// that use something the generator doesn't handle yet.
+class Interpreter {
+    AK_MAKE_NONCOPYABLE(Interpreter);
+    AK_MAKE_NONMOVABLE(Interpreter);
+
+public:
+    explicit Interpreter(VM&);
+    ~Interpreter();
+
+    VM& vm() { return m_vm; }
+    GlobalObject& global_object() { return *m_global_object; }
+
+    // Runs block in the current call frame, with a fresh set of registers. Returns an empty value if it threw.
+    Value run(const Block&, GlobalObject&);
+
+    ALWAYS_INLINE Value& accumulator() { return reg(Register::accumulator()); }
+    ALWAYS_INLINE Value& reg(Register r) { return m_registers[r.index()]; }
+
+    void jump(Label label) { m_pending_jump = label.address(); }
+    void do_return(Value return_value) { m_return_value = return_value; }
+
+    void enter_scope(const ScopeNode&, ScopeType);
+    void leave_scope();
+
+    void gather_roots(HashTable<Cell*>&);
+
+private:
+    VM& m_vm;
+    GlobalObject* m_global_object { nullptr };
+
+    // The registers of the block that's running right now. Each run() has its own, so these only have to be
+    // swapped out when one block calls into another.
+    Value* m_registers { nullptr };
+    Vector<Vector<Value, 32>*> m_register_windows;
+
+    // The scopes the running blocks have entered, which they leave again however they stop running.
+    Vector<const ScopeNode*> m_entered_scopes;
+
+    Optional<size_t> m_pending_jump;
+    Optional<Value> m_return_value;
+};
+
+}
@@ -0,0 +1,486 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/StringBuilder.h>
+#include <LibJS/AST.h>
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Runtime/Array.h>
+#include <LibJS/Runtime/BigInt.h>
+#include <LibJS/Runtime/GlobalObject.h>
+#include <LibJS/Runtime/MarkedValueList.h>
+#include <LibJS/Runtime/NativeFunction.h>
+#include <LibJS/Runtime/PrimitiveString.h>
+#include <LibJS/Runtime/Reference.h>
+#include <LibJS/Runtime/ScriptFunction.h>
+#include <LibJS/Runtime/Value.h>
+
+namespace JS::Bytecode::Op {
+
+void Load::execute(Bytecode::Interpreter& interpreter) const
+{
+    interpreter.accumulator() = interpreter.reg(m_src);
+}
+
+void LoadImmediate::execute(Bytecode::Interpreter& interpreter) const
+{
+    interpreter.accumulator() = m_value;
+}
+
+void Store::execute(Bytecode::Interpreter& interpreter) const
+{
+    interpreter.reg(m_dst) = interpreter.accumulator();
+}
+
+static Value abstract_inequals(GlobalObject& global_object, Value lhs, Value rhs)
+{
+    return Value(!abstract_eq(global_object, lhs, rhs));
+}
+
+static Value abstract_equals(GlobalObject& global_object, Value lhs, Value rhs)
+{
+    return Value(abstract_eq(global_object, lhs, rhs));
+}
+
+static Value typed_inequals(GlobalObject&, Value lhs, Value rhs)
+{
+    return Value(!strict_eq(lhs, rhs));
+}
+
+static Value typed_equals(GlobalObject&, Value lhs, Value rhs)
+{
+    return Value(strict_eq(lhs, rhs));
+}
+
+#define JS_DEFINE_COMMON_BINARY_OP(OpTitleCase, op_snake_case)                                                         \
+    void OpTitleCase::execute(Bytecode::Interpreter& interpreter) const                                                 \
+    {                                                                                                                   \
+        auto lhs = interpreter.reg(m_lhs_reg);                                                                          \
+        auto rhs = interpreter.accumulator();                                                                           \
+        auto result = op_snake_case(interpreter.global_object(), lhs, rhs);                                             \
+        if (!interpreter.vm().exception())                                                                              \
+            interpreter.accumulator() = result;                                                                         \
+    }                                                                                                                   \
+                                                                                                                        \
+    String OpTitleCase::to_string() const                                                                               \
+    {                                                                                                                   \
+        return String::formatted(#OpTitleCase " {}", m_lhs_reg);                                                        \
+    }
+
+JS_ENUMERATE_COMMON_BINARY_OPS(JS_DEFINE_COMMON_BINARY_OP)
+#undef JS_DEFINE_COMMON_BINARY_OP
+
+static Value not_(GlobalObject&, Value value)
+{
+    return Value(!value.to_boolean());
+}
+
+static Value typeof_(GlobalObject& global_object, Value value)
+{
+    return js_string(global_object.vm(), value.typeof());
+}
+
+static Value to_numeric(GlobalObject& global_object, Value value)
+{
+    return value.to_numeric(global_object);
+}
+
+// Increment and Decrement expect a value that went through ToNumeric already.
+static Value increment(GlobalObject& global_object, Value value)
+{
+    if (value.is_number())
+        return Value(value.as_double() + 1);
+    return js_bigint(global_object.heap(), value.as_bigint().big_integer().plus(Crypto::SignedBigInteger { 1 }));
+}
+
+static Value decrement(GlobalObject& global_object, Value value)
+{
+    if (value.is_number())
+        return Value(value.as_double() - 1);
+    return js_bigint(global_object.heap(), value.as_bigint().big_integer().minus(Crypto::SignedBigInteger { 1 }));
+}
+
+#define JS_DEFINE_COMMON_UNARY_OP(OpTitleCase, op_snake_case)                                       \
+    void OpTitleCase::execute(Bytecode::Interpreter& interpreter) const                             \
+    {                                                                                               \
+        auto result = op_snake_case(interpreter.global_object(), interpreter.accumulator());        \
+        if (!interpreter.vm().exception())                                                          \
+            interpreter.accumulator() = result;                                                     \
+    }                                                                                               \
+                                                                                                    \
+    String OpTitleCase::to_string() const                                                           \
+    {                                                                                               \
+        return #OpTitleCase;                                                                        \
+    }
+
+JS_ENUMERATE_COMMON_UNARY_OPS(JS_DEFINE_COMMON_UNARY_OP)
+#undef JS_DEFINE_COMMON_UNARY_OP
+
+void NewString::execute(Bytecode::Interpreter& interpreter) const
+{
+    interpreter.accumulator() = js_string(interpreter.vm(), m_string);
+}
+
+void NewBigInt::execute(Bytecode::Interpreter& interpreter) const
+{
+    interpreter.accumulator() = js_bigint(interpreter.vm().heap(), m_bigint);
+}
+
+void NewObject::execute(Bytecode::Interpreter& interpreter) const
+{
+    interpreter.accumulator() = Object::create_empty(interpreter.global_object());
+}
+
+void NewArray::execute(Bytecode::Interpreter& interpreter) const
+{
+    auto* array = Array::create(interpreter.global_object());
+    for (size_t i = 0; i < m_element_count; ++i)
+        array->indexed_properties().append(interpreter.reg(m_elements[i]));
+    interpreter.accumulator() = array;
+}
+
+void NewFunction::execute(Bytecode::Interpreter& interpreter) const
+{
+    auto& vm = interpreter.vm();
+    auto& function = m_function_expression;
+    interpreter.accumulator() = ScriptFunction::create(interpreter.global_object(), function, vm.current_scope(), function.is_strict_mode() || vm.in_strict_mode(), function.is_arrow_function());
+}
+
+void ConcatString::execute(Bytecode::Interpreter& interpreter) const
+{
+    auto* string = interpreter.accumulator().to_primitive_string(interpreter.global_object());
+    if (interpreter.vm().exception())
+        return;
+    auto& lhs = interpreter.reg(m_lhs);
+    lhs = js_rope_string(interpreter.vm(), lhs.as_string(), *string);
+}
+
+void ResolveThisBinding::execute(Bytecode::Interpreter& interpreter) const
+{
+    interpreter.accumulator() = interpreter.vm().resolve_this_binding(interpreter.global_object());
+}
+
+void GetVariable::execute(Bytecode::Interpreter& interpreter) const
+{
+    auto& vm = interpreter.vm();
+    auto value = vm.get_variable(m_identifier, interpreter.global_object(), &m_environment_coordinate);
+    if (value.is_empty()) {
+        if (!vm.exception())
+            vm.throw_exception<ReferenceError>(interpreter.global_object(), ErrorType::UnknownIdentifier, m_identifier);
+        return;
+    }
+    interpreter.accumulator() = value;
+}
+
+void SetVariable::execute(Bytecode::Interpreter& interpreter) const
+{
+    auto& vm = interpreter.vm();
+    if (m_mode == Mode::Initialize) {
+        vm.set_variable(m_identifier, interpreter.accumulator(), interpreter.global_object(), true, &m_environment_coordinate);
+        return;
+    }
+    vm.get_reference(m_identifier, &m_environment_coordinate).put(interpreter.global_object(), interpreter.accumulator());
+}
+
+void TypeofVariable::execute(Bytecode::Interpreter& interpreter) const
+{
+    auto& vm = interpreter.vm();
+    auto value = vm.get_variable(m_identifier, interpreter.global_object(), &m_environment_coordinate).value_or(js_undefined());
+    if (vm.exception())
+        return;
+    interpreter.accumulator() = js_string(vm, value.typeof());
+}
+
+void GetById::execute(Bytecode::Interpreter& interpreter) const
+{
+    auto value = m_inline_cache.get_property(interpreter.global_object(), interpreter.accumulator(), m_property);
+    if (!interpreter.vm().exception())
+        interpreter.accumulator() = value;
+}
+
+void PutById::execute(Bytecode::Interpreter& interpreter) const
+{
+    Reference(interpreter.reg(m_base), m_property).put(interpreter.global_object(), interpreter.accumulator());
+}
+
+void GetByValue::execute(Bytecode::Interpreter& interpreter) const
+{
+    auto& global_object = interpreter.global_object();
+    auto property_name = PropertyName::from_value(global_object, interpreter.accumulator());
+    if (!property_name.is_valid())
+        return;
+    auto value = Reference(interpreter.reg(m_base), property_name).get(global_object);
+    if (!interpreter.vm().exception())
+        interpreter.accumulator() = value;
+}
+
+void PutByValue::execute(Bytecode::Interpreter& interpreter) const
+{
+    auto& global_object = interpreter.global_object();
+    auto property_name = PropertyName::from_value(global_object, interpreter.reg(m_property));
+    if (!property_name.is_valid())
+        return;
+    Reference(interpreter.reg(m_base), property_name).put(global_object, interpreter.accumulator());
+}
+
+void DefineProperty::execute(Bytecode::Interpreter& interpreter) const
+{
+    auto& global_object = interpreter.global_object();
+    auto& object = interpreter.reg(m_object).as_object();
+    auto key = interpreter.reg(m_key);
+    auto value = interpreter.accumulator();
+
+    auto property_name = PropertyName::from_value(global_object, key);
+    if (!property_name.is_valid())
+        return;
+
+    if (value.is_function()) {
+        auto& function = value.as_function();
+        if (m_is_method)
+            function.set_home_object(&object);
+        if (is<ScriptFunction>(function) && function.name().is_empty()) {
+            auto name = key.is_symbol() ? String::formatted("[{}]", key.as_symbol().description()) : property_name.to_string();
+            static_cast<ScriptFunction&>(function).set_name(name);
+        }
+    }
+
+    object.define_property(property_name, value);
+}
+
+void Jump::execute(Bytecode::Interpreter& interpreter) const
+{
+    interpreter.jump(*m_target);
+}
+
+void JumpIfTrue::execute(Bytecode::Interpreter& interpreter) const
+{
+    if (interpreter.accumulator().to_boolean())
+        interpreter.jump(*m_target);
+}
+
+void JumpIfFalse::execute(Bytecode::Interpreter& interpreter) const
+{
+    if (!interpreter.accumulator().to_boolean())
+        interpreter.jump(*m_target);
+}
+
+void JumpIfNotNullish::execute(Bytecode::Interpreter& interpreter) const
+{
+    if (!interpreter.accumulator().is_nullish())
+        interpreter.jump(*m_target);
+}
+
+void Call::execute(Bytecode::Interpreter& interpreter) const
+{
+    auto& vm = interpreter.vm();
+    auto& global_object = interpreter.global_object();
+
+    auto callee = interpreter.reg(m_callee);
+    if (!callee.is_function()
+        || (m_type == CallType::Construct && is<NativeFunction>(callee.as_object()) && !static_cast<NativeFunction&>(callee.as_object()).has_constructor())) {
+        m_expression.throw_type_error_for_callee(global_object, callee, m_type == CallType::Construct ? "constructor" : "function");
+        return;
+    }
+    auto& function = callee.as_function();
+
+    // Like the AST interpreter, this converts primitive bases of member calls to objects.
+    Value this_value = &global_object;
+    if (m_this_value.has_value()) {
+        this_value = interpreter.reg(*m_this_value).to_object(global_object);
+        if (vm.exception())
+            return;
+    }
+
+    MarkedValueList arguments(vm.heap());
+    arguments.ensure_capacity(m_argument_count);
+    for (size_t i = 0; i < m_argument_count; ++i)
+        arguments.append(interpreter.reg(m_arguments[i]));
+
+    vm.call_frame().current_node = &m_expression;
+    Value result;
+    if (m_type == CallType::Construct)
+        result = vm.construct(function, function, move(arguments), global_object);
+    else
+        result = vm.call(function, this_value, move(arguments));
+    if (!vm.exception())
+        interpreter.accumulator() = result;
+}
+
+void EnterScope::execute(Bytecode::Interpreter& interpreter) const
+{
+    interpreter.enter_scope(m_scope_node, m_scope_type);
+}
+
+void LeaveScope::execute(Bytecode::Interpreter& interpreter) const
+{
+    interpreter.leave_scope();
+}
+
+void Return::execute(Bytecode::Interpreter& interpreter) const
+{
+    interpreter.do_return(interpreter.accumulator().value_or(js_undefined()));
+}
+
+void Throw::execute(Bytecode::Interpreter& interpreter) const
+{
+    interpreter.vm().throw_exception(interpreter.global_object(), interpreter.accumulator());
+}
+
+String Load::to_string() const
+{
+    return String::formatted("Load {}", m_src);
+}
+
+String LoadImmediate::to_string() const
+{
+    return String::formatted("LoadImmediate {}", m_value.is_empty() ? "<empty>" : m_value.to_string_without_side_effects());
+}
+
+String Store::to_string() const
+{
+    return String::formatted("Store {}", m_dst);
+}
+
+String NewString::to_string() const
+{
+    return String::formatted("NewString \"{}\"", m_string);
+}
+
+String NewBigInt::to_string() const
+{
+    return String::formatted("NewBigInt {}n", m_bigint.to_base10());
+}
+
+String NewObject::to_string() const
+{
+    return "NewObject";
+}
+
+String NewArray::to_string() const
+{
+    StringBuilder builder;
+    builder.append("NewArray [");
+    for (size_t i = 0; i < m_element_count; ++i) {
+        if (i != 0)
+            builder.append(", ");
+        builder.appendff("{}", m_elements[i]);
+    }
+    builder.append(']');
+    return builder.to_string();
+}
+
+String NewFunction::to_string() const
+{
+    return String::formatted("NewFunction \"{}\"", m_function_expression.name());
+}
+
+String ConcatString::to_string() const
+{
+    return String::formatted("ConcatString {}", m_lhs);
+}
+
+String ResolveThisBinding::to_string() const
+{
+    return "ResolveThisBinding";
+}
+
+String GetVariable::to_string() const
+{
+    return String::formatted("GetVariable {}", m_identifier);
+}
+
+String SetVariable::to_string() const
+{
+    return String::formatted("SetVariable {}{}", m_identifier, m_mode == Mode::Initialize ? " (initialize)" : "");
+}
+
+String TypeofVariable::to_string() const
+{
+    return String::formatted("TypeofVariable {}", m_identifier);
+}
+
+String GetById::to_string() const
+{
+    return String::formatted("GetById {}", m_property.to_string());
+}
+
+String PutById::to_string() const
+{
+    return String::formatted("PutById base:{}, {}", m_base, m_property.to_string());
+}
+
+String GetByValue::to_string() const
+{
+    return String::formatted("GetByValue base:{}", m_base);
+}
+
+String PutByValue::to_string() const
+{
+    return String::formatted("PutByValue base:{}, property:{}", m_base, m_property);
+}
+
+String DefineProperty::to_string() const
+{
+    return String::formatted("DefineProperty object:{}, key:{}{}", m_object, m_key, m_is_method ? " (method)" : "");
+}
+
+String Jump::to_string() const
+{
+    return String::formatted("Jump {}", *m_target);
+}
+
+String JumpIfTrue::to_string() const
+{
+    return String::formatted("JumpIfTrue {}", *m_target);
+}
+
+String JumpIfFalse::to_string() const
+{
+    return String::formatted("JumpIfFalse {}", *m_target);
+}
+
+String JumpIfNotNullish::to_string() const
+{
+    return String::formatted("JumpIfNotNullish {}", *m_target);
+}
+
+String Call::to_string() const
+{
+    StringBuilder builder;
+    builder.appendff("{} callee:{}", m_type == CallType::Construct ? "Construct" : "Call", m_callee);
+    if (m_this_value.has_value())
+        builder.appendff(", this:{}", *m_this_value);
+    builder.append(", arguments:[");
+    for (size_t i = 0; i < m_argument_count; ++i) {
+        if (i != 0)
+            builder.append(", ");
+        builder.appendff("{}", m_arguments[i]);
+    }
+    builder.append(']');
+    return builder.to_string();
+}
+
+String EnterScope::to_string() const
+{
+    return String::formatted("EnterScope {}{}", m_scope_node.class_name(), m_scope_type == ScopeType::Function ? " (function)" : "");
+}
+
+String LeaveScope::to_string() const
+{
+    return "LeaveScope";
+}
+
+String Return::to_string() const
+{
+    return "Return";
+}
+
+String Throw::to_string() const
+{
+    return "Throw";
+}
+
+}
@@ -0,0 +1,540 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/FlyString.h>
+#include <AK/Optional.h>
+#include <AK/Span.h>
+#include <LibCrypto/BigInt/SignedBigInteger.h>
+#include <LibJS/Bytecode/Instruction.h>
+#include <LibJS/Bytecode/Label.h>
+#include <LibJS/Bytecode/Register.h>
+#include <LibJS/Runtime/EnvironmentLayout.h>
+#include <LibJS/Runtime/InlineCache.h>
+#include <LibJS/Runtime/PropertyName.h>
+#include <LibJS/Runtime/VM.h>
+#include <LibJS/Runtime/Value.h>
+
+namespace JS::Bytecode {
+class Interpreter;
+}
+
+namespace JS::Bytecode::Op {
+
+class Load final : public Instruction {
+public:
+    explicit Load(Register src)
+        : Instruction(Type::Load)
+        , m_src(src)
+    {
+    }
+
+    void execute(Bytecode::Interpreter&) const;
+    String to_string() const;
+
+private:
+    Register m_src;
+};
+
+class LoadImmediate final : public Instruction {
+public:
+    explicit LoadImmediate(Value value)
+        : Instruction(Type::LoadImmediate)
+        , m_value(value)
+    {
+        // The op outlives any GC cycle, so it can't keep anything on the heap alive.
+        VERIFY(!value.is_cell());
+    }
+
+    void execute(Bytecode::Interpreter&) const;
+    String to_string() const;
+
+private:
+    Value m_value;
+};
+
+class Store final : public Instruction {
+public:
+    explicit Store(Register dst)
+        : Instruction(Type::Store)
+        , m_dst(dst)
+    {
+    }
+
+    void execute(Bytecode::Interpreter&) const;
+    String to_string() const;
+
+private:
+    Register m_dst;
+};
+
+// The binary ops compute lhs OP accumulator, and leave the result in the accumulator.
+#define JS_ENUMERATE_COMMON_BINARY_OPS(O)            \
+    O(Add, add)                                      \
+    O(Sub, sub)                                      \
+    O(Mul, mul)                                      \
+    O(Div, div)                                      \
+    O(Exp, exp)                                      \
+    O(Mod, mod)                                      \
+    O(In, in)                                        \
+    O(InstanceOf, instance_of)                       \
+    O(GreaterThan, greater_than)                     \
+    O(GreaterThanEquals, greater_than_equals)        \
+    O(LessThan, less_than)                           \
+    O(LessThanEquals, less_than_equals)              \
+    O(AbstractInequals, abstract_inequals)           \
+    O(AbstractEquals, abstract_equals)               \
+    O(TypedInequals, typed_inequals)                 \
+    O(TypedEquals, typed_equals)                     \
+    O(BitwiseAnd, bitwise_and)                       \
+    O(BitwiseOr, bitwise_or)                         \
+    O(BitwiseXor, bitwise_xor)                       \
+    O(LeftShift, left_shift)                         \
+    O(RightShift, right_shift)                       \
+    O(UnsignedRightShift, unsigned_right_shift)
+
+#define JS_DECLARE_COMMON_BINARY_OP(OpTitleCase, op_snake_case) \
+    class OpTitleCase final : public Instruction {               \
+    public:                                                      \
+        explicit OpTitleCase(Register lhs_reg)                   \
+            : Instruction(Type::OpTitleCase)                     \
+            , m_lhs_reg(lhs_reg)                                 \
+        {                                                        \
+        }                                                        \
+                                                                 \
+        void execute(Bytecode::Interpreter&) const;              \
+        String to_string() const;                                \
+                                                                 \
+    private:                                                     \
+        Register m_lhs_reg;                                      \
+    };
+
+JS_ENUMERATE_COMMON_BINARY_OPS(JS_DECLARE_COMMON_BINARY_OP)
+#undef JS_DECLARE_COMMON_BINARY_OP
+
+// The unary ops work on the accumulator in place.
+#define JS_ENUMERATE_COMMON_UNARY_OPS(O) \
+    O(BitwiseNot, bitwise_not)           \
+    O(Not, not_)                         \
+    O(UnaryPlus, unary_plus)             \
+    O(UnaryMinus, unary_minus)           \
+    O(Typeof, typeof_)                   \
+    O(ToNumeric, to_numeric)             \
+    O(Increment, increment)              \
+    O(Decrement, decrement)
+
+#define JS_DECLARE_COMMON_UNARY_OP(OpTitleCase, op_snake_case) \
+    class OpTitleCase final : public Instruction {              \
+    public:                                                     \
+        OpTitleCase()                                           \
+            : Instruction(Type::OpTitleCase)                    \
+        {                                                       \
+        }                                                       \
+                                                                \
+        void execute(Bytecode::Interpreter&) const;             \
+        String to_string() const;                               \
+    };
+
+JS_ENUMERATE_COMMON_UNARY_OPS(JS_DECLARE_COMMON_UNARY_OP)
+#undef JS_DECLARE_COMMON_UNARY_OP
+
+class NewString final : public Instruction {
+public:
+    explicit NewString(String string)
+        : Instruction(Type::NewString)
+        , m_string(move(string))
+    {
+    }
+
+    void execute(Bytecode::Interpreter&) const;
+    String to_string() const;
+
+private:
+    String m_string;
+};
+
+class NewBigInt final : public Instruction {
+public:
+    explicit NewBigInt(Crypto::SignedBigInteger bigint)
+        : Instruction(Type::NewBigInt)
+        , m_bigint(move(bigint))
+    {
+    }
+
+    void execute(Bytecode::Interpreter&) const;
+    String to_string() const;
+
+private:
+    Crypto::SignedBigInteger m_bigint;
+};
+
+class NewObject final : public Instruction {
+public:
+    NewObject()
+        : Instruction(Type::NewObject)
+    {
+    }
+
+    void execute(Bytecode::Interpreter&) const;
+    String to_string() const;
+};
+
+// Creates an array out of the values in a run of registers. Empty values become holes.
+class NewArray final : public Instruction {
+public:
+    explicit NewArray(Span<const Register> elements)
+        : Instruction(Type::NewArray)
+        , m_element_count(elements.size())
+    {
+        for (size_t i = 0; i < m_element_count; ++i)
+            m_elements[i] = elements[i];
+    }
+
+    void execute(Bytecode::Interpreter&) const;
+    String to_string() const;
+
+private:
+    size_t m_element_count { 0 };
+    Register m_elements[];
+};
+
+class NewFunction final : public Instruction {
+public:
+    explicit NewFunction(const FunctionExpression& function_expression)
+        : Instruction(Type::NewFunction)
+        , m_function_expression(function_expression)
+    {
+    }
+
+    void execute(Bytecode::Interpreter&) const;
+    String to_string() const;
+
+private:
+    const FunctionExpression& m_function_expression;
+};
+
+// Appends the accumulator to the string in lhs, converting it to a string first.
+class ConcatString final : public Instruction {
+public:
+    explicit ConcatString(Register lhs)
+        : Instruction(Type::ConcatString)
+        , m_lhs(lhs)
+    {
+    }
+
+    void execute(Bytecode::Interpreter&) const;
+    String to_string() const;
+
+private:
+    Register m_lhs;
+};
+
+class ResolveThisBinding final : public Instruction {
+public:
+    ResolveThisBinding()
+        : Instruction(Type::ResolveThisBinding)
+    {
+    }
+
+    void execute(Bytecode::Interpreter&) const;
+    String to_string() const;
+};
+
+class GetVariable final : public Instruction {
+public:
+    GetVariable(FlyString identifier, EnvironmentCoordinate environment_coordinate)
+        : Instruction(Type::GetVariable)
+        , m_identifier(move(identifier))
+        , m_environment_coordinate(move(environment_coordinate))
+    {
+    }
+
+    void execute(Bytecode::Interpreter&) const;
+    String to_string() const;
+
+private:
+    FlyString m_identifier;
+    EnvironmentCoordinate m_environment_coordinate;
+};
+
+class SetVariable final : public Instruction {
+public:
+    enum class Mode {
+        // Plain assignment, which throws for constants and follows the usual rules for undeclared variables.
+        Assign,
+        // The initializer of a declaration.
+        Initialize,
+    };
+
+    SetVariable(FlyString identifier, EnvironmentCoordinate environment_coordinate, Mode mode)
+        : Instruction(Type::SetVariable)
+        , m_identifier(move(identifier))
+        , m_environment_coordinate(move(environment_coordinate))
+        , m_mode(mode)
+    {
+    }
+
+    void execute(Bytecode::Interpreter&) const;
+    String to_string() const;
+
+private:
+    FlyString m_identifier;
+    EnvironmentCoordinate m_environment_coordinate;
+    Mode m_mode;
+};
+
+// Unlike GetVariable, this doesn't throw for variables that don't exist.
+class TypeofVariable final : public Instruction {
+public:
+    TypeofVariable(FlyString identifier, EnvironmentCoordinate environment_coordinate)
+        : Instruction(Type::TypeofVariable)
+        , m_identifier(move(identifier))
+        , m_environment_coordinate(move(environment_coordinate))
+    {
+    }
+
+    void execute(Bytecode::Interpreter&) const;
+    String to_string() const;
+
+private:
+    FlyString m_identifier;
+    EnvironmentCoordinate m_environment_coordinate;
+};
+
+// Looks the property up on the value in the accumulator.
+class GetById final : public Instruction {
+public:
+    explicit GetById(PropertyName property)
+        : Instruction(Type::GetById)
+        , m_property(move(property))
+    {
+    }
+
+    void execute(Bytecode::Interpreter&) const;
+    String to_string() const;
+
+private:
+    PropertyName m_property;
+    mutable InlineCache m_inline_cache;
+};
+
+// Stores the accumulator into the property of base.
+class PutById final : public Instruction {
+public:
+    PutById(Register base, PropertyName property)
+        : Instruction(Type::PutById)
+        , m_base(base)
+        , m_property(move(property))
+    {
+    }
+
+    void execute(Bytecode::Interpreter&) const;
+    String to_string() const;
+
+private:
+    Register m_base;
+    PropertyName m_property;
+};
+
+// Looks up the property named by the accumulator on base.
+class GetByValue final : public Instruction {
+public:
+    explicit GetByValue(Register base)
+        : Instruction(Type::GetByValue)
+        , m_base(base)
+    {
+    }
+
+    void execute(Bytecode::Interpreter&) const;
+    String to_string() const;
+
+private:
+    Register m_base;
+};
+
+// Stores the accumulator into the property of base named by the value in property.
+class PutByValue final : public Instruction {
+public:
+    PutByValue(Register base, Register property)
+        : Instruction(Type::PutByValue)
+        , m_base(base)
+        , m_property(property)
+    {
+    }
+
+    void execute(Bytecode::Interpreter&) const;
+    String to_string() const;
+
+private:
+    Register m_base;
+    Register m_property;
+};
+
+// Defines a property of an object literal, with the accumulator as its value.
+class DefineProperty final : public Instruction {
+public:
+    DefineProperty(Register object, Register key, bool is_method)
+        : Instruction(Type::DefineProperty)
+        , m_object(object)
+        , m_key(key)
+        , m_is_method(is_method)
+    {
+    }
+
+    void execute(Bytecode::Interpreter&) const;
+    String to_string() const;
+
+private:
+    Register m_object;
+    Register m_key;
+    bool m_is_method { false };
+};
+
+class Jump : public Instruction {
+public:
+    explicit Jump(Optional<Label> target = {})
+        : Instruction(Type::Jump)
+        , m_target(move(target))
+    {
+    }
+
+    void set_target(Label target) { m_target = target; }
+
+    void execute(Bytecode::Interpreter&) const;
+    String to_string() const;
+
+protected:
+    Jump(Type type, Optional<Label> target)
+        : Instruction(type)
+        , m_target(move(target))
+    {
+    }
+
+    Optional<Label> m_target;
+};
+
+// The conditional jumps look at the accumulator, and leave it alone.
+class JumpIfTrue final : public Jump {
+public:
+    explicit JumpIfTrue(Optional<Label> target = {})
+        : Jump(Type::JumpIfTrue, move(target))
+    {
+    }
+
+    void execute(Bytecode::Interpreter&) const;
+    String to_string() const;
+};
+
+class JumpIfFalse final : public Jump {
+public:
+    explicit JumpIfFalse(Optional<Label> target = {})
+        : Jump(Type::JumpIfFalse, move(target))
+    {
+    }
+
+    void execute(Bytecode::Interpreter&) const;
+    String to_string() const;
+};
+
+class JumpIfNotNullish final : public Jump {
+public:
+    explicit JumpIfNotNullish(Optional<Label> target = {})
+        : Jump(Type::JumpIfNotNullish, move(target))
+    {
+    }
+
+    void execute(Bytecode::Interpreter&) const;
+    String to_string() const;
+};
+
+// Calls or constructs callee with the values in a run of registers as arguments, leaving the result in the
+// accumulator. Plain calls without a this value get the global object.
+class Call final : public Instruction {
+public:
+    enum class CallType {
+        Call,
+        Construct,
+    };
+
+    Call(CallType type, Register callee, Optional<Register> this_value, const CallExpression& expression, Span<const Register> arguments)
+        : Instruction(Type::Call)
+        , m_type(type)
+        , m_callee(callee)
+        , m_this_value(move(this_value))
+        , m_expression(expression)
+        , m_argument_count(arguments.size())
+    {
+        for (size_t i = 0; i < m_argument_count; ++i)
+            m_arguments[i] = arguments[i];
+    }
+
+    void execute(Bytecode::Interpreter&) const;
+    String to_string() const;
+
+private:
+    CallType m_type;
+    Register m_callee;
+    Optional<Register> m_this_value;
+    // For error messages and tracebacks.
+    const CallExpression& m_expression;
+    size_t m_argument_count { 0 };
+    Register m_arguments[];
+};
+
+class EnterScope final : public Instruction {
+public:
+    EnterScope(const ScopeNode& scope_node, ScopeType scope_type)
+        : Instruction(Type::EnterScope)
+        , m_scope_node(scope_node)
+        , m_scope_type(scope_type)
+    {
+    }
+
+    void execute(Bytecode::Interpreter&) const;
+    String to_string() const;
+
+private:
+    const ScopeNode& m_scope_node;
+    ScopeType m_scope_type;
+};
+
+// Leaves the innermost scope entered through EnterScope.
+class LeaveScope final : public Instruction {
+public:
+    LeaveScope()
+        : Instruction(Type::LeaveScope)
+    {
+    }
+
+    void execute(Bytecode::Interpreter&) const;
+    String to_string() const;
+};
+
+// Stops running the block, with the accumulator as its result.
+class Return final : public Instruction {
+public:
+    Return()
+        : Instruction(Type::Return)
+    {
+    }
+
+    void execute(Bytecode::Interpreter&) const;
+    String to_string() const;
+};
+
+class Throw final : public Instruction {
+public:
+    Throw()
+        : Instruction(Type::Throw)
+    {
+    }
+
+    void execute(Bytecode::Interpreter&) const;
+    String to_string() const;
+};
+
+}
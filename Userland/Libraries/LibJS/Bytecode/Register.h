@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Format.h>
+#include <AK/Types.h>
+
+namespace JS::Bytecode {
+
+class Register {
+public:
+    // Most instructions take one of their operands from, and leave their result in, this register.
+    static constexpr u32 accumulator_index = 0;
+
+    static constexpr Register accumulator() { return Register(accumulator_index); }
+
+    constexpr explicit Register(u32 index)
+        : m_index(index)
+    {
+    }
+
+    constexpr u32 index() const { return m_index; }
+
+private:
+    u32 m_index { 0 };
+};
+
+}
+
+template<>
+struct AK::Formatter<JS::Bytecode::Register> : AK::Formatter<FormatString> {
+    void format(FormatBuilder& builder, const JS::Bytecode::Register& value)
+    {
+        if (value.index() == JS::Bytecode::Register::accumulator_index)
+            Formatter<FormatString>::format(builder, "acc");
+        else
+            Formatter<FormatString>::format(builder, "${}", value.index());
+    }
+};
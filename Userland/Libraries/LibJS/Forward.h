@@ -103,17 +103,21 @@ class ASTNode;
 class Allocator;
 class BigInt;
 class BoundFunction;
+class CallExpression;
 class Cell;
 class Console;
 class DeferGC;
+class EnvironmentLayout;
 class Error;
 class Exception;
 class Expression;
+class FunctionExpression;
 class Accessor;
 class GlobalObject;
 class HandleImpl;
 class Heap;
 class HeapBlock;
+class InlineCache;
 class Interpreter;
 class LexicalEnvironment;
 class MarkedValueList;
@@ -135,7 +139,9 @@ class Uint8ClampedArray;
 class VM;
 class Value;
 enum class DeclarationKind;
+enum class ScopeType;
 struct AlreadyResolved;
+struct EnvironmentCoordinate;
 struct JobCallback;
 struct PromiseCapability;
 
@@ -158,4 +164,12 @@ JS_ENUMERATE_TYPED_ARRAYS
 template<class T>
 class Handle;
 
+namespace Bytecode {
+class Block;
+class Generator;
+class Instruction;
+class Interpreter;
+class Register;
+}
+
 }
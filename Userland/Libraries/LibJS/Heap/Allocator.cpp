@@ -6,6 +6,7 @@
 
 #include <AK/Badge.h>
 #include <LibJS/Heap/Allocator.h>
+#include <LibJS/Heap/Heap.h>
 #include <LibJS/Heap/HeapBlock.h>
 
 namespace JS {
@@ -21,6 +22,9 @@ Allocator::~Allocator()
 
 Cell* Allocator::allocate_cell(Heap& heap)
 {
+    while (m_usable_blocks.is_empty() && !m_blocks_to_sweep.is_empty())
+        heap.sweep_block({}, *m_blocks_to_sweep.first());
+
     if (m_usable_blocks.is_empty()) {
         auto block = HeapBlock::create_with_cell_size(heap, m_cell_size);
         m_usable_blocks.append(*block.leak_ptr());
@@ -46,4 +50,26 @@ void Allocator::block_did_become_usable(Badge<Heap>, HeapBlock& block)
     m_usable_blocks.append(block);
 }
 
+size_t Allocator::will_sweep_all_blocks(Badge<Heap>)
+{
+    size_t block_count = 0;
+    while (auto* block = m_full_blocks.first()) {
+        m_blocks_to_sweep.append(*block);
+        ++block_count;
+    }
+    while (auto* block = m_usable_blocks.first()) {
+        m_blocks_to_sweep.append(*block);
+        ++block_count;
+    }
+    return block_count;
+}
+
+void Allocator::block_was_swept(Badge<Heap>, HeapBlock& block)
+{
+    if (block.is_full())
+        m_full_blocks.append(block);
+    else
+        m_usable_blocks.append(block);
+}
+
 }
@@ -34,18 +34,28 @@ public:
             if (callback(block) == IterationDecision::Break)
                 return IterationDecision::Break;
         }
+        for (auto& block : m_blocks_to_sweep) {
+            if (callback(block) == IterationDecision::Break)
+                return IterationDecision::Break;
+        }
         return IterationDecision::Continue;
     }
 
     void block_did_become_empty(Badge<Heap>, HeapBlock&);
     void block_did_become_usable(Badge<Heap>, HeapBlock&);
 
+    // Blocks are swept lazily after an incremental collection, and not allocated from before they have been.
+    size_t will_sweep_all_blocks(Badge<Heap>);
+    HeapBlock* block_to_sweep() { return m_blocks_to_sweep.first(); }
+    void block_was_swept(Badge<Heap>, HeapBlock&);
+
 private:
     const size_t m_cell_size;
 
     typedef IntrusiveList<HeapBlock, RawPtr<HeapBlock>, &HeapBlock::m_list_node> BlockList;
     BlockList m_full_blocks;
     BlockList m_usable_blocks;
+    BlockList m_blocks_to_sweep;
 };
 
 }
@@ -9,14 +9,17 @@
 #include <AK/HashTable.h>
 #include <AK/StackInfo.h>
 #include <AK/TemporaryChange.h>
+#include <AK/Time.h>
 #include <LibCore/ElapsedTimer.h>
 #include <LibJS/Heap/Allocator.h>
 #include <LibJS/Heap/Handle.h>
 #include <LibJS/Heap/Heap.h>
 #include <LibJS/Heap/HeapBlock.h>
 #include <LibJS/Interpreter.h>
+#include <LibJS/Runtime/InlineCache.h>
 #include <LibJS/Runtime/Object.h>
 #include <setjmp.h>
+#include <time.h>
 
 namespace JS {
 
@@ -36,6 +39,10 @@ Heap::Heap(VM& vm)
 Heap::~Heap()
 {
     collect_garbage(CollectionType::CollectEverything);
+
+    // Whatever is still holding on to these (like the AST of a program that's kept around) may outlive us.
+    for (auto* inline_cache : m_inline_caches)
+        inline_cache->did_destroy_heap({});
 }
 
 ALWAYS_INLINE Allocator& Heap::allocator_for_size(size_t cell_size)
@@ -50,35 +57,286 @@ ALWAYS_INLINE Allocator& Heap::allocator_for_size(size_t cell_size)
 Cell* Heap::allocate_cell(size_t size)
 {
     if (should_collect_on_every_allocation()) {
-        collect_garbage();
+        collect_due_garbage();
     } else if (m_allocations_since_last_gc > m_max_allocations_between_gc) {
         m_allocations_since_last_gc = 0;
-        collect_garbage();
+        collect_due_garbage();
     } else {
         ++m_allocations_since_last_gc;
     }
 
     auto& allocator = allocator_for_size(size);
-    return allocator.allocate_cell(*this);
+    auto* cell = allocator.allocate_cell(*this);
+    m_young_cells.append(cell);
+    return cell;
+}
+
+static Time monotonic_time()
+{
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return Time::from_timespec(now);
+}
+
+void GarbageCollectionStatistics::Collections::record_pause(u64 microseconds)
+{
+    ++count;
+    total_pause_microseconds += microseconds;
+    longest_pause_microseconds = max(longest_pause_microseconds, microseconds);
+    size_t bucket = 0;
+    while (bucket < pause_histogram_bucket_count - 1 && microseconds >= (1ull << bucket))
+        ++bucket;
+    ++pause_histogram[bucket];
 }
 
+class MarkingVisitor final : public Cell::Visitor {
+public:
+    MarkingVisitor(Vector<Cell*>& mark_stack, bool young_cells_only)
+        : m_mark_stack(mark_stack)
+        , m_young_cells_only(young_cells_only)
+    {
+    }
+
+    virtual void visit_impl(Cell* cell) override
+    {
+        if (cell->is_marked())
+            return;
+        if (m_young_cells_only && cell->is_old())
+            return;
+        dbgln_if(HEAP_DEBUG, "  ! {}", cell);
+        cell->set_marked(true);
+        m_mark_stack.append(cell);
+    }
+
+    // Returns false if the deadline passed before the edges of every marked cell were visited.
+    bool visit_marked_cells(Optional<Time> deadline = {})
+    {
+        size_t visited_cells = 0;
+        while (!m_mark_stack.is_empty()) {
+            if (deadline.has_value() && ++visited_cells % 256 == 0 && monotonic_time() >= *deadline)
+                return false;
+            m_mark_stack.take_last()->visit_edges(*this);
+        }
+        return true;
+    }
+
+private:
+    Vector<Cell*>& m_mark_stack;
+    bool m_young_cells_only { false };
+};
+
+// Cells start out young, and become old when they survive a collection. Old cells don't move, and most of them
+// never die, so minor collections leave them alone: they only mark the young cells reachable from the roots,
+// and only sweep the cells allocated since the last collection. Young cells that are only reachable through an
+// old one are found through the cells the write barrier remembered, and the old cells that don't have one.
+// Full collections look at everything, like there was just one generation.
 void Heap::collect_garbage(CollectionType collection_type, bool print_report)
 {
+    if (collection_type == CollectionType::CollectYoungGeneration && is_collecting_incrementally()) {
+        // The young generation is collected along with everything else by the collection that's in progress.
+        perform_incremental_step();
+        return;
+    }
+
     VERIFY(!m_collecting_garbage);
     TemporaryChange change(m_collecting_garbage, true);
 
+    auto start_time = monotonic_time();
     Core::ElapsedTimer collection_measurement_timer;
     collection_measurement_timer.start();
-    if (collection_type == CollectionType::CollectGarbage) {
+    if (collection_type != CollectionType::CollectEverything) {
         if (m_gc_deferrals) {
+            if (!m_should_gc_when_deferral_ends || m_collection_type_when_deferral_ends == CollectionType::CollectYoungGeneration)
+                m_collection_type_when_deferral_ends = collection_type;
             m_should_gc_when_deferral_ends = true;
             return;
         }
+    }
+
+    if (m_incremental_state == IncrementalState::Marking && collection_type == CollectionType::CollectEverything)
+        abandon_incremental_marking();
+    else if (is_collecting_incrementally())
+        finish_incremental_collection();
+
+    if (collection_type != CollectionType::CollectEverything) {
         HashTable<Cell*> roots;
         gather_roots(roots);
-        mark_live_cells(roots);
+        if (collection_type == CollectionType::CollectYoungGeneration)
+            mark_live_young_cells(roots);
+        else
+            mark_live_cells(roots);
+    }
+
+    if (collection_type == CollectionType::CollectYoungGeneration) {
+        sweep_dead_young_cells(print_report, collection_measurement_timer);
+        m_statistics.minor.record_pause((monotonic_time() - start_time).to_microseconds());
+    } else {
+        sweep_dead_cells(print_report, collection_measurement_timer);
+        m_statistics.full.record_pause((monotonic_time() - start_time).to_microseconds());
     }
-    sweep_dead_cells(print_report, collection_measurement_timer);
+}
+
+// What's due is usually a minor collection, and a full one once the old generation has grown enough since the last.
+void Heap::collect_due_garbage()
+{
+    if (m_gc_deferrals) {
+        if (!m_should_gc_when_deferral_ends)
+            m_collection_type_when_deferral_ends = CollectionType::CollectYoungGeneration;
+        m_should_gc_when_deferral_ends = true;
+        return;
+    }
+
+    if (is_collecting_incrementally())
+        perform_incremental_step();
+    else if (m_old_cell_count < m_old_cell_count_for_full_collection)
+        collect_garbage(CollectionType::CollectYoungGeneration);
+    else if (m_incremental_step_microseconds)
+        start_incremental_collection();
+    else
+        collect_garbage(CollectionType::CollectGarbage);
+}
+
+void Heap::collect_deferred_garbage()
+{
+    m_should_gc_when_deferral_ends = false;
+    if (m_collection_type_when_deferral_ends == CollectionType::CollectYoungGeneration)
+        collect_due_garbage();
+    else
+        collect_garbage(m_collection_type_when_deferral_ends);
+}
+
+// Incremental collections mark the heap a step at a time, while the program keeps running in between. Whenever the
+// write barrier sees a cell being stored into one that's already been marked, it marks that one as well, so nothing
+// that's reachable from a marked cell can be missed. What the barrier doesn't see (the roots, and the cells without
+// a write barrier) is visited again at the end, in one go. Cells that are created in the meantime are considered
+// live. Afterwards, the blocks are swept one at a time as well, and the allocator sweeps the ones it wants to
+// allocate from itself.
+void Heap::start_incremental_collection()
+{
+    VERIFY(m_incremental_state == IncrementalState::Idle);
+    VERIFY(!m_collecting_garbage);
+    TemporaryChange change(m_collecting_garbage, true);
+
+    auto start_time = monotonic_time();
+    dbgln_if(HEAP_DEBUG, "start_incremental_collection:");
+
+    HashTable<Cell*> roots;
+    gather_roots(roots);
+    MarkingVisitor visitor(m_mark_stack, false);
+    for (auto* root : roots)
+        visitor.visit(root);
+    m_incremental_state = IncrementalState::Marking;
+
+    m_statistics.incremental_steps.record_pause((monotonic_time() - start_time).to_microseconds());
+
+    if (on_incremental_collection_start)
+        on_incremental_collection_start();
+}
+
+void Heap::perform_incremental_step()
+{
+    if (!is_collecting_incrementally() || m_gc_deferrals)
+        return;
+    VERIFY(!m_collecting_garbage);
+    TemporaryChange change(m_collecting_garbage, true);
+
+    auto start_time = monotonic_time();
+    auto deadline = start_time + Time::from_microseconds(m_incremental_step_microseconds);
+
+    if (m_incremental_state == IncrementalState::Marking) {
+        MarkingVisitor visitor(m_mark_stack, false);
+        if (visitor.visit_marked_cells(deadline))
+            finish_incremental_marking();
+    } else {
+        for (auto& allocator : m_allocators) {
+            while (auto* block = allocator->block_to_sweep()) {
+                sweep_block(*block);
+                if (monotonic_time() >= deadline)
+                    break;
+            }
+            if (monotonic_time() >= deadline)
+                break;
+        }
+        if (!m_blocks_to_sweep)
+            finish_sweeping();
+    }
+
+    m_statistics.incremental_steps.record_pause((monotonic_time() - start_time).to_microseconds());
+}
+
+void Heap::finish_incremental_marking()
+{
+    VERIFY(m_incremental_state == IncrementalState::Marking);
+    dbgln_if(HEAP_DEBUG, "finish_incremental_marking:");
+
+    HashTable<Cell*> roots;
+    gather_roots(roots);
+    MarkingVisitor visitor(m_mark_stack, false);
+    for (auto* root : roots)
+        visitor.visit(root);
+    for (auto* cell : m_cells_to_visit_again)
+        m_mark_stack.append(cell);
+    m_cells_to_visit_again.clear();
+    for (auto* cell : m_old_cells_without_write_barrier) {
+        if (cell->is_marked())
+            m_mark_stack.append(cell);
+    }
+    for (auto* cell : m_young_cells) {
+        if (cell->is_marked() && !cell->has_write_barrier())
+            m_mark_stack.append(cell);
+    }
+    visitor.visit_marked_cells();
+
+    start_sweeping();
+}
+
+void Heap::finish_incremental_collection()
+{
+    if (m_incremental_state == IncrementalState::Marking)
+        finish_incremental_marking();
+    finish_sweeping();
+}
+
+// Nothing is kept alive by the roots while the heap is going away, so the marking that was done so far is undone.
+void Heap::abandon_incremental_marking()
+{
+    VERIFY(m_incremental_state == IncrementalState::Marking);
+    m_mark_stack.clear_with_capacity();
+    m_cells_to_visit_again.clear();
+    for_each_block([](auto& block) {
+        block.for_each_cell([](Cell* cell) {
+            cell->set_marked(false);
+        });
+        return IterationDecision::Continue;
+    });
+    m_incremental_state = IncrementalState::Idle;
+}
+
+void Heap::write_barrier_slow_path(Badge<Cell>, Cell& cell, Cell* stored_cell)
+{
+    // The cells that survive the collection that's being swept become old once their block has been.
+    bool is_old = cell.is_old() || (m_incremental_state == IncrementalState::Sweeping && cell.is_marked());
+    if (is_old && !cell.is_remembered() && (!stored_cell || !stored_cell->is_old()))
+        remember(cell);
+
+    if (m_incremental_state == IncrementalState::Marking && cell.is_marked()) {
+        if (!stored_cell)
+            m_cells_to_visit_again.set(&cell);
+        else if (!stored_cell->is_marked())
+            shade(*stored_cell);
+    }
+}
+
+void Heap::remember(Cell& cell)
+{
+    cell.set_remembered(true);
+    m_remembered_cells.append(&cell);
+}
+
+void Heap::shade(Cell& cell)
+{
+    cell.set_marked(true);
+    m_mark_stack.append(&cell);
 }
 
 void Heap::gather_roots(HashTable<Cell*>& roots)
@@ -96,6 +354,9 @@ void Heap::gather_roots(HashTable<Cell*>& roots)
         }
     }
 
+    for (auto* inline_cache : m_inline_caches)
+        inline_cache->gather_roots({}, roots);
+
     if constexpr (HEAP_DEBUG) {
         dbgln("gather_roots:");
         for (auto* root : roots)
@@ -114,17 +375,24 @@ __attribute__((no_sanitize("address"))) void Heap::gather_conservative_roots(Has
 
     HashTable<FlatPtr> possible_pointers;
 
+    // Values on the stack are NaN-boxed, so the pointer to a cell is only in the lower bits of the word holding it.
+    auto add_possible_pointer = [&](FlatPtr data) {
+        possible_pointers.set(data);
+        if (auto pointer = Value::possible_cell_pointer(data); pointer != data)
+            possible_pointers.set(pointer);
+    };
+
     const FlatPtr* raw_jmp_buf = reinterpret_cast<const FlatPtr*>(buf);
 
     for (size_t i = 0; i < ((size_t)sizeof(buf)) / sizeof(FlatPtr); i += sizeof(FlatPtr))
-        possible_pointers.set(raw_jmp_buf[i]);
+        add_possible_pointer(raw_jmp_buf[i]);
 
     FlatPtr stack_reference = reinterpret_cast<FlatPtr>(&dummy);
     auto& stack_info = m_vm.stack_info();
 
     for (FlatPtr stack_address = stack_reference; stack_address < stack_info.top(); stack_address += sizeof(FlatPtr)) {
         auto data = *reinterpret_cast<FlatPtr*>(stack_address);
-        possible_pointers.set(data);
+        add_possible_pointer(data);
     }
 
     HashTable<HeapBlock*> all_live_heap_blocks;
@@ -151,73 +419,41 @@ __attribute__((no_sanitize("address"))) void Heap::gather_conservative_roots(Has
     }
 }
 
-class MarkingVisitor final : public Cell::Visitor {
-public:
-    MarkingVisitor() { }
-
-    virtual void visit_impl(Cell* cell)
-    {
-        if (cell->is_marked())
-            return;
-        dbgln_if(HEAP_DEBUG, "  ! {}", cell);
-        cell->set_marked(true);
-        cell->visit_edges(*this);
-    }
-};
-
 void Heap::mark_live_cells(const HashTable<Cell*>& roots)
 {
     dbgln_if(HEAP_DEBUG, "mark_live_cells:");
-    MarkingVisitor visitor;
+    MarkingVisitor visitor(m_mark_stack, false);
     for (auto* root : roots)
         visitor.visit(root);
+    visitor.visit_marked_cells();
 }
 
-void Heap::sweep_dead_cells(bool print_report, const Core::ElapsedTimer& measurement_timer)
+void Heap::mark_live_young_cells(const HashTable<Cell*>& roots)
 {
-    dbgln_if(HEAP_DEBUG, "sweep_dead_cells:");
-    Vector<HeapBlock*, 32> empty_blocks;
-    Vector<HeapBlock*, 32> full_blocks_that_became_usable;
-
-    size_t collected_cells = 0;
-    size_t live_cells = 0;
-    size_t collected_cell_bytes = 0;
-    size_t live_cell_bytes = 0;
-
-    for_each_block([&](auto& block) {
-        bool block_has_live_cells = false;
-        bool block_was_full = block.is_full();
-        block.for_each_cell([&](Cell* cell) {
-            if (cell->is_live()) {
-                if (!cell->is_marked()) {
-                    dbgln_if(HEAP_DEBUG, "  ~ {}", cell);
-                    block.deallocate(cell);
-                    ++collected_cells;
-                    collected_cell_bytes += block.cell_size();
-                } else {
-                    cell->set_marked(false);
-                    block_has_live_cells = true;
-                    ++live_cells;
-                    live_cell_bytes += block.cell_size();
-                }
-            }
-        });
-        if (!block_has_live_cells)
-            empty_blocks.append(&block);
-        else if (block_was_full != block.is_full())
-            full_blocks_that_became_usable.append(&block);
-        return IterationDecision::Continue;
-    });
+    dbgln_if(HEAP_DEBUG, "mark_live_young_cells:");
+    MarkingVisitor visitor(m_mark_stack, true);
+    for (auto* root : roots)
+        visitor.visit(root);
+    for (auto* cell : m_remembered_cells)
+        cell->visit_edges(visitor);
+    for (auto* cell : m_old_cells_without_write_barrier)
+        cell->visit_edges(visitor);
+    visitor.visit_marked_cells();
+}
 
-    for (auto* block : empty_blocks) {
-        dbgln_if(HEAP_DEBUG, " - HeapBlock empty @ {}: cell_size={}", block, block->cell_size());
-        allocator_for_size(block->cell_size()).block_did_become_empty({}, *block);
-    }
+void Heap::promote(Cell& cell)
+{
+    cell.set_old(true);
+    ++m_old_cell_count;
+    if (!cell.has_write_barrier())
+        m_old_cells_without_write_barrier.append(&cell);
+}
 
-    for (auto* block : full_blocks_that_became_usable) {
-        dbgln_if(HEAP_DEBUG, " - HeapBlock usable again @ {}: cell_size={}", block, block->cell_size());
-        allocator_for_size(block->cell_size()).block_did_become_usable({}, *block);
-    }
+void Heap::sweep_dead_cells(bool print_report, const Core::ElapsedTimer& measurement_timer)
+{
+    dbgln_if(HEAP_DEBUG, "sweep_dead_cells:");
+    start_sweeping();
+    finish_sweeping();
 
     if constexpr (HEAP_DEBUG) {
         for_each_block([&](auto& block) {
@@ -238,10 +474,126 @@ void Heap::sweep_dead_cells(bool print_report, const Core::ElapsedTimer& measure
         dbgln("Garbage collection report");
         dbgln("=============================================");
         dbgln("     Time spent: {} ms", time_spent);
-        dbgln("     Live cells: {} ({} bytes)", live_cells, live_cell_bytes);
-        dbgln("Collected cells: {} ({} bytes)", collected_cells, collected_cell_bytes);
+        dbgln("     Live cells: {} ({} bytes)", m_sweep_counts.live_cells, m_sweep_counts.live_cell_bytes);
+        dbgln("Collected cells: {} ({} bytes)", m_sweep_counts.collected_cells, m_sweep_counts.collected_cell_bytes);
         dbgln("    Live blocks: {} ({} bytes)", live_block_count, live_block_count * HeapBlock::block_size);
-        dbgln("   Freed blocks: {} ({} bytes)", empty_blocks.size(), empty_blocks.size() * HeapBlock::block_size);
+        dbgln("   Freed blocks: {} ({} bytes)", m_sweep_counts.freed_blocks, m_sweep_counts.freed_blocks * HeapBlock::block_size);
+        dbgln("=============================================");
+    }
+}
+
+void Heap::start_sweeping()
+{
+    // Everything that survives is old afterwards, so the young generation and what was remembered about it is
+    // empty again.
+    m_young_cells.clear_with_capacity();
+    for (auto* cell : m_remembered_cells)
+        cell->set_remembered(false);
+    m_remembered_cells.clear_with_capacity();
+    m_old_cells_without_write_barrier.clear_with_capacity();
+    m_old_cell_count = 0;
+
+    m_sweep_counts = {};
+    m_blocks_to_sweep = 0;
+    for (auto& allocator : m_allocators)
+        m_blocks_to_sweep += allocator->will_sweep_all_blocks({});
+    m_incremental_state = IncrementalState::Sweeping;
+}
+
+void Heap::sweep_block(HeapBlock& block)
+{
+    VERIFY(m_incremental_state == IncrementalState::Sweeping);
+    bool block_has_live_cells = false;
+    block.for_each_cell([&](Cell* cell) {
+        if (!cell->is_live())
+            return;
+        if (!cell->is_marked()) {
+            dbgln_if(HEAP_DEBUG, "  ~ {}", cell);
+            block.deallocate(cell);
+            ++m_sweep_counts.collected_cells;
+            m_sweep_counts.collected_cell_bytes += block.cell_size();
+        } else {
+            cell->set_marked(false);
+            promote(*cell);
+            block_has_live_cells = true;
+            ++m_sweep_counts.live_cells;
+            m_sweep_counts.live_cell_bytes += block.cell_size();
+        }
+    });
+
+    VERIFY(m_blocks_to_sweep);
+    --m_blocks_to_sweep;
+
+    auto& allocator = allocator_for_size(block.cell_size());
+    if (!block_has_live_cells) {
+        dbgln_if(HEAP_DEBUG, " - HeapBlock empty @ {}: cell_size={}", &block, block.cell_size());
+        ++m_sweep_counts.freed_blocks;
+        allocator.block_did_become_empty({}, block);
+    } else {
+        allocator.block_was_swept({}, block);
+    }
+}
+
+void Heap::sweep_block(Badge<Allocator>, HeapBlock& block)
+{
+    sweep_block(block);
+    if (!m_blocks_to_sweep)
+        finish_sweeping();
+}
+
+void Heap::finish_sweeping()
+{
+    VERIFY(m_incremental_state == IncrementalState::Sweeping);
+    for (auto& allocator : m_allocators) {
+        while (auto* block = allocator->block_to_sweep())
+            sweep_block(*block);
+    }
+    m_incremental_state = IncrementalState::Idle;
+    m_old_cell_count_for_full_collection = max(2 * m_old_cell_count, min_old_cells_before_full_collection);
+}
+
+void Heap::sweep_dead_young_cells(bool print_report, const Core::ElapsedTimer& measurement_timer)
+{
+    dbgln_if(HEAP_DEBUG, "sweep_dead_young_cells:");
+    Vector<HeapBlock*, 32> full_blocks_that_became_usable;
+
+    size_t collected_cells = 0;
+    size_t promoted_cells = 0;
+
+    for (auto* cell : m_young_cells) {
+        VERIFY(cell->is_live());
+        if (cell->is_marked()) {
+            cell->set_marked(false);
+            promote(*cell);
+            ++promoted_cells;
+            continue;
+        }
+        dbgln_if(HEAP_DEBUG, "  ~ {}", cell);
+        auto* block = HeapBlock::from_cell(cell);
+        if (block->is_full())
+            full_blocks_that_became_usable.append(block);
+        block->deallocate(cell);
+        ++collected_cells;
+    }
+    m_young_cells.clear_with_capacity();
+
+    for (auto* cell : m_remembered_cells)
+        cell->set_remembered(false);
+    m_remembered_cells.clear_with_capacity();
+
+    // Blocks that become empty are only given back by full collections.
+    for (auto* block : full_blocks_that_became_usable) {
+        dbgln_if(HEAP_DEBUG, " - HeapBlock usable again @ {}: cell_size={}", block, block->cell_size());
+        allocator_for_size(block->cell_size()).block_did_become_usable({}, *block);
+    }
+
+    if (print_report) {
+        dbgln("Minor garbage collection report");
+        dbgln("=============================================");
+        dbgln("     Time spent: {} ms", measurement_timer.elapsed());
+        dbgln(" Promoted cells: {}", promoted_cells);
+        dbgln("Collected cells: {}", collected_cells);
+        dbgln("      Old cells: {}", m_old_cell_count);
         dbgln("=============================================");
     }
 }
@@ -270,21 +622,16 @@ void Heap::did_destroy_marked_value_list(Badge<MarkedValueList>, MarkedValueList
     m_marked_value_lists.remove(&list);
 }
 
-void Heap::defer_gc(Badge<DeferGC>)
+void Heap::did_create_inline_cache(Badge<InlineCache>, InlineCache& inline_cache)
 {
-    ++m_gc_deferrals;
+    VERIFY(!m_inline_caches.contains(&inline_cache));
+    m_inline_caches.set(&inline_cache);
 }
 
-void Heap::undefer_gc(Badge<DeferGC>)
+void Heap::did_destroy_inline_cache(Badge<InlineCache>, InlineCache& inline_cache)
 {
-    VERIFY(m_gc_deferrals > 0);
-    --m_gc_deferrals;
-
-    if (!m_gc_deferrals) {
-        if (m_should_gc_when_deferral_ends)
-            collect_garbage();
-        m_should_gc_when_deferral_ends = false;
-    }
+    VERIFY(m_inline_caches.contains(&inline_cache));
+    m_inline_caches.remove(&inline_cache);
 }
 
 }
@@ -6,9 +6,13 @@
 
 #pragma once
 
+#include <AK/Array.h>
+#include <AK/Function.h>
 #include <AK/HashTable.h>
 #include <AK/Noncopyable.h>
 #include <AK/NonnullOwnPtr.h>
+#include <AK/Optional.h>
+#include <AK/Time.h>
 #include <AK/Types.h>
 #include <AK/Vector.h>
 #include <LibCore/Forward.h>
@@ -20,6 +24,25 @@
 
 namespace JS {
 
+struct GarbageCollectionStatistics {
+    // Bucket n counts the pauses that took less than 2^n microseconds (but at least half as long), the last bucket
+    // everything longer than that.
+    static constexpr size_t pause_histogram_bucket_count = 24;
+
+    struct Collections {
+        size_t count { 0 };
+        u64 total_pause_microseconds { 0 };
+        u64 longest_pause_microseconds { 0 };
+        AK::Array<size_t, pause_histogram_bucket_count> pause_histogram {};
+
+        void record_pause(u64 microseconds);
+    };
+
+    Collections minor;
+    Collections full;
+    Collections incremental_steps;
+};
+
 class Heap {
     AK_MAKE_NONCOPYABLE(Heap);
     AK_MAKE_NONMOVABLE(Heap);
@@ -28,11 +51,16 @@ public:
     explicit Heap(VM&);
     ~Heap();
 
+    // No collections happen while a cell is being constructed and initialized, so it's still young by the time
+    // anything that's stored into it has to go through the write barrier.
     template<typename T, typename... Args>
     T* allocate_without_global_object(Args&&... args)
     {
         auto* memory = allocate_cell(sizeof(T));
+        defer_gc();
         new (memory) T(forward<Args>(args)...);
+        did_construct_cell(*static_cast<T*>(memory));
+        undefer_gc();
         return static_cast<T*>(memory);
     }
 
@@ -40,19 +68,25 @@ public:
     T* allocate(GlobalObject& global_object, Args&&... args)
     {
         auto* memory = allocate_cell(sizeof(T));
+        defer_gc();
         new (memory) T(forward<Args>(args)...);
         auto* cell = static_cast<T*>(memory);
+        did_construct_cell(*cell);
         constexpr bool is_object = IsBaseOf<Object, T>;
         if constexpr (is_object)
             static_cast<Object*>(cell)->disable_transitions();
         cell->initialize(global_object);
         if constexpr (is_object)
             static_cast<Object*>(cell)->enable_transitions();
+        undefer_gc();
         return cell;
     }
 
     enum class CollectionType {
+        // Marks and sweeps the whole heap.
         CollectGarbage,
+        // Only looks at the cells allocated since the last collection, see collect_garbage().
+        CollectYoungGeneration,
         CollectEverything,
     };
 
@@ -63,22 +97,76 @@ public:
     bool should_collect_on_every_allocation() const { return m_should_collect_on_every_allocation; }
     void set_should_collect_on_every_allocation(bool b) { m_should_collect_on_every_allocation = b; }
 
+    // When this is set, full collections that are due are done a step at a time, and no step should take much longer
+    // than this. Zero means they stop the world until they're done.
+    u64 incremental_step_microseconds() const { return m_incremental_step_microseconds; }
+    void set_incremental_step_microseconds(u64 microseconds) { m_incremental_step_microseconds = microseconds; }
+
+    bool is_collecting_incrementally() const { return m_incremental_state != IncrementalState::Idle; }
+    void perform_incremental_step();
+
+    // Lets whoever runs the event loop know that it should call perform_incremental_step() when it's idle,
+    // until is_collecting_incrementally() is false again. Allocating cells moves the collection along as well.
+    AK::Function<void()> on_incremental_collection_start;
+
     void did_create_handle(Badge<HandleImpl>, HandleImpl&);
     void did_destroy_handle(Badge<HandleImpl>, HandleImpl&);
 
     void did_create_marked_value_list(Badge<MarkedValueList>, MarkedValueList&);
     void did_destroy_marked_value_list(Badge<MarkedValueList>, MarkedValueList&);
 
-    void defer_gc(Badge<DeferGC>);
-    void undefer_gc(Badge<DeferGC>);
+    void did_create_inline_cache(Badge<InlineCache>, InlineCache&);
+    void did_destroy_inline_cache(Badge<InlineCache>, InlineCache&);
+
+    void defer_gc(Badge<DeferGC>) { defer_gc(); }
+    void undefer_gc(Badge<DeferGC>) { undefer_gc(); }
+
+    void write_barrier_slow_path(Badge<Cell>, Cell&, Cell* stored_cell);
+
+    void sweep_block(Badge<Allocator>, HeapBlock&);
+
+    const GarbageCollectionStatistics& statistics() const { return m_statistics; }
 
 private:
     Cell* allocate_cell(size_t);
 
+    void defer_gc() { ++m_gc_deferrals; }
+    void undefer_gc()
+    {
+        VERIFY(m_gc_deferrals > 0);
+        if (!--m_gc_deferrals && m_should_gc_when_deferral_ends)
+            collect_deferred_garbage();
+    }
+    void collect_deferred_garbage();
+
+    // Cells created while an incremental collection is marking have to be treated as live, since nothing
+    // told the write barrier about what was stored into them while they were being constructed.
+    ALWAYS_INLINE void did_construct_cell(Cell& cell)
+    {
+        if (m_incremental_state == IncrementalState::Marking) [[unlikely]]
+            shade(cell);
+    }
+
     void gather_roots(HashTable<Cell*>&);
     void gather_conservative_roots(HashTable<Cell*>&);
     void mark_live_cells(const HashTable<Cell*>& live_cells);
+    void mark_live_young_cells(const HashTable<Cell*>& live_cells);
     void sweep_dead_cells(bool print_report, const Core::ElapsedTimer&);
+    void sweep_dead_young_cells(bool print_report, const Core::ElapsedTimer&);
+    void promote(Cell&);
+    void remember(Cell&);
+    void shade(Cell&);
+
+    void collect_due_garbage();
+
+    void start_incremental_collection();
+    void finish_incremental_marking();
+    void finish_incremental_collection();
+    void abandon_incremental_marking();
+
+    void start_sweeping();
+    void sweep_block(HeapBlock&);
+    void finish_sweeping();
 
     Allocator& allocator_for_size(size_t);
 
@@ -94,6 +182,41 @@ private:
     size_t m_max_allocations_between_gc { 10000 };
     size_t m_allocations_since_last_gc { 0 };
 
+    // The old generation is collected once it's grown to twice the size it was after the last full collection.
+    static constexpr size_t min_old_cells_before_full_collection = 100000;
+    size_t m_old_cell_count { 0 };
+    size_t m_old_cell_count_for_full_collection { min_old_cells_before_full_collection };
+
+    Vector<Cell*> m_young_cells;
+    // Old cells that have had young cells stored into them since the last collection.
+    Vector<Cell*> m_remembered_cells;
+    Vector<Cell*> m_old_cells_without_write_barrier;
+
+    GarbageCollectionStatistics m_statistics;
+
+    enum class IncrementalState {
+        Idle,
+        Marking,
+        Sweeping,
+    };
+    IncrementalState m_incremental_state { IncrementalState::Idle };
+    u64 m_incremental_step_microseconds { 0 };
+
+    // Marked cells whose edges haven't been visited yet.
+    Vector<Cell*> m_mark_stack;
+    // Marked cells that something unknown was stored into while the marking was going on.
+    HashTable<Cell*> m_cells_to_visit_again;
+
+    size_t m_blocks_to_sweep { 0 };
+    struct SweepCounts {
+        size_t live_cells { 0 };
+        size_t live_cell_bytes { 0 };
+        size_t collected_cells { 0 };
+        size_t collected_cell_bytes { 0 };
+        size_t freed_blocks { 0 };
+    };
+    SweepCounts m_sweep_counts;
+
     bool m_should_collect_on_every_allocation { false };
 
     VM& m_vm;
@@ -103,8 +226,11 @@ private:
 
     HashTable<MarkedValueList*> m_marked_value_lists;
 
+    HashTable<InlineCache*> m_inline_caches;
+
     size_t m_gc_deferrals { 0 };
     bool m_should_gc_when_deferral_ends { false };
+    CollectionType m_collection_type_when_deferral_ends { CollectionType::CollectYoungGeneration };
 
     bool m_collecting_garbage { false };
 };
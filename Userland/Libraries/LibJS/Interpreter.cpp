@@ -8,6 +8,7 @@
 #include <AK/ScopeGuard.h>
 #include <AK/StringBuilder.h>
 #include <LibJS/AST.h>
+#include <LibJS/Bytecode/Interpreter.h>
 #include <LibJS/Interpreter.h>
 #include <LibJS/Runtime/GlobalObject.h>
 #include <LibJS/Runtime/LexicalEnvironment.h>
@@ -55,7 +56,11 @@ void Interpreter::run(GlobalObject& global_object, const Program& program)
     global_call_frame.is_strict_mode = program.is_strict_mode();
     vm.push_call_frame(global_call_frame, global_object);
     VERIFY(!vm.exception());
-    program.execute(*this, global_object);
+    auto* bytecode_interpreter = vm.bytecode_interpreter_if_exists();
+    if (auto* block = bytecode_interpreter ? program.bytecode_block() : nullptr)
+        vm.set_last_value({}, bytecode_interpreter->run(*block, global_object));
+    else
+        program.execute(*this, global_object);
 
     // Whatever the promise jobs or on_call_stack_emptied do should not affect the effective
     // 'last value'.
@@ -84,7 +89,7 @@ void Interpreter::enter_scope(const ScopeNode& scope_node, ScopeType scope_type,
 {
     ScopeGuard guard([&] {
         for (auto& declaration : scope_node.functions()) {
-            auto* function = ScriptFunction::create(global_object, declaration.name(), declaration.body(), declaration.parameters(), declaration.function_length(), current_scope(), declaration.is_strict_mode());
+            auto* function = ScriptFunction::create(global_object, declaration, current_scope(), declaration.is_strict_mode());
             vm().set_variable(declaration.name(), function, global_object);
         }
     });
@@ -96,6 +101,13 @@ void Interpreter::enter_scope(const ScopeNode& scope_node, ScopeType scope_type,
         return;
     }
 
+    if (auto& environment_layout = scope_node.environment_layout()) {
+        auto* block_lexical_environment = heap().allocate<LexicalEnvironment>(global_object, *environment_layout, current_scope());
+        vm().call_frame().scope = block_lexical_environment;
+        push_scope({ scope_type, scope_node, true });
+        return;
+    }
+
     HashMap<FlyString, Variable> scope_variables_with_declaration_kind;
     scope_variables_with_declaration_kind.ensure_capacity(16);
 
@@ -59,6 +59,73 @@ public:
     unsigned m_mask { 0 };
 };
 
+class VariableScopePusher {
+public:
+    explicit VariableScopePusher(Parser& parser)
+        : m_parser(parser)
+    {
+        m_parser.m_variable_scopes.append(Parser::VariableScope {});
+    }
+
+    ~VariableScopePusher()
+    {
+        if (!m_popped)
+            m_parser.pop_variable_scope({});
+    }
+
+    // Scopes that aren't popped with a layout don't get an environment of their own at runtime.
+    void pop(RefPtr<EnvironmentLayout> environment_layout)
+    {
+        VERIFY(!m_popped);
+        m_parser.pop_variable_scope(move(environment_layout));
+        m_popped = true;
+    }
+
+    // For functions whose body was skipped: what's in their environment isn't known yet, so nothing in here can be
+    // resolved (or passed on to the parent, since it doesn't end up in the parent's environment either).
+    void discard()
+    {
+        VERIFY(!m_popped);
+        auto scope = m_parser.m_variable_scopes.take_last();
+        // Functions skipped in here (in default parameter values) can't look any further than this either.
+        if (scope.enclosing_scope)
+            scope.enclosing_scope->may_bind_any_name = true;
+        m_popped = true;
+    }
+
+    Parser& m_parser;
+    bool m_popped { false };
+};
+
+// These have to match the environments Interpreter::enter_scope() and ScriptFunction::create_environment() set up.
+static void add_variable_bindings(EnvironmentLayout& environment_layout, const NonnullRefPtrVector<VariableDeclaration>& declarations)
+{
+    for (auto& declaration : declarations) {
+        for (auto& declarator : declaration.declarations())
+            environment_layout.add_binding(declarator.id().string(), declaration.declaration_kind());
+    }
+}
+
+static RefPtr<EnvironmentLayout> block_environment_layout(const NonnullRefPtrVector<VariableDeclaration>& declarations)
+{
+    if (declarations.is_empty())
+        return {};
+    auto environment_layout = EnvironmentLayout::create();
+    add_variable_bindings(environment_layout, declarations);
+    return environment_layout;
+}
+
+static NonnullRefPtr<EnvironmentLayout> function_environment_layout(const Vector<FunctionNode::Parameter>& parameters, const ScopeNode& body)
+{
+    auto environment_layout = EnvironmentLayout::create();
+    for (auto& parameter : parameters)
+        environment_layout->add_binding(parameter.name, DeclarationKind::Var);
+    add_variable_bindings(environment_layout, body.variables());
+    for (auto& function : body.functions())
+        environment_layout->add_binding(function.name(), DeclarationKind::Var);
+    return environment_layout;
+}
+
 class OperatorPrecedenceTable {
 public:
     constexpr OperatorPrecedenceTable()
@@ -180,10 +247,21 @@ Parser::ParserState::ParserState(Lexer lexer)
 }
 
 Parser::Parser(Lexer lexer)
-    : m_parser_state(move(lexer))
+    : m_ast_arena_scope(ASTArena::create())
+    , m_parser_state(move(lexer))
 {
 }
 
+void Parser::set_parse_function_bodies_lazily(bool lazily)
+{
+    m_parse_function_bodies_lazily = lazily;
+    // The skipped bodies have to hold on to the source, which the lexer doesn't own.
+    if (lazily && m_source.is_null()) {
+        m_source = m_parser_state.m_lexer.source();
+        m_source_filename = m_parser_state.m_lexer.filename();
+    }
+}
+
 Associativity Parser::operator_associativity(TokenType type) const
 {
     switch (type) {
@@ -229,6 +307,7 @@ NonnullRefPtr<Program> Parser::parse_program()
 {
     auto rule_start = push_start();
     ScopePusher scope(*this, ScopePusher::Var | ScopePusher::Let | ScopePusher::Function);
+    VariableScopePusher variable_scope(*this);
     auto program = adopt_ref(*new Program({ m_filename, rule_start.position(), position() }));
 
     bool first = true;
@@ -349,6 +428,7 @@ RefPtr<FunctionExpression> Parser::try_parse_arrow_function_expression(bool expe
     ArmedScopeGuard state_rollback_guard = [&] {
         load_state();
     };
+    VariableScopePusher variable_scope(*this);
 
     Vector<FunctionNode::Parameter> parameters;
     i32 function_length = -1;
@@ -415,6 +495,9 @@ RefPtr<FunctionExpression> Parser::try_parse_arrow_function_expression(bool expe
         state_rollback_guard.disarm();
         discard_saved_state();
         auto body = function_body_result.release_nonnull();
+        auto environment_layout = function_environment_layout(parameters, body);
+        body->set_environment_layout(environment_layout);
+        variable_scope.pop(move(environment_layout));
         return create_ast_node<FunctionExpression>({ m_parser_state.m_current_token.filename(), rule_start.position(), position() }, "", move(body), move(parameters), function_length, m_parser_state.m_var_scopes.take_last(), is_strict, true);
     }
 
@@ -471,7 +554,11 @@ RefPtr<MetaProperty> Parser::try_parse_new_target_expression()
 NonnullRefPtr<ClassDeclaration> Parser::parse_class_declaration()
 {
     auto rule_start = push_start();
-    return create_ast_node<ClassDeclaration>({ m_parser_state.m_current_token.filename(), rule_start.position(), position() }, parse_class_expression(true));
+    auto class_expression = parse_class_expression(true);
+    // The class gets put into whatever the current scope is when the declaration runs.
+    if (!m_variable_scopes.is_empty())
+        m_variable_scopes.last().dynamically_bound_names.set(class_expression->name());
+    return create_ast_node<ClassDeclaration>({ m_parser_state.m_current_token.filename(), rule_start.position(), position() }, move(class_expression));
 }
 
 NonnullRefPtr<ClassExpression> Parser::parse_class_expression(bool expect_class_name)
@@ -641,7 +728,9 @@ NonnullRefPtr<Expression> Parser::parse_primary_expression()
 
             set_try_parse_arrow_function_expression_failed_at_position(position(), true);
         }
-        return create_ast_node<Identifier>({ m_parser_state.m_current_token.filename(), rule_start.position(), position() }, consume().value());
+        auto identifier = create_ast_node<Identifier>({ m_parser_state.m_current_token.filename(), rule_start.position(), position() }, consume().value());
+        register_identifier_reference(identifier);
+        return identifier;
     }
     case TokenType::NumericLiteral:
         return create_ast_node<NumericLiteral>({ m_parser_state.m_current_token.filename(), rule_start.position(), position() }, consume_and_validate_numeric_literal().double_value());
@@ -817,7 +906,9 @@ NonnullRefPtr<ObjectExpression> Parser::parse_object_expression()
                 property_name = parse_property_key();
             } else {
                 property_name = create_ast_node<StringLiteral>({ m_parser_state.m_current_token.filename(), rule_start.position(), position() }, identifier);
-                property_value = create_ast_node<Identifier>({ m_parser_state.m_current_token.filename(), rule_start.position(), position() }, identifier);
+                auto identifier_reference = create_ast_node<Identifier>({ m_parser_state.m_current_token.filename(), rule_start.position(), position() }, identifier);
+                register_identifier_reference(identifier_reference);
+                property_value = move(identifier_reference);
             }
         } else {
             property_name = parse_property_key();
@@ -1281,8 +1372,13 @@ NonnullRefPtr<ReturnStatement> Parser::parse_return_statement()
 NonnullRefPtr<BlockStatement> Parser::parse_block_statement()
 {
     auto rule_start = push_start();
+    VariableScopePusher variable_scope(*this);
     bool dummy = false;
-    return parse_block_statement(dummy);
+    auto block = parse_block_statement(dummy);
+    auto environment_layout = block_environment_layout(block->variables());
+    block->set_environment_layout(environment_layout);
+    variable_scope.pop(move(environment_layout));
+    return block;
 }
 
 NonnullRefPtr<BlockStatement> Parser::parse_block_statement(bool& is_strict)
@@ -1335,6 +1431,7 @@ NonnullRefPtr<FunctionNodeType> Parser::parse_function_node(u8 parse_options)
     TemporaryChange super_constructor_call_rollback(m_parser_state.m_allow_super_constructor_call, !!(parse_options & FunctionNodeParseOptions::AllowSuperConstructorCall));
 
     ScopePusher scope(*this, ScopePusher::Var | ScopePusher::Function);
+    VariableScopePusher variable_scope(*this);
 
     String name;
     if (parse_options & FunctionNodeParseOptions::CheckForFunctionAndName) {
@@ -1356,13 +1453,167 @@ NonnullRefPtr<FunctionNodeType> Parser::parse_function_node(u8 parse_options)
         m_parser_state.m_labels_in_scope = move(old_labels_in_scope);
     });
 
+    if (m_parse_function_bodies_lazily && match(TokenType::CurlyOpen)) {
+        auto lazy_body = skip_function_body();
+        variable_scope.discard();
+        if (!lazy_body) {
+            auto error = create_ast_node<ErrorStatement>({ m_parser_state.m_current_token.filename(), rule_start.position(), position() });
+            return create_ast_node<FunctionNodeType>({ m_parser_state.m_current_token.filename(), rule_start.position(), position() }, name, move(error), move(parameters), function_length, NonnullRefPtrVector<VariableDeclaration>(), m_parser_state.m_strict_mode);
+        }
+        auto function = create_ast_node<FunctionNodeType>({ m_parser_state.m_current_token.filename(), rule_start.position(), position() }, name, nullptr, move(parameters), function_length, NonnullRefPtrVector<VariableDeclaration>(), lazy_body->is_strict_mode());
+        function->set_lazy_body(lazy_body.release_nonnull());
+        return function;
+    }
+
     bool is_strict = false;
     auto body = parse_block_statement(is_strict);
     body->add_variables(m_parser_state.m_var_scopes.last());
     body->add_functions(m_parser_state.m_function_scopes.last());
+    auto environment_layout = function_environment_layout(parameters, body);
+    body->set_environment_layout(environment_layout);
+    variable_scope.pop(move(environment_layout));
     return create_ast_node<FunctionNodeType>({ m_parser_state.m_current_token.filename(), rule_start.position(), position() }, name, move(body), move(parameters), function_length, NonnullRefPtrVector<VariableDeclaration>(), is_strict);
 }
 
+size_t Parser::source_offset_of(const Token& token) const
+{
+    auto lexer_source = m_parser_state.m_lexer.source().characters_without_null_termination();
+    return m_source_offset + (token.value().characters_without_null_termination() - lexer_source);
+}
+
+// Finds the end of the function body starting at the current token, making sure the brackets in between match up
+// but otherwise only looking at the tokens to see whether the function opts into strict mode.
+RefPtr<LazyFunctionBody> Parser::skip_function_body()
+{
+    auto start = position();
+    auto start_offset = source_offset_of(m_parser_state.m_current_token);
+    consume(TokenType::CurlyOpen);
+
+    bool is_strict = m_parser_state.m_strict_mode;
+    if (!is_strict && match(TokenType::StringLiteral)) {
+        auto value = consume().value();
+        if (value == "'use strict'" || value == "\"use strict\"") {
+            // It's only a directive if the string is a statement all by itself.
+            if (match(TokenType::Semicolon) || match(TokenType::CurlyClose))
+                is_strict = true;
+            else if (m_parser_state.m_current_token.trivia_contains_line_terminator() && !match_secondary_expression())
+                is_strict = true;
+        }
+    }
+
+    Vector<TokenType, 16> closing_brackets;
+    closing_brackets.append(TokenType::CurlyClose);
+    size_t end_offset = 0;
+    while (!closing_brackets.is_empty()) {
+        auto type = m_parser_state.m_current_token.type();
+        switch (type) {
+        case TokenType::CurlyOpen:
+            closing_brackets.append(TokenType::CurlyClose);
+            break;
+        case TokenType::ParenOpen:
+            closing_brackets.append(TokenType::ParenClose);
+            break;
+        case TokenType::BracketOpen:
+            closing_brackets.append(TokenType::BracketClose);
+            break;
+        case TokenType::TemplateLiteralExprStart:
+            closing_brackets.append(TokenType::TemplateLiteralExprEnd);
+            break;
+        case TokenType::CurlyClose:
+        case TokenType::ParenClose:
+        case TokenType::BracketClose:
+        case TokenType::TemplateLiteralExprEnd:
+            if (closing_brackets.last() != type) {
+                expected(Token::name(closing_brackets.last()));
+                return {};
+            }
+            closing_brackets.take_last();
+            if (closing_brackets.is_empty())
+                end_offset = source_offset_of(m_parser_state.m_current_token) + 1;
+            break;
+        case TokenType::Eof:
+        case TokenType::Invalid:
+        case TokenType::UnterminatedRegexLiteral:
+        case TokenType::UnterminatedStringLiteral:
+        case TokenType::UnterminatedTemplateLiteral:
+            expected(Token::name(closing_brackets.last()));
+            return {};
+        default:
+            break;
+        }
+        consume();
+    }
+
+    // The body is parsed in the scopes it's in now, so they all need to remember what they were like once they're done.
+    RefPtr<LazyFunctionBody::EnclosingScope> enclosing_scope = m_enclosing_scope;
+    for (size_t i = 0; i + 1 < m_variable_scopes.size(); ++i) {
+        auto& scope = m_variable_scopes[i];
+        if (!scope.enclosing_scope) {
+            scope.enclosing_scope = adopt_ref(*new LazyFunctionBody::EnclosingScope);
+            scope.enclosing_scope->parent = enclosing_scope;
+        }
+        enclosing_scope = scope.enclosing_scope;
+    }
+
+    auto lazy_body = adopt_ref(*new LazyFunctionBody);
+    lazy_body->m_source = m_source;
+    lazy_body->m_filename = m_source_filename;
+    lazy_body->m_start_offset = start_offset;
+    lazy_body->m_end_offset = end_offset;
+    lazy_body->m_start = start;
+    lazy_body->m_is_in_strict_mode_context = m_parser_state.m_strict_mode;
+    lazy_body->m_is_strict_mode = is_strict;
+    lazy_body->m_allow_super_property_lookup = m_parser_state.m_allow_super_property_lookup;
+    lazy_body->m_allow_super_constructor_call = m_parser_state.m_allow_super_constructor_call;
+    lazy_body->m_enclosing_scope = move(enclosing_scope);
+    return lazy_body;
+}
+
+NonnullRefPtr<BlockStatement> Parser::parse_skipped_function_body(const Vector<FunctionNode::Parameter>& parameters, bool& is_strict)
+{
+    ScopePusher scope(*this, ScopePusher::Var | ScopePusher::Function);
+    VariableScopePusher variable_scope(*this);
+    TemporaryChange change(m_parser_state.m_in_function_context, true);
+
+    auto body = parse_block_statement(is_strict);
+    if (!done())
+        expected("end of function body");
+    body->add_variables(m_parser_state.m_var_scopes.last());
+    body->add_functions(m_parser_state.m_function_scopes.last());
+    auto environment_layout = function_environment_layout(parameters, body);
+    body->set_environment_layout(environment_layout);
+    variable_scope.pop(move(environment_layout));
+    return body;
+}
+
+const Statement& LazyFunctionBody::parse(const Vector<FunctionNode::Parameter>& parameters) const
+{
+    if (m_body)
+        return *m_body;
+
+    auto source = m_source.substring_view(m_start_offset, m_end_offset - m_start_offset);
+    // The lexer counts the first character it reads as a column of its own.
+    Parser parser(Lexer(source, m_filename, m_start.line, m_start.column - 1));
+    parser.m_parse_function_bodies_lazily = true;
+    parser.m_source = m_source;
+    parser.m_source_filename = m_filename;
+    parser.m_source_offset = m_start_offset;
+    parser.m_enclosing_scope = move(m_enclosing_scope);
+    parser.m_parser_state.m_strict_mode = m_is_in_strict_mode_context;
+    parser.m_parser_state.m_allow_super_property_lookup = m_allow_super_property_lookup;
+    parser.m_parser_state.m_allow_super_constructor_call = m_allow_super_constructor_call;
+
+    bool is_strict = false;
+    auto body = parser.parse_skipped_function_body(parameters, is_strict);
+    if (parser.has_errors()) {
+        m_syntax_error = parser.errors().first().to_string();
+        m_body = create_ast_node<ErrorStatement>(body->source_range());
+    } else {
+        m_body = move(body);
+    }
+    return *m_body;
+}
+
 Vector<FunctionNode::Parameter> Parser::parse_function_parameters(int& function_length, u8 parse_options)
 {
     auto rule_start = push_start();
@@ -1456,6 +1707,7 @@ NonnullRefPtr<VariableDeclaration> Parser::parse_variable_declaration(bool for_l
             syntax_error("Missing initializer in 'const' variable declaration");
         }
         auto identifier = create_ast_node<Identifier>({ m_parser_state.m_current_token.filename(), rule_start.position(), position() }, move(id));
+        register_identifier_reference(identifier);
         if (init && is<FunctionExpression>(*init)) {
             static_cast<FunctionExpression&>(*init).set_name_if_possible(id);
         }
@@ -1649,7 +1901,10 @@ NonnullRefPtr<WithStatement> Parser::parse_with_statement()
 
     consume(TokenType::ParenClose);
 
+    VariableScopePusher variable_scope(*this);
     auto body = parse_statement();
+    // Any name might be looked up on the object, so nothing in the body can be resolved statically.
+    m_variable_scopes.last() = {};
     return create_ast_node<WithStatement>({ m_parser_state.m_current_token.filename(), rule_start.position(), position() }, move(object), move(body));
 }
 
@@ -1690,8 +1945,15 @@ NonnullRefPtr<CatchClause> Parser::parse_catch_clause()
         consume(TokenType::ParenClose);
     }
 
+    VariableScopePusher variable_scope(*this);
     auto body = parse_block_statement();
-    return create_ast_node<CatchClause>({ m_parser_state.m_current_token.filename(), rule_start.position(), position() }, parameter, move(body));
+    auto environment_layout = EnvironmentLayout::create();
+    environment_layout->add_binding(parameter, DeclarationKind::Var);
+    variable_scope.pop(environment_layout);
+
+    auto catch_clause = create_ast_node<CatchClause>({ m_parser_state.m_current_token.filename(), rule_start.position(), position() }, parameter, move(body));
+    catch_clause->set_environment_layout(move(environment_layout));
+    return catch_clause;
 }
 
 NonnullRefPtr<IfStatement> Parser::parse_if_statement()
@@ -1742,6 +2004,7 @@ NonnullRefPtr<Statement> Parser::parse_for_statement()
 
     consume(TokenType::ParenOpen);
 
+    VariableScopePusher variable_scope(*this);
     bool in_scope = false;
     RefPtr<ASTNode> init;
     if (!match(TokenType::Semicolon)) {
@@ -1785,11 +2048,19 @@ NonnullRefPtr<Statement> Parser::parse_for_statement()
     TemporaryChange continue_change(m_parser_state.m_in_continue_context, true);
     auto body = parse_statement();
 
+    RefPtr<EnvironmentLayout> head_environment_layout;
     if (in_scope) {
         m_parser_state.m_let_scopes.take_last();
+        head_environment_layout = EnvironmentLayout::create();
+        auto& declaration = static_cast<VariableDeclaration&>(*init);
+        for (auto& declarator : declaration.declarations())
+            head_environment_layout->add_binding(declarator.id().string(), declaration.declaration_kind());
     }
+    variable_scope.pop(head_environment_layout);
 
-    return create_ast_node<ForStatement>({ m_parser_state.m_current_token.filename(), rule_start.position(), position() }, move(init), move(test), move(update), move(body));
+    auto for_statement = create_ast_node<ForStatement>({ m_parser_state.m_current_token.filename(), rule_start.position(), position() }, move(init), move(test), move(update), move(body));
+    for_statement->set_head_environment_layout(move(head_environment_layout));
+    return for_statement;
 }
 
 NonnullRefPtr<Statement> Parser::parse_for_in_of_statement(NonnullRefPtr<ASTNode> lhs)
@@ -2064,6 +2335,8 @@ void Parser::syntax_error(const String& message, Optional<Position> position)
 
 void Parser::save_state()
 {
+    if (!m_variable_scopes.is_empty())
+        m_parser_state.m_unresolved_identifier_count = m_variable_scopes.last().unresolved_identifiers.size();
     m_saved_state.append(m_parser_state);
 }
 
@@ -2071,6 +2344,9 @@ void Parser::load_state()
 {
     VERIFY(!m_saved_state.is_empty());
     m_parser_state = m_saved_state.take_last();
+    // The identifiers parsed since are thrown away with everything else.
+    if (!m_variable_scopes.is_empty())
+        m_variable_scopes.last().unresolved_identifiers.shrink(m_parser_state.m_unresolved_identifier_count, true);
 }
 
 void Parser::discard_saved_state()
@@ -2078,4 +2354,74 @@ void Parser::discard_saved_state()
     m_saved_state.take_last();
 }
 
+void Parser::register_identifier_reference(const NonnullRefPtr<Identifier>& identifier)
+{
+    if (m_variable_scopes.is_empty())
+        return;
+    auto& scope = m_variable_scopes.last();
+    auto& name = identifier->string();
+    // `arguments` is conjured up by the VM when it isn't declared, so it's always looked up by name.
+    if (name == "arguments")
+        return;
+    // A direct eval can declare anything in the scope it's called from.
+    if (name == "eval")
+        scope.may_bind_any_name = true;
+    scope.unresolved_identifiers.append({ identifier, 0 });
+}
+
+void Parser::pop_variable_scope(RefPtr<EnvironmentLayout> environment_layout)
+{
+    auto scope = m_variable_scopes.take_last();
+    auto* parent = m_variable_scopes.is_empty() ? nullptr : &m_variable_scopes.last();
+
+    for (auto& unresolved : scope.unresolved_identifiers) {
+        auto& name = unresolved.identifier->string();
+        if (environment_layout) {
+            if (auto slot = environment_layout->slot_of(name); slot.has_value()) {
+                unresolved.identifier->set_environment_coordinate({ environment_layout, unresolved.hops, slot.value() });
+                continue;
+            }
+        }
+        if (scope.may_bind_any_name || scope.dynamically_bound_names.contains(name))
+            continue;
+        auto hops = unresolved.hops + (environment_layout ? 1 : 0);
+        if (parent)
+            parent->unresolved_identifiers.append({ unresolved.identifier, hops });
+        else if (m_enclosing_scope)
+            resolve_in_enclosing_scopes(*unresolved.identifier, hops);
+        // Identifiers that make it past the outermost scope are globals (or undeclared), which stay looked up by name.
+    }
+
+    if (scope.enclosing_scope) {
+        scope.enclosing_scope->environment_layout = environment_layout;
+        scope.enclosing_scope->dynamically_bound_names = scope.dynamically_bound_names;
+        scope.enclosing_scope->may_bind_any_name = scope.may_bind_any_name;
+    }
+
+    // Without an environment of its own, whatever gets bound in this scope at runtime ends up in the parent's.
+    if (parent && !environment_layout) {
+        parent->may_bind_any_name |= scope.may_bind_any_name;
+        for (auto& name : scope.dynamically_bound_names)
+            parent->dynamically_bound_names.set(name);
+    }
+}
+
+// Picks up where pop_variable_scope() left off when the outermost scope of this parser is the body of a function that
+// was skipped before, using what the parser that skipped it knew about the scopes around it.
+void Parser::resolve_in_enclosing_scopes(Identifier& identifier, size_t hops)
+{
+    auto& name = identifier.string();
+    for (auto* scope = m_enclosing_scope.ptr(); scope; scope = scope->parent.ptr()) {
+        if (scope->environment_layout) {
+            if (auto slot = scope->environment_layout->slot_of(name); slot.has_value()) {
+                identifier.set_environment_coordinate({ scope->environment_layout, hops, slot.value() });
+                return;
+            }
+            ++hops;
+        }
+        if (scope->may_bind_any_name || scope->dynamically_bound_names.contains(name))
+            return;
+    }
+}
+
 }
@@ -38,6 +38,10 @@ public:
 
     NonnullRefPtr<Program> parse_program();
 
+    // Only skims over function bodies, leaving them to be parsed when they're first needed. Syntax errors in them
+    // (apart from unbalanced brackets) then only come up once the function is called.
+    void set_parse_function_bodies_lazily(bool);
+
     template<typename FunctionNodeType>
     NonnullRefPtr<FunctionNodeType> parse_function_node(u8 parse_options = FunctionNodeParseOptions::CheckForFunctionAndName);
     Vector<FunctionNode::Parameter> parse_function_parameters(int& function_length, u8 parse_options = 0);
@@ -133,6 +137,8 @@ public:
 
 private:
     friend class ScopePusher;
+    friend class VariableScopePusher;
+    friend class LazyFunctionBody;
 
     Associativity operator_associativity(TokenType) const;
     bool match_expression() const;
@@ -156,6 +162,14 @@ private:
     void discard_saved_state();
     Position position() const;
 
+    void register_identifier_reference(const NonnullRefPtr<Identifier>&);
+    void pop_variable_scope(RefPtr<EnvironmentLayout>);
+    void resolve_in_enclosing_scopes(Identifier&, size_t hops);
+
+    RefPtr<LazyFunctionBody> skip_function_body();
+    NonnullRefPtr<BlockStatement> parse_skipped_function_body(const Vector<FunctionNode::Parameter>&, bool& is_strict);
+    size_t source_offset_of(const Token&) const;
+
     bool try_parse_arrow_function_expression_failed_at_position(const Position&) const;
     void set_try_parse_arrow_function_expression_failed_at_position(const Position&, bool);
 
@@ -203,10 +217,27 @@ private:
         bool m_in_break_context { false };
         bool m_in_continue_context { false };
         bool m_string_legacy_octal_escape_sequence_in_scope { false };
+        size_t m_unresolved_identifier_count { 0 };
 
         explicit ParserState(Lexer);
     };
 
+    struct UnresolvedIdentifier {
+        NonnullRefPtr<Identifier> identifier;
+        size_t hops { 0 };
+    };
+
+    // Everything that may get an environment at runtime, and the identifiers inside it that haven't been matched
+    // up with a variable yet. Names bound behind the parser's back (by eval, with or class declarations) are
+    // never resolved past the scope they might be bound in.
+    struct VariableScope {
+        Vector<UnresolvedIdentifier> unresolved_identifiers;
+        HashTable<FlyString> dynamically_bound_names;
+        bool may_bind_any_name { false };
+        // Filled in when the scope is popped, for the function bodies inside it that were skipped.
+        RefPtr<LazyFunctionBody::EnclosingScope> enclosing_scope;
+    };
+
     class PositionKeyTraits {
     public:
         static int hash(const Position& position)
@@ -220,10 +251,20 @@ private:
         }
     };
 
+    ASTArena::Scope m_ast_arena_scope;
     Vector<Position> m_rule_starts;
     ParserState m_parser_state;
     FlyString m_filename;
     Vector<ParserState> m_saved_state;
+    Vector<VariableScope> m_variable_scopes;
     HashMap<Position, TokenMemoization, PositionKeyTraits> m_token_memoizations;
+
+    // When parsing function bodies lazily, this is the whole source (which the lexer's source starts m_source_offset
+    // into), and the scopes around the function that was skipped if this parser is parsing its body now.
+    bool m_parse_function_bodies_lazily { false };
+    String m_source;
+    String m_source_filename;
+    size_t m_source_offset { 0 };
+    RefPtr<LazyFunctionBody::EnclosingScope> m_enclosing_scope;
 };
 }
@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/StringImpl.h>
+#include <LibJS/ProgramCache.h>
+
+namespace JS {
+
+static u32 source_hash(const StringView& source)
+{
+    return string_hash(source.characters_without_null_termination(), source.length());
+}
+
+RefPtr<Program> ProgramCache::find(const StringView& source, const StringView& filename)
+{
+    auto hash = source_hash(source);
+    for (size_t i = 0; i < m_entries.size(); ++i) {
+        auto& entry = m_entries[i];
+        if (entry.hash != hash || entry.source != source || entry.filename != filename)
+            continue;
+        auto program = entry.program;
+        m_entries.append(m_entries.take(i));
+        return program;
+    }
+    return {};
+}
+
+void ProgramCache::add(const StringView& source, const StringView& filename, NonnullRefPtr<Program> program)
+{
+    if (m_capacity == 0)
+        return;
+    if (m_entries.size() == m_capacity)
+        m_entries.take_first();
+    m_entries.append({ source_hash(source), source, filename, move(program) });
+}
+
+}
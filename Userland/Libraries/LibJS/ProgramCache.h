@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/String.h>
+#include <AK/Vector.h>
+#include <LibJS/AST.h>
+
+namespace JS {
+
+// Holds on to the programs parsed from the last few sources, so running the same source again (like when a page is
+// reloaded) doesn't mean parsing it all over again. That includes the function bodies that were only parsed once
+// they got called.
+class ProgramCache {
+public:
+    explicit ProgramCache(size_t capacity = 16)
+        : m_capacity(capacity)
+    {
+    }
+
+    RefPtr<Program> find(const StringView& source, const StringView& filename);
+
+    // Only programs that parsed without errors should be added, since the errors aren't kept.
+    void add(const StringView& source, const StringView& filename, NonnullRefPtr<Program>);
+
+private:
+    struct Entry {
+        u32 hash { 0 };
+        String source;
+        String filename;
+        NonnullRefPtr<Program> program;
+    };
+
+    size_t m_capacity { 0 };
+    // The most recently used entry is the last one.
+    Vector<Entry> m_entries;
+};
+
+}
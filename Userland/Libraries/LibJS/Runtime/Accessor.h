@@ -26,10 +26,18 @@ public:
     }
 
     Function* getter() const { return m_getter; }
-    void set_getter(Function* getter) { m_getter = getter; }
+    void set_getter(Function* getter)
+    {
+        m_getter = getter;
+        write_barrier(m_getter);
+    }
 
     Function* setter() const { return m_setter; }
-    void set_setter(Function* setter) { m_setter = setter; }
+    void set_setter(Function* setter)
+    {
+        m_setter = setter;
+        write_barrier(m_setter);
+    }
 
     Value call_getter(Value this_value)
     {
@@ -54,6 +62,7 @@ public:
 
 private:
     const char* class_name() const override { return "Accessor"; };
+    bool has_write_barrier() const override { return true; }
 
     Function* m_getter { nullptr };
     Function* m_setter { nullptr };
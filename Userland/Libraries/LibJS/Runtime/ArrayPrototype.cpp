@@ -8,6 +8,7 @@
 
 #include <AK/Function.h>
 #include <AK/HashTable.h>
+#include <AK/QuickSort.h>
 #include <AK/ScopeGuard.h>
 #include <AK/StringBuilder.h>
 #include <LibJS/Runtime/Array.h>
@@ -88,6 +89,32 @@ static Function* callback_from_args(GlobalObject& global_object, const String& n
     return &callback.as_function();
 }
 
+// The elements of a packed array can be read straight out of its storage, as reading them can't run any code.
+// Since any JS that does run can change that, this has to be asked again afterwards.
+static Optional<Span<const Value>> packed_elements_of(const Object& object)
+{
+    if (!object.is_array() || !is_packed(object.indexed_properties().element_kind()))
+        return {};
+    return object.indexed_properties().packed_elements();
+}
+
+// Proxies of arrays are arrays too, but they don't keep their elements themselves, so only use the elements
+// if there are as many as the length says there should be.
+static Optional<Span<const Value>> all_packed_elements_of(const Object& object, size_t length)
+{
+    auto elements = packed_elements_of(object);
+    if (!elements.has_value() || elements->size() != length)
+        return {};
+    return elements;
+}
+
+static Value get_element(Object& object, size_t index)
+{
+    if (auto elements = packed_elements_of(object); elements.has_value() && index < elements->size())
+        return (*elements)[index];
+    return object.get(index);
+}
+
 static void for_each_item(VM& vm, GlobalObject& global_object, const String& name, AK::Function<IterationDecision(size_t index, Value value, Value callback_result)> callback, bool skip_empty = true)
 {
     auto* this_object = vm.this_value(global_object).to_object(global_object);
@@ -105,7 +132,7 @@ static void for_each_item(VM& vm, GlobalObject& global_object, const String& nam
     auto this_value = vm.argument(1);
 
     for (size_t i = 0; i < initial_length; ++i) {
-        auto value = this_object->get(i);
+        auto value = get_element(*this_object, i);
         if (vm.exception())
             return;
         if (value.is_empty()) {
@@ -330,7 +357,7 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::join)
     for (size_t i = 0; i < length; ++i) {
         if (i > 0)
             builder.append(separator);
-        auto value = this_object->get(i).value_or(js_undefined());
+        auto value = get_element(*this_object, i).value_or(js_undefined());
         if (vm.exception())
             return {};
         if (value.is_nullish())
@@ -352,6 +379,8 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::concat)
 
     auto* new_array = Array::create(global_object);
     new_array->indexed_properties().append_all(array, array->indexed_properties());
+    // Getters may have run and collected garbage since the write barrier, so the new array could be old by now.
+    new_array->write_barrier();
     if (vm.exception())
         return {};
 
@@ -360,6 +389,7 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::concat)
         if (argument.is_array()) {
             auto& argument_object = argument.as_object();
             new_array->indexed_properties().append_all(&argument_object, argument_object.indexed_properties());
+            new_array->write_barrier();
             if (vm.exception())
                 return {};
         } else {
@@ -379,6 +409,7 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::slice)
     auto* new_array = Array::create(global_object);
     if (vm.argument_count() == 0) {
         new_array->indexed_properties().append_all(array, array->indexed_properties());
+        new_array->write_barrier();
         if (vm.exception())
             return {};
         return new_array;
@@ -394,7 +425,7 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::slice)
         return new_array;
 
     if (start_slice < 0)
-        start_slice = end_slice + start_slice;
+        start_slice = max(end_slice + start_slice, static_cast<ssize_t>(0));
 
     if (vm.argument_count() >= 2) {
         end_slice = vm.argument(1).to_i32(global_object);
@@ -406,10 +437,18 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::slice)
             end_slice = array_size;
     }
 
+    if (auto elements = packed_elements_of(*array); elements.has_value() && static_cast<size_t>(array_size) == elements->size()) {
+        auto& new_indexed_properties = new_array->indexed_properties();
+        for (ssize_t i = start_slice; i < end_slice; ++i)
+            new_indexed_properties.append((*elements)[i]);
+        return new_array;
+    }
+
     for (ssize_t i = start_slice; i < end_slice; ++i) {
-        new_array->indexed_properties().append(array->get(i));
+        auto value = array->get(i);
         if (vm.exception())
             return {};
+        new_array->indexed_properties().append(value);
     }
 
     return new_array;
@@ -436,6 +475,23 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::index_of)
             from_index = max(length + from_index, 0);
     }
     auto search_element = vm.argument(0);
+    if (auto elements = all_packed_elements_of(*this_object, length); elements.has_value()) {
+        if (is_packed_number(this_object->indexed_properties().element_kind())) {
+            if (!search_element.is_number())
+                return Value(-1);
+            auto number = search_element.as_double();
+            for (i32 i = from_index; i < length; ++i) {
+                if ((*elements)[i].as_double() == number)
+                    return Value(i);
+            }
+            return Value(-1);
+        }
+        for (i32 i = from_index; i < length; ++i) {
+            if (strict_eq((*elements)[i], search_element))
+                return Value(i);
+        }
+        return Value(-1);
+    }
     for (i32 i = from_index; i < length; ++i) {
         auto element = this_object->get(i);
         if (vm.exception())
@@ -565,10 +621,15 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::reverse)
     auto size = array->indexed_properties().array_like_size();
     array_reverse.ensure_capacity(size);
 
-    for (ssize_t i = size - 1; i >= 0; --i) {
-        array_reverse.append(array->get(i));
-        if (vm.exception())
-            return {};
+    if (auto elements = all_packed_elements_of(*array, size); elements.has_value()) {
+        for (ssize_t i = size - 1; i >= 0; --i)
+            array_reverse.append((*elements)[i]);
+    } else {
+        for (ssize_t i = size - 1; i >= 0; --i) {
+            array_reverse.append(array->get(i));
+            if (vm.exception())
+                return {};
+        }
     }
 
     array->set_indexed_property_elements(move(array_reverse));
@@ -701,23 +762,50 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::sort)
 
     MarkedValueList values_to_sort(vm.heap());
 
-    for (size_t i = 0; i < original_length; ++i) {
-        auto element_val = array->get(i);
-        if (vm.exception())
-            return {};
+    auto elements = all_packed_elements_of(*array, original_length);
+    if (elements.has_value()) {
+        values_to_sort.ensure_capacity(original_length);
+        for (auto& element : *elements)
+            values_to_sort.unchecked_append(element);
+    } else {
+        for (size_t i = 0; i < original_length; ++i) {
+            auto element_val = array->get(i);
+            if (vm.exception())
+                return {};
 
-        if (!element_val.is_empty())
-            values_to_sort.append(element_val);
+            if (!element_val.is_empty())
+                values_to_sort.append(element_val);
+        }
     }
 
-    // Perform sorting by merge sort. This isn't as efficient compared to quick sort, but
-    // quicksort can't be used in all cases because the spec requires Array.prototype.sort()
-    // to be stable. FIXME: when initially scanning through the array, maintain a flag
-    // for if an unstable sort would be indistinguishable from a stable sort (such as just
-    // just strings or numbers), and in that case use quick sort instead for better performance.
-    array_merge_sort(vm, global_object, callback.is_undefined() ? nullptr : &callback.as_function(), values_to_sort);
-    if (vm.exception())
-        return {};
+    if (elements.has_value() && callback.is_undefined() && array->indexed_properties().element_kind() == ElementKind::PackedInt32) {
+        // Different int32s never turn into the same string, so there's no way to tell whether this sort is stable,
+        // and the strings can be made just once.
+        Vector<String> keys;
+        keys.ensure_capacity(values_to_sort.size());
+        Vector<size_t> order;
+        order.ensure_capacity(values_to_sort.size());
+        for (size_t i = 0; i < values_to_sort.size(); ++i) {
+            keys.unchecked_append(values_to_sort[i].to_string_without_side_effects());
+            order.unchecked_append(i);
+        }
+        quick_sort(order, [&](size_t a, size_t b) { return keys[a] < keys[b]; });
+        Vector<Value> sorted_values;
+        sorted_values.ensure_capacity(values_to_sort.size());
+        for (auto index : order)
+            sorted_values.unchecked_append(values_to_sort[index]);
+        for (size_t i = 0; i < sorted_values.size(); ++i)
+            values_to_sort[i] = sorted_values[i];
+    } else {
+        // Perform sorting by merge sort. This isn't as efficient compared to quick sort, but
+        // quicksort can't be used in all cases because the spec requires Array.prototype.sort()
+        // to be stable. FIXME: when initially scanning through the array, maintain a flag
+        // for if an unstable sort would be indistinguishable from a stable sort (such as just
+        // just strings or numbers), and in that case use quick sort instead for better performance.
+        array_merge_sort(vm, global_object, callback.is_undefined() ? nullptr : &callback.as_function(), values_to_sort);
+        if (vm.exception())
+            return {};
+    }
 
     for (size_t i = 0; i < values_to_sort.size(); ++i) {
         array->put(i, values_to_sort[i]);
@@ -758,6 +846,15 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::last_index_of)
             from_index = length + from_index;
     }
     auto search_element = vm.argument(0);
+    if (auto elements = all_packed_elements_of(*this_object, length); elements.has_value()) {
+        if (is_packed_number(this_object->indexed_properties().element_kind()) && !search_element.is_number())
+            return Value(-1);
+        for (i32 i = from_index; i >= 0; --i) {
+            if (strict_eq((*elements)[i], search_element))
+                return Value(i);
+        }
+        return Value(-1);
+    }
     for (i32 i = from_index; i >= 0; --i) {
         auto element = this_object->get(i);
         if (vm.exception())
@@ -789,6 +886,15 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::includes)
             from_index = max(length + from_index, 0);
     }
     auto value_to_find = vm.argument(0);
+    if (auto elements = all_packed_elements_of(*this_object, length); elements.has_value()) {
+        if (is_packed_number(this_object->indexed_properties().element_kind()) && !value_to_find.is_number())
+            return Value(false);
+        for (i32 i = from_index; i < length; ++i) {
+            if (same_value_zero((*elements)[i], value_to_find))
+                return Value(true);
+        }
+        return Value(false);
+    }
     for (i32 i = from_index; i < length; ++i) {
         auto element = this_object->get(i).value_or(js_undefined());
         if (vm.exception())
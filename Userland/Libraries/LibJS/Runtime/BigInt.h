@@ -21,6 +21,7 @@ public:
 
 private:
     virtual const char* class_name() const override { return "BigInt"; }
+    virtual bool has_write_barrier() const override { return true; }
 
     Crypto::SignedBigInteger m_big_integer;
 };
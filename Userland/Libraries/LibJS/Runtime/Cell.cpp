@@ -8,9 +8,15 @@
 #include <LibJS/Heap/HeapBlock.h>
 #include <LibJS/Runtime/Cell.h>
 #include <LibJS/Runtime/Value.h>
+#include <LibJS/Runtime/VM.h>
 
 namespace JS {
 
+void Cell::write_barrier_slow_path(Cell* cell)
+{
+    heap().write_barrier_slow_path({}, *this, cell);
+}
+
 void Cell::Visitor::visit(Cell* cell)
 {
     if (cell)
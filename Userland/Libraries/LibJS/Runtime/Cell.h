@@ -12,6 +12,7 @@
 #include <AK/String.h>
 #include <AK/TypeCasts.h>
 #include <LibJS/Forward.h>
+#include <LibJS/Runtime/Value.h>
 
 namespace JS {
 
@@ -29,6 +30,38 @@ public:
     bool is_live() const { return m_live; }
     void set_live(bool b) { m_live = b; }
 
+    // Cells that have survived a garbage collection are old, and only looked at again by full collections.
+    bool is_old() const { return m_old; }
+    void set_old(bool b) { m_old = b; }
+
+    bool is_remembered() const { return m_remembered; }
+    void set_remembered(bool b) { m_remembered = b; }
+
+    // Minor collections only find the young cells an old cell points to if the heap is told about them, and
+    // incremental collections the cells stored into one they've already marked, so this has to be called with every
+    // cell stored into this one once it's been initialized. Cells that don't do that have to say so here, and are
+    // then visited by every minor collection, and again at the end of incremental marking, instead.
+    virtual bool has_write_barrier() const { return false; }
+
+    ALWAYS_INLINE void write_barrier(Cell* cell)
+    {
+        if (cell && ((m_old && !m_remembered && !cell->m_old) || (m_mark && !cell->m_mark))) [[unlikely]]
+            write_barrier_slow_path(cell);
+    }
+
+    ALWAYS_INLINE void write_barrier(Value value)
+    {
+        if (value.is_cell())
+            write_barrier(value.as_cell());
+    }
+
+    // For when it isn't known what's going to be stored.
+    ALWAYS_INLINE void write_barrier()
+    {
+        if ((m_old && !m_remembered) || m_mark) [[unlikely]]
+            write_barrier_slow_path(nullptr);
+    }
+
     virtual const char* class_name() const = 0;
 
     class Visitor {
@@ -50,8 +83,12 @@ protected:
     Cell() { }
 
 private:
+    void write_barrier_slow_path(Cell*);
+
     bool m_mark { false };
     bool m_live { true };
+    bool m_old { false };
+    bool m_remembered { false };
 };
 
 }
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/FlyString.h>
+#include <AK/HashMap.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/Optional.h>
+#include <AK/RefCounted.h>
+#include <AK/RefPtr.h>
+#include <AK/Vector.h>
+#include <LibJS/Forward.h>
+
+namespace JS {
+
+// The variables the parser knows an environment is going to have, in the order they're kept in its slots.
+// Every environment created for the same piece of code shares the same layout.
+class EnvironmentLayout : public RefCounted<EnvironmentLayout> {
+public:
+    struct Binding {
+        FlyString name;
+        DeclarationKind declaration_kind;
+    };
+
+    static NonnullRefPtr<EnvironmentLayout> create() { return adopt_ref(*new EnvironmentLayout); }
+
+    // Declaring a name again keeps its slot, but takes on the new declaration kind.
+    void add_binding(const FlyString& name, DeclarationKind declaration_kind)
+    {
+        if (auto slot = m_slots.get(name); slot.has_value()) {
+            m_bindings[slot.value()].declaration_kind = declaration_kind;
+            return;
+        }
+        m_slots.set(name, m_bindings.size());
+        m_bindings.append({ name, declaration_kind });
+    }
+
+    Optional<size_t> slot_of(const FlyString& name) const { return m_slots.get(name); }
+    const Vector<Binding>& bindings() const { return m_bindings; }
+
+private:
+    EnvironmentLayout() = default;
+
+    Vector<Binding> m_bindings;
+    HashMap<FlyString, size_t> m_slots;
+};
+
+// Where the parser found the variable an identifier refers to: the given slot of the environment `hops` steps up
+// the scope chain, which was created from layout. Identifiers that couldn't be resolved have no layout.
+struct EnvironmentCoordinate {
+    RefPtr<EnvironmentLayout> layout;
+    size_t hops { 0 };
+    size_t slot { 0 };
+};
+
+}
@@ -31,6 +31,7 @@ public:
 private:
     virtual const char* class_name() const override { return "Exception"; }
     virtual void visit_edges(Visitor&) override;
+    virtual bool has_write_barrier() const override { return true; }
 
     Value m_value;
     Vector<TracebackFrame> m_traceback;
@@ -57,6 +57,9 @@ protected:
 
 private:
     virtual bool is_global_object() const final { return true; }
+    // The constructors and prototypes are set up by initialize(), which doesn't run while the heap holds off on
+    // collecting garbage. There's only one global object, so it's just looked at by every minor collection.
+    virtual bool has_write_barrier() const override { return false; }
 
     JS_DECLARE_NATIVE_FUNCTION(gc);
     JS_DECLARE_NATIVE_FUNCTION(is_nan);
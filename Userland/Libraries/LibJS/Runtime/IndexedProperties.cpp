@@ -16,6 +16,24 @@ SimpleIndexedPropertyStorage::SimpleIndexedPropertyStorage(Vector<Value>&& initi
     : m_array_size(initial_values.size())
     , m_packed_elements(move(initial_values))
 {
+    for (auto& value : m_packed_elements)
+        update_element_kind(value);
+}
+
+void SimpleIndexedPropertyStorage::update_element_kind(Value value)
+{
+    if (m_element_kind == ElementKind::Holey)
+        return;
+    if (value.is_empty() || value.is_accessor()) {
+        m_element_kind = ElementKind::Holey;
+        return;
+    }
+    if (value.is_number()) {
+        if (m_element_kind == ElementKind::PackedInt32 && value.type() != Value::Type::Int32)
+            m_element_kind = ElementKind::PackedDouble;
+        return;
+    }
+    m_element_kind = ElementKind::Packed;
 }
 
 bool SimpleIndexedPropertyStorage::has_index(u32 index) const
@@ -43,16 +61,21 @@ void SimpleIndexedPropertyStorage::put(u32 index, Value value, PropertyAttribute
     VERIFY(attributes == default_attributes);
 
     if (index >= m_array_size) {
+        if (index > m_array_size)
+            m_element_kind = ElementKind::Holey;
         m_array_size = index + 1;
         grow_storage_if_needed();
     }
     m_packed_elements[index] = value;
+    update_element_kind(value);
 }
 
 void SimpleIndexedPropertyStorage::remove(u32 index)
 {
-    if (index < m_array_size)
+    if (index < m_array_size) {
         m_packed_elements[index] = {};
+        m_element_kind = ElementKind::Holey;
+    }
 }
 
 void SimpleIndexedPropertyStorage::insert(u32 index, Value value, PropertyAttributes attributes)
@@ -60,6 +83,7 @@ void SimpleIndexedPropertyStorage::insert(u32 index, Value value, PropertyAttrib
     VERIFY(attributes == default_attributes);
     m_array_size++;
     m_packed_elements.insert(index, value);
+    update_element_kind(value);
 }
 
 ValueAndAttributes SimpleIndexedPropertyStorage::take_first()
@@ -78,6 +102,10 @@ ValueAndAttributes SimpleIndexedPropertyStorage::take_last()
 
 void SimpleIndexedPropertyStorage::set_array_like_size(size_t new_size)
 {
+    if (new_size > m_array_size)
+        m_element_kind = ElementKind::Holey;
+    else if (new_size == 0)
+        m_element_kind = ElementKind::PackedInt32;
     m_array_size = new_size;
     m_packed_elements.resize(new_size);
 }
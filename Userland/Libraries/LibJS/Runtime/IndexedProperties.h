@@ -12,6 +12,19 @@
 
 namespace JS {
 
+// What's known about the elements of an array in simple storage, from most to least specific.
+// Packed means every index below the length has an element and none of them are accessors, so reading
+// them can't fall through to the prototype or run any code.
+enum class ElementKind : u8 {
+    PackedInt32,
+    PackedDouble,
+    Packed,
+    Holey,
+};
+
+inline bool is_packed(ElementKind kind) { return kind != ElementKind::Holey; }
+inline bool is_packed_number(ElementKind kind) { return kind == ElementKind::PackedInt32 || kind == ElementKind::PackedDouble; }
+
 struct ValueAndAttributes {
     Value value;
     PropertyAttributes attributes { default_attributes };
@@ -62,13 +75,17 @@ public:
     virtual bool is_simple_storage() const override { return true; }
     const Vector<Value>& elements() const { return m_packed_elements; }
 
+    ElementKind element_kind() const { return m_element_kind; }
+
 private:
     friend GenericIndexedPropertyStorage;
 
     void grow_storage_if_needed();
+    void update_element_kind(Value);
 
     size_t m_array_size { 0 };
     Vector<Value> m_packed_elements;
+    ElementKind m_element_kind { ElementKind::PackedInt32 };
 };
 
 class GenericIndexedPropertyStorage final : public IndexedPropertyStorage {
@@ -144,6 +161,19 @@ public:
 
     Vector<u32> indices() const;
 
+    ElementKind element_kind() const
+    {
+        if (!m_storage->is_simple_storage())
+            return ElementKind::Holey;
+        return static_cast<const SimpleIndexedPropertyStorage&>(*m_storage).element_kind();
+    }
+
+    Span<const Value> packed_elements() const
+    {
+        VERIFY(is_packed(element_kind()));
+        return static_cast<const SimpleIndexedPropertyStorage&>(*m_storage).elements().span().trim(array_like_size());
+    }
+
     template<typename Callback>
     void for_each_value(Callback callback)
     {
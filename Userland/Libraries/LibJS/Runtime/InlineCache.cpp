@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Heap/Heap.h>
+#include <LibJS/Runtime/InlineCache.h>
+#include <LibJS/Runtime/GlobalObject.h>
+#include <LibJS/Runtime/Object.h>
+#include <LibJS/Runtime/ProxyObject.h>
+#include <LibJS/Runtime/Reference.h>
+#include <LibJS/Runtime/Shape.h>
+#include <LibJS/Runtime/VM.h>
+
+namespace JS {
+
+InlineCache::~InlineCache()
+{
+    if (m_heap)
+        m_heap->did_destroy_inline_cache({}, *this);
+}
+
+Value InlineCache::get(const Object& object)
+{
+    auto& statistics = object.vm().inline_cache_statistics();
+    auto* shape = &object.shape();
+    for (size_t i = 0; i < m_entry_count; ++i) {
+        auto& entry = m_entries[i];
+        if (entry.shape != shape)
+            continue;
+        const Object* holder = &object;
+        if (entry.holder) {
+            // The prototype has changed since, the property may not even be there anymore.
+            if (&entry.holder->shape() != entry.holder_shape)
+                break;
+            holder = entry.holder;
+        }
+        auto value = holder->get_direct(entry.offset);
+        if (value.is_accessor() || value.is_native_property())
+            break;
+        ++statistics.hits;
+        return value.value_or(js_undefined());
+    }
+    ++statistics.misses;
+    return {};
+}
+
+void InlineCache::fill(const Object& object, const StringOrSymbol& property_name)
+{
+    if (m_heap && m_heap != &object.heap())
+        return;
+    if (is<ProxyObject>(object) || object.shape().is_unique())
+        return;
+
+    Entry entry { &object.shape() };
+    const Object* holder = &object;
+    auto metadata = object.shape().lookup(property_name);
+    if (!metadata.has_value()) {
+        auto* prototype = object.prototype();
+        if (!prototype || is<ProxyObject>(*prototype) || prototype->shape().is_unique())
+            return;
+        metadata = prototype->shape().lookup(property_name);
+        if (!metadata.has_value())
+            return;
+        entry.holder = prototype;
+        entry.holder_shape = &prototype->shape();
+        holder = prototype;
+    }
+
+    // Getters have to be called with the right receiver, leave them to the slow path.
+    auto value = holder->get_direct(metadata->offset);
+    if (value.is_accessor() || value.is_native_property())
+        return;
+    entry.offset = metadata->offset;
+
+    if (!m_heap) {
+        m_heap = &object.heap();
+        m_heap->did_create_inline_cache({}, *this);
+    }
+
+    for (size_t i = 0; i < m_entry_count; ++i) {
+        if (m_entries[i].shape == entry.shape) {
+            m_entries[i] = entry;
+            return;
+        }
+    }
+    if (m_entry_count < max_entries) {
+        m_entries[m_entry_count++] = entry;
+        return;
+    }
+    m_entries[m_next_entry_to_replace] = entry;
+    m_next_entry_to_replace = (m_next_entry_to_replace + 1) % max_entries;
+}
+
+Value InlineCache::get_property(GlobalObject& global_object, Value base, const PropertyName& property_name)
+{
+    VERIFY(!property_name.is_number());
+    if (base.is_object()) {
+        if (auto value = get(base.as_object()); !value.is_empty())
+            return value;
+    }
+    auto value = Reference(base, property_name).get(global_object);
+    if (!global_object.vm().exception() && base.is_object())
+        fill(base.as_object(), property_name.to_string_or_symbol());
+    return value;
+}
+
+void InlineCache::gather_roots(Badge<Heap>, HashTable<Cell*>& roots) const
+{
+    for (size_t i = 0; i < m_entry_count; ++i) {
+        roots.set(const_cast<Shape*>(m_entries[i].shape));
+        if (m_entries[i].holder_shape)
+            roots.set(const_cast<Shape*>(m_entries[i].holder_shape));
+    }
+}
+
+void InlineCache::did_destroy_heap(Badge<Heap>)
+{
+    m_heap = nullptr;
+    m_entry_count = 0;
+    m_next_entry_to_replace = 0;
+}
+
+}
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Badge.h>
+#include <AK/HashTable.h>
+#include <AK/Noncopyable.h>
+#include <LibJS/Forward.h>
+#include <LibJS/Runtime/StringOrSymbol.h>
+#include <LibJS/Runtime/Value.h>
+
+namespace JS {
+
+// Remembers where one property access site found its property on the last few shapes it saw, so that looking
+// it up again on an object with one of those shapes is a pointer comparison and a load, rather than a hash table
+// lookup on every object in the prototype chain.
+//
+// Only data properties on the object itself or on its prototype are cached, and only while the shapes involved
+// are shared ones, as those never change once they've been created. The cache keeps them alive.
+class InlineCache {
+    AK_MAKE_NONCOPYABLE(InlineCache);
+    AK_MAKE_NONMOVABLE(InlineCache);
+
+public:
+    // Sites that see more shapes than this keep replacing the oldest one.
+    static constexpr size_t max_entries = 4;
+
+    InlineCache() = default;
+    ~InlineCache();
+
+    // Returns an empty value if the cache doesn't know, in which case the caller has to look the property up
+    // itself, and should call fill() afterwards.
+    Value get(const Object&);
+    void fill(const Object&, const StringOrSymbol& property_name);
+
+    // Gets a named property (not an index) of base the same way Reference::get() does, going through the cache
+    // whenever base is an object.
+    Value get_property(GlobalObject&, Value base, const PropertyName&);
+
+    void gather_roots(Badge<Heap>, HashTable<Cell*>&) const;
+    void did_destroy_heap(Badge<Heap>);
+
+private:
+    struct Entry {
+        const Shape* shape { nullptr };
+        // Where the property was found, if it wasn't on the object itself.
+        const Object* holder { nullptr };
+        const Shape* holder_shape { nullptr };
+        size_t offset { 0 };
+    };
+
+    Entry m_entries[max_entries];
+    size_t m_entry_count { 0 };
+    size_t m_next_entry_to_replace { 0 };
+    Heap* m_heap { nullptr };
+};
+
+}
@@ -37,6 +37,16 @@ LexicalEnvironment::LexicalEnvironment(HashMap<FlyString, Variable> variables, S
 {
 }
 
+LexicalEnvironment::LexicalEnvironment(NonnullRefPtr<EnvironmentLayout> layout, ScopeObject* parent_scope, EnvironmentRecordType environment_record_type)
+    : ScopeObject(parent_scope)
+    , m_environment_record_type(environment_record_type)
+    , m_layout(move(layout))
+{
+    m_slots.ensure_capacity(m_layout->bindings().size());
+    for (auto& binding : m_layout->bindings())
+        m_slots.unchecked_append({ js_undefined(), binding.declaration_kind });
+}
+
 LexicalEnvironment::~LexicalEnvironment()
 {
 }
@@ -48,18 +58,32 @@ void LexicalEnvironment::visit_edges(Visitor& visitor)
     visitor.visit(m_home_object);
     visitor.visit(m_new_target);
     visitor.visit(m_current_function);
+    for (auto& variable : m_slots)
+        visitor.visit(variable.value);
     for (auto& it : m_variables)
         visitor.visit(it.value.value);
 }
 
 Optional<Variable> LexicalEnvironment::get_from_scope(const FlyString& name) const
 {
+    if (m_layout) {
+        if (auto slot = m_layout->slot_of(name); slot.has_value())
+            return m_slots[slot.value()];
+    }
     return m_variables.get(name);
 }
 
 void LexicalEnvironment::put_to_scope(const FlyString& name, Variable variable)
 {
+    if (m_layout) {
+        if (auto slot = m_layout->slot_of(name); slot.has_value()) {
+            m_slots[slot.value()] = variable;
+            write_barrier(variable.value);
+            return;
+        }
+    }
     m_variables.set(name, variable);
+    write_barrier(variable.value);
 }
 
 bool LexicalEnvironment::has_super_binding() const
@@ -109,6 +133,13 @@ void LexicalEnvironment::bind_this_value(GlobalObject& global_object, Value this
     }
     m_this_value = this_value;
     m_this_binding_status = ThisBindingStatus::Initialized;
+    write_barrier(this_value);
+}
+
+void LexicalEnvironment::set_current_function(Function& function)
+{
+    m_current_function = &function;
+    write_barrier(m_current_function);
 }
 
 }
@@ -8,6 +8,8 @@
 
 #include <AK/FlyString.h>
 #include <AK/HashMap.h>
+#include <AK/NonnullRefPtr.h>
+#include <LibJS/Runtime/EnvironmentLayout.h>
 #include <LibJS/Runtime/ScopeObject.h>
 #include <LibJS/Runtime/Value.h>
 
@@ -34,6 +36,7 @@ public:
     LexicalEnvironment(EnvironmentRecordType);
     LexicalEnvironment(HashMap<FlyString, Variable> variables, ScopeObject* parent_scope);
     LexicalEnvironment(HashMap<FlyString, Variable> variables, ScopeObject* parent_scope, EnvironmentRecordType);
+    LexicalEnvironment(NonnullRefPtr<EnvironmentLayout>, ScopeObject* parent_scope, EnvironmentRecordType = EnvironmentRecordType::Declarative);
     virtual ~LexicalEnvironment() override;
 
     // ^ScopeObject
@@ -44,9 +47,20 @@ public:
 
     void clear();
 
-    const HashMap<FlyString, Variable>& variables() const { return m_variables; }
-
-    void set_home_object(Value object) { m_home_object = object; }
+    // The variables from the layout live in slots, anything else is kept by name.
+    const EnvironmentLayout* layout() const { return m_layout.ptr(); }
+    const Variable& slot(size_t index) const { return m_slots[index]; }
+    void set_slot_value(size_t index, Value value)
+    {
+        m_slots[index].value = value;
+        write_barrier(value);
+    }
+
+    void set_home_object(Value object)
+    {
+        m_home_object = object;
+        write_barrier(object);
+    }
     bool has_super_binding() const;
     Value get_super_base();
 
@@ -54,21 +68,32 @@ public:
     void bind_this_value(GlobalObject&, Value this_value);
 
     // Not a standard operation.
-    void replace_this_binding(Value this_value) { m_this_value = this_value; }
+    void replace_this_binding(Value this_value)
+    {
+        m_this_value = this_value;
+        write_barrier(this_value);
+    }
 
     Value new_target() const { return m_new_target; };
-    void set_new_target(Value new_target) { m_new_target = new_target; }
+    void set_new_target(Value new_target)
+    {
+        m_new_target = new_target;
+        write_barrier(new_target);
+    }
 
     Function* current_function() const { return m_current_function; }
-    void set_current_function(Function& function) { m_current_function = &function; }
+    void set_current_function(Function& function);
 
     EnvironmentRecordType type() const { return m_environment_record_type; }
 
 private:
+    virtual bool is_lexical_environment() const override { return true; }
     virtual void visit_edges(Visitor&) override;
 
     EnvironmentRecordType m_environment_record_type : 8 { EnvironmentRecordType::Declarative };
     ThisBindingStatus m_this_binding_status : 8 { ThisBindingStatus::Uninitialized };
+    RefPtr<EnvironmentLayout> m_layout;
+    Vector<Variable> m_slots;
     HashMap<FlyString, Variable> m_variables;
     Value m_home_object;
     Value m_this_value;
@@ -77,4 +102,7 @@ private:
     Function* m_current_function { nullptr };
 };
 
+template<>
+inline bool Object::fast_is<LexicalEnvironment>() const { return is_lexical_environment(); }
+
 }
@@ -21,6 +21,7 @@ public:
 
 private:
     virtual const char* class_name() const override { return "NativeProperty"; }
+    virtual bool has_write_barrier() const override { return true; }
 
     AK::Function<Value(VM&, GlobalObject&)> m_getter;
     AK::Function<void(VM&, GlobalObject&, Value)> m_setter;
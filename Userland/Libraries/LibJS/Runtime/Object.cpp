@@ -82,8 +82,8 @@ Object::Object(ConstructWithoutPrototypeTag, GlobalObject& global_object)
 
 Object::Object(Object& prototype)
 {
-    m_shape = prototype.global_object().empty_object_shape();
-    set_prototype(&prototype);
+    // This shape can't be shared, initialize() adds properties to it in place.
+    m_shape = prototype.heap().allocate_without_global_object<Shape>(*prototype.global_object().empty_object_shape(), &prototype);
 }
 
 Object::Object(Shape& shape)
@@ -120,7 +120,14 @@ bool Object::set_prototype(Object* new_prototype)
         shape().set_prototype_without_transition(new_prototype);
         return true;
     }
+    if (!m_transitions_enabled) {
+        // Like in the constructor, we'll be adding properties to the shape in place.
+        m_shape = heap().allocate_without_global_object<Shape>(*m_shape, new_prototype);
+        write_barrier(m_shape);
+        return true;
+    }
     m_shape = m_shape->create_prototype_transition(new_prototype);
+    write_barrier(m_shape);
     return true;
 }
 
@@ -441,6 +448,7 @@ void Object::set_shape(Shape& new_shape)
 {
     m_storage.resize(new_shape.property_count());
     m_shape = &new_shape;
+    write_barrier(m_shape);
 }
 
 bool Object::define_property(const StringOrSymbol& property_name, const Object& descriptor, bool throw_exceptions)
@@ -583,6 +591,7 @@ bool Object::put_own_property(const StringOrSymbol& property_name, Value value,
         m_shape->add_property_without_transition(property_name, attributes);
         m_storage.resize(m_shape->property_count());
         m_storage[m_shape->property_count() - 1] = value;
+        write_barrier(value);
         return true;
     }
 
@@ -647,6 +656,7 @@ bool Object::put_own_property(const StringOrSymbol& property_name, Value value,
         call_native_property_setter(value_here.as_native_property(), this, value);
     } else {
         m_storage[metadata.value().offset] = value;
+        write_barrier(value);
     }
     return true;
 }
@@ -695,6 +705,7 @@ bool Object::put_own_property_by_index(u32 property_index, Value value, Property
         call_native_property_setter(value_here.as_native_property(), this, value);
     } else {
         m_indexed_properties.put(this, property_index, value, attributes, mode == PutOwnPropertyMode::Put);
+        write_barrier(value);
     }
     return true;
 }
@@ -733,6 +744,7 @@ void Object::ensure_shape_is_unique()
         return;
 
     m_shape = m_shape->create_unique_clone();
+    write_barrier(m_shape);
 }
 
 Value Object::get_by_index(u32 property_index) const
@@ -4,20 +4,66 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/StringBuilder.h>
+#include <AK/Vector.h>
 #include <LibJS/Runtime/PrimitiveString.h>
 #include <LibJS/Runtime/VM.h>
 
 namespace JS {
 
+// Concatenations shorter than this are cheaper to just do right away.
+static constexpr size_t minimum_rope_byte_length = 64;
+
 PrimitiveString::PrimitiveString(String string)
     : m_string(move(string))
 {
 }
 
+PrimitiveString::PrimitiveString(PrimitiveString& lhs, PrimitiveString& rhs)
+    : m_is_rope(true)
+    , m_lhs(&lhs)
+    , m_rhs(&rhs)
+    , m_rope_byte_length(lhs.byte_length() + rhs.byte_length())
+{
+}
+
 PrimitiveString::~PrimitiveString()
 {
 }
 
+void PrimitiveString::visit_edges(Cell::Visitor& visitor)
+{
+    if (m_is_rope) {
+        visitor.visit(m_lhs);
+        visitor.visit(m_rhs);
+    }
+}
+
+void PrimitiveString::resolve_rope() const
+{
+    VERIFY(m_is_rope);
+
+    // Ropes built in a loop are as deep as the loop was long, so walk them without recursing.
+    StringBuilder builder(m_rope_byte_length);
+    Vector<const PrimitiveString*> pieces;
+    pieces.append(m_rhs);
+    pieces.append(m_lhs);
+    while (!pieces.is_empty()) {
+        auto* piece = pieces.take_last();
+        if (piece->m_is_rope) {
+            pieces.append(piece->m_rhs);
+            pieces.append(piece->m_lhs);
+            continue;
+        }
+        builder.append(piece->m_string);
+    }
+
+    m_string = builder.build();
+    m_is_rope = false;
+    m_lhs = nullptr;
+    m_rhs = nullptr;
+}
+
 PrimitiveString* js_string(Heap& heap, String string)
 {
     if (string.is_empty())
@@ -34,4 +80,21 @@ PrimitiveString* js_string(VM& vm, String string)
     return js_string(vm.heap(), move(string));
 }
 
+PrimitiveString* js_rope_string(VM& vm, PrimitiveString& lhs, PrimitiveString& rhs)
+{
+    if (lhs.byte_length() == 0)
+        return &rhs;
+    if (rhs.byte_length() == 0)
+        return &lhs;
+
+    if (lhs.byte_length() + rhs.byte_length() < minimum_rope_byte_length) {
+        StringBuilder builder(lhs.byte_length() + rhs.byte_length());
+        builder.append(lhs.string());
+        builder.append(rhs.string());
+        return js_string(vm, builder.build());
+    }
+
+    return vm.heap().allocate_without_global_object<PrimitiveString>(lhs, rhs);
+}
+
 }
@@ -14,17 +14,38 @@ namespace JS {
 class PrimitiveString final : public Cell {
 public:
     explicit PrimitiveString(String);
+    PrimitiveString(PrimitiveString& lhs, PrimitiveString& rhs);
     virtual ~PrimitiveString();
 
-    const String& string() const { return m_string; }
+    const String& string() const
+    {
+        if (m_is_rope)
+            resolve_rope();
+        return m_string;
+    }
+
+    bool is_rope() const { return m_is_rope; }
+    size_t byte_length() const { return m_is_rope ? m_rope_byte_length : m_string.length(); }
 
 private:
     virtual const char* class_name() const override { return "PrimitiveString"; }
+    virtual bool has_write_barrier() const override { return true; }
+    virtual void visit_edges(Cell::Visitor&) override;
+
+    void resolve_rope() const;
+
+    // A rope is the concatenation of two other strings, which is only done once someone looks at what's in it.
+    // That way, building a long string a piece at a time doesn't copy everything built so far at every step.
+    mutable bool m_is_rope { false };
+    mutable PrimitiveString* m_lhs { nullptr };
+    mutable PrimitiveString* m_rhs { nullptr };
+    size_t m_rope_byte_length { 0 };
 
-    String m_string;
+    mutable String m_string;
 };
 
 PrimitiveString* js_string(Heap&, String);
 PrimitiveString* js_string(VM&, String);
+PrimitiveString* js_rope_string(VM&, PrimitiveString& lhs, PrimitiveString& rhs);
 
 }
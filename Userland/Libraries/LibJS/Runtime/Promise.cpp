@@ -115,6 +115,7 @@ Value Promise::fulfill(Value value)
     VERIFY(!value.is_empty());
     m_state = State::Fulfilled;
     m_result = value;
+    write_barrier(value);
     trigger_reactions();
     m_fulfill_reactions.clear();
     m_reject_reactions.clear();
@@ -130,6 +131,7 @@ Value Promise::reject(Value reason)
     auto& vm = this->vm();
     m_state = State::Rejected;
     m_result = reason;
+    write_barrier(reason);
     if (!m_is_handled)
         vm.promise_rejection_tracker(*this, RejectionOperation::Reject);
     trigger_reactions();
@@ -183,6 +185,8 @@ Value Promise::perform_then(Value on_fulfilled, Value on_rejected, Optional<Prom
         dbgln_if(PROMISE_DEBUG, "[Promise @ {} / perform_then()]: state is State::Pending, adding fulfill/reject reactions", this);
         m_fulfill_reactions.append(fulfill_reaction);
         m_reject_reactions.append(reject_reaction);
+        write_barrier(fulfill_reaction);
+        write_barrier(reject_reaction);
         break;
     case Promise::State::Fulfilled: {
         auto value = m_result;
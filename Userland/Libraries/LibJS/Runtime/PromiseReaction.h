@@ -45,6 +45,7 @@ public:
 private:
     virtual const char* class_name() const override { return "PromiseReaction"; }
     virtual void visit_edges(Visitor&) override;
+    virtual bool has_write_barrier() const override { return true; }
 
     Type m_type;
     Optional<PromiseCapability> m_capability;
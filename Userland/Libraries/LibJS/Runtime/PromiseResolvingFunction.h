@@ -14,6 +14,7 @@ struct AlreadyResolved final : public Cell {
     bool value { false };
 
     virtual const char* class_name() const override { return "AlreadyResolved"; }
+    virtual bool has_write_barrier() const override { return true; }
 
 protected:
     // Allocated cells must be >= sizeof(FreelistEntry), which is 24 bytes -
@@ -21,7 +21,7 @@ void Reference::put(GlobalObject& global_object, Value value)
 
     if (is_local_variable() || is_global_variable()) {
         if (is_local_variable())
-            vm.set_variable(m_name.to_string(), value, global_object);
+            vm.set_variable(m_name.as_string(), value, global_object, false, m_environment_coordinate);
         else
             global_object.put(m_name, value);
         return;
@@ -71,7 +71,7 @@ Value Reference::get(GlobalObject& global_object)
     if (is_local_variable() || is_global_variable()) {
         Value value;
         if (is_local_variable())
-            value = vm.get_variable(m_name.to_string(), global_object);
+            value = vm.get_variable(m_name.as_string(), global_object, m_environment_coordinate);
         else
             value = global_object.get(m_name);
         if (vm.exception())
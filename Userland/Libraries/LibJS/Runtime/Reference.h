@@ -23,11 +23,12 @@ public:
     }
 
     enum LocalVariableTag { LocalVariable };
-    Reference(LocalVariableTag, const FlyString& name, bool strict = false)
+    Reference(LocalVariableTag, const FlyString& name, bool strict = false, const EnvironmentCoordinate* environment_coordinate = nullptr)
         : m_base(js_null())
         , m_name(name)
         , m_strict(strict)
         , m_local_variable(true)
+        , m_environment_coordinate(environment_coordinate)
     {
     }
 
@@ -76,6 +77,7 @@ private:
     bool m_strict { false };
     bool m_local_variable { false };
     bool m_global_variable { false };
+    const EnvironmentCoordinate* m_environment_coordinate { nullptr };
 };
 
 }
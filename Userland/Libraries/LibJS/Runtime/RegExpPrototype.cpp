@@ -170,7 +170,8 @@ JS_DEFINE_NATIVE_FUNCTION(RegExpPrototype::exec)
     array->indexed_properties().set_array_like_size(result.n_capture_groups + 1);
     array->define_property(vm.names.index, Value((i32)match.global_offset));
     array->define_property(vm.names.input, js_string(vm, str));
-    array->indexed_properties().put(array, 0, js_string(vm, match.view.to_string()));
+    auto* match_string = js_string(vm, match.view.to_string());
+    array->indexed_properties().put(array, 0, match_string);
 
     for (size_t i = 0; i < result.n_capture_groups; ++i) {
         auto capture_value = js_undefined();
@@ -6,6 +6,7 @@
 
 #include <AK/Function.h>
 #include <LibJS/AST.h>
+#include <LibJS/Bytecode/Interpreter.h>
 #include <LibJS/Interpreter.h>
 #include <LibJS/Runtime/Array.h>
 #include <LibJS/Runtime/Error.h>
@@ -29,13 +30,22 @@ static ScriptFunction* typed_this(VM& vm, GlobalObject& global_object)
 
 ScriptFunction* ScriptFunction::create(GlobalObject& global_object, const FlyString& name, const Statement& body, Vector<FunctionNode::Parameter> parameters, i32 m_function_length, ScopeObject* parent_scope, bool is_strict, bool is_arrow_function)
 {
-    return global_object.heap().allocate<ScriptFunction>(global_object, global_object, name, body, move(parameters), m_function_length, parent_scope, *global_object.function_prototype(), is_strict, is_arrow_function);
+    return global_object.heap().allocate<ScriptFunction>(global_object, global_object, name, body, nullptr, move(parameters), m_function_length, parent_scope, *global_object.function_prototype(), is_strict, is_arrow_function);
 }
 
-ScriptFunction::ScriptFunction(GlobalObject& global_object, const FlyString& name, const Statement& body, Vector<FunctionNode::Parameter> parameters, i32 m_function_length, ScopeObject* parent_scope, Object& prototype, bool is_strict, bool is_arrow_function)
+ScriptFunction* ScriptFunction::create(GlobalObject& global_object, const FunctionNode& function_node, ScopeObject* parent_scope, bool is_strict, bool is_arrow_function)
+{
+    // Skipped bodies stay skipped until the function is actually called.
+    if (auto& lazy_body = function_node.lazy_body(); lazy_body && !lazy_body->is_parsed())
+        return global_object.heap().allocate<ScriptFunction>(global_object, global_object, function_node.name(), nullptr, lazy_body, function_node.parameters(), function_node.function_length(), parent_scope, *global_object.function_prototype(), is_strict, is_arrow_function);
+    return create(global_object, function_node.name(), function_node.body(), function_node.parameters(), function_node.function_length(), parent_scope, is_strict, is_arrow_function);
+}
+
+ScriptFunction::ScriptFunction(GlobalObject& global_object, const FlyString& name, RefPtr<Statement> body, RefPtr<LazyFunctionBody> lazy_body, Vector<FunctionNode::Parameter> parameters, i32 m_function_length, ScopeObject* parent_scope, Object& prototype, bool is_strict, bool is_arrow_function)
     : Function(prototype, is_arrow_function ? vm().this_value(global_object) : Value(), {})
     , m_name(name)
-    , m_body(body)
+    , m_body(move(body))
+    , m_lazy_body(move(lazy_body))
     , m_parameters(move(parameters))
     , m_parent_scope(parent_scope)
     , m_function_length(m_function_length)
@@ -61,6 +71,13 @@ ScriptFunction::~ScriptFunction()
 {
 }
 
+const Statement& ScriptFunction::body() const
+{
+    if (!m_body)
+        return m_lazy_body->parse(m_parameters);
+    return *m_body;
+}
+
 void ScriptFunction::visit_edges(Visitor& visitor)
 {
     Function::visit_edges(visitor);
@@ -69,20 +86,32 @@ void ScriptFunction::visit_edges(Visitor& visitor)
 
 LexicalEnvironment* ScriptFunction::create_environment()
 {
-    HashMap<FlyString, Variable> variables;
-    for (auto& parameter : m_parameters) {
-        variables.set(parameter.name, { js_undefined(), DeclarationKind::Var });
-    }
+    // The parser lays out the environments of the functions it parses, so the variables only have to be worked out
+    // here for functions that were put together some other way (like default class constructors).
+    RefPtr<EnvironmentLayout> environment_layout;
+    if (is<ScopeNode>(body()))
+        environment_layout = static_cast<const ScopeNode&>(body()).environment_layout();
+
+    LexicalEnvironment* environment = nullptr;
+    if (environment_layout) {
+        environment = heap().allocate<LexicalEnvironment>(global_object(), environment_layout.release_nonnull(), m_parent_scope, LexicalEnvironment::EnvironmentRecordType::Function);
+    } else {
+        HashMap<FlyString, Variable> variables;
+        for (auto& parameter : m_parameters) {
+            variables.set(parameter.name, { js_undefined(), DeclarationKind::Var });
+        }
 
-    if (is<ScopeNode>(body())) {
-        for (auto& declaration : static_cast<const ScopeNode&>(body()).variables()) {
-            for (auto& declarator : declaration.declarations()) {
-                variables.set(declarator.id().string(), { js_undefined(), declaration.declaration_kind() });
+        if (is<ScopeNode>(body())) {
+            for (auto& declaration : static_cast<const ScopeNode&>(body()).variables()) {
+                for (auto& declarator : declaration.declarations()) {
+                    variables.set(declarator.id().string(), { js_undefined(), declaration.declaration_kind() });
+                }
             }
         }
+
+        environment = heap().allocate<LexicalEnvironment>(global_object(), move(variables), m_parent_scope, LexicalEnvironment::EnvironmentRecordType::Function);
     }
 
-    auto* environment = heap().allocate<LexicalEnvironment>(global_object(), move(variables), m_parent_scope, LexicalEnvironment::EnvironmentRecordType::Function);
     environment->set_home_object(home_object());
     environment->set_current_function(*this);
     if (m_is_arrow_function) {
@@ -106,6 +135,12 @@ Value ScriptFunction::execute_function_body()
 
     VM::InterpreterExecutionScope scope(*interpreter);
 
+    // Syntax errors in bodies that were skipped over while parsing only come up once the function is called.
+    if (m_lazy_body && !m_lazy_body->syntax_error().is_null()) {
+        vm.throw_exception<SyntaxError>(global_object(), m_lazy_body->syntax_error());
+        return {};
+    }
+
     auto& call_frame_args = vm.call_frame().arguments;
     for (size_t i = 0; i < m_parameters.size(); ++i) {
         auto parameter = m_parameters[i];
@@ -127,7 +162,13 @@ Value ScriptFunction::execute_function_body()
         vm.current_scope()->put_to_scope(parameter.name, { argument_value, DeclarationKind::Var });
     }
 
-    return interpreter->execute_statement(global_object(), m_body, ScopeType::Function);
+    auto& body = this->body();
+    if (auto* bytecode_interpreter = vm.bytecode_interpreter_if_exists(); bytecode_interpreter && is<ScopeNode>(body)) {
+        if (auto* block = static_cast<const ScopeNode&>(body).bytecode_block())
+            return bytecode_interpreter->run(*block, global_object());
+    }
+
+    return interpreter->execute_statement(global_object(), body, ScopeType::Function);
 }
 
 Value ScriptFunction::call()
@@ -30,6 +30,7 @@ Shape* Shape::create_put_transition(const StringOrSymbol& property_name, Propert
         return existing_shape;
     auto* new_shape = heap().allocate_without_global_object<Shape>(*this, property_name, attributes, TransitionType::Put);
     m_forward_transitions.set(key, new_shape);
+    write_barrier(new_shape);
     return new_shape;
 }
 
@@ -40,12 +41,25 @@ Shape* Shape::create_configure_transition(const StringOrSymbol& property_name, P
         return existing_shape;
     auto* new_shape = heap().allocate_without_global_object<Shape>(*this, property_name, attributes, TransitionType::Configure);
     m_forward_transitions.set(key, new_shape);
+    write_barrier(new_shape);
     return new_shape;
 }
 
 Shape* Shape::create_prototype_transition(Object* new_prototype)
 {
-    return heap().allocate_without_global_object<Shape>(*this, new_prototype);
+    // Objects made by the same constructor all get the same prototype, so remembering the last transition is
+    // enough to have them share shapes (and inline caches hit on them), without keeping every prototype alive.
+    if (m_last_prototype_transition && m_last_prototype_transition->m_prototype == new_prototype)
+        return m_last_prototype_transition;
+    m_last_prototype_transition = heap().allocate_without_global_object<Shape>(*this, new_prototype);
+    write_barrier(m_last_prototype_transition);
+    return m_last_prototype_transition;
+}
+
+void Shape::set_prototype_without_transition(Object* new_prototype)
+{
+    m_prototype = new_prototype;
+    write_barrier(m_prototype);
 }
 
 Shape::Shape(ShapeWithoutGlobalObjectTag)
@@ -90,6 +104,7 @@ void Shape::visit_edges(Cell::Visitor& visitor)
     m_property_name.visit_edges(visitor);
     for (auto& it : m_forward_transitions)
         visitor.visit(it.value);
+    visitor.visit(m_last_prototype_transition);
 
     if (m_property_table) {
         for (auto& it : *m_property_table)
@@ -172,6 +187,7 @@ void Shape::add_property_to_unique_shape(const StringOrSymbol& property_name, Pr
     VERIFY(!m_property_table->contains(property_name));
     m_property_table->set(property_name, { m_property_table->size(), attributes });
     ++m_property_count;
+    write_barrier(property_name);
 }
 
 void Shape::reconfigure_property_in_unique_shape(const StringOrSymbol& property_name, PropertyAttributes attributes)
@@ -182,6 +198,7 @@ void Shape::reconfigure_property_in_unique_shape(const StringOrSymbol& property_
     VERIFY(it != m_property_table->end());
     it->value.attributes = attributes;
     m_property_table->set(property_name, it->value);
+    write_barrier(property_name);
 }
 
 void Shape::remove_property_from_unique_shape(const StringOrSymbol& property_name, size_t offset)
@@ -202,6 +219,7 @@ void Shape::add_property_without_transition(const StringOrSymbol& property_name,
     ensure_property_table();
     if (m_property_table->set(property_name, { m_property_count, attributes }) == AK::HashSetResult::InsertedNewEntry)
         ++m_property_count;
+    write_barrier(property_name);
 }
 
 }
@@ -74,7 +74,7 @@ public:
 
     Vector<Property> property_table_ordered() const;
 
-    void set_prototype_without_transition(Object* new_prototype) { m_prototype = new_prototype; }
+    void set_prototype_without_transition(Object* new_prototype);
 
     void remove_property_from_unique_shape(const StringOrSymbol&, size_t offset);
     void add_property_to_unique_shape(const StringOrSymbol&, PropertyAttributes attributes);
@@ -83,6 +83,14 @@ public:
 private:
     virtual const char* class_name() const override { return "Shape"; }
     virtual void visit_edges(Visitor&) override;
+    virtual bool has_write_barrier() const override { return true; }
+
+    void write_barrier(const StringOrSymbol& property_name)
+    {
+        if (property_name.is_symbol())
+            Cell::write_barrier(const_cast<Symbol*>(property_name.as_symbol()));
+    }
+    using Cell::write_barrier;
 
     void ensure_property_table() const;
 
@@ -95,6 +103,7 @@ private:
     mutable OwnPtr<HashMap<StringOrSymbol, PropertyMetadata>> m_property_table;
 
     HashMap<TransitionKey, Shape*> m_forward_transitions;
+    Shape* m_last_prototype_transition { nullptr };
     Shape* m_previous { nullptr };
     StringOrSymbol m_property_name;
     Object* m_prototype { nullptr };
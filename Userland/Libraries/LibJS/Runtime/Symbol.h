@@ -25,6 +25,7 @@ public:
 
 private:
     virtual const char* class_name() const override { return "Symbol"; }
+    virtual bool has_write_barrier() const override { return true; }
 
     String m_description;
     bool m_is_global;
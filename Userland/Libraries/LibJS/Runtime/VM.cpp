@@ -6,12 +6,15 @@
  */
 
 #include <AK/Debug.h>
+#include <AK/HashFunctions.h>
 #include <AK/ScopeGuard.h>
 #include <AK/StringBuilder.h>
+#include <LibJS/Bytecode/Interpreter.h>
 #include <LibJS/Interpreter.h>
 #include <LibJS/Runtime/Array.h>
 #include <LibJS/Runtime/Error.h>
 #include <LibJS/Runtime/GlobalObject.h>
+#include <LibJS/Runtime/LexicalEnvironment.h>
 #include <LibJS/Runtime/NativeFunction.h>
 #include <LibJS/Runtime/PromiseReaction.h>
 #include <LibJS/Runtime/Reference.h>
@@ -83,11 +86,35 @@ VM::InterpreterExecutionScope::~InterpreterExecutionScope()
     m_interpreter.vm().pop_interpreter(m_interpreter);
 }
 
+PrimitiveString& VM::number_string(Value number)
+{
+    auto value = number.as_double();
+
+    // Small non-negative integers get a slot of their own, everything else is hashed.
+    size_t index;
+    if (number.type() == Value::Type::Int32 && value >= 0 && value < number_string_cache_size)
+        index = static_cast<size_t>(value);
+    else
+        index = u64_hash(bit_cast<u64>(value)) % number_string_cache_size;
+
+    auto& entry = m_number_string_cache[index];
+    if (entry.string && entry.number == value)
+        return *entry.string;
+
+    auto* string = js_string(*this, number.to_string_without_side_effects());
+    entry = { value, string };
+    return *string;
+}
+
 void VM::gather_roots(HashTable<Cell*>& roots)
 {
     roots.set(m_empty_string);
     for (auto* string : m_single_ascii_character_strings)
         roots.set(string);
+    for (auto& entry : m_number_string_cache) {
+        if (entry.string)
+            roots.set(entry.string);
+    }
 
     roots.set(m_scope_object_shape);
     roots.set(m_exception);
@@ -106,6 +133,9 @@ void VM::gather_roots(HashTable<Cell*>& roots)
         roots.set(call_frame->scope);
     }
 
+    if (m_bytecode_interpreter)
+        m_bytecode_interpreter->gather_roots(roots);
+
 #define __JS_ENUMERATE(SymbolName, snake_name) \
     roots.set(well_known_symbol_##snake_name());
     JS_ENUMERATE_WELL_KNOWN_SYMBOLS
@@ -129,8 +159,31 @@ Symbol* VM::get_global_symbol(const String& description)
     return new_global_symbol;
 }
 
-void VM::set_variable(const FlyString& name, Value value, GlobalObject& global_object, bool first_assignment)
+LexicalEnvironment* VM::environment_at(const EnvironmentCoordinate* coordinate)
 {
+    if (!coordinate || !coordinate->layout || m_call_stack.is_empty())
+        return nullptr;
+    auto* scope = current_scope();
+    for (size_t i = 0; i < coordinate->hops && scope; ++i)
+        scope = scope->parent();
+    // Functions can end up in a different scope than the one they were declared in (block-level function
+    // declarations are hoisted), and then the parser's coordinates don't apply.
+    if (!is<LexicalEnvironment>(scope) || static_cast<LexicalEnvironment*>(scope)->layout() != coordinate->layout)
+        return nullptr;
+    return static_cast<LexicalEnvironment*>(scope);
+}
+
+void VM::set_variable(const FlyString& name, Value value, GlobalObject& global_object, bool first_assignment, const EnvironmentCoordinate* coordinate)
+{
+    if (auto* environment = environment_at(coordinate)) {
+        if (!first_assignment && environment->slot(coordinate->slot).declaration_kind == DeclarationKind::Const) {
+            throw_exception<TypeError>(global_object, ErrorType::InvalidAssignToConst);
+            return;
+        }
+        environment->set_slot_value(coordinate->slot, value);
+        return;
+    }
+
     if (m_call_stack.size()) {
         for (auto* scope = current_scope(); scope; scope = scope->parent()) {
             auto possible_match = scope->get_from_scope(name);
@@ -149,8 +202,11 @@ void VM::set_variable(const FlyString& name, Value value, GlobalObject& global_o
     global_object.put(move(name), move(value));
 }
 
-Value VM::get_variable(const FlyString& name, GlobalObject& global_object)
+Value VM::get_variable(const FlyString& name, GlobalObject& global_object, const EnvironmentCoordinate* coordinate)
 {
+    if (auto* environment = environment_at(coordinate))
+        return environment->slot(coordinate->slot).value;
+
     if (!m_call_stack.is_empty()) {
         if (name == names.arguments && !call_frame().callee.is_empty()) {
             // HACK: Special handling for the name "arguments":
@@ -185,8 +241,11 @@ Value VM::get_variable(const FlyString& name, GlobalObject& global_object)
     return value;
 }
 
-Reference VM::get_reference(const FlyString& name)
+Reference VM::get_reference(const FlyString& name, const EnvironmentCoordinate* coordinate)
 {
+    if (environment_at(coordinate))
+        return { Reference::LocalVariable, name, false, coordinate };
+
     if (m_call_stack.size()) {
         for (auto* scope = current_scope(); scope; scope = scope->parent()) {
             if (is<GlobalObject>(scope))
@@ -49,6 +49,12 @@ struct CallFrame {
     bool is_strict_mode { false };
 };
 
+// How often property lookups went through an InlineCache without having to search for the property.
+struct InlineCacheStatistics {
+    u64 hits { 0 };
+    u64 misses { 0 };
+};
+
 class VM : public RefCounted<VM> {
 public:
     static NonnullRefPtr<VM> create();
@@ -63,6 +69,9 @@ public:
     void push_interpreter(Interpreter&);
     void pop_interpreter(Interpreter&);
 
+    Bytecode::Interpreter* bytecode_interpreter_if_exists() { return m_bytecode_interpreter; }
+    void set_bytecode_interpreter(Badge<Bytecode::Interpreter>, Bytecode::Interpreter* interpreter) { m_bytecode_interpreter = interpreter; }
+
     Exception* exception() { return m_exception; }
     void set_exception(Exception& exception) { m_exception = &exception; }
     void clear_exception() { m_exception = nullptr; }
@@ -91,6 +100,7 @@ public:
         VERIFY(character < 0x80);
         return *m_single_ascii_character_strings[character];
     }
+    PrimitiveString& number_string(Value number);
 
     void push_call_frame(CallFrame& call_frame, GlobalObject& global_object)
     {
@@ -156,6 +166,8 @@ public:
 
     const StackInfo& stack_info() const { return m_stack_info; };
 
+    InlineCacheStatistics& inline_cache_statistics() { return m_inline_cache_statistics; }
+
     bool underscore_is_last_value() const { return m_underscore_is_last_value; }
     void set_underscore_is_last_value(bool b) { m_underscore_is_last_value = b; }
 
@@ -179,10 +191,12 @@ public:
 
     ScopeType unwind_until() const { return m_unwind_until; }
 
-    Value get_variable(const FlyString& name, GlobalObject&);
-    void set_variable(const FlyString& name, Value, GlobalObject&, bool first_assignment = false);
+    // If the parser resolved the variable to an environment coordinate, that's where we look first. We still need
+    // the name for when the scope chain doesn't look like the parser expected, e.g. inside a with statement.
+    Value get_variable(const FlyString& name, GlobalObject&, const EnvironmentCoordinate* = nullptr);
+    void set_variable(const FlyString& name, Value, GlobalObject&, bool first_assignment = false, const EnvironmentCoordinate* = nullptr);
 
-    Reference get_reference(const FlyString& name);
+    Reference get_reference(const FlyString& name, const EnvironmentCoordinate* = nullptr);
 
     template<typename T, typename... Args>
     void throw_exception(GlobalObject& global_object, Args&&... args)
@@ -238,12 +252,15 @@ public:
 private:
     VM();
 
+    LexicalEnvironment* environment_at(const EnvironmentCoordinate*);
+
     [[nodiscard]] Value call_internal(Function&, Value this_value, Optional<MarkedValueList> arguments);
 
     Exception* m_exception { nullptr };
 
     Heap m_heap;
     Vector<Interpreter*> m_interpreters;
+    Bytecode::Interpreter* m_bytecode_interpreter { nullptr };
 
     Vector<CallFrame*> m_call_stack;
 
@@ -253,6 +270,8 @@ private:
 
     StackInfo m_stack_info;
 
+    InlineCacheStatistics m_inline_cache_statistics;
+
     HashMap<String, Symbol*> m_global_symbol_map;
 
     Vector<NativeFunction*> m_promise_jobs;
@@ -260,6 +279,14 @@ private:
     PrimitiveString* m_empty_string { nullptr };
     PrimitiveString* m_single_ascii_character_strings[128] {};
 
+    // The strings most recently made from numbers, since the same ones (mostly small integers) keep getting converted.
+    struct NumberStringCacheEntry {
+        double number { 0 };
+        PrimitiveString* string { nullptr };
+    };
+    static constexpr size_t number_string_cache_size = 256;
+    NumberStringCacheEntry m_number_string_cache[number_string_cache_size];
+
 #define __JS_ENUMERATE(SymbolName, snake_name) \
     Symbol* m_well_known_symbol_##snake_name { nullptr };
     JS_ENUMERATE_WELL_KNOWN_SYMBOLS
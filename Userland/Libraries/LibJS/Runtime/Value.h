@@ -30,9 +30,10 @@ public:
         Null,
         Int32,
         Double,
+        Boolean,
+        // Everything from here on is a cell.
         String,
         Object,
-        Boolean,
         Symbol,
         Accessor,
         BigInt,
@@ -45,19 +46,19 @@ public:
         Number,
     };
 
-    bool is_empty() const { return m_type == Type::Empty; }
-    bool is_undefined() const { return m_type == Type::Undefined; }
-    bool is_null() const { return m_type == Type::Null; }
-    bool is_number() const { return m_type == Type::Int32 || m_type == Type::Double; }
-    bool is_string() const { return m_type == Type::String; }
-    bool is_object() const { return m_type == Type::Object; }
-    bool is_boolean() const { return m_type == Type::Boolean; }
-    bool is_symbol() const { return m_type == Type::Symbol; }
-    bool is_accessor() const { return m_type == Type::Accessor; };
-    bool is_bigint() const { return m_type == Type::BigInt; };
-    bool is_native_property() const { return m_type == Type::NativeProperty; }
+    bool is_empty() const { return tag() == tag_for(Type::Empty); }
+    bool is_undefined() const { return tag() == tag_for(Type::Undefined); }
+    bool is_null() const { return tag() == tag_for(Type::Null); }
+    bool is_number() const { return tag() <= max_double_tag || tag() == tag_for(Type::Int32); }
+    bool is_string() const { return tag() == tag_for(Type::String); }
+    bool is_object() const { return tag() == tag_for(Type::Object); }
+    bool is_boolean() const { return tag() == tag_for(Type::Boolean); }
+    bool is_symbol() const { return tag() == tag_for(Type::Symbol); }
+    bool is_accessor() const { return tag() == tag_for(Type::Accessor); };
+    bool is_bigint() const { return tag() == tag_for(Type::BigInt); };
+    bool is_native_property() const { return tag() == tag_for(Type::NativeProperty); }
     bool is_nullish() const { return is_null() || is_undefined(); }
-    bool is_cell() const { return is_string() || is_accessor() || is_object() || is_bigint() || is_symbol() || is_native_property(); }
+    bool is_cell() const { return tag() >= tag_for(Type::String); }
     bool is_array() const;
     bool is_function() const;
     bool is_constructor() const;
@@ -79,171 +80,168 @@ public:
     }
 
     Value()
-        : m_type(Type::Empty)
+        : Value(Type::Empty)
     {
     }
 
     explicit Value(bool value)
-        : m_type(Type::Boolean)
+        : m_value(encode(Type::Boolean, value))
     {
-        m_value.as_bool = value;
     }
 
     explicit Value(double value)
     {
         bool is_negative_zero = bit_cast<u64>(value) == NEGATIVE_ZERO_BITS;
-        if (value >= NumericLimits<i32>::min() && value <= NumericLimits<i32>::max() && trunc(value) == value && !is_negative_zero) {
-            m_type = Type::Int32;
-            m_value.as_i32 = static_cast<i32>(value);
-        } else {
-            m_type = Type::Double;
-            m_value.as_double = value;
-        }
+        if (value >= NumericLimits<i32>::min() && value <= NumericLimits<i32>::max() && trunc(value) == value && !is_negative_zero)
+            m_value = encode(Type::Int32, static_cast<u32>(static_cast<i32>(value)));
+        else if (__builtin_isnan(value))
+            m_value = canonical_nan_bits;
+        else
+            m_value = bit_cast<u64>(value);
     }
 
     explicit Value(unsigned long value)
     {
-        if (value > NumericLimits<i32>::max()) {
-            m_value.as_double = static_cast<double>(value);
-            m_type = Type::Double;
-        } else {
-            m_value.as_i32 = static_cast<i32>(value);
-            m_type = Type::Int32;
-        }
+        if (value > NumericLimits<i32>::max())
+            m_value = bit_cast<u64>(static_cast<double>(value));
+        else
+            m_value = encode(Type::Int32, static_cast<u32>(value));
     }
 
     explicit Value(unsigned value)
     {
-        if (value > NumericLimits<i32>::max()) {
-            m_value.as_double = static_cast<double>(value);
-            m_type = Type::Double;
-        } else {
-            m_value.as_i32 = static_cast<i32>(value);
-            m_type = Type::Int32;
-        }
+        if (value > NumericLimits<i32>::max())
+            m_value = bit_cast<u64>(static_cast<double>(value));
+        else
+            m_value = encode(Type::Int32, value);
     }
 
     explicit Value(i32 value)
-        : m_type(Type::Int32)
+        : m_value(encode(Type::Int32, static_cast<u32>(value)))
     {
-        m_value.as_i32 = value;
     }
 
     Value(const Object* object)
-        : m_type(object ? Type::Object : Type::Null)
+        : m_value(object ? encode_pointer(Type::Object, object) : encode(Type::Null, 0u))
     {
-        m_value.as_object = const_cast<Object*>(object);
     }
 
     Value(const PrimitiveString* string)
-        : m_type(Type::String)
+        : m_value(encode_pointer(Type::String, string))
     {
-        m_value.as_string = const_cast<PrimitiveString*>(string);
     }
 
     Value(const Symbol* symbol)
-        : m_type(Type::Symbol)
+        : m_value(encode_pointer(Type::Symbol, symbol))
     {
-        m_value.as_symbol = const_cast<Symbol*>(symbol);
     }
 
     Value(const Accessor* accessor)
-        : m_type(Type::Accessor)
+        : m_value(encode_pointer(Type::Accessor, accessor))
     {
-        m_value.as_accessor = const_cast<Accessor*>(accessor);
     }
 
     Value(const BigInt* bigint)
-        : m_type(Type::BigInt)
+        : m_value(encode_pointer(Type::BigInt, bigint))
     {
-        m_value.as_bigint = const_cast<BigInt*>(bigint);
     }
 
     Value(const NativeProperty* native_property)
-        : m_type(Type::NativeProperty)
+        : m_value(encode_pointer(Type::NativeProperty, native_property))
     {
-        m_value.as_native_property = const_cast<NativeProperty*>(native_property);
     }
 
     explicit Value(Type type)
-        : m_type(type)
+        : m_value(encode(type, 0u))
     {
+        VERIFY(type != Type::Double);
     }
 
-    Type type() const { return m_type; }
+    Type type() const
+    {
+        if (tag() <= max_double_tag)
+            return Type::Double;
+        return static_cast<Type>(tag() - tag_for(Type::Empty));
+    }
 
     double as_double() const
     {
         VERIFY(is_number());
-        if (m_type == Type::Int32)
-            return m_value.as_i32;
-        return m_value.as_double;
+        if (tag() == tag_for(Type::Int32))
+            return int32_payload();
+        return bit_cast<double>(m_value);
     }
 
     bool as_bool() const
     {
         VERIFY(type() == Type::Boolean);
-        return m_value.as_bool;
+        return m_value & 1;
     }
 
     Object& as_object()
     {
         VERIFY(type() == Type::Object);
-        return *m_value.as_object;
+        return *cell_payload<Object>();
     }
 
     const Object& as_object() const
     {
         VERIFY(type() == Type::Object);
-        return *m_value.as_object;
+        return *cell_payload<Object>();
     }
 
     PrimitiveString& as_string()
     {
         VERIFY(is_string());
-        return *m_value.as_string;
+        return *cell_payload<PrimitiveString>();
     }
 
     const PrimitiveString& as_string() const
     {
         VERIFY(is_string());
-        return *m_value.as_string;
+        return *cell_payload<PrimitiveString>();
     }
 
     Symbol& as_symbol()
     {
         VERIFY(is_symbol());
-        return *m_value.as_symbol;
+        return *cell_payload<Symbol>();
     }
 
     const Symbol& as_symbol() const
     {
         VERIFY(is_symbol());
-        return *m_value.as_symbol;
+        return *cell_payload<Symbol>();
     }
 
     Cell* as_cell()
     {
         VERIFY(is_cell());
-        return m_value.as_cell;
+        return cell_payload<Cell>();
     }
 
     Accessor& as_accessor()
     {
         VERIFY(is_accessor());
-        return *m_value.as_accessor;
+        return *cell_payload<Accessor>();
     }
 
     BigInt& as_bigint()
     {
         VERIFY(is_bigint());
-        return *m_value.as_bigint;
+        return *cell_payload<BigInt>();
+    }
+
+    const BigInt& as_bigint() const
+    {
+        VERIFY(is_bigint());
+        return *cell_payload<BigInt>();
     }
 
     NativeProperty& as_native_property()
     {
         VERIFY(is_native_property());
-        return *m_value.as_native_property;
+        return *cell_payload<NativeProperty>();
     }
 
     Array& as_array();
@@ -262,8 +260,8 @@ public:
     double to_double(GlobalObject&) const;
     i32 to_i32(GlobalObject& global_object) const
     {
-        if (m_type == Type::Int32)
-            return m_value.as_i32;
+        if (tag() == tag_for(Type::Int32))
+            return int32_payload();
         return to_i32_slow_case(global_object);
     }
     u32 to_u32(GlobalObject&) const;
@@ -283,25 +281,46 @@ public:
 
     String typeof() const;
 
+    // For the conservative stack scan: if the word could be a Value holding a cell, the pointer to that cell.
+    static FlatPtr possible_cell_pointer(FlatPtr word)
+    {
+        if ((static_cast<u64>(word) >> tag_shift) < tag_for(Type::String))
+            return word;
+        return static_cast<FlatPtr>(word & payload_mask);
+    }
+
 private:
-    Type m_type { Type::Empty };
+    // Values are NaN-boxed: doubles are kept as they are, except that every NaN is turned into the same one.
+    // That leaves all the other NaNs (the ones above negative infinity, whose top 16 bits are 0xfff1 or more)
+    // for everything else, with the type in the top 16 bits and the payload (an i32, a bool, or a pointer to
+    // a cell) in the lower 48. Pointers fit, since user space only ever uses the lower 47 bits of the address space.
+    static constexpr u64 tag_shift = 48;
+    static constexpr u64 payload_mask = (1ull << tag_shift) - 1;
+    static constexpr u64 max_double_tag = 0xfff0;
+    static constexpr u64 canonical_nan_bits = 0x7ff8000000000000ull;
+
+    static constexpr u64 tag_for(Type type) { return max_double_tag + 1 + static_cast<u64>(type); }
+
+    static constexpr u64 encode(Type type, u64 payload) { return (tag_for(type) << tag_shift) | payload; }
+    static u64 encode_pointer(Type type, const void* cell)
+    {
+        auto pointer = reinterpret_cast<FlatPtr>(cell);
+        VERIFY(!(static_cast<u64>(pointer) & ~payload_mask));
+        return encode(type, static_cast<u64>(pointer));
+    }
+
+    u64 tag() const { return m_value >> tag_shift; }
+    i32 int32_payload() const { return static_cast<i32>(static_cast<u32>(m_value)); }
+    template<typename T>
+    T* cell_payload() const { return reinterpret_cast<T*>(static_cast<FlatPtr>(m_value & payload_mask)); }
 
     i32 to_i32_slow_case(GlobalObject&) const;
 
-    union {
-        bool as_bool;
-        i32 as_i32;
-        double as_double;
-        PrimitiveString* as_string;
-        Symbol* as_symbol;
-        Object* as_object;
-        Cell* as_cell;
-        Accessor* as_accessor;
-        BigInt* as_bigint;
-        NativeProperty* as_native_property;
-    } m_value;
+    u64 m_value { encode(Type::Empty, 0u) };
 };
 
+static_assert(sizeof(Value) == sizeof(u64));
+
 inline Value js_undefined()
 {
     return Value(Value::Type::Undefined);
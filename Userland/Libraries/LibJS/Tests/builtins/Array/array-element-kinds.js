@@ -0,0 +1,101 @@
+test("searching arrays of every element kind", () => {
+    const ints = [1, 2, 3, 2];
+    const doubles = [1.5, 2, NaN, -0];
+    const mixed = [1, "2", null, undefined, ints];
+    const holey = [1, , 3];
+
+    expect(ints.indexOf(2)).toBe(1);
+    expect(ints.lastIndexOf(2)).toBe(3);
+    expect(ints.indexOf("2")).toBe(-1);
+    expect(ints.includes(3)).toBeTrue();
+    expect(ints.includes("3")).toBeFalse();
+    expect(ints.includes(NaN)).toBeFalse();
+
+    expect(doubles.indexOf(1.5)).toBe(0);
+    expect(doubles.indexOf(NaN)).toBe(-1);
+    expect(doubles.includes(NaN)).toBeTrue();
+    expect(doubles.indexOf(0)).toBe(3);
+    expect(doubles.includes(+0)).toBeTrue();
+
+    expect(mixed.indexOf("2")).toBe(1);
+    expect(mixed.indexOf(2)).toBe(-1);
+    expect(mixed.indexOf(undefined)).toBe(3);
+    expect(mixed.indexOf(ints)).toBe(4);
+
+    expect(holey.indexOf(undefined)).toBe(-1);
+    expect(holey.includes(undefined)).toBeTrue();
+});
+
+test("holes are looked up on the prototype", () => {
+    const array = [1, 2, 3];
+    array.length = 5;
+    Array.prototype[4] = "from prototype";
+    try {
+        expect(array.indexOf("from prototype")).toBe(4);
+        expect(array.includes("from prototype")).toBeTrue();
+        expect(array.join()).toBe("1,2,3,,from prototype");
+        expect(array.slice(3)).toEqual([undefined, "from prototype"]);
+    } finally {
+        delete Array.prototype[4];
+    }
+});
+
+test("arrays that change while being iterated", () => {
+    const array = [1, 2, 3, 4];
+    const seen = [];
+    array.forEach((value, index) => {
+        seen.push(value);
+        if (index === 0) array.pop();
+        if (index === 1) delete array[2];
+    });
+    expect(seen).toEqual([1, 2]);
+
+    const growing = [1, 2];
+    const mapped = growing.map(value => {
+        growing.push(value * 10);
+        return value + 0.5;
+    });
+    expect(mapped).toEqual([1.5, 2.5]);
+    expect(growing).toEqual([1, 2, 10, 20]);
+
+    const changing = [1, 2, 3];
+    expect(
+        changing.join({
+            toString() {
+                changing[2] = "changed";
+                return "-";
+            },
+        })
+    ).toBe("1-2-changed");
+});
+
+test("sorting arrays of every element kind", () => {
+    expect([10, 9, 1, -5, 100, 2, -10].sort()).toEqual([-10, -5, 1, 10, 100, 2, 9]);
+    expect([3, 1, 2].sort((a, b) => b - a)).toEqual([3, 2, 1]);
+    expect([0.5, 10, -0.25, 2].sort()).toEqual([-0.25, 0.5, 10, 2]);
+    expect(["b", "a", 1, undefined, "c"].sort()).toEqual([1, "a", "b", "c", undefined]);
+    const holey = [3, , 1];
+    holey.sort();
+    expect(holey.length).toBe(3);
+    expect(holey[0]).toBe(1);
+    expect(holey[1]).toBe(3);
+    expect(1 in holey).toBeTrue();
+    expect(2 in holey).toBeFalse();
+});
+
+test("reversing and slicing", () => {
+    expect([1, 2, 3].reverse()).toEqual([3, 2, 1]);
+    expect([1.5, "a", null].reverse()).toEqual([null, "a", 1.5]);
+    expect([1, 2, 3, 4].slice(1, 3)).toEqual([2, 3]);
+    expect([1, 2, 3].slice(-2)).toEqual([2, 3]);
+    expect([1, 2, 3].slice(-10)).toEqual([1, 2, 3]);
+    expect([1, 2, 3].slice(-10, 1)).toEqual([1]);
+});
+
+test("arrays that are emptied can be packed again", () => {
+    const array = [1, , 3];
+    array.length = 0;
+    array.push(1, 2, 3);
+    expect(array.indexOf(3)).toBe(2);
+    expect(array.includes(2)).toBeTrue();
+});
@@ -0,0 +1,140 @@
+// These pass either way, but are meant for running with --lazy-parse, where function bodies are skipped over at first.
+
+test("functions see the variables around them", () => {
+    let before = 1;
+    function outer(parameter) {
+        var local = 2;
+        function inner() {
+            return before + parameter + local + after;
+        }
+        return inner();
+    }
+    let after = 4;
+    expect(outer(3)).toBe(10);
+});
+
+test("closures keep their own variables", () => {
+    function makeCounter() {
+        let count = 0;
+        return function () {
+            return ++count;
+        };
+    }
+    const a = makeCounter();
+    const b = makeCounter();
+    expect(a()).toBe(1);
+    expect(a()).toBe(2);
+    expect(b()).toBe(1);
+});
+
+test("shadowing", () => {
+    let x = 1;
+    function f() {
+        let x = 2;
+        function g() {
+            return x;
+        }
+        return g();
+    }
+    function h(x) {
+        return function () {
+            return x;
+        };
+    }
+    expect(f()).toBe(2);
+    expect(h(3)()).toBe(3);
+    expect(x).toBe(1);
+});
+
+test("variables bound by eval and with", () => {
+    let x = "outer";
+    function withEval() {
+        eval("var x = 'eval'");
+        return (function () {
+            return x;
+        })();
+    }
+    function withWith() {
+        with ({ x: "with" }) {
+            return (function () {
+                return x;
+            })();
+        }
+    }
+    expect(withEval()).toBe("eval");
+    expect(withWith()).toBe("with");
+});
+
+test("brackets in strings, templates and regular expressions", () => {
+    function f() {
+        const s = "}";
+        const t = `{${`${"}"}`}`;
+        const r = /[}]{1}/;
+        return [s, t, r.test("}")];
+    }
+    expect(f()).toEqual(["}", "{}", true]);
+});
+
+test("use strict directive", () => {
+    function strict() {
+        "use strict";
+        return isStrictMode();
+    }
+    // prettier-ignore
+    function strictWithoutSemicolon() {
+        "use strict"
+        return isStrictMode();
+    }
+    function sloppy() {
+        "use strict" + "";
+        return isStrictMode();
+    }
+    expect(strict()).toBeTrue();
+    expect(strictWithoutSemicolon()).toBeTrue();
+    expect(sloppy()).toBeFalse();
+});
+
+test("methods and classes", () => {
+    class A {
+        constructor(value) {
+            this.value = value;
+        }
+        double() {
+            return this.value * 2;
+        }
+    }
+    class B extends A {
+        constructor() {
+            super(21);
+        }
+        double() {
+            return super.double();
+        }
+    }
+    const o = {
+        method() {
+            return new.target;
+        },
+    };
+    expect(new B().double()).toBe(42);
+    expect(o.method()).toBeUndefined();
+});
+
+test("function length and name don't need the body", () => {
+    function f(a, b, c) {
+        return a + b + c;
+    }
+    expect(f.length).toBe(3);
+    expect(f.name).toBe("f");
+    expect(f(1, 2, 3)).toBe(6);
+});
+
+test("functions in default parameter values", () => {
+    let a = "outer";
+    function f(a = "parameter", g = function () {
+        return a;
+    }) {
+        return g();
+    }
+    expect(f()).toBe("parameter");
+});
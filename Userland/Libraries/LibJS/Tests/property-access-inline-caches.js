@@ -0,0 +1,103 @@
+// Each of these runs the same property access site over objects that differ in a way the site's inline cache
+// has to notice.
+
+function getX(object) {
+    return object.x;
+}
+
+test("objects with different shapes", () => {
+    const objects = [{ x: 1 }, { y: 0, x: 2 }, { z: 0, y: 0, x: 3 }, { w: 0, z: 0, y: 0, x: 4 }, { v: 0, x: 5 }];
+    for (let i = 0; i < 3; ++i) {
+        objects.forEach((object, index) => {
+            expect(getX(object)).toBe(index + 1);
+        });
+    }
+    expect(getX({})).toBeUndefined();
+});
+
+test("properties that are changed, deleted and added back", () => {
+    const object = { x: 1, y: 2 };
+    expect(getX(object)).toBe(1);
+    object.x = 10;
+    expect(getX(object)).toBe(10);
+    delete object.x;
+    expect(getX(object)).toBeUndefined();
+    object.x = 20;
+    expect(getX(object)).toBe(20);
+});
+
+test("properties that are found on the prototype", () => {
+    const prototype = { x: 1 };
+    const object = Object.create(prototype);
+    expect(getX(object)).toBe(1);
+    prototype.x = 2;
+    expect(getX(object)).toBe(2);
+    delete prototype.x;
+    expect(getX(object)).toBeUndefined();
+    prototype.x = 3;
+    expect(getX(object)).toBe(3);
+    object.x = 4;
+    expect(getX(object)).toBe(4);
+    Object.setPrototypeOf(object, { x: 5 });
+    expect(getX(object)).toBe(4);
+    delete object.x;
+    expect(getX(object)).toBe(5);
+});
+
+test("instances of a class", () => {
+    class A {
+        constructor(x) {
+            this.x = x;
+        }
+        method() {
+            return this.x;
+        }
+    }
+    const instances = [];
+    for (let i = 0; i < 10; ++i) instances.push(new A(i));
+    instances.forEach((instance, index) => {
+        expect(instance.method()).toBe(index);
+        expect(getX(instance)).toBe(index);
+    });
+    A.prototype.method = function () {
+        return -this.x;
+    };
+    instances.forEach((instance, index) => {
+        expect(instance.method()).toBe(-index);
+    });
+});
+
+test("getters and setters", () => {
+    let calls = 0;
+    const object = {
+        get x() {
+            return ++calls;
+        },
+    };
+    expect(getX(object)).toBe(1);
+    expect(getX(object)).toBe(2);
+    Object.defineProperty(object, "x", { value: 42 });
+    expect(getX(object)).toBe(42);
+    expect(calls).toBe(2);
+});
+
+test("proxies", () => {
+    const target = { x: 1 };
+    const proxy = new Proxy(target, {
+        get(target, property) {
+            return property === "x" ? target.x * 100 : undefined;
+        },
+    });
+    expect(getX(target)).toBe(1);
+    expect(getX(proxy)).toBe(100);
+    expect(getX(target)).toBe(1);
+});
+
+test("primitives", () => {
+    expect(getX(1)).toBeUndefined();
+    Number.prototype.x = "number";
+    expect(getX(1)).toBe("number");
+    delete Number.prototype.x;
+    expect(getX(1)).toBeUndefined();
+    expect(() => getX(null)).toThrowWithMessage(TypeError, "Cannot get property 'x' of null");
+});
@@ -0,0 +1,46 @@
+test("building a long string a piece at a time", () => {
+    let s = "";
+    for (let i = 0; i < 10000; ++i) s += "abcdefghij";
+    expect(s.length).toBe(100000);
+    expect(s.substring(0, 12)).toBe("abcdefghijab");
+    expect(s.substring(99995)).toBe("fghij");
+    expect(s.indexOf("j")).toBe(9);
+});
+
+test("concatenation order is kept", () => {
+    let left = "";
+    let right = "";
+    for (let i = 0; i < 1000; ++i) {
+        left = left + String.fromCharCode(65 + (i % 26));
+        right = String.fromCharCode(65 + (i % 26)) + right;
+    }
+    expect(left.length).toBe(1000);
+    expect(left.substring(0, 28)).toBe("ABCDEFGHIJKLMNOPQRSTUVWXYZAB");
+    expect(right.substring(972)).toBe("BAZYXWVUTSRQPONMLKJIHGFEDCBA");
+    expect(left.split("").reverse().join("")).toBe(right);
+});
+
+test("strings made of strings that are still being built", () => {
+    const long = "x".repeat(100);
+    const a = long + "a";
+    const b = long + "b";
+    const ab = a + b;
+    const aab = a + ab;
+    expect(aab).toBe(long + "a" + long + "a" + long + "b");
+    expect(ab).toBe(long + "a" + long + "b");
+    expect(a).toBe(long + "a");
+    expect(ab === a + b).toBeTrue();
+    const object = {};
+    object[ab] = 1;
+    expect(object[long + "a" + long + "b"]).toBe(1);
+});
+
+test("numbers and other values", () => {
+    let s = "";
+    for (let i = 0; i < 300; ++i) s += i;
+    expect(s.substring(0, 12)).toBe("012345678910");
+    expect(s.endsWith("298299")).toBeTrue();
+    expect("" + 1.5 + -0 + NaN + Infinity + true + null + undefined + 12345678901234).toBe("1.50NaNInfinitytruenullundefined12345678901234");
+    expect(`${"y".repeat(70)}${1}${"z".repeat(70)}`).toBe("y".repeat(70) + "1" + "z".repeat(70));
+    expect(String(42) + 42).toBe("4242");
+});
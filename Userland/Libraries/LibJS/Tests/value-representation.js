@@ -0,0 +1,41 @@
+test("NaNs from any source stay numbers", () => {
+    const nans = [0 / 0, -(0 / 0), Infinity - Infinity, Math.sqrt(-1), -Math.sqrt(-1), Infinity * 0, parseFloat("x"), +"x", NaN];
+    nans.forEach(nan => {
+        expect(typeof nan).toBe("number");
+        expect(Number.isNaN(nan)).toBeTrue();
+        expect(nan === nan).toBeFalse();
+        expect(nan + 1).toBeNaN();
+    });
+    const array = new Float64Array(nans.length);
+    nans.forEach((nan, i) => (array[i] = nan));
+    for (let i = 0; i < array.length; ++i) expect(array[i]).toBeNaN();
+});
+
+test("numbers at the edges of the int32 range", () => {
+    expect(2147483647 + 1).toBe(2147483648);
+    expect(-2147483648 - 1).toBe(-2147483649);
+    expect(2147483647 | 0).toBe(2147483647);
+    expect(-2147483648 | 0).toBe(-2147483648);
+    expect(2147483648 | 0).toBe(-2147483648);
+    expect(-1 >>> 0).toBe(4294967295);
+    expect(Object.is(-0, 0)).toBeFalse();
+    expect(Object.is(0 * -1, -0)).toBeTrue();
+    expect(1 / -0).toBe(-Infinity);
+    expect(1.7976931348623157e308 * 2).toBe(Infinity);
+    expect(-1.7976931348623157e308 * 2).toBe(-Infinity);
+    expect(5e-324 / 2).toBe(0);
+});
+
+test("values of every type keep their identity", () => {
+    const object = {};
+    const symbol = Symbol("s");
+    const values = [undefined, null, true, false, 0, -1, 1.5, "", "string", object, symbol, 1n, -(2n ** 64n), () => {}];
+    const array = values.slice();
+    for (let i = 0; i < values.length; ++i) {
+        expect(array[i]).toBe(values[i]);
+        expect(typeof array[i]).toBe(typeof values[i]);
+    }
+    expect(array[9]).toBe(object);
+    expect(array[10]).toBe(symbol);
+    expect(array[12] === -(2n ** 64n)).toBeTrue();
+});
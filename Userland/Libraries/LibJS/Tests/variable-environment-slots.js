@@ -0,0 +1,121 @@
+test("closures see variables from the right scope", () => {
+    const makeCounter = () => {
+        let count = 0;
+        return () => ++count;
+    };
+    const a = makeCounter();
+    const b = makeCounter();
+    expect(a()).toBe(1);
+    expect(a()).toBe(2);
+    expect(b()).toBe(1);
+});
+
+test("shadowing", () => {
+    let x = 1;
+    {
+        let x = 2;
+        {
+            let y = x;
+            expect(y).toBe(2);
+        }
+        expect(x).toBe(2);
+    }
+    function inner(x) {
+        return x;
+    }
+    expect(inner(3)).toBe(3);
+    expect(x).toBe(1);
+});
+
+test("let in for loop heads", () => {
+    let sum = 0;
+    for (let i = 0, j = 10; i < 5; ++i) {
+        let k = i;
+        sum += k + j;
+    }
+    expect(sum).toBe(60);
+    expect(typeof i).toBe("undefined");
+});
+
+test("catch parameters", () => {
+    let e = "outer";
+    try {
+        throw "inner";
+    } catch (e) {
+        expect(e).toBe("inner");
+        e = "changed";
+        expect(e).toBe("changed");
+    }
+    expect(e).toBe("outer");
+});
+
+test("with statements", () => {
+    let value = "variable";
+    const object = { value: "property" };
+    with (object) {
+        expect(value).toBe("property");
+        value = "assigned";
+    }
+    expect(value).toBe("variable");
+    expect(object.value).toBe("assigned");
+});
+
+test("classes declared by eval", () => {
+    function declareClass() {
+        eval("class Declared { static greet() { return 'declared'; } }");
+        return Declared.greet();
+    }
+    expect(declareClass()).toBe("declared");
+});
+
+test("classes declared in blocks", () => {
+    {
+        class Foo {}
+        expect(typeof Foo).toBe("function");
+        const f = () => Foo;
+        expect(f()).toBe(Foo);
+    }
+});
+
+test("assignment to const", () => {
+    const c = 1;
+    expect(() => {
+        c = 2;
+    }).toThrowWithMessage(TypeError, "Invalid assignment to const variable");
+    expect(c).toBe(1);
+});
+
+test("typeof on variables", () => {
+    let declared = 1;
+    expect(typeof declared).toBe("number");
+    expect(typeof notDeclaredAnywhere).toBe("undefined");
+});
+
+test("default parameters see earlier parameters", () => {
+    function f(a, b = a + 1) {
+        return b;
+    }
+    expect(f(1)).toBe(2);
+    expect(f(1, 5)).toBe(5);
+});
+
+test("functions declared in blocks", () => {
+    let result;
+    {
+        let local = "local";
+        function fromBlock() {
+            return local;
+        }
+        result = fromBlock();
+    }
+    expect(result).toBe("local");
+});
+
+test("arrow functions that turn out to be parenthesized expressions", () => {
+    let a = 1;
+    let b = 2;
+    const c = (a, b);
+    expect(c).toBe(2);
+    const d = (a) + (b);
+    expect(d).toBe(3);
+});
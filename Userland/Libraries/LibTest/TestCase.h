@@ -40,6 +40,20 @@ private:
 // Helper to hide implementation of TestSuite from users
 void add_test_case_to_suite(const NonnullRefPtr<TestCase>& test_case);
 
+// A benchmark can call these to say how much work one run of it does, to get throughput reported along with timings.
+void set_benchmark_bytes_processed(u64);
+void set_benchmark_items_processed(u64);
+
+// Keeps the compiler from optimizing away a value that's computed but never used, which benchmarks are full of.
+template<typename T>
+ALWAYS_INLINE void do_not_optimize(const T& value)
+{
+    asm volatile(""
+                 :
+                 : "r,m"(value)
+                 : "memory");
+}
+
 }
 
 #define __TESTCASE_FUNC(x) __test_##x
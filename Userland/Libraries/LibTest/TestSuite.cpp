@@ -7,10 +7,17 @@
 
 #include <LibTest/Macros.h> // intentionally first -- we redefine VERIFY and friends in here
 
+#include <AK/JsonArray.h>
+#include <AK/JsonObject.h>
+#include <AK/JsonValue.h>
+#include <AK/QuickSort.h>
 #include <LibCore/ArgsParser.h>
+#include <LibCore/File.h>
 #include <LibTest/TestSuite.h>
+#include <math.h>
 #include <stdlib.h>
 #include <sys/time.h>
+#include <time.h>
 
 namespace Test {
 
@@ -37,6 +44,22 @@ private:
     struct timeval m_started = {};
 };
 
+static u64 monotonic_nanoseconds()
+{
+    struct timespec now = {};
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<u64>(now.tv_sec) * 1'000'000'000 + now.tv_nsec;
+}
+
+static Optional<u64> cycle_counter()
+{
+#if ARCH(I386) || ARCH(X86_64)
+    return __builtin_ia32_rdtsc();
+#else
+    return {};
+#endif
+}
+
 // Declared in Macros.h
 void current_test_case_did_fail()
 {
@@ -49,6 +72,18 @@ void add_test_case_to_suite(const NonnullRefPtr<TestCase>& test_case)
     TestSuite::the().add_case(test_case);
 }
 
+// Declared in TestCase.h
+void set_benchmark_bytes_processed(u64 bytes)
+{
+    TestSuite::the().set_benchmark_bytes_processed(bytes);
+}
+
+// Declared in TestCase.h
+void set_benchmark_items_processed(u64 items)
+{
+    TestSuite::the().set_benchmark_items_processed(items);
+}
+
 int TestSuite::main(const String& suite_name, int argc, char** argv)
 {
     m_suite_name = suite_name;
@@ -61,11 +96,20 @@ int TestSuite::main(const String& suite_name, int argc, char** argv)
     const char* search_string = "*";
 
     args_parser.add_option(do_tests_only, "Only run tests.", "tests", 0);
-    args_parser.add_option(do_benchmarks_only, "Only run benchmarks.", "bench", 0);
+    args_parser.add_option(do_benchmarks_only, "Only run benchmarks, measuring each one over many runs.", "bench", 0);
+    args_parser.add_option(m_benchmark_time_budget_ms, "Roughly how long to spend measuring each benchmark (default: 1000).", "bench-time", 0, "milliseconds");
+    args_parser.add_option(m_count_cycles, "Count CPU cycles as well (x86 only).", "cycles", 0);
+    args_parser.add_option(m_json_output_path, "Write benchmark results to a JSON file.", "json", 0, "path");
+    args_parser.add_option(m_baseline_path, "Compare benchmark results against a JSON file written by --json earlier.", "compare", 0, "path");
+    args_parser.add_option(m_regression_threshold_percent, "How much slower than the baseline counts as a regression (default: 5).", "threshold", 0, "percent");
     args_parser.add_option(do_list_cases, "List available test cases.", "list", 0);
     args_parser.add_positional_argument(search_string, "Only run matching cases.", "pattern", Core::ArgsParser::Required::No);
     args_parser.parse(argc, argv);
 
+    m_measure_benchmarks = do_benchmarks_only || !m_json_output_path.is_empty() || !m_baseline_path.is_empty();
+    if (m_measure_benchmarks)
+        do_tests_only = false;
+
     const auto& matching_tests = find_cases(search_string, !do_benchmarks_only, !do_tests_only);
 
     if (do_list_cases) {
@@ -115,7 +159,15 @@ int TestSuite::run(const NonnullRefPtrVector<TestCase>& tests)
         m_current_test_case_passed = true;
 
         TestElapsedTimer timer;
-        t.func()();
+        if (t.is_benchmark() && m_measure_benchmarks) {
+            auto result = measure_benchmark(t);
+            if (m_current_test_case_passed) {
+                report_benchmark(result);
+                m_benchmark_results.append(move(result));
+            }
+        } else {
+            t.func()();
+        }
         const auto time = timer.elapsed_milliseconds();
 
         dbgln("{} {} '{}' in {}ms", m_current_test_case_passed ? "Completed" : "Failed", test_type, t.name(), time);
@@ -142,7 +194,192 @@ int TestSuite::run(const NonnullRefPtrVector<TestCase>& tests)
         global_timer.elapsed_milliseconds() - (m_testtime + m_benchtime));
     dbgln("Out of {} tests, {} passed and {} failed.", test_count, test_count - test_failed_count, test_failed_count);
 
+    if (!m_json_output_path.is_empty() && !write_benchmark_results(m_json_output_path))
+        test_failed_count++;
+    if (!m_baseline_path.is_empty())
+        test_failed_count += compare_benchmark_results(m_baseline_path);
+
     return (int)test_failed_count;
 }
 
+double TestSuite::BenchmarkResult::median() const
+{
+    size_t middle = samples.size() / 2;
+    if (samples.size() % 2)
+        return samples[middle];
+    return (samples[middle - 1] + samples[middle]) / 2;
+}
+
+double TestSuite::BenchmarkResult::p99() const
+{
+    size_t index = static_cast<size_t>(ceil(samples.size() * 0.99)) - 1;
+    return samples[AK::min(index, samples.size() - 1)];
+}
+
+// Each sample runs the benchmark enough times in a row to take at least this long, so timer
+// resolution and the overhead of reading the clock don't skew the results.
+static constexpr u64 min_sample_nanoseconds = 10'000'000;
+static constexpr size_t max_sample_count = 100;
+
+TestSuite::BenchmarkResult TestSuite::measure_benchmark(const TestCase& test_case)
+{
+    BenchmarkResult result;
+    result.name = test_case.name();
+    m_benchmark_bytes_processed = 0;
+    m_benchmark_items_processed = 0;
+
+    // The first run warms up caches and lazily initialized state, and tells us roughly how long a run takes.
+    auto warmup_start = monotonic_nanoseconds();
+    test_case.func()();
+    auto run_nanoseconds = max(monotonic_nanoseconds() - warmup_start, static_cast<u64>(1));
+    if (!m_current_test_case_passed)
+        return result;
+    result.bytes_per_iteration = m_benchmark_bytes_processed;
+    result.items_per_iteration = m_benchmark_items_processed;
+
+    result.iterations_per_sample = max(min_sample_nanoseconds / run_nanoseconds, static_cast<u64>(1));
+    u64 time_budget_nanoseconds = static_cast<u64>(max(m_benchmark_time_budget_ms, 1)) * 1'000'000;
+    size_t sample_count = clamp(time_budget_nanoseconds / (run_nanoseconds * result.iterations_per_sample), static_cast<u64>(1), static_cast<u64>(max_sample_count));
+
+    u64 total_cycles = 0;
+    bool have_cycles = m_count_cycles && cycle_counter().has_value();
+    for (size_t sample = 0; sample < sample_count && m_current_test_case_passed; ++sample) {
+        auto start_cycles = have_cycles ? cycle_counter().value() : 0;
+        auto start = monotonic_nanoseconds();
+        for (u64 i = 0; i < result.iterations_per_sample; ++i)
+            test_case.func()();
+        auto elapsed = monotonic_nanoseconds() - start;
+        if (have_cycles)
+            total_cycles += cycle_counter().value() - start_cycles;
+        result.samples.append(static_cast<double>(elapsed) / result.iterations_per_sample);
+    }
+
+    if (have_cycles)
+        result.cycles_per_iteration = static_cast<double>(total_cycles) / (result.samples.size() * result.iterations_per_sample);
+    quick_sort(result.samples);
+    return result;
+}
+
+static String human_readable_duration(double nanoseconds)
+{
+    if (nanoseconds < 1'000)
+        return String::formatted("{:.1}ns", nanoseconds);
+    if (nanoseconds < 1'000'000)
+        return String::formatted("{:.2}us", nanoseconds / 1'000);
+    if (nanoseconds < 1'000'000'000)
+        return String::formatted("{:.2}ms", nanoseconds / 1'000'000);
+    return String::formatted("{:.2}s", nanoseconds / 1'000'000'000);
+}
+
+static String human_readable_rate(double per_second, StringView unit)
+{
+    if (per_second >= 1e9)
+        return String::formatted("{:.2} G{}/s", per_second / 1e9, unit);
+    if (per_second >= 1e6)
+        return String::formatted("{:.2} M{}/s", per_second / 1e6, unit);
+    if (per_second >= 1e3)
+        return String::formatted("{:.2} K{}/s", per_second / 1e3, unit);
+    return String::formatted("{:.2} {}/s", per_second, unit);
+}
+
+void TestSuite::report_benchmark(const BenchmarkResult& result) const
+{
+    StringBuilder builder;
+    builder.appendff("{} samples of {} iterations: min {}, median {}, p99 {}",
+        result.samples.size(),
+        result.iterations_per_sample,
+        human_readable_duration(result.min()),
+        human_readable_duration(result.median()),
+        human_readable_duration(result.p99()));
+    double iterations_per_second = 1e9 / result.median();
+    if (result.bytes_per_iteration)
+        builder.appendff(", {}", human_readable_rate(result.bytes_per_iteration * iterations_per_second, "B"));
+    if (result.items_per_iteration)
+        builder.appendff(", {}", human_readable_rate(result.items_per_iteration * iterations_per_second, "items"));
+    if (result.cycles_per_iteration.has_value())
+        builder.appendff(", {:.0} cycles", result.cycles_per_iteration.value());
+    dbgln("    {}", builder.string_view());
+}
+
+bool TestSuite::write_benchmark_results(const String& path) const
+{
+    JsonArray benchmarks;
+    for (auto& result : m_benchmark_results) {
+        JsonObject benchmark;
+        benchmark.set("name", result.name);
+        benchmark.set("iterations_per_sample", result.iterations_per_sample);
+        benchmark.set("samples", result.samples.size());
+        benchmark.set("min_ns", result.min());
+        benchmark.set("median_ns", result.median());
+        benchmark.set("p99_ns", result.p99());
+        if (result.bytes_per_iteration)
+            benchmark.set("bytes_per_second", result.bytes_per_iteration * 1e9 / result.median());
+        if (result.items_per_iteration)
+            benchmark.set("items_per_second", result.items_per_iteration * 1e9 / result.median());
+        if (result.cycles_per_iteration.has_value())
+            benchmark.set("cycles_per_iteration", result.cycles_per_iteration.value());
+        benchmarks.append(move(benchmark));
+    }
+    JsonObject results;
+    results.set("suite", m_suite_name);
+    results.set("benchmarks", move(benchmarks));
+
+    auto file = Core::File::construct(path);
+    if (!file->open(Core::OpenMode::WriteOnly | Core::OpenMode::Truncate)) {
+        warnln("Couldn't open {} to write benchmark results to: {}", path, file->error_string());
+        return false;
+    }
+    auto json = results.to_string();
+    if (!file->write(json)) {
+        warnln("Couldn't write benchmark results to {}: {}", path, file->error_string());
+        return false;
+    }
+    return true;
+}
+
+size_t TestSuite::compare_benchmark_results(const String& baseline_path) const
+{
+    auto file = Core::File::construct(baseline_path);
+    if (!file->open(Core::OpenMode::ReadOnly)) {
+        warnln("Couldn't open baseline {}: {}", baseline_path, file->error_string());
+        return 1;
+    }
+    auto baseline = JsonValue::from_string(file->read_all());
+    if (!baseline.has_value() || !baseline->is_object() || !baseline->as_object().get("benchmarks").is_array()) {
+        warnln("{} doesn't look like benchmark results", baseline_path);
+        return 1;
+    }
+
+    HashMap<String, double> baseline_medians;
+    baseline->as_object().get("benchmarks").as_array().for_each([&](const JsonValue& benchmark) {
+        if (!benchmark.is_object())
+            return;
+        auto& object = benchmark.as_object();
+        if (object.get("name").is_string() && object.get("median_ns").is_number())
+            baseline_medians.set(object.get("name").as_string(), object.get("median_ns").to_number<double>());
+    });
+
+    size_t regression_count = 0;
+    double threshold = m_regression_threshold_percent / 100;
+    dbgln("Compared to {}:", baseline_path);
+    for (auto& result : m_benchmark_results) {
+        auto baseline_median = baseline_medians.get(result.name);
+        if (!baseline_median.has_value() || baseline_median.value() <= 0) {
+            dbgln("    {}: not in the baseline", result.name);
+            continue;
+        }
+        double change = result.median() / baseline_median.value() - 1;
+        const char* verdict = "";
+        if (change > threshold) {
+            verdict = " \033[31;1mREGRESSION\033[0m";
+            ++regression_count;
+        } else if (change < -threshold) {
+            verdict = " \033[32;1mimprovement\033[0m";
+        }
+        dbgln("    {}: {} -> {} ({:+.1}%){}", result.name, human_readable_duration(baseline_median.value()), human_readable_duration(result.median()), change * 100, verdict);
+    }
+    dbgln("{} of {} benchmarks regressed by more than {}%.", regression_count, m_benchmark_results.size(), m_regression_threshold_percent);
+    return regression_count;
+}
+
 }
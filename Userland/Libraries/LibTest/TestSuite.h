@@ -12,7 +12,9 @@
 #include <AK/Format.h>
 #include <AK/Function.h>
 #include <AK/NonnullRefPtrVector.h>
+#include <AK/Optional.h>
 #include <AK/String.h>
+#include <AK/Vector.h>
 #include <LibTest/TestCase.h>
 
 namespace Test {
@@ -43,13 +45,47 @@ public:
 
     void current_test_case_did_fail() { m_current_test_case_passed = false; }
 
+    void set_benchmark_bytes_processed(u64 bytes) { m_benchmark_bytes_processed = bytes; }
+    void set_benchmark_items_processed(u64 items) { m_benchmark_items_processed = items; }
+
 private:
+    struct BenchmarkResult {
+        String name;
+        u64 iterations_per_sample { 0 };
+        // Nanoseconds per iteration, sorted.
+        Vector<double> samples;
+        Optional<double> cycles_per_iteration;
+        u64 bytes_per_iteration { 0 };
+        u64 items_per_iteration { 0 };
+
+        double min() const { return samples.first(); }
+        double median() const;
+        double p99() const;
+    };
+
+    BenchmarkResult measure_benchmark(const TestCase&);
+    void report_benchmark(const BenchmarkResult&) const;
+    bool write_benchmark_results(const String& path) const;
+    // Returns how many benchmarks got slower than the baseline says they should be.
+    size_t compare_benchmark_results(const String& baseline_path) const;
+
     static TestSuite* s_global;
     NonnullRefPtrVector<TestCase> m_cases;
     u64 m_testtime = 0;
     u64 m_benchtime = 0;
     String m_suite_name;
     bool m_current_test_case_passed = true;
+
+    // Without --bench, benchmarks only run once, to make sure they still work.
+    bool m_measure_benchmarks = false;
+    int m_benchmark_time_budget_ms = 1000;
+    bool m_count_cycles = false;
+    String m_json_output_path;
+    String m_baseline_path;
+    double m_regression_threshold_percent = 5;
+    u64 m_benchmark_bytes_processed = 0;
+    u64 m_benchmark_items_processed = 0;
+    Vector<BenchmarkResult> m_benchmark_results;
 };
 
 }
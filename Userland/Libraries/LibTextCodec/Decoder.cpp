@@ -6,6 +6,8 @@
 
 #include <AK/String.h>
 #include <AK/StringBuilder.h>
+#include <AK/Utf8.h>
+#include <AK/Vector.h>
 #include <LibTextCodec/Decoder.h>
 
 namespace TextCodec {
@@ -177,25 +179,52 @@ bool is_standardized_encoding(const String& encoding)
 
 String UTF8Decoder::to_utf8(const StringView& input)
 {
-    return input;
+    size_t valid_bytes = 0;
+    if (validate_utf8(input.bytes(), valid_bytes))
+        return input;
+
+    // Anything that isn't part of a valid sequence is replaced with U+FFFD, so that whoever iterates over the
+    // result doesn't have to worry about it.
+    StringBuilder builder(input.length());
+    auto remaining = input;
+    for (;;) {
+        builder.append(remaining.substring_view(0, valid_bytes));
+        builder.append_code_point(0xfffd);
+        remaining = remaining.substring_view(valid_bytes + 1);
+        if (validate_utf8(remaining.bytes(), valid_bytes))
+            break;
+    }
+    builder.append(remaining);
+    return builder.to_string();
 }
 
 String UTF16BEDecoder::to_utf8(const StringView& input)
 {
-    StringBuilder builder(input.length() / 2);
-    size_t utf16_length = input.length() - (input.length() % 2);
-    for (size_t i = 0; i < utf16_length; i += 2) {
-        u16 code_point = (input[i] << 8) | input[i + 1];
-        builder.append_code_point(code_point);
-    }
-    return builder.to_string();
+    size_t code_unit_count = input.length() / 2;
+    if (code_unit_count == 0)
+        return String::empty();
+    Vector<u16> code_units;
+    code_units.resize(code_unit_count);
+    for (size_t i = 0; i < code_unit_count; ++i)
+        code_units[i] = ((u8)input[i * 2] << 8) | (u8)input[i * 2 + 1];
+
+    Vector<u8> utf8;
+    utf8.resize(code_unit_count * 3);
+    auto utf8_length = transcode_utf16_to_utf8(code_units.span(), utf8.data());
+    return String { (const char*)utf8.data(), utf8_length };
 }
 
 String Latin1Decoder::to_utf8(const StringView& input)
 {
     StringBuilder builder(input.length());
-    for (size_t i = 0; i < input.length(); ++i) {
-        u8 ch = input[i];
+    for (size_t i = 0; i < input.length();) {
+        // Runs of ASCII are already UTF-8.
+        auto ascii_length = ascii_prefix_length(input.bytes().slice(i));
+        builder.append(input.substring_view(i, ascii_length));
+        i += ascii_length;
+        if (i == input.length())
+            break;
+        u8 ch = input[i++];
         // Latin1 is the same as the first 256 Unicode code_points, so no mapping is needed, just utf-8 encoding.
         builder.append_code_point(ch);
     }
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/MergeSort.h>
+#include <AK/QuickSort.h>
+#include <AK/Span.h>
+#include <AK/Vector.h>
+#include <LibThread/ThreadPool.h>
+#include <sched.h>
+#include <unistd.h>
+
+namespace LibThread {
+
+namespace Detail {
+
+// Anything smaller than this sorts faster on one thread than it takes to get more of them going.
+static constexpr size_t parallel_sort_min_elements_per_thread = 16 * KiB;
+
+// Calls callback(i) for every i in [0, count), on the shared thread pool and this thread, and waits for all of them.
+template<typename Callback>
+void run_in_parallel(size_t count, Callback& callback)
+{
+    auto& pool = ThreadPool::the();
+    Atomic<size_t> remaining { count - 1 };
+    for (size_t i = 1; i < count; ++i) {
+        pool.submit([&callback, &remaining, i] {
+            callback(i);
+            remaining.fetch_sub(1, AK::memory_order_release);
+        });
+    }
+    callback(0);
+    while (remaining.load(AK::memory_order_acquire) > 0) {
+        if (!pool.run_pending_job())
+            sched_yield();
+    }
+}
+
+}
+
+// Splits elements into one chunk per processor, sorts the chunks on the thread pool, and then merges them
+// back together, again with a job per pair of chunks. less_than gets copied for every thread, and those
+// copies get called at the same time, so it mustn't touch anything another thread could be changing.
+// Like quick_sort(), this isn't stable.
+template<typename T, typename LessThan>
+void parallel_sort(Span<T> elements, LessThan less_than)
+{
+    size_t processor_count = max(sysconf(_SC_NPROCESSORS_ONLN), 1l);
+    size_t chunk_count = min(processor_count, elements.size() / Detail::parallel_sort_min_elements_per_thread);
+    if (chunk_count <= 1) {
+        quick_sort(elements, move(less_than));
+        return;
+    }
+
+    Vector<size_t> bounds;
+    for (size_t i = 0; i <= chunk_count; ++i)
+        bounds.append(elements.size() * i / chunk_count);
+
+    auto sort_chunk = [&](size_t i) {
+        auto chunk = elements.slice(bounds[i], bounds[i + 1] - bounds[i]);
+        auto chunk_less_than = less_than;
+        quick_sort(chunk, chunk_less_than);
+    };
+    Detail::run_in_parallel(chunk_count, sort_chunk);
+
+    // Merge neighbouring chunks pairwise until there's only one left.
+    while (bounds.size() > 2) {
+        auto merge_chunks = [&](size_t i) {
+            size_t start = bounds[2 * i];
+            size_t middle = bounds[2 * i + 1];
+            size_t end = bounds[2 * i + 2];
+            auto merge_less_than = less_than;
+            Vector<T> buffer;
+            AK::Detail::merge_adjacent(elements.slice(start, end - start), middle - start, merge_less_than, buffer);
+        };
+        Detail::run_in_parallel((bounds.size() - 1) / 2, merge_chunks);
+
+        Vector<size_t> merged_bounds;
+        for (size_t i = 0; i < bounds.size(); i += 2)
+            merged_bounds.append(bounds[i]);
+        if (merged_bounds.last() != bounds.last())
+            merged_bounds.append(bounds.last());
+        bounds = move(merged_bounds);
+    }
+}
+
+template<typename Collection, typename LessThan>
+void parallel_sort(Collection& collection, LessThan less_than)
+{
+    parallel_sort(collection.span(), move(less_than));
+}
+
+}
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibThread/ThreadPool.h>
+#include <sched.h>
+#include <unistd.h>
+
+namespace LibThread {
+
+__thread ThreadPool::Worker* ThreadPool::s_current_worker;
+
+ThreadPool& ThreadPool::the()
+{
+    static ThreadPool* s_the = new ThreadPool(max(sysconf(_SC_NPROCESSORS_ONLN), 1l));
+    return *s_the;
+}
+
+ThreadPool::ThreadPool(size_t worker_count)
+{
+    VERIFY(worker_count > 0);
+    pthread_mutex_init(&m_sleep_mutex, nullptr);
+    pthread_cond_init(&m_sleep_condition, nullptr);
+
+    for (size_t i = 0; i < worker_count; ++i) {
+        auto worker = make<Worker>();
+        worker->pool = this;
+        worker->index = i;
+        m_workers.append(move(worker));
+    }
+
+    // Only start them once they're all there to steal from.
+    for (auto& worker : m_workers) {
+        worker.thread = Thread::construct([this, &worker]() -> intptr_t {
+            run_worker(worker);
+            return 0;
+        },
+            "ThreadPool");
+        worker.thread->start();
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    pthread_mutex_lock(&m_sleep_mutex);
+    m_should_exit = true;
+    pthread_cond_broadcast(&m_sleep_condition);
+    pthread_mutex_unlock(&m_sleep_mutex);
+
+    for (auto& worker : m_workers)
+        [[maybe_unused]] auto result = worker.thread->join();
+
+    pthread_cond_destroy(&m_sleep_condition);
+    pthread_mutex_destroy(&m_sleep_mutex);
+}
+
+void ThreadPool::submit(Function<void()> job)
+{
+    ++m_unfinished_job_count;
+    // This has to go up before the job is in a queue, so no worker can decide there's nothing to do in between.
+    ++m_queued_job_count;
+
+    auto* worker = current_worker();
+    bool was_queued = worker ? worker->jobs.try_enqueue(move(job)) : m_shared_jobs.try_enqueue(move(job));
+    if (!was_queued) {
+        --m_queued_job_count;
+        run_job(job);
+        return;
+    }
+
+    wake_worker();
+}
+
+bool ThreadPool::run_pending_job()
+{
+    return run_pending_job(current_worker());
+}
+
+void ThreadPool::wait_for_all()
+{
+    VERIFY(!current_worker());
+    while (m_unfinished_job_count.load(AK::memory_order_acquire) > 0) {
+        if (!run_pending_job(nullptr))
+            sched_yield();
+    }
+}
+
+void ThreadPool::run_worker(Worker& worker)
+{
+    s_current_worker = &worker;
+    for (;;) {
+        if (run_pending_job(&worker))
+            continue;
+
+        pthread_mutex_lock(&m_sleep_mutex);
+        // We have to say we're going to sleep before taking the last look at the queues, so whoever queues a job
+        // after that knows to wake us up again.
+        ++m_sleeping_worker_count;
+        if (!m_should_exit && m_queued_job_count == 0)
+            pthread_cond_wait(&m_sleep_condition, &m_sleep_mutex);
+        --m_sleeping_worker_count;
+        bool should_exit = m_should_exit;
+        pthread_mutex_unlock(&m_sleep_mutex);
+
+        if (should_exit && m_queued_job_count == 0)
+            break;
+    }
+    s_current_worker = nullptr;
+}
+
+bool ThreadPool::run_pending_job(Worker* worker)
+{
+    if (m_queued_job_count == 0)
+        return false;
+    auto job = take_job(worker);
+    if (!job.has_value())
+        return false;
+    --m_queued_job_count;
+    run_job(job.value());
+    return true;
+}
+
+Optional<Function<void()>> ThreadPool::take_job(Worker* worker)
+{
+    if (worker) {
+        if (auto job = worker->jobs.try_dequeue(); job.has_value())
+            return job;
+    }
+    if (auto job = m_shared_jobs.try_dequeue(); job.has_value())
+        return job;
+
+    // Steal from the others, starting with the next one along so thieves don't all go for the same victim.
+    size_t first_victim = worker ? worker->index + 1 : 0;
+    for (size_t i = 0; i < m_workers.size(); ++i) {
+        auto& victim = m_workers[(first_victim + i) % m_workers.size()];
+        if (&victim == worker)
+            continue;
+        if (auto job = victim.jobs.try_dequeue(); job.has_value())
+            return job;
+    }
+    return {};
+}
+
+void ThreadPool::run_job(Function<void()>& job)
+{
+    job();
+    m_unfinished_job_count.fetch_sub(1, AK::memory_order_release);
+}
+
+void ThreadPool::wake_worker()
+{
+    if (m_sleeping_worker_count == 0)
+        return;
+    pthread_mutex_lock(&m_sleep_mutex);
+    pthread_cond_signal(&m_sleep_condition);
+    pthread_mutex_unlock(&m_sleep_mutex);
+}
+
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/Function.h>
+#include <AK/MPMCQueue.h>
+#include <AK/Noncopyable.h>
+#include <AK/NonnullOwnPtrVector.h>
+#include <AK/Optional.h>
+#include <AK/RefPtr.h>
+#include <LibThread/Thread.h>
+#include <pthread.h>
+
+namespace LibThread {
+
+// A fixed set of worker threads running jobs. Every worker has a queue of its own, which jobs submitted from
+// that worker go into; jobs from anywhere else go into a shared queue. Workers that run out of jobs take them
+// from the shared queue, and then from each other, before going to sleep.
+class ThreadPool {
+    AK_MAKE_NONCOPYABLE(ThreadPool);
+    AK_MAKE_NONMOVABLE(ThreadPool);
+
+public:
+    // A pool shared by the whole process, with a worker per processor. It's never destroyed.
+    static ThreadPool& the();
+
+    explicit ThreadPool(size_t worker_count);
+    // Runs whatever jobs are still queued, and then stops the workers.
+    ~ThreadPool();
+
+    size_t worker_count() const { return m_workers.size(); }
+
+    // Runs job on one of the workers at some point. If the queue it would go into is full, the job gets
+    // run right away on the calling thread instead.
+    void submit(Function<void()> job);
+
+    // Runs one queued job on the calling thread, if there is one. Anyone waiting for jobs to finish should
+    // call this rather than block, so they still make progress when every worker is waiting as well.
+    bool run_pending_job();
+
+    // Waits until every job submitted so far, and every job those submit, has finished, helping out meanwhile.
+    // Jobs can't call this, as they'd be waiting for themselves.
+    void wait_for_all();
+
+private:
+    static constexpr size_t worker_queue_capacity = 256;
+    static constexpr size_t shared_queue_capacity = 1024;
+
+    using JobQueue = MPMCQueue<Function<void()>, worker_queue_capacity>;
+
+    struct Worker {
+        ThreadPool* pool { nullptr };
+        size_t index { 0 };
+        JobQueue jobs;
+        RefPtr<Thread> thread;
+    };
+
+    static __thread Worker* s_current_worker;
+
+    Worker* current_worker() const { return s_current_worker && s_current_worker->pool == this ? s_current_worker : nullptr; }
+
+    void run_worker(Worker&);
+    bool run_pending_job(Worker*);
+    Optional<Function<void()>> take_job(Worker*);
+    void run_job(Function<void()>&);
+    void wake_worker();
+
+    NonnullOwnPtrVector<Worker> m_workers;
+    MPMCQueue<Function<void()>, shared_queue_capacity> m_shared_jobs;
+
+    // Jobs that were submitted but haven't finished running yet.
+    Atomic<size_t> m_unfinished_job_count { 0 };
+    // Jobs that are sitting in one of the queues.
+    Atomic<size_t> m_queued_job_count { 0 };
+
+    Atomic<size_t> m_sleeping_worker_count { 0 };
+    Atomic<bool> m_should_exit { false };
+    pthread_mutex_t m_sleep_mutex;
+    pthread_cond_t m_sleep_condition;
+};
+
+}
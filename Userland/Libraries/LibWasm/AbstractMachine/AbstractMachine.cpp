@@ -5,6 +5,7 @@
  */
 
 #include <LibWasm/AbstractMachine/AbstractMachine.h>
+#include <LibWasm/AbstractMachine/Compiler.h>
 #include <LibWasm/AbstractMachine/Configuration.h>
 #include <LibWasm/Types.h>
 
@@ -13,7 +14,7 @@ namespace Wasm {
 Optional<FunctionAddress> Store::allocate(ModuleInstance& module, const Module::Function& function)
 {
     FunctionAddress address { m_functions.size() };
-    if (function.type().value() > module.types().size())
+    if (function.type().value() >= module.types().size())
         return {};
 
     auto& type = module.types()[function.type().value()];
@@ -23,6 +24,9 @@ Optional<FunctionAddress> Store::allocate(ModuleInstance& module, const Module::
 
 Optional<FunctionAddress> Store::allocate(const HostFunction& function)
 {
+    // A host function hands back at most a single value, so it can't be given a type with more results than that.
+    if (function.type().results().size() > 1)
+        return {};
     FunctionAddress address { m_functions.size() };
     m_functions.empend(HostFunction { function });
     return address;
@@ -91,8 +95,6 @@ InstantiationResult AbstractMachine::instantiate(const Module& module, Vector<Ex
         m_module_instance.types() = section.types();
     });
 
-    // FIXME: Validate stuff
-
     Vector<Value> global_values;
     ModuleInstance auxiliary_instance;
 
@@ -105,14 +107,8 @@ InstantiationResult AbstractMachine::instantiate(const Module& module, Vector<Ex
 
     module.for_each_section_of_type<GlobalSection>([&](auto& global_section) {
         for (auto& entry : global_section.entries()) {
-            auto frame = make<Frame>(
-                auxiliary_instance,
-                Vector<Value> {},
-                entry.expression(),
-                1);
             Configuration config { m_store };
-            config.set_frame(move(frame));
-            auto result = config.execute();
+            auto result = config.execute(auxiliary_instance, entry.expression(), entry.type().type());
             // What if this traps?
             if (result.is_trap())
                 instantiation_result = InstantiationError { "Global value construction trapped" };
@@ -125,42 +121,67 @@ InstantiationResult AbstractMachine::instantiate(const Module& module, Vector<Ex
         return result.error();
     }
 
-    module.for_each_section_of_type<ElementSection>([&](const ElementSection&) {
-        // FIXME: Implement me
-        // https://webassembly.github.io/spec/core/bikeshed/#element-segments%E2%91%A0
-        // https://webassembly.github.io/spec/core/bikeshed/#instantiation%E2%91%A1 step 9
+    if (auto result = compile_functions(module); result.is_error())
+        return result.error();
+
+    module.for_each_section_of_type<ElementSection>([&](const ElementSection& section) {
+        for (auto& segment : section.segments()) {
+            // FIXME: Implement the other segment types
+            // https://webassembly.github.io/spec/core/bikeshed/#element-segments%E2%91%A0
+            auto* active = segment.get_pointer<ElementSection::SegmentType0>();
+            if (!active)
+                continue;
+            Configuration config { m_store };
+            auto result = config.execute(m_module_instance, active->mode.expression, ValueType { ValueType::I32 });
+            if (result.is_trap()) {
+                instantiation_result = InstantiationError { "Element segment offset computation trapped" };
+                return;
+            }
+            size_t offset = static_cast<u32>(result.values().first().value().get<i32>());
+            if (m_module_instance.tables().size() <= active->mode.index.value()) {
+                instantiation_result = InstantiationError { String::formatted("Element segment referenced out-of-bounds table ({}) of max {} entries", active->mode.index.value(), m_module_instance.tables().size()) };
+                return;
+            }
+            auto* table = m_store.get(m_module_instance.tables()[active->mode.index.value()]);
+            if (!table || offset + active->function_indices.size() > table->elements().size()) {
+                instantiation_result = InstantiationError { "Element segment attempted to write to out-of-bounds table entries" };
+                return;
+            }
+            for (size_t i = 0; i < active->function_indices.size(); ++i) {
+                auto index = active->function_indices[i].value();
+                if (m_module_instance.functions().size() <= index) {
+                    instantiation_result = InstantiationError { String::formatted("Element segment referenced out-of-bounds function ({}) of max {} entries", index, m_module_instance.functions().size()) };
+                    return;
+                }
+                table->elements()[offset + i] = Reference { Reference::Func { m_module_instance.functions()[index] } };
+            }
+        }
     });
 
+    if (instantiation_result.has_value() && instantiation_result->is_error())
+        return instantiation_result.release_value();
+
     module.for_each_section_of_type<DataSection>([&](const DataSection& data_section) {
         for (auto& segment : data_section.data()) {
             segment.value().visit(
                 [&](const DataSection::Data::Active& data) {
-                    auto frame = make<Frame>(
-                        m_module_instance,
-                        Vector<Value> {},
-                        data.offset,
-                        1);
                     Configuration config { m_store };
-                    config.set_frame(move(frame));
-                    auto result = config.execute();
-                    size_t offset = 0;
-                    result.values().first().value().visit(
-                        [&](const auto& value) { offset = value; },
-                        [&](const FunctionAddress&) { instantiation_result = InstantiationError { "Data segment offset returned an address" }; },
-                        [&](const ExternAddress&) { instantiation_result = InstantiationError { "Data segment offset returned an address" }; });
-                    if (instantiation_result.has_value() && instantiation_result->is_error())
+                    auto result = config.execute(m_module_instance, data.offset, ValueType { ValueType::I32 });
+                    if (result.is_trap()) {
+                        instantiation_result = InstantiationError { "Data segment offset computation trapped" };
                         return;
+                    }
+                    size_t offset = static_cast<u32>(result.values().first().value().get<i32>());
                     if (m_module_instance.memories().size() <= data.index.value()) {
                         instantiation_result = InstantiationError { String::formatted("Data segment referenced out-of-bounds memory ({}) of max {} entries", data.index.value(), m_module_instance.memories().size()) };
                         return;
                     }
                     auto address = m_module_instance.memories()[data.index.value()];
                     if (auto instance = m_store.get(address)) {
-                        if (instance->type().limits().max().value_or(data.init.size() + offset + 1) <= data.init.size() + offset) {
-                            instantiation_result = InstantiationError { String::formatted("Data segment attempted to write to out-of-bounds memory ({}) of max {} bytes", data.init.size() + offset, instance->type().limits().max().value()) };
+                        if (instance->size() < data.init.size() + offset) {
+                            instantiation_result = InstantiationError { String::formatted("Data segment attempted to write to out-of-bounds memory ({}) of max {} bytes", data.init.size() + offset, instance->size()) };
                             return;
                         }
-                        instance->grow(data.init.size() + offset - instance->size());
                         instance->data().overwrite(offset, data.init.data(), data.init.size());
                     }
                 },
@@ -268,6 +289,22 @@ InstantiationResult AbstractMachine::allocate_all(const Module& module, Vector<E
     return result.value_or({});
 }
 
+InstantiationResult AbstractMachine::compile_functions(const Module& module)
+{
+    // The module's own functions come after the imported ones.
+    auto imported_function_count = m_module_instance.functions().size() - module.functions().size();
+    Compiler compiler { m_store, m_module_instance };
+    for (size_t i = 0; i < module.functions().size(); ++i) {
+        auto index = imported_function_count + i;
+        auto& function = m_store.get(m_module_instance.functions()[index])->get<WasmFunction>();
+        auto result = compiler.compile(function.type(), function.code().locals(), function.code().body());
+        if (result.is_error())
+            return InstantiationError { String::formatted("Function {} failed validation: {}", index, result.error().error) };
+        function.set_compiled_code(result.release_value());
+    }
+    return {};
+}
+
 Result AbstractMachine::invoke(FunctionAddress address, Vector<Value> arguments)
 {
     return Configuration { m_store }.call(address, move(arguments));
@@ -6,8 +6,10 @@
 
 #pragma once
 
+#include <AK/BitCast.h>
 #include <AK/OwnPtr.h>
 #include <AK/Result.h>
+#include <LibWasm/AbstractMachine/CompiledCode.h>
 #include <LibWasm/Types.h>
 
 namespace Wasm {
@@ -89,9 +91,65 @@ public:
     {
     }
 
+    Value& operator=(Value&& value)
+    {
+        m_value = move(value.m_value);
+        m_type = move(value.m_type);
+        return *this;
+    }
+
+    Value& operator=(const Value& value)
+    {
+        m_value = value.m_value;
+        m_type = value.m_type;
+        return *this;
+    }
+
     auto& type() const { return m_type; }
     auto& value() const { return m_value; }
 
+    // The untagged representation of values on the interpreter's value stack.
+    // 32-bit values are zero-extended, and a null reference is all ones.
+    static constexpr u64 null_reference = NumericLimits<u64>::max();
+
+    u64 to_raw() const
+    {
+        switch (m_type.kind()) {
+        case ValueType::Kind::I32:
+            return static_cast<u32>(m_value.get<i32>());
+        case ValueType::Kind::I64:
+            return m_value.get<i64>();
+        case ValueType::Kind::F32:
+            return bit_cast<u32>(m_value.get<float>());
+        case ValueType::Kind::F64:
+            return bit_cast<u64>(m_value.get<double>());
+        case ValueType::Kind::FunctionReference:
+            return m_value.get<FunctionAddress>().value();
+        case ValueType::Kind::ExternReference:
+            return m_value.get<ExternAddress>().value();
+        }
+        VERIFY_NOT_REACHED();
+    }
+
+    static Value from_raw(ValueType type, u64 raw)
+    {
+        switch (type.kind()) {
+        case ValueType::Kind::I32:
+            return Value { static_cast<i32>(raw) };
+        case ValueType::Kind::I64:
+            return Value { static_cast<i64>(raw) };
+        case ValueType::Kind::F32:
+            return Value { bit_cast<float>(static_cast<u32>(raw)) };
+        case ValueType::Kind::F64:
+            return Value { bit_cast<double>(raw) };
+        case ValueType::Kind::FunctionReference:
+            return Value { FunctionAddress { raw } };
+        case ValueType::Kind::ExternReference:
+            return Value { ExternAddress { raw } };
+        }
+        VERIFY_NOT_REACHED();
+    }
+
 private:
     AnyValueType m_value;
     ValueType m_type;
@@ -191,10 +249,15 @@ public:
     auto& module() const { return m_module; }
     auto& code() const { return m_code; }
 
+    // The validated and lowered body, set when the module is instantiated.
+    const CompiledCode* compiled_code() const { return m_compiled_code.ptr(); }
+    void set_compiled_code(NonnullOwnPtr<CompiledCode> code) { m_compiled_code = move(code); }
+
 private:
     const FunctionType& m_type;
     const ModuleInstance& m_module;
     const Module::Function& m_code;
+    OwnPtr<CompiledCode> m_compiled_code;
 };
 
 class HostFunction {
@@ -258,6 +321,9 @@ private:
 
 class MemoryInstance {
 public:
+    static constexpr size_t page_size = 64 * KiB;
+    static constexpr size_t max_pages = 65536;
+
     explicit MemoryInstance(const MemoryType& type)
         : m_type(type)
     {
@@ -265,15 +331,27 @@ public:
     }
 
     auto& type() const { return m_type; }
-    auto size() const { return m_size; }
+    auto size() const { return m_data.size(); }
     auto& data() const { return m_data; }
     auto& data() { return m_data; }
 
-    void grow(size_t new_size) { m_data.grow(new_size); }
+    // Grows the memory by the given number of pages, which start out zeroed.
+    bool grow(size_t pages)
+    {
+        auto current_pages = size() / page_size;
+        auto max = min<size_t>(m_type.limits().max().value_or(max_pages), max_pages);
+        if (pages > max - min(max, current_pages))
+            return false;
+        if (pages == 0)
+            return true;
+        auto old_size = size();
+        m_data.grow(old_size + pages * page_size);
+        __builtin_memset(m_data.data() + old_size, 0, pages * page_size);
+        return true;
+    }
 
 private:
     const MemoryType& m_type;
-    size_t m_size { 0 };
     ByteBuffer m_data;
 };
 
@@ -287,6 +365,11 @@ public:
 
     auto is_mutable() const { return m_mutable; }
     auto& value() const { return m_value; }
+    void set_value(Value value)
+    {
+        VERIFY(is_mutable());
+        m_value = move(value);
+    }
 
 private:
     bool m_mutable { false };
@@ -315,60 +398,6 @@ private:
     Vector<GlobalInstance> m_globals;
 };
 
-class Label {
-public:
-    explicit Label(InstructionPointer continuation)
-        : m_continuation(continuation)
-    {
-    }
-
-    auto continuation() const { return m_continuation; }
-
-private:
-    InstructionPointer m_continuation;
-};
-
-class Frame {
-    AK_MAKE_NONCOPYABLE(Frame);
-
-public:
-    explicit Frame(const ModuleInstance& module, Vector<Value> locals, const Expression& expression, size_t arity)
-        : m_module(module)
-        , m_locals(move(locals))
-        , m_expression(expression)
-        , m_arity(arity)
-    {
-    }
-
-    auto& module() const { return m_module; }
-    auto& locals() const { return m_locals; }
-    auto& expression() const { return m_expression; }
-    auto arity() const { return m_arity; }
-
-private:
-    const ModuleInstance& m_module;
-    Vector<Value> m_locals;
-    const Expression& m_expression;
-    size_t m_arity { 0 };
-};
-
-class Stack {
-public:
-    using EntryType = Variant<NonnullOwnPtr<Value>, NonnullOwnPtr<Label>, NonnullOwnPtr<Frame>>;
-    Stack() = default;
-
-    [[nodiscard]] bool is_empty() const { return m_data.is_empty(); }
-    void push(EntryType entry) { m_data.append(move(entry)); }
-    auto pop() { return m_data.take_last(); }
-    auto& last() { return m_data.last(); }
-
-    auto size() const { return m_data.size(); }
-    auto& entries() const { return m_data; }
-
-private:
-    Vector<EntryType> m_data;
-};
-
 class AbstractMachine {
 public:
     explicit AbstractMachine() = default;
@@ -384,6 +413,7 @@ public:
 
 private:
     InstantiationResult allocate_all(const Module&, Vector<ExternValue>&, Vector<Value>& global_values);
+    InstantiationResult compile_functions(const Module&);
     ModuleInstance m_module_instance;
     Store m_store;
 };
@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Types.h>
+#include <AK/Vector.h>
+
+namespace Wasm {
+
+class ModuleInstance;
+
+// Operations of the lowered form of a function body that the interpreter executes.
+// The value stack is untagged, so operations that only move bits around are shared between types;
+// i32 and f32 values are always kept zero-extended to 64 bits.
+#define ENUMERATE_COMPILED_OPCODES(O) \
+    O(Unreachable)                    \
+    O(Jump)                           \
+    O(JumpIfZero)                     \
+    O(JumpIfNotZero)                  \
+    O(Branch)                         \
+    O(BranchIf)                       \
+    O(BranchTable)                    \
+    O(Return)                         \
+    O(Call)                           \
+    O(CallIndirect)                   \
+    O(Drop)                           \
+    O(Select)                         \
+    O(Const)                          \
+    O(LocalGet)                       \
+    O(LocalSet)                       \
+    O(LocalTee)                       \
+    O(GlobalGet)                      \
+    O(GlobalSet)                      \
+    O(TableGet)                       \
+    O(TableSet)                       \
+    O(TableSize)                      \
+    O(RefIsNull)                      \
+    O(Load8S32)                       \
+    O(Load8S64)                       \
+    O(Load8U)                         \
+    O(Load16S32)                      \
+    O(Load16S64)                      \
+    O(Load16U)                        \
+    O(Load32S64)                      \
+    O(Load32)                         \
+    O(Load64)                         \
+    O(Store8)                         \
+    O(Store16)                        \
+    O(Store32)                        \
+    O(Store64)                        \
+    O(MemorySize)                     \
+    O(MemoryGrow)                     \
+    O(MemoryCopy)                     \
+    O(MemoryFill)                     \
+    O(Eqz)                            \
+    O(Eq)                             \
+    O(Ne)                             \
+    O(And)                            \
+    O(Or)                             \
+    O(Xor)                            \
+    O(I32LtS)                         \
+    O(I32LtU)                         \
+    O(I32GtS)                         \
+    O(I32GtU)                         \
+    O(I32LeS)                         \
+    O(I32LeU)                         \
+    O(I32GeS)                         \
+    O(I32GeU)                         \
+    O(I32Clz)                         \
+    O(I32Ctz)                         \
+    O(I32Popcnt)                      \
+    O(I32Add)                         \
+    O(I32Sub)                         \
+    O(I32Mul)                         \
+    O(I32DivS)                        \
+    O(I32DivU)                        \
+    O(I32RemS)                        \
+    O(I32RemU)                        \
+    O(I32Shl)                         \
+    O(I32ShrS)                        \
+    O(I32ShrU)                        \
+    O(I32Rotl)                        \
+    O(I32Rotr)                        \
+    O(I64LtS)                         \
+    O(I64LtU)                         \
+    O(I64GtS)                         \
+    O(I64GtU)                         \
+    O(I64LeS)                         \
+    O(I64LeU)                         \
+    O(I64GeS)                         \
+    O(I64GeU)                         \
+    O(I64Clz)                         \
+    O(I64Ctz)                         \
+    O(I64Popcnt)                      \
+    O(I64Add)                         \
+    O(I64Sub)                         \
+    O(I64Mul)                         \
+    O(I64DivS)                        \
+    O(I64DivU)                        \
+    O(I64RemS)                        \
+    O(I64RemU)                        \
+    O(I64Shl)                         \
+    O(I64ShrS)                        \
+    O(I64ShrU)                        \
+    O(I64Rotl)                        \
+    O(I64Rotr)                        \
+    O(F32Eq)                          \
+    O(F32Ne)                          \
+    O(F32Lt)                          \
+    O(F32Gt)                          \
+    O(F32Le)                          \
+    O(F32Ge)                          \
+    O(F32Abs)                         \
+    O(F32Neg)                         \
+    O(F32Ceil)                        \
+    O(F32Floor)                       \
+    O(F32Trunc)                       \
+    O(F32Nearest)                     \
+    O(F32Sqrt)                        \
+    O(F32Add)                         \
+    O(F32Sub)                         \
+    O(F32Mul)                         \
+    O(F32Div)                         \
+    O(F32Min)                         \
+    O(F32Max)                         \
+    O(F32Copysign)                    \
+    O(F64Eq)                          \
+    O(F64Ne)                          \
+    O(F64Lt)                          \
+    O(F64Gt)                          \
+    O(F64Le)                          \
+    O(F64Ge)                          \
+    O(F64Abs)                         \
+    O(F64Neg)                         \
+    O(F64Ceil)                        \
+    O(F64Floor)                       \
+    O(F64Trunc)                       \
+    O(F64Nearest)                     \
+    O(F64Sqrt)                        \
+    O(F64Add)                         \
+    O(F64Sub)                         \
+    O(F64Mul)                         \
+    O(F64Div)                         \
+    O(F64Min)                         \
+    O(F64Max)                         \
+    O(F64Copysign)                    \
+    O(I32WrapI64)                     \
+    O(I32TruncF32S)                   \
+    O(I32TruncF32U)                   \
+    O(I32TruncF64S)                   \
+    O(I32TruncF64U)                   \
+    O(I64ExtendI32S)                  \
+    O(I64TruncF32S)                   \
+    O(I64TruncF32U)                   \
+    O(I64TruncF64S)                   \
+    O(I64TruncF64U)                   \
+    O(F32ConvertI32S)                 \
+    O(F32ConvertI32U)                 \
+    O(F32ConvertI64S)                 \
+    O(F32ConvertI64U)                 \
+    O(F32DemoteF64)                   \
+    O(F64ConvertI32S)                 \
+    O(F64ConvertI32U)                 \
+    O(F64ConvertI64S)                 \
+    O(F64ConvertI64U)                 \
+    O(F64PromoteF32)                  \
+    O(I32TruncSatF32S)                \
+    O(I32TruncSatF32U)                \
+    O(I32TruncSatF64S)                \
+    O(I32TruncSatF64U)                \
+    O(I64TruncSatF32S)                \
+    O(I64TruncSatF32U)                \
+    O(I64TruncSatF64S)                \
+    O(I64TruncSatF64U)
+
+enum class CompiledOpCode : u32 {
+#define __ENUMERATE_COMPILED_OPCODE(name) name,
+    ENUMERATE_COMPILED_OPCODES(__ENUMERATE_COMPILED_OPCODE)
+#undef __ENUMERATE_COMPILED_OPCODE
+};
+
+// Operands, depending on the opcode:
+// - Jump, JumpIfZero, JumpIfNotZero: a is the target.
+// - Branch, BranchIf: a is the target, b holds the label's stack height (low half) and arity (high half).
+// - BranchTable: a is the first of b + 1 entries in the branch target table, the last one being the default.
+// - Return: a is the number of results.
+// - Call: a is the callee's function address.
+// - CallIndirect: a is the expected type's index in the module, b is the table address.
+// - Const: b holds the value's bits.
+// - LocalGet, LocalSet, LocalTee: a is the local's index in the frame.
+// - GlobalGet, GlobalSet: a is the global address.
+// - TableGet, TableSet, TableSize: a is the table address.
+// - Loads and stores: a is the static offset.
+struct CompiledInstruction {
+    CompiledOpCode opcode;
+    u32 a { 0 };
+    u64 b { 0 };
+};
+
+struct BranchTarget {
+    u32 address { 0 };
+    u32 height { 0 };
+    u32 arity { 0 };
+};
+
+// Stack heights are counted in value stack slots, from the start of the frame's locals.
+struct CompiledCode {
+    const ModuleInstance* module { nullptr };
+    Vector<CompiledInstruction> instructions;
+    Vector<BranchTarget> branch_targets;
+    size_t parameter_count { 0 };
+    size_t local_count { 0 };
+    size_t result_count { 0 };
+    size_t max_stack_height { 0 };
+};
+
+}
@@ -0,0 +1,773 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibWasm/AbstractMachine/Compiler.h>
+
+namespace Wasm {
+
+CompilationResult Compiler::compile(const FunctionType& type, const Vector<ValueType>& locals, const Expression& expression)
+{
+    m_code = make<CompiledCode>();
+    m_code->module = &m_module;
+    m_code->parameter_count = type.parameters().size();
+    m_code->result_count = type.results().size();
+
+    m_locals.clear();
+    m_locals.append(type.parameters().data(), type.parameters().size());
+    m_locals.append(locals.data(), locals.size());
+    m_code->local_count = m_locals.size();
+    m_code->max_stack_height = m_locals.size();
+
+    m_operands.clear();
+    m_frames.clear();
+    m_frames.append(ControlFrame { Instructions::block, {}, type.results() });
+
+    for (auto& instruction : expression.instructions()) {
+        if (!compile(instruction))
+            return ValidationError { move(m_error) };
+    }
+    if (!finish_function())
+        return ValidationError { move(m_error) };
+
+    return m_code.release_nonnull();
+}
+
+bool Compiler::fail(String error)
+{
+    m_error = move(error);
+    return false;
+}
+
+size_t Compiler::emit(CompiledOpCode opcode, u32 a, u64 b)
+{
+    m_code->instructions.append(CompiledInstruction { opcode, a, b });
+    return m_code->instructions.size() - 1;
+}
+
+void Compiler::push(StackType type)
+{
+    m_operands.append(type);
+    m_code->max_stack_height = max(m_code->max_stack_height, height());
+}
+
+void Compiler::push(const Vector<ValueType>& types)
+{
+    for (auto& type : types)
+        push(type.kind());
+}
+
+bool Compiler::pop(StackType& type)
+{
+    auto& frame = m_frames.last();
+    if (m_operands.size() == frame.height) {
+        if (!frame.unreachable)
+            return fail("Popped a value off an empty stack");
+        type = {};
+        return true;
+    }
+    type = m_operands.take_last();
+    return true;
+}
+
+bool Compiler::pop(ValueType::Kind expected)
+{
+    StackType type;
+    if (!pop(type))
+        return false;
+    if (type.has_value() && type.value() != expected)
+        return fail(String::formatted("Expected a value of type {}, but got {}", ValueType::kind_name(expected), ValueType::kind_name(type.value())));
+    return true;
+}
+
+bool Compiler::pop(const Vector<ValueType>& types)
+{
+    for (size_t i = types.size(); i > 0; --i) {
+        if (!pop(types[i - 1].kind()))
+            return false;
+    }
+    return true;
+}
+
+bool Compiler::check_frame_end(const ControlFrame& frame)
+{
+    if (!pop(frame.results))
+        return false;
+    if (m_operands.size() != frame.height)
+        return fail("Values were left on the stack at the end of a block");
+    return true;
+}
+
+void Compiler::set_unreachable()
+{
+    auto& frame = m_frames.last();
+    m_operands.shrink(frame.height);
+    frame.unreachable = true;
+}
+
+bool Compiler::block_type_signature(const BlockType& block_type, Vector<ValueType>& parameters, Vector<ValueType>& results)
+{
+    switch (block_type.kind()) {
+    case BlockType::Empty:
+        return true;
+    case BlockType::Type:
+        results.append(block_type.value_type());
+        return true;
+    case BlockType::Index: {
+        auto index = block_type.type_index().value();
+        if (index >= m_module.types().size())
+            return fail(String::formatted("Block type index {} is out of bounds", index));
+        auto& type = m_module.types()[index];
+        parameters = type.parameters();
+        results = type.results();
+        return true;
+    }
+    }
+    VERIFY_NOT_REACHED();
+}
+
+const FunctionType* Compiler::function_type(FunctionIndex index)
+{
+    if (index.value() >= m_module.functions().size()) {
+        fail(String::formatted("Function index {} is out of bounds", index.value()));
+        return nullptr;
+    }
+    auto* function = m_store.get(m_module.functions()[index.value()]);
+    if (!function) {
+        fail(String::formatted("Function {} doesn't exist", index.value()));
+        return nullptr;
+    }
+    if (auto* wasm_function = function->get_pointer<WasmFunction>())
+        return &wasm_function->type();
+    return &function->get<HostFunction>().type();
+}
+
+bool Compiler::compile_block(const Instruction& instruction)
+{
+    auto& arguments = instruction.arguments().get<Instruction::StructuredInstructionArgs>();
+    ControlFrame frame { instruction.opcode() };
+    if (!block_type_signature(arguments.block_type, frame.parameters, frame.results))
+        return false;
+
+    if (instruction.opcode() == Instructions::if_) {
+        if (!pop(ValueType::I32))
+            return false;
+        frame.else_fixup = emit(CompiledOpCode::JumpIfZero);
+    }
+
+    if (!pop(frame.parameters))
+        return false;
+    frame.height = m_operands.size();
+    frame.loop_address = current_address();
+    m_frames.append(move(frame));
+    push(m_frames.last().parameters);
+    return true;
+}
+
+void Compiler::patch_fixups(ControlFrame& frame, size_t address)
+{
+    for (auto index : frame.jump_fixups)
+        m_code->instructions[index].a = address;
+    for (auto index : frame.branch_target_fixups)
+        m_code->branch_targets[index].address = address;
+}
+
+bool Compiler::compile_else()
+{
+    auto& frame = m_frames.last();
+    if (frame.opcode != Instructions::if_ || !frame.else_fixup.has_value())
+        return fail("Found an else without a matching if");
+    if (!check_frame_end(frame))
+        return false;
+
+    frame.jump_fixups.append(emit(CompiledOpCode::Jump));
+    m_code->instructions[frame.else_fixup.value()].a = current_address();
+    frame.else_fixup.clear();
+    frame.unreachable = false;
+    push(frame.parameters);
+    return true;
+}
+
+bool Compiler::compile_end()
+{
+    if (m_frames.size() == 1)
+        return fail("Found an end without a matching block");
+    auto& frame = m_frames.last();
+    if (!check_frame_end(frame))
+        return false;
+
+    if (frame.else_fixup.has_value()) {
+        // Without an else, the parameters pass straight through when the condition is false.
+        if (frame.parameters.size() != frame.results.size())
+            return fail("An if without an else must have the same parameter and result types");
+        for (size_t i = 0; i < frame.parameters.size(); ++i) {
+            if (frame.parameters[i].kind() != frame.results[i].kind())
+                return fail("An if without an else must have the same parameter and result types");
+        }
+        m_code->instructions[frame.else_fixup.value()].a = current_address();
+    }
+
+    patch_fixups(frame, current_address());
+    auto results = move(frame.results);
+    m_frames.take_last();
+    push(results);
+    return true;
+}
+
+bool Compiler::finish_function()
+{
+    if (m_frames.size() != 1)
+        return fail("The function body ended inside a block");
+    auto& frame = m_frames.last();
+    if (!check_frame_end(frame))
+        return false;
+
+    patch_fixups(frame, emit(CompiledOpCode::Return, frame.results.size()));
+    return true;
+}
+
+bool Compiler::compile_branch(LabelIndex label, bool is_conditional)
+{
+    if (label.value() >= m_frames.size())
+        return fail(String::formatted("Branch label {} is out of bounds", label.value()));
+    if (is_conditional && !pop(ValueType::I32))
+        return false;
+
+    auto& frame = m_frames[m_frames.size() - 1 - label.value()];
+    auto& types = frame.label_types();
+    if (!pop(types))
+        return false;
+
+    auto arity = types.size();
+    auto label_height = m_locals.size() + frame.height;
+    bool is_function = label.value() == m_frames.size() - 1;
+
+    size_t index;
+    if (is_function && !is_conditional) {
+        index = emit(CompiledOpCode::Return, arity);
+    } else if (!m_frames.last().unreachable && height() == label_height) {
+        // The results are already where the label expects them, so this is just a jump.
+        index = emit(is_conditional ? CompiledOpCode::JumpIfNotZero : CompiledOpCode::Jump);
+    } else {
+        index = emit(is_conditional ? CompiledOpCode::BranchIf : CompiledOpCode::Branch, 0, label_height | (static_cast<u64>(arity) << 32));
+    }
+
+    if (frame.opcode == Instructions::loop)
+        m_code->instructions[index].a = frame.loop_address;
+    else if (!is_function || is_conditional)
+        frame.jump_fixups.append(index);
+
+    if (is_conditional)
+        push(types);
+    else
+        set_unreachable();
+    return true;
+}
+
+BranchTarget Compiler::branch_target_for(ControlFrame& frame, size_t table_index)
+{
+    BranchTarget target;
+    target.height = m_locals.size() + frame.height;
+    target.arity = frame.label_types().size();
+    if (frame.opcode == Instructions::loop)
+        target.address = frame.loop_address;
+    else
+        frame.branch_target_fixups.append(table_index);
+    return target;
+}
+
+bool Compiler::compile_branch_table(const Instruction::TableBranchArgs& arguments)
+{
+    if (!pop(ValueType::I32))
+        return false;
+
+    auto check_label = [&](LabelIndex label) -> ControlFrame* {
+        if (label.value() >= m_frames.size()) {
+            fail(String::formatted("Branch label {} is out of bounds", label.value()));
+            return nullptr;
+        }
+        return &m_frames[m_frames.size() - 1 - label.value()];
+    };
+
+    auto* default_frame = check_label(arguments.default_);
+    if (!default_frame)
+        return false;
+    auto arity = default_frame->label_types().size();
+
+    auto first_index = m_code->branch_targets.size();
+    for (auto& label : arguments.labels) {
+        auto* frame = check_label(label);
+        if (!frame)
+            return false;
+        if (frame->label_types().size() != arity)
+            return fail("All labels of a br_table must have the same arity");
+        // Check the types against a copy of the stack, as each label is a separate use of the same values.
+        auto operands = m_operands;
+        if (!pop(frame->label_types()))
+            return false;
+        m_operands = move(operands);
+        m_code->branch_targets.append(branch_target_for(*frame, m_code->branch_targets.size()));
+    }
+    if (!pop(default_frame->label_types()))
+        return false;
+    m_code->branch_targets.append(branch_target_for(*default_frame, m_code->branch_targets.size()));
+
+    emit(CompiledOpCode::BranchTable, first_index, arguments.labels.size());
+    set_unreachable();
+    return true;
+}
+
+bool Compiler::compile_call(const FunctionType& type, CompiledOpCode opcode, u32 a, u64 b)
+{
+    if (!pop(type.parameters()))
+        return false;
+    emit(opcode, a, b);
+    push(type.results());
+    return true;
+}
+
+bool Compiler::compile_load(const Instruction& instruction, ValueType::Kind type, size_t size, CompiledOpCode opcode)
+{
+    if (m_module.memories().is_empty())
+        return fail("Memory access without a memory");
+    auto& argument = instruction.arguments().get<Instruction::MemoryArgument>();
+    if (argument.align >= 32 || (1u << argument.align) > size)
+        return fail("Memory access alignment is larger than the natural alignment");
+    if (!pop(ValueType::I32))
+        return false;
+    emit(opcode, argument.offset);
+    push(type);
+    return true;
+}
+
+bool Compiler::compile_store(const Instruction& instruction, ValueType::Kind type, size_t size, CompiledOpCode opcode)
+{
+    if (m_module.memories().is_empty())
+        return fail("Memory access without a memory");
+    auto& argument = instruction.arguments().get<Instruction::MemoryArgument>();
+    if (argument.align >= 32 || (1u << argument.align) > size)
+        return fail("Memory access alignment is larger than the natural alignment");
+    if (!pop(type) || !pop(ValueType::I32))
+        return false;
+    emit(opcode, argument.offset);
+    return true;
+}
+
+bool Compiler::compile_unary(ValueType::Kind operand, ValueType::Kind result, Optional<CompiledOpCode> opcode)
+{
+    if (!pop(operand))
+        return false;
+    // Some conversions don't change the bits on the untagged stack, so they don't need any code.
+    if (opcode.has_value())
+        emit(opcode.value());
+    push(result);
+    return true;
+}
+
+bool Compiler::compile_binary(ValueType::Kind operand, ValueType::Kind result, CompiledOpCode opcode)
+{
+    if (!pop(operand) || !pop(operand))
+        return false;
+    emit(opcode);
+    push(result);
+    return true;
+}
+
+bool Compiler::compile(const Instruction& instruction)
+{
+    using Kind = ValueType::Kind;
+
+#define UNARY(name, operand, result, opcode) \
+    case Instructions::name.value():         \
+        return compile_unary(Kind::operand, Kind::result, CompiledOpCode::opcode);
+#define NO_OP_CONVERSION(name, operand, result) \
+    case Instructions::name.value():            \
+        return compile_unary(Kind::operand, Kind::result, {});
+#define BINARY(name, operand, result, opcode) \
+    case Instructions::name.value():          \
+        return compile_binary(Kind::operand, Kind::result, CompiledOpCode::opcode);
+#define LOAD(name, type, size, opcode) \
+    case Instructions::name.value():   \
+        return compile_load(instruction, Kind::type, size, CompiledOpCode::opcode);
+#define STORE(name, type, size, opcode) \
+    case Instructions::name.value():    \
+        return compile_store(instruction, Kind::type, size, CompiledOpCode::opcode);
+
+    switch (instruction.opcode().value()) {
+    case Instructions::unreachable.value():
+        emit(CompiledOpCode::Unreachable);
+        set_unreachable();
+        return true;
+    case Instructions::nop.value():
+        return true;
+    case Instructions::block.value():
+    case Instructions::loop.value():
+    case Instructions::if_.value():
+        return compile_block(instruction);
+    case Instructions::structured_else.value():
+        return compile_else();
+    case Instructions::structured_end.value():
+        return compile_end();
+    case Instructions::br.value():
+        return compile_branch(instruction.arguments().get<LabelIndex>(), false);
+    case Instructions::br_if.value():
+        return compile_branch(instruction.arguments().get<LabelIndex>(), true);
+    case Instructions::br_table.value():
+        return compile_branch_table(instruction.arguments().get<Instruction::TableBranchArgs>());
+    case Instructions::return_.value(): {
+        auto& results = m_frames.first().results;
+        if (!pop(results))
+            return false;
+        emit(CompiledOpCode::Return, results.size());
+        set_unreachable();
+        return true;
+    }
+    case Instructions::call.value(): {
+        auto index = instruction.arguments().get<FunctionIndex>();
+        auto* type = function_type(index);
+        if (!type)
+            return false;
+        return compile_call(*type, CompiledOpCode::Call, m_module.functions()[index.value()].value());
+    }
+    case Instructions::call_indirect.value(): {
+        auto& arguments = instruction.arguments().get<Instruction::IndirectCallArgs>();
+        if (arguments.type.value() >= m_module.types().size())
+            return fail(String::formatted("Type index {} is out of bounds", arguments.type.value()));
+        if (arguments.table.value() >= m_module.tables().size())
+            return fail(String::formatted("Table index {} is out of bounds", arguments.table.value()));
+        auto* table = m_store.get(m_module.tables()[arguments.table.value()]);
+        if (!table || table->type().element_type().kind() != Kind::FunctionReference)
+            return fail("call_indirect needs a table of function references");
+        if (!pop(Kind::I32))
+            return false;
+        return compile_call(m_module.types()[arguments.type.value()], CompiledOpCode::CallIndirect, arguments.type.value(), m_module.tables()[arguments.table.value()].value());
+    }
+    case Instructions::drop.value(): {
+        StackType type;
+        if (!pop(type))
+            return false;
+        emit(CompiledOpCode::Drop);
+        return true;
+    }
+    case Instructions::select.value():
+    case Instructions::select_typed.value(): {
+        if (!pop(Kind::I32))
+            return false;
+        StackType type;
+        if (instruction.opcode() == Instructions::select_typed) {
+            auto& types = instruction.arguments().get<Vector<ValueType>>();
+            if (types.size() != 1)
+                return fail("A typed select must have exactly one type");
+            type = types.first().kind();
+            if (!pop(type.value()) || !pop(type.value()))
+                return false;
+        } else {
+            StackType other;
+            if (!pop(type) || !pop(other))
+                return false;
+            if (type.has_value() && other.has_value() && type.value() != other.value())
+                return fail("The operands of select must have the same type");
+            if (!type.has_value())
+                type = other;
+            if (type.has_value() && ValueType { type.value() }.is_reference())
+                return fail("An untyped select can only select numbers");
+        }
+        emit(CompiledOpCode::Select);
+        push(type);
+        return true;
+    }
+    case Instructions::local_get.value():
+    case Instructions::local_set.value():
+    case Instructions::local_tee.value(): {
+        auto index = instruction.arguments().get<LocalIndex>().value();
+        if (index >= m_locals.size())
+            return fail(String::formatted("Local index {} is out of bounds", index));
+        auto type = m_locals[index].kind();
+        if (instruction.opcode() == Instructions::local_get) {
+            emit(CompiledOpCode::LocalGet, index);
+            push(type);
+            return true;
+        }
+        if (!pop(type))
+            return false;
+        if (instruction.opcode() == Instructions::local_tee) {
+            emit(CompiledOpCode::LocalTee, index);
+            push(type);
+        } else {
+            emit(CompiledOpCode::LocalSet, index);
+        }
+        return true;
+    }
+    case Instructions::global_get.value():
+    case Instructions::global_set.value(): {
+        auto index = instruction.arguments().get<GlobalIndex>().value();
+        if (index >= m_module.globals().size())
+            return fail(String::formatted("Global index {} is out of bounds", index));
+        auto address = m_module.globals()[index];
+        auto* global = m_store.get(address);
+        if (!global)
+            return fail(String::formatted("Global {} doesn't exist", index));
+        auto type = global->value().type().kind();
+        if (instruction.opcode() == Instructions::global_get) {
+            emit(CompiledOpCode::GlobalGet, address.value());
+            push(type);
+            return true;
+        }
+        if (!global->is_mutable())
+            return fail(String::formatted("Global {} is immutable", index));
+        if (!pop(type))
+            return false;
+        emit(CompiledOpCode::GlobalSet, address.value());
+        return true;
+    }
+    case Instructions::table_get.value():
+    case Instructions::table_set.value():
+    case Instructions::table_size.value(): {
+        auto index = instruction.arguments().get<TableIndex>().value();
+        if (index >= m_module.tables().size())
+            return fail(String::formatted("Table index {} is out of bounds", index));
+        auto address = m_module.tables()[index];
+        auto* table = m_store.get(address);
+        if (!table)
+            return fail(String::formatted("Table {} doesn't exist", index));
+        auto type = table->type().element_type().kind();
+        if (instruction.opcode() == Instructions::table_get) {
+            if (!pop(Kind::I32))
+                return false;
+            emit(CompiledOpCode::TableGet, address.value());
+            push(type);
+        } else if (instruction.opcode() == Instructions::table_set) {
+            if (!pop(type) || !pop(Kind::I32))
+                return false;
+            emit(CompiledOpCode::TableSet, address.value());
+        } else {
+            emit(CompiledOpCode::TableSize, address.value());
+            push(Kind::I32);
+        }
+        return true;
+    }
+    case Instructions::ref_null.value():
+        emit(CompiledOpCode::Const, 0, Value::null_reference);
+        push(instruction.arguments().get<ValueType>().kind());
+        return true;
+    case Instructions::ref_is_null.value(): {
+        StackType type;
+        if (!pop(type))
+            return false;
+        if (type.has_value() && !ValueType { type.value() }.is_reference())
+            return fail("ref.is_null expects a reference");
+        emit(CompiledOpCode::RefIsNull);
+        push(Kind::I32);
+        return true;
+    }
+    case Instructions::ref_func.value(): {
+        auto index = instruction.arguments().get<FunctionIndex>();
+        if (!function_type(index))
+            return false;
+        emit(CompiledOpCode::Const, 0, m_module.functions()[index.value()].value());
+        push(Kind::FunctionReference);
+        return true;
+    }
+        LOAD(i32_load, I32, 4, Load32)
+        LOAD(i64_load, I64, 8, Load64)
+        LOAD(f32_load, F32, 4, Load32)
+        LOAD(f64_load, F64, 8, Load64)
+        LOAD(i32_load8_s, I32, 1, Load8S32)
+        LOAD(i32_load8_u, I32, 1, Load8U)
+        LOAD(i32_load16_s, I32, 2, Load16S32)
+        LOAD(i32_load16_u, I32, 2, Load16U)
+        LOAD(i64_load8_s, I64, 1, Load8S64)
+        LOAD(i64_load8_u, I64, 1, Load8U)
+        LOAD(i64_load16_s, I64, 2, Load16S64)
+        LOAD(i64_load16_u, I64, 2, Load16U)
+        LOAD(i64_load32_s, I64, 4, Load32S64)
+        LOAD(i64_load32_u, I64, 4, Load32)
+        STORE(i32_store, I32, 4, Store32)
+        STORE(i64_store, I64, 8, Store64)
+        STORE(f32_store, F32, 4, Store32)
+        STORE(f64_store, F64, 8, Store64)
+        STORE(i32_store8, I32, 1, Store8)
+        STORE(i32_store16, I32, 2, Store16)
+        STORE(i64_store8, I64, 1, Store8)
+        STORE(i64_store16, I64, 2, Store16)
+        STORE(i64_store32, I64, 4, Store32)
+    case Instructions::memory_size.value():
+    case Instructions::memory_grow.value():
+    case Instructions::memory_copy.value():
+    case Instructions::memory_fill.value():
+        if (m_module.memories().is_empty())
+            return fail("Memory instruction without a memory");
+        if (instruction.opcode() == Instructions::memory_size) {
+            emit(CompiledOpCode::MemorySize);
+            push(Kind::I32);
+            return true;
+        }
+        if (instruction.opcode() == Instructions::memory_grow)
+            return compile_unary(Kind::I32, Kind::I32, CompiledOpCode::MemoryGrow);
+        // memory.copy takes (destination, source, count), memory.fill (destination, value, count).
+        if (!pop(Kind::I32) || !pop(Kind::I32) || !pop(Kind::I32))
+            return false;
+        emit(instruction.opcode() == Instructions::memory_copy ? CompiledOpCode::MemoryCopy : CompiledOpCode::MemoryFill);
+        return true;
+    case Instructions::i32_const.value():
+        emit(CompiledOpCode::Const, 0, static_cast<u32>(instruction.arguments().get<i32>()));
+        push(Kind::I32);
+        return true;
+    case Instructions::i64_const.value():
+        emit(CompiledOpCode::Const, 0, static_cast<u64>(instruction.arguments().get<i64>()));
+        push(Kind::I64);
+        return true;
+    case Instructions::f32_const.value():
+        emit(CompiledOpCode::Const, 0, bit_cast<u32>(instruction.arguments().get<float>()));
+        push(Kind::F32);
+        return true;
+    case Instructions::f64_const.value():
+        emit(CompiledOpCode::Const, 0, bit_cast<u64>(instruction.arguments().get<double>()));
+        push(Kind::F64);
+        return true;
+        UNARY(i32_eqz, I32, I32, Eqz)
+        BINARY(i32_eq, I32, I32, Eq)
+        BINARY(i32_ne, I32, I32, Ne)
+        BINARY(i32_lts, I32, I32, I32LtS)
+        BINARY(i32_ltu, I32, I32, I32LtU)
+        BINARY(i32_gts, I32, I32, I32GtS)
+        BINARY(i32_gtu, I32, I32, I32GtU)
+        BINARY(i32_les, I32, I32, I32LeS)
+        BINARY(i32_leu, I32, I32, I32LeU)
+        BINARY(i32_ges, I32, I32, I32GeS)
+        BINARY(i32_geu, I32, I32, I32GeU)
+        UNARY(i64_eqz, I64, I32, Eqz)
+        BINARY(i64_eq, I64, I32, Eq)
+        BINARY(i64_ne, I64, I32, Ne)
+        BINARY(i64_lts, I64, I32, I64LtS)
+        BINARY(i64_ltu, I64, I32, I64LtU)
+        BINARY(i64_gts, I64, I32, I64GtS)
+        BINARY(i64_gtu, I64, I32, I64GtU)
+        BINARY(i64_les, I64, I32, I64LeS)
+        BINARY(i64_leu, I64, I32, I64LeU)
+        BINARY(i64_ges, I64, I32, I64GeS)
+        BINARY(i64_geu, I64, I32, I64GeU)
+        BINARY(f32_eq, F32, I32, F32Eq)
+        BINARY(f32_ne, F32, I32, F32Ne)
+        BINARY(f32_lt, F32, I32, F32Lt)
+        BINARY(f32_gt, F32, I32, F32Gt)
+        BINARY(f32_le, F32, I32, F32Le)
+        BINARY(f32_ge, F32, I32, F32Ge)
+        BINARY(f64_eq, F64, I32, F64Eq)
+        BINARY(f64_ne, F64, I32, F64Ne)
+        BINARY(f64_lt, F64, I32, F64Lt)
+        BINARY(f64_gt, F64, I32, F64Gt)
+        BINARY(f64_le, F64, I32, F64Le)
+        BINARY(f64_ge, F64, I32, F64Ge)
+        UNARY(i32_clz, I32, I32, I32Clz)
+        UNARY(i32_ctz, I32, I32, I32Ctz)
+        UNARY(i32_popcnt, I32, I32, I32Popcnt)
+        BINARY(i32_add, I32, I32, I32Add)
+        BINARY(i32_sub, I32, I32, I32Sub)
+        BINARY(i32_mul, I32, I32, I32Mul)
+        BINARY(i32_divs, I32, I32, I32DivS)
+        BINARY(i32_divu, I32, I32, I32DivU)
+        BINARY(i32_rems, I32, I32, I32RemS)
+        BINARY(i32_remu, I32, I32, I32RemU)
+        BINARY(i32_and, I32, I32, And)
+        BINARY(i32_or, I32, I32, Or)
+        BINARY(i32_xor, I32, I32, Xor)
+        BINARY(i32_shl, I32, I32, I32Shl)
+        BINARY(i32_shrs, I32, I32, I32ShrS)
+        BINARY(i32_shru, I32, I32, I32ShrU)
+        BINARY(i32_rotl, I32, I32, I32Rotl)
+        BINARY(i32_rotr, I32, I32, I32Rotr)
+        UNARY(i64_clz, I64, I64, I64Clz)
+        UNARY(i64_ctz, I64, I64, I64Ctz)
+        UNARY(i64_popcnt, I64, I64, I64Popcnt)
+        BINARY(i64_add, I64, I64, I64Add)
+        BINARY(i64_sub, I64, I64, I64Sub)
+        BINARY(i64_mul, I64, I64, I64Mul)
+        BINARY(i64_divs, I64, I64, I64DivS)
+        BINARY(i64_divu, I64, I64, I64DivU)
+        BINARY(i64_rems, I64, I64, I64RemS)
+        BINARY(i64_remu, I64, I64, I64RemU)
+        BINARY(i64_and, I64, I64, And)
+        BINARY(i64_or, I64, I64, Or)
+        BINARY(i64_xor, I64, I64, Xor)
+        BINARY(i64_shl, I64, I64, I64Shl)
+        BINARY(i64_shrs, I64, I64, I64ShrS)
+        BINARY(i64_shru, I64, I64, I64ShrU)
+        BINARY(i64_rotl, I64, I64, I64Rotl)
+        BINARY(i64_rotr, I64, I64, I64Rotr)
+        UNARY(f32_abs, F32, F32, F32Abs)
+        UNARY(f32_neg, F32, F32, F32Neg)
+        UNARY(f32_ceil, F32, F32, F32Ceil)
+        UNARY(f32_floor, F32, F32, F32Floor)
+        UNARY(f32_trunc, F32, F32, F32Trunc)
+        UNARY(f32_nearest, F32, F32, F32Nearest)
+        UNARY(f32_sqrt, F32, F32, F32Sqrt)
+        BINARY(f32_add, F32, F32, F32Add)
+        BINARY(f32_sub, F32, F32, F32Sub)
+        BINARY(f32_mul, F32, F32, F32Mul)
+        BINARY(f32_div, F32, F32, F32Div)
+        BINARY(f32_min, F32, F32, F32Min)
+        BINARY(f32_max, F32, F32, F32Max)
+        BINARY(f32_copysign, F32, F32, F32Copysign)
+        UNARY(f64_abs, F64, F64, F64Abs)
+        UNARY(f64_neg, F64, F64, F64Neg)
+        UNARY(f64_ceil, F64, F64, F64Ceil)
+        UNARY(f64_floor, F64, F64, F64Floor)
+        UNARY(f64_trunc, F64, F64, F64Trunc)
+        UNARY(f64_nearest, F64, F64, F64Nearest)
+        UNARY(f64_sqrt, F64, F64, F64Sqrt)
+        BINARY(f64_add, F64, F64, F64Add)
+        BINARY(f64_sub, F64, F64, F64Sub)
+        BINARY(f64_mul, F64, F64, F64Mul)
+        BINARY(f64_div, F64, F64, F64Div)
+        BINARY(f64_min, F64, F64, F64Min)
+        BINARY(f64_max, F64, F64, F64Max)
+        BINARY(f64_copysign, F64, F64, F64Copysign)
+        UNARY(i32_wrap_i64, I64, I32, I32WrapI64)
+        UNARY(i32_trunc_sf32, F32, I32, I32TruncF32S)
+        UNARY(i32_trunc_uf32, F32, I32, I32TruncF32U)
+        UNARY(i32_trunc_sf64, F64, I32, I32TruncF64S)
+        UNARY(i32_trunc_uf64, F64, I32, I32TruncF64U)
+        UNARY(i64_extend_si32, I32, I64, I64ExtendI32S)
+        NO_OP_CONVERSION(i64_extend_ui32, I32, I64)
+        UNARY(i64_trunc_sf32, F32, I64, I64TruncF32S)
+        UNARY(i64_trunc_uf32, F32, I64, I64TruncF32U)
+        UNARY(i64_trunc_sf64, F64, I64, I64TruncF64S)
+        UNARY(i64_trunc_uf64, F64, I64, I64TruncF64U)
+        UNARY(f32_convert_si32, I32, F32, F32ConvertI32S)
+        UNARY(f32_convert_ui32, I32, F32, F32ConvertI32U)
+        UNARY(f32_convert_si64, I64, F32, F32ConvertI64S)
+        UNARY(f32_convert_ui64, I64, F32, F32ConvertI64U)
+        UNARY(f32_demote_f64, F64, F32, F32DemoteF64)
+        UNARY(f64_convert_si32, I32, F64, F64ConvertI32S)
+        UNARY(f64_convert_ui32, I32, F64, F64ConvertI32U)
+        UNARY(f64_convert_si64, I64, F64, F64ConvertI64S)
+        UNARY(f64_convert_ui64, I64, F64, F64ConvertI64U)
+        UNARY(f64_promote_f32, F32, F64, F64PromoteF32)
+        NO_OP_CONVERSION(i32_reinterpret_f32, F32, I32)
+        NO_OP_CONVERSION(i64_reinterpret_f64, F64, I64)
+        NO_OP_CONVERSION(f32_reinterpret_i32, I32, F32)
+        NO_OP_CONVERSION(f64_reinterpret_i64, I64, F64)
+        UNARY(i32_trunc_sat_f32_s, F32, I32, I32TruncSatF32S)
+        UNARY(i32_trunc_sat_f32_u, F32, I32, I32TruncSatF32U)
+        UNARY(i32_trunc_sat_f64_s, F64, I32, I32TruncSatF64S)
+        UNARY(i32_trunc_sat_f64_u, F64, I32, I32TruncSatF64U)
+        UNARY(i64_trunc_sat_f32_s, F32, I64, I64TruncSatF32S)
+        UNARY(i64_trunc_sat_f32_u, F32, I64, I64TruncSatF32U)
+        UNARY(i64_trunc_sat_f64_s, F64, I64, I64TruncSatF64S)
+        UNARY(i64_trunc_sat_f64_u, F64, I64, I64TruncSatF64U)
+    }
+
+#undef UNARY
+#undef NO_OP_CONVERSION
+#undef BINARY
+#undef LOAD
+#undef STORE
+
+    // FIXME: Implement the bulk memory and table instructions that need passive segments or growable tables.
+    return fail(String::formatted("Instruction {:#x} is not supported", instruction.opcode().value()));
+}
+
+}
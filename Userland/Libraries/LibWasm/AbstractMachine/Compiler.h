@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Result.h>
+#include <LibWasm/AbstractMachine/AbstractMachine.h>
+#include <LibWasm/AbstractMachine/CompiledCode.h>
+
+namespace Wasm {
+
+struct ValidationError {
+    String error { "Unknown error" };
+};
+using CompilationResult = AK::Result<NonnullOwnPtr<CompiledCode>, ValidationError>;
+
+// Validates a function body and lowers it into the form the interpreter runs.
+// Structured control flow turns into jumps to precomputed addresses, and since the operand stack height is known
+// statically at every instruction, each branch knows where its results go without looking for labels at runtime.
+class Compiler {
+public:
+    Compiler(Store& store, const ModuleInstance& module)
+        : m_store(store)
+        , m_module(module)
+    {
+    }
+
+    CompilationResult compile(const FunctionType&, const Vector<ValueType>& locals, const Expression&);
+
+private:
+    // An empty type is the "unknown" type that pops out of an unreachable stack.
+    using StackType = Optional<ValueType::Kind>;
+
+    struct ControlFrame {
+        explicit ControlFrame(OpCode opcode, Vector<ValueType> parameters = {}, Vector<ValueType> results = {})
+            : opcode(opcode)
+            , parameters(move(parameters))
+            , results(move(results))
+        {
+        }
+
+        OpCode opcode;
+        Vector<ValueType> parameters;
+        Vector<ValueType> results;
+        size_t height { 0 };
+        bool unreachable { false };
+        size_t loop_address { 0 };
+        Optional<size_t> else_fixup;
+        Vector<size_t> jump_fixups;
+        Vector<size_t> branch_target_fixups;
+
+        const Vector<ValueType>& label_types() const { return opcode == Instructions::loop ? parameters : results; }
+    };
+
+    bool compile(const Instruction&);
+    bool compile_block(const Instruction&);
+    bool compile_else();
+    bool compile_end();
+    bool compile_branch(LabelIndex, bool is_conditional);
+    bool compile_branch_table(const Instruction::TableBranchArgs&);
+    bool compile_call(const FunctionType&, CompiledOpCode, u32 a, u64 b = 0);
+    bool compile_load(const Instruction&, ValueType::Kind, size_t size, CompiledOpCode);
+    bool compile_store(const Instruction&, ValueType::Kind, size_t size, CompiledOpCode);
+    bool compile_unary(ValueType::Kind operand, ValueType::Kind result, Optional<CompiledOpCode>);
+    bool compile_binary(ValueType::Kind operand, ValueType::Kind result, CompiledOpCode);
+    bool finish_function();
+
+    BranchTarget branch_target_for(ControlFrame&, size_t table_index);
+    void patch_fixups(ControlFrame&, size_t address);
+
+    size_t emit(CompiledOpCode, u32 a = 0, u64 b = 0);
+    size_t current_address() const { return m_code->instructions.size(); }
+    size_t height() const { return m_locals.size() + m_operands.size(); }
+
+    void push(StackType);
+    void push(const Vector<ValueType>&);
+    bool pop(StackType&);
+    bool pop(ValueType::Kind);
+    bool pop(const Vector<ValueType>&);
+    bool check_frame_end(const ControlFrame&);
+    void set_unreachable();
+
+    bool block_type_signature(const BlockType&, Vector<ValueType>& parameters, Vector<ValueType>& results);
+    const FunctionType* function_type(FunctionIndex);
+    bool fail(String);
+
+    Store& m_store;
+    const ModuleInstance& m_module;
+    OwnPtr<CompiledCode> m_code;
+    Vector<ValueType> m_locals;
+    Vector<StackType> m_operands;
+    Vector<ControlFrame> m_frames;
+    String m_error;
+};
+
+}
@@ -4,21 +4,22 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <LibWasm/AbstractMachine/Compiler.h>
 #include <LibWasm/AbstractMachine/Configuration.h>
 #include <LibWasm/AbstractMachine/Interpreter.h>
 
 namespace Wasm {
 
-Optional<Label> Configuration::nth_label(size_t i)
+static constexpr size_t initial_value_stack_size = 4 * KiB;
+
+bool Configuration::ensure_value_stack_size(size_t size)
 {
-    for (auto& entry : m_stack.entries()) {
-        if (auto ptr = entry.get_pointer<NonnullOwnPtr<Label>>()) {
-            if (i == 0)
-                return **ptr;
-            --i;
-        }
-    }
-    return {};
+    if (size <= m_value_stack.size())
+        return true;
+    if (size > max_value_stack_size)
+        return false;
+    m_value_stack.resize(min(max(size, max(m_value_stack.size() * 2, initial_value_stack_size)), max_value_stack_size));
+    return true;
 }
 
 Result Configuration::call(FunctionAddress address, Vector<Value> arguments)
@@ -27,51 +28,54 @@ Result Configuration::call(FunctionAddress address, Vector<Value> arguments)
     if (!function)
         return Trap {};
     if (auto* wasm_function = function->get_pointer<WasmFunction>()) {
-        Vector<Value> locals;
-        locals.ensure_capacity(arguments.size() + wasm_function->code().locals().size());
-        for (auto& value : arguments)
-            locals.append(Value { value });
-        for (auto& type : wasm_function->code().locals())
-            locals.empend(type, 0ull);
-
-        auto frame = make<Frame>(
-            wasm_function->module(),
-            move(locals),
-            wasm_function->code().body(),
-            wasm_function->type().results().size());
+        auto& parameters = wasm_function->type().parameters();
+        if (arguments.size() != parameters.size())
+            return Trap {};
+        for (size_t i = 0; i < arguments.size(); ++i) {
+            if (arguments[i].type().kind() != parameters[i].kind())
+                return Trap {};
+        }
 
-        set_frame(move(frame));
-        return execute();
+        auto* code = wasm_function->compiled_code();
+        if (!code)
+            return Trap {};
+        return execute(*code, wasm_function->type().results(), arguments);
     }
 
     // It better be a host function, else something is really wrong.
     auto& host_function = function->get<HostFunction>();
     auto result = bit_cast<HostFunctionType>(host_function.ptr())(m_store, arguments);
-    auto count = host_function.type().results().size();
-    if (count == 0)
+    if (host_function.type().results().is_empty())
         return Result { Vector<Value> {} };
-    if (count == 1)
-        return Result { Vector<Value> { Value { host_function.type().results().first(), result } } };
-    TODO();
+    return Result { Vector<Value> { Value { host_function.type().results().first(), result } } };
 }
 
-Result Configuration::execute()
+Result Configuration::execute(const ModuleInstance& module, const Expression& expression, ValueType result_type)
 {
-    Interpreter interpreter;
-    interpreter.interpret(*this);
+    FunctionType type { {}, { result_type } };
+    Compiler compiler { m_store, module };
+    auto code = compiler.compile(type, {}, expression);
+    if (code.is_error())
+        return Trap {};
+    return execute(*code.value(), type.results(), {});
+}
+
+Result Configuration::execute(const CompiledCode& code, const Vector<ValueType>& result_types, const Vector<Value>& arguments)
+{
+    if (!ensure_value_stack_size(code.max_stack_height))
+        return Trap {};
+    for (size_t i = 0; i < arguments.size(); ++i)
+        m_value_stack[i] = arguments[i].to_raw();
 
-    Vector<NonnullOwnPtr<Value>> results;
-    for (size_t i = 0; i < m_current_frame->arity(); ++i)
-        results.append(move(stack().pop().get<NonnullOwnPtr<Value>>()));
-    auto label = stack().pop();
-    // ASSERT: label == current frame
-    if (!label.has<NonnullOwnPtr<Label>>())
+    Interpreter interpreter;
+    if (!interpreter.interpret(*this, code, 0))
         return Trap {};
-    Vector<Value> results_moved;
-    results_moved.ensure_capacity(results.size());
-    for (auto& entry : results)
-        results_moved.unchecked_append(move(*entry));
-    return Result { move(results_moved) };
+
+    Vector<Value> results;
+    results.ensure_capacity(result_types.size());
+    for (size_t i = 0; i < result_types.size(); ++i)
+        results.unchecked_append(Value::from_raw(result_types[i], m_value_stack[i]));
+    return Result { move(results) };
 }
 
 }
@@ -12,38 +12,44 @@ namespace Wasm {
 
 typedef u64 (*HostFunctionType)(Store&, Vector<Value>&);
 
+struct CallFrame {
+    const CompiledCode* code { nullptr };
+    const CompiledInstruction* return_address { nullptr };
+    size_t base { 0 };
+};
+
 class Configuration {
 public:
+    // Both limits are there to turn runaway recursion into a trap.
+    static constexpr size_t max_call_depth = 64 * KiB;
+    static constexpr size_t max_value_stack_size = 1 * MiB;
+
     explicit Configuration(Store& store)
         : m_store(store)
     {
     }
 
-    Optional<Label> nth_label(size_t);
-    void set_frame(NonnullOwnPtr<Frame> frame)
-    {
-        m_current_frame = frame.ptr();
-        m_stack.push(move(frame));
-        m_stack.push(make<Label>(m_current_frame->expression().instructions().size() - 1));
-    }
-    auto& frame() const { return m_current_frame; }
-    auto& frame() { return m_current_frame; }
-    auto& ip() const { return m_ip; }
-    auto& ip() { return m_ip; }
-    auto& depth() const { return m_depth; }
-    auto& depth() { return m_depth; }
-    auto& stack() const { return m_stack; }
-    auto& stack() { return m_stack; }
+    auto& store() const { return m_store; }
+    auto& store() { return m_store; }
+    auto& value_stack() const { return m_value_stack; }
+    auto& value_stack() { return m_value_stack; }
+    auto& call_frames() const { return m_call_frames; }
+    auto& call_frames() { return m_call_frames; }
+
+    // Makes sure the value stack holds at least the given number of slots, and reports whether it could.
+    bool ensure_value_stack_size(size_t);
 
     Result call(FunctionAddress, Vector<Value> arguments);
-    Result execute();
+
+    // Evaluates a constant expression, such as a global's initializer or a segment's offset.
+    Result execute(const ModuleInstance&, const Expression&, ValueType result_type);
 
 private:
+    Result execute(const CompiledCode&, const Vector<ValueType>& result_types, const Vector<Value>& arguments);
+
     Store& m_store;
-    Frame* m_current_frame { nullptr };
-    Stack m_stack;
-    size_t m_depth { 0 };
-    InstructionPointer m_ip;
+    Vector<u64> m_value_stack;
+    Vector<CallFrame> m_call_frames;
 };
 
 }
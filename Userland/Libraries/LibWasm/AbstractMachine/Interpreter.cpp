@@ -4,20 +4,710 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/BitCast.h>
 #include <LibWasm/AbstractMachine/AbstractMachine.h>
 #include <LibWasm/AbstractMachine/Configuration.h>
 #include <LibWasm/AbstractMachine/Interpreter.h>
-#include <LibWasm/Opcode.h>
+#include <math.h>
 
 namespace Wasm {
 
-void Interpreter::interpret(Configuration& configuration)
+// Reading and writing typed values from and to the untagged value stack.
+template<typename T>
+ALWAYS_INLINE static T as(u64 raw)
 {
-    // FIXME: Interpret stuff
-    dbgln("FIXME: Interpret stuff!");
-    // Push some dummy values
-    for (size_t i = 0; i < configuration.frame()->arity(); ++i)
-        configuration.stack().push(make<Value>(0));
+    if constexpr (IsSame<T, float>)
+        return bit_cast<float>(static_cast<u32>(raw));
+    else if constexpr (IsSame<T, double>)
+        return bit_cast<double>(raw);
+    else
+        return static_cast<T>(raw);
+}
+
+template<typename T>
+ALWAYS_INLINE static u64 to_raw(T value)
+{
+    if constexpr (IsSame<T, bool>)
+        return value ? 1 : 0;
+    else if constexpr (IsSame<T, float>)
+        return bit_cast<u32>(value);
+    else if constexpr (IsSame<T, double>)
+        return bit_cast<u64>(value);
+    else if constexpr (sizeof(T) <= sizeof(u32))
+        return static_cast<u32>(value);
+    else
+        return static_cast<u64>(value);
+}
+
+template<typename T>
+static T count_leading_zeroes(T value)
+{
+    if (value == 0)
+        return sizeof(T) * 8;
+    if constexpr (sizeof(T) == sizeof(u64))
+        return __builtin_clzll(value);
+    else
+        return __builtin_clz(value);
+}
+
+template<typename T>
+static T count_trailing_zeroes(T value)
+{
+    if (value == 0)
+        return sizeof(T) * 8;
+    if constexpr (sizeof(T) == sizeof(u64))
+        return __builtin_ctzll(value);
+    else
+        return __builtin_ctz(value);
+}
+
+template<typename T>
+static T population_count(T value)
+{
+    if constexpr (sizeof(T) == sizeof(u64))
+        return __builtin_popcountll(value);
+    else
+        return __builtin_popcount(value);
+}
+
+template<typename T>
+static T rotate_left(T value, T count)
+{
+    constexpr T bits = sizeof(T) * 8;
+    count &= bits - 1;
+    if (count == 0)
+        return value;
+    return (value << count) | (value >> (bits - count));
+}
+
+template<typename T>
+static T rotate_right(T value, T count)
+{
+    constexpr T bits = sizeof(T) * 8;
+    count &= bits - 1;
+    if (count == 0)
+        return value;
+    return (value >> count) | (value << (bits - count));
+}
+
+// Unlike fmin() and fmax(), these return NaN if either operand is NaN, and order -0 before +0.
+template<typename T>
+static T minimum(T lhs, T rhs)
+{
+    if (__builtin_isnan(lhs) || __builtin_isnan(rhs))
+        return lhs + rhs;
+    if (lhs == rhs)
+        return __builtin_signbit(lhs) ? lhs : rhs;
+    return lhs < rhs ? lhs : rhs;
+}
+
+template<typename T>
+static T maximum(T lhs, T rhs)
+{
+    if (__builtin_isnan(lhs) || __builtin_isnan(rhs))
+        return lhs + rhs;
+    if (lhs == rhs)
+        return __builtin_signbit(lhs) ? rhs : lhs;
+    return lhs > rhs ? lhs : rhs;
+}
+
+// Every float and every integer limit we compare against is exactly representable as a double,
+// so truncating in double precision gives the exact answer for all conversions.
+template<typename To, typename From>
+static bool truncate(From value, To& result)
+{
+    if (__builtin_isnan(value))
+        return false;
+    auto truncated = trunc(static_cast<double>(value));
+    if (truncated < static_cast<double>(NumericLimits<To>::min()) || truncated >= static_cast<double>(NumericLimits<To>::max()) + 1.0)
+        return false;
+    result = static_cast<To>(truncated);
+    return true;
+}
+
+template<typename To, typename From>
+static To saturating_truncate(From value)
+{
+    if (__builtin_isnan(value))
+        return 0;
+    auto truncated = trunc(static_cast<double>(value));
+    if (truncated < static_cast<double>(NumericLimits<To>::min()))
+        return NumericLimits<To>::min();
+    if (truncated >= static_cast<double>(NumericLimits<To>::max()) + 1.0)
+        return NumericLimits<To>::max();
+    return static_cast<To>(truncated);
+}
+
+static u64 reference_to_raw(const Optional<Reference>& reference)
+{
+    if (!reference.has_value())
+        return Value::null_reference;
+    if (auto* function = reference->ref().get_pointer<Reference::Func>())
+        return function->address.value();
+    if (auto* extern_ = reference->ref().get_pointer<Reference::Extern>())
+        return extern_->address.value();
+    return Value::null_reference;
+}
+
+static Reference reference_from_raw(ValueType type, u64 raw)
+{
+    if (raw == Value::null_reference)
+        return Reference { Reference::Null { type } };
+    if (type.kind() == ValueType::FunctionReference)
+        return Reference { Reference::Func { FunctionAddress { raw } } };
+    return Reference { Reference::Extern { ExternAddress { raw } } };
+}
+
+static bool types_match(const FunctionType& a, const FunctionType& b)
+{
+    if (&a == &b)
+        return true;
+    auto kinds_match = [](auto& a, auto& b) {
+        if (a.size() != b.size())
+            return false;
+        for (size_t i = 0; i < a.size(); ++i) {
+            if (a[i].kind() != b[i].kind())
+                return false;
+        }
+        return true;
+    };
+    return kinds_match(a.parameters(), b.parameters()) && kinds_match(a.results(), b.results());
+}
+
+// Pops the arguments off the value stack and pushes the result back, Store::allocate() makes sure there is at most one.
+static void call_host_function(Store& store, const HostFunction& function, u64*& sp)
+{
+    auto& type = function.type();
+    VERIFY(type.results().size() <= 1);
+    sp -= type.parameters().size();
+    Vector<Value> arguments;
+    arguments.ensure_capacity(type.parameters().size());
+    for (size_t i = 0; i < type.parameters().size(); ++i)
+        arguments.unchecked_append(Value::from_raw(type.parameters()[i], sp[i]));
+    auto result = bit_cast<HostFunctionType>(function.ptr())(store, arguments);
+    if (!type.results().is_empty())
+        *sp++ = Value { type.results().first(), result }.to_raw();
+}
+
+bool Interpreter::interpret(Configuration& configuration, const CompiledCode& entry_code, size_t base)
+{
+    // This is a token-threaded interpreter: every handler jumps straight to the next one through this table,
+    // which gives the branch predictor a separate indirect jump per handler to learn from.
+    static void* const handlers[] = {
+#define __ENUMERATE_COMPILED_OPCODE(name) &&handle_##name,
+        ENUMERATE_COMPILED_OPCODES(__ENUMERATE_COMPILED_OPCODE)
+#undef __ENUMERATE_COMPILED_OPCODE
+    };
+
+    auto& store = configuration.store();
+    auto& value_stack = configuration.value_stack();
+    auto& call_frames = configuration.call_frames();
+    auto entry_depth = call_frames.size();
+
+    auto* code = &entry_code;
+    auto* ip = code->instructions.data();
+    auto* fp = value_stack.data() + base;
+    auto* sp = fp + code->parameter_count;
+    for (auto i = code->parameter_count; i < code->local_count; ++i)
+        *sp++ = 0;
+
+    // The current module's memory, refreshed whenever the module or the memory's size could have changed.
+    MemoryInstance* memory = nullptr;
+    u8* memory_data = nullptr;
+    u64 memory_size = 0;
+    auto refresh_memory = [&] {
+        auto& memories = code->module->memories();
+        memory = memories.is_empty() ? nullptr : store.get(memories.first());
+        memory_data = memory ? memory->data().data() : nullptr;
+        memory_size = memory ? memory->size() : 0;
+    };
+    refresh_memory();
+
+    const CompiledCode* callee = nullptr;
+
+#define DISPATCH() goto* handlers[static_cast<u32>(ip->opcode)]
+#define NEXT()      \
+    do {            \
+        ++ip;       \
+        DISPATCH(); \
+    } while (0)
+#define HANDLER(name) handle_##name:
+#define JUMP_TO(address)                            \
+    do {                                            \
+        ip = code->instructions.data() + (address); \
+        DISPATCH();                                 \
+    } while (0)
+
+    DISPATCH();
+
+    HANDLER(Unreachable)
+    {
+        goto trap;
+    }
+
+    HANDLER(Jump)
+    {
+        JUMP_TO(ip->a);
+    }
+
+    HANDLER(JumpIfZero)
+    {
+        if (*--sp == 0)
+            JUMP_TO(ip->a);
+        NEXT();
+    }
+
+    HANDLER(JumpIfNotZero)
+    {
+        if (*--sp != 0)
+            JUMP_TO(ip->a);
+        NEXT();
+    }
+
+    HANDLER(Branch)
+    {
+        // Results move down over whatever the block left on the stack below them.
+        auto arity = ip->b >> 32;
+        auto* destination = fp + static_cast<u32>(ip->b);
+        for (size_t i = 0; i < arity; ++i)
+            destination[i] = sp[i - arity];
+        sp = destination + arity;
+        JUMP_TO(ip->a);
+    }
+
+    HANDLER(BranchIf)
+    {
+        if (*--sp != 0)
+            goto handle_Branch;
+        NEXT();
+    }
+
+    HANDLER(BranchTable)
+    {
+        auto index = min<u64>(static_cast<u32>(*--sp), ip->b);
+        auto& target = code->branch_targets[ip->a + index];
+        auto* destination = fp + target.height;
+        for (size_t i = 0; i < target.arity; ++i)
+            destination[i] = sp[i - target.arity];
+        sp = destination + target.arity;
+        JUMP_TO(target.address);
+    }
+
+    HANDLER(Return)
+    {
+        auto arity = ip->a;
+        for (size_t i = 0; i < arity; ++i)
+            fp[i] = sp[i - arity];
+        sp = fp + arity;
+        if (call_frames.size() == entry_depth)
+            return true;
+        auto frame = call_frames.take_last();
+        code = frame.code;
+        ip = frame.return_address;
+        fp = value_stack.data() + frame.base;
+        refresh_memory();
+        DISPATCH();
+    }
+
+    HANDLER(Call)
+    {
+        auto* function = store.get(FunctionAddress { ip->a });
+        if (auto* wasm_function = function->get_pointer<WasmFunction>()) {
+            callee = wasm_function->compiled_code();
+            goto call;
+        }
+        call_host_function(store, function->get<HostFunction>(), sp);
+        refresh_memory();
+        NEXT();
+    }
+
+    HANDLER(CallIndirect)
+    {
+        auto index = static_cast<u32>(*--sp);
+        auto* table = store.get(TableAddress { ip->b });
+        if (index >= table->elements().size())
+            goto trap;
+        auto raw_reference = reference_to_raw(table->elements()[index]);
+        if (raw_reference == Value::null_reference)
+            goto trap;
+        auto* function = store.get(FunctionAddress { raw_reference });
+        if (!function)
+            goto trap;
+        auto& expected_type = code->module->types()[ip->a];
+        if (auto* wasm_function = function->get_pointer<WasmFunction>()) {
+            if (!types_match(wasm_function->type(), expected_type))
+                goto trap;
+            callee = wasm_function->compiled_code();
+            goto call;
+        }
+        auto& host_function = function->get<HostFunction>();
+        if (!types_match(host_function.type(), expected_type))
+            goto trap;
+        call_host_function(store, host_function, sp);
+        refresh_memory();
+        NEXT();
+    }
+
+    HANDLER(Drop)
+    {
+        --sp;
+        NEXT();
+    }
+
+    HANDLER(Select)
+    {
+        auto condition = sp[-1];
+        sp -= 2;
+        if (condition == 0)
+            sp[-1] = sp[0];
+        NEXT();
+    }
+
+    HANDLER(Const)
+    {
+        *sp++ = ip->b;
+        NEXT();
+    }
+
+    HANDLER(LocalGet)
+    {
+        *sp++ = fp[ip->a];
+        NEXT();
+    }
+
+    HANDLER(LocalSet)
+    {
+        fp[ip->a] = *--sp;
+        NEXT();
+    }
+
+    HANDLER(LocalTee)
+    {
+        fp[ip->a] = sp[-1];
+        NEXT();
+    }
+
+    HANDLER(GlobalGet)
+    {
+        *sp++ = store.get(GlobalAddress { ip->a })->value().to_raw();
+        NEXT();
+    }
+
+    HANDLER(GlobalSet)
+    {
+        auto* global = store.get(GlobalAddress { ip->a });
+        global->set_value(Value::from_raw(global->value().type(), *--sp));
+        NEXT();
+    }
+
+    HANDLER(TableGet)
+    {
+        auto& elements = store.get(TableAddress { ip->a })->elements();
+        auto index = static_cast<u32>(sp[-1]);
+        if (index >= elements.size())
+            goto trap;
+        sp[-1] = reference_to_raw(elements[index]);
+        NEXT();
+    }
+
+    HANDLER(TableSet)
+    {
+        auto* table = store.get(TableAddress { ip->a });
+        auto index = static_cast<u32>(sp[-2]);
+        auto value = sp[-1];
+        sp -= 2;
+        if (index >= table->elements().size())
+            goto trap;
+        table->elements()[index] = reference_from_raw(table->type().element_type(), value);
+        NEXT();
+    }
+
+    HANDLER(TableSize)
+    {
+        *sp++ = store.get(TableAddress { ip->a })->elements().size();
+        NEXT();
+    }
+
+    HANDLER(RefIsNull)
+    {
+        sp[-1] = sp[-1] == Value::null_reference;
+        NEXT();
+    }
+
+    // The effective address is computed in 64 bits, so adding the static offset can't overflow.
+#define LOAD(name, type, result_type)                                      \
+    HANDLER(name)                                                          \
+    {                                                                      \
+        auto address = static_cast<u64>(static_cast<u32>(sp[-1])) + ip->a; \
+        if (address + sizeof(type) > memory_size)                          \
+            goto trap;                                                     \
+        type value;                                                        \
+        __builtin_memcpy(&value, memory_data + address, sizeof(type));     \
+        sp[-1] = to_raw(static_cast<result_type>(value));                  \
+        NEXT();                                                            \
+    }
+
+    LOAD(Load8S32, i8, i32)
+    LOAD(Load8S64, i8, i64)
+    LOAD(Load8U, u8, u64)
+    LOAD(Load16S32, i16, i32)
+    LOAD(Load16S64, i16, i64)
+    LOAD(Load16U, u16, u64)
+    LOAD(Load32S64, i32, i64)
+    LOAD(Load32, u32, u32)
+    LOAD(Load64, u64, u64)
+#undef LOAD
+
+#define STORE(name, type)                                                  \
+    HANDLER(name)                                                          \
+    {                                                                      \
+        auto value = static_cast<type>(sp[-1]);                            \
+        auto address = static_cast<u64>(static_cast<u32>(sp[-2])) + ip->a; \
+        sp -= 2;                                                           \
+        if (address + sizeof(type) > memory_size)                          \
+            goto trap;                                                     \
+        __builtin_memcpy(memory_data + address, &value, sizeof(type));     \
+        NEXT();                                                            \
+    }
+
+    STORE(Store8, u8)
+    STORE(Store16, u16)
+    STORE(Store32, u32)
+    STORE(Store64, u64)
+#undef STORE
+
+    HANDLER(MemorySize)
+    {
+        *sp++ = memory_size / MemoryInstance::page_size;
+        NEXT();
+    }
+
+    HANDLER(MemoryGrow)
+    {
+        auto old_pages = memory_size / MemoryInstance::page_size;
+        if (memory->grow(static_cast<u32>(sp[-1])))
+            sp[-1] = old_pages;
+        else
+            sp[-1] = static_cast<u32>(-1);
+        refresh_memory();
+        NEXT();
+    }
+
+    HANDLER(MemoryCopy)
+    {
+        auto count = static_cast<u32>(sp[-1]);
+        auto source = static_cast<u32>(sp[-2]);
+        auto destination = static_cast<u32>(sp[-3]);
+        sp -= 3;
+        if (static_cast<u64>(source) + count > memory_size || static_cast<u64>(destination) + count > memory_size)
+            goto trap;
+        __builtin_memmove(memory_data + destination, memory_data + source, count);
+        NEXT();
+    }
+
+    HANDLER(MemoryFill)
+    {
+        auto count = static_cast<u32>(sp[-1]);
+        auto value = static_cast<u8>(sp[-2]);
+        auto destination = static_cast<u32>(sp[-3]);
+        sp -= 3;
+        if (static_cast<u64>(destination) + count > memory_size)
+            goto trap;
+        __builtin_memset(memory_data + destination, value, count);
+        NEXT();
+    }
+
+#define UNARY(name, type, expression)    \
+    HANDLER(name)                        \
+    {                                    \
+        auto operand = as<type>(sp[-1]); \
+        sp[-1] = to_raw(expression);     \
+        NEXT();                          \
+    }
+
+#define BINARY(name, type, expression) \
+    HANDLER(name)                      \
+    {                                  \
+        auto lhs = as<type>(sp[-2]);   \
+        auto rhs = as<type>(sp[-1]);   \
+        sp[-2] = to_raw(expression);   \
+        --sp;                          \
+        NEXT();                        \
+    }
+
+    // Since i32 values are zero-extended, these work on the raw bits of both integer types.
+    UNARY(Eqz, u64, operand == 0)
+    BINARY(Eq, u64, lhs == rhs)
+    BINARY(Ne, u64, lhs != rhs)
+    BINARY(And, u64, lhs & rhs)
+    BINARY(Or, u64, lhs | rhs)
+    BINARY(Xor, u64, lhs ^ rhs)
+
+#define INTEGER_OPERATIONS(prefix, signed_type, unsigned_type, bits)                                    \
+    BINARY(prefix##LtS, signed_type, lhs < rhs)                                                         \
+    BINARY(prefix##LtU, unsigned_type, lhs < rhs)                                                       \
+    BINARY(prefix##GtS, signed_type, lhs > rhs)                                                         \
+    BINARY(prefix##GtU, unsigned_type, lhs > rhs)                                                       \
+    BINARY(prefix##LeS, signed_type, lhs <= rhs)                                                        \
+    BINARY(prefix##LeU, unsigned_type, lhs <= rhs)                                                      \
+    BINARY(prefix##GeS, signed_type, lhs >= rhs)                                                        \
+    BINARY(prefix##GeU, unsigned_type, lhs >= rhs)                                                      \
+    UNARY(prefix##Clz, unsigned_type, count_leading_zeroes(operand))                                    \
+    UNARY(prefix##Ctz, unsigned_type, count_trailing_zeroes(operand))                                   \
+    UNARY(prefix##Popcnt, unsigned_type, population_count(operand))                                     \
+    BINARY(prefix##Add, unsigned_type, static_cast<unsigned_type>(lhs + rhs))                           \
+    BINARY(prefix##Sub, unsigned_type, static_cast<unsigned_type>(lhs - rhs))                           \
+    BINARY(prefix##Mul, unsigned_type, static_cast<unsigned_type>(lhs * rhs))                           \
+    BINARY(prefix##Shl, unsigned_type, static_cast<unsigned_type>(lhs << (rhs & (bits - 1))))           \
+    BINARY(prefix##ShrS, signed_type, static_cast<signed_type>(lhs >> (rhs & (bits - 1))))              \
+    BINARY(prefix##ShrU, unsigned_type, static_cast<unsigned_type>(lhs >> (rhs & (bits - 1))))          \
+    BINARY(prefix##Rotl, unsigned_type, rotate_left(lhs, rhs))                                          \
+    BINARY(prefix##Rotr, unsigned_type, rotate_right(lhs, rhs))                                         \
+    HANDLER(prefix##DivS)                                                                               \
+    {                                                                                                   \
+        auto lhs = as<signed_type>(sp[-2]);                                                             \
+        auto rhs = as<signed_type>(sp[-1]);                                                             \
+        if (rhs == 0 || (lhs == NumericLimits<signed_type>::min() && rhs == -1))                        \
+            goto trap;                                                                                  \
+        sp[-2] = to_raw(static_cast<signed_type>(lhs / rhs));                                           \
+        --sp;                                                                                           \
+        NEXT();                                                                                         \
+    }                                                                                                   \
+    HANDLER(prefix##DivU)                                                                               \
+    {                                                                                                   \
+        auto lhs = as<unsigned_type>(sp[-2]);                                                           \
+        auto rhs = as<unsigned_type>(sp[-1]);                                                           \
+        if (rhs == 0)                                                                                   \
+            goto trap;                                                                                  \
+        sp[-2] = to_raw(static_cast<unsigned_type>(lhs / rhs));                                         \
+        --sp;                                                                                           \
+        NEXT();                                                                                         \
+    }                                                                                                   \
+    HANDLER(prefix##RemS)                                                                               \
+    {                                                                                                   \
+        auto lhs = as<signed_type>(sp[-2]);                                                             \
+        auto rhs = as<signed_type>(sp[-1]);                                                             \
+        if (rhs == 0)                                                                                   \
+            goto trap;                                                                                  \
+        sp[-2] = to_raw(rhs == -1 ? static_cast<signed_type>(0) : static_cast<signed_type>(lhs % rhs)); \
+        --sp;                                                                                           \
+        NEXT();                                                                                         \
+    }                                                                                                   \
+    HANDLER(prefix##RemU)                                                                               \
+    {                                                                                                   \
+        auto lhs = as<unsigned_type>(sp[-2]);                                                           \
+        auto rhs = as<unsigned_type>(sp[-1]);                                                           \
+        if (rhs == 0)                                                                                   \
+            goto trap;                                                                                  \
+        sp[-2] = to_raw(static_cast<unsigned_type>(lhs % rhs));                                         \
+        --sp;                                                                                           \
+        NEXT();                                                                                         \
+    }
+
+    INTEGER_OPERATIONS(I32, i32, u32, 32)
+    INTEGER_OPERATIONS(I64, i64, u64, 64)
+#undef INTEGER_OPERATIONS
+
+    // Sign manipulation works on the bits, so that NaN payloads are left alone.
+#define FLOAT_OPERATIONS(prefix, type, bits_type, sign_bit, ceil, floor, trunc, nearbyint, sqrt) \
+    BINARY(prefix##Eq, type, lhs == rhs)                                                         \
+    BINARY(prefix##Ne, type, lhs != rhs)                                                         \
+    BINARY(prefix##Lt, type, lhs < rhs)                                                          \
+    BINARY(prefix##Gt, type, lhs > rhs)                                                          \
+    BINARY(prefix##Le, type, lhs <= rhs)                                                         \
+    BINARY(prefix##Ge, type, lhs >= rhs)                                                         \
+    UNARY(prefix##Abs, bits_type, static_cast<bits_type>(operand & ~(sign_bit)))                 \
+    UNARY(prefix##Neg, bits_type, static_cast<bits_type>(operand ^ (sign_bit)))                  \
+    UNARY(prefix##Ceil, type, ceil(operand))                                                     \
+    UNARY(prefix##Floor, type, floor(operand))                                                   \
+    UNARY(prefix##Trunc, type, trunc(operand))                                                   \
+    UNARY(prefix##Nearest, type, nearbyint(operand))                                             \
+    UNARY(prefix##Sqrt, type, sqrt(operand))                                                     \
+    BINARY(prefix##Add, type, lhs + rhs)                                                         \
+    BINARY(prefix##Sub, type, lhs - rhs)                                                         \
+    BINARY(prefix##Mul, type, lhs * rhs)                                                         \
+    BINARY(prefix##Div, type, lhs / rhs)                                                         \
+    BINARY(prefix##Min, type, minimum(lhs, rhs))                                                 \
+    BINARY(prefix##Max, type, maximum(lhs, rhs))                                                 \
+    BINARY(prefix##Copysign, bits_type, static_cast<bits_type>((lhs & ~(sign_bit)) | (rhs & (sign_bit))))
+
+    FLOAT_OPERATIONS(F32, float, u32, 0x80000000u, ceilf, floorf, truncf, nearbyintf, sqrtf)
+    FLOAT_OPERATIONS(F64, double, u64, 0x8000000000000000ull, ceil, floor, trunc, nearbyint, sqrt)
+#undef FLOAT_OPERATIONS
+
+#define TRUNCATE(name, from, to)                 \
+    HANDLER(name)                                \
+    {                                            \
+        to result {};                            \
+        if (!truncate(as<from>(sp[-1]), result)) \
+            goto trap;                           \
+        sp[-1] = to_raw(result);                 \
+        NEXT();                                  \
+    }
+
+    UNARY(I32WrapI64, u64, static_cast<u32>(operand))
+    TRUNCATE(I32TruncF32S, float, i32)
+    TRUNCATE(I32TruncF32U, float, u32)
+    TRUNCATE(I32TruncF64S, double, i32)
+    TRUNCATE(I32TruncF64U, double, u32)
+    UNARY(I64ExtendI32S, i32, static_cast<i64>(operand))
+    TRUNCATE(I64TruncF32S, float, i64)
+    TRUNCATE(I64TruncF32U, float, u64)
+    TRUNCATE(I64TruncF64S, double, i64)
+    TRUNCATE(I64TruncF64U, double, u64)
+    UNARY(F32ConvertI32S, i32, static_cast<float>(operand))
+    UNARY(F32ConvertI32U, u32, static_cast<float>(operand))
+    UNARY(F32ConvertI64S, i64, static_cast<float>(operand))
+    UNARY(F32ConvertI64U, u64, static_cast<float>(operand))
+    UNARY(F32DemoteF64, double, static_cast<float>(operand))
+    UNARY(F64ConvertI32S, i32, static_cast<double>(operand))
+    UNARY(F64ConvertI32U, u32, static_cast<double>(operand))
+    UNARY(F64ConvertI64S, i64, static_cast<double>(operand))
+    UNARY(F64ConvertI64U, u64, static_cast<double>(operand))
+    UNARY(F64PromoteF32, float, static_cast<double>(operand))
+    UNARY(I32TruncSatF32S, float, saturating_truncate<i32>(operand))
+    UNARY(I32TruncSatF32U, float, saturating_truncate<u32>(operand))
+    UNARY(I32TruncSatF64S, double, saturating_truncate<i32>(operand))
+    UNARY(I32TruncSatF64U, double, saturating_truncate<u32>(operand))
+    UNARY(I64TruncSatF32S, float, saturating_truncate<i64>(operand))
+    UNARY(I64TruncSatF32U, float, saturating_truncate<u64>(operand))
+    UNARY(I64TruncSatF64S, double, saturating_truncate<i64>(operand))
+    UNARY(I64TruncSatF64U, double, saturating_truncate<u64>(operand))
+#undef TRUNCATE
+#undef UNARY
+#undef BINARY
+
+call:
+    // The arguments on top of the caller's stack become the start of the callee's locals.
+    {
+        if (!callee || call_frames.size() - entry_depth >= Configuration::max_call_depth)
+            goto trap;
+        auto new_base = static_cast<size_t>(sp - value_stack.data()) - callee->parameter_count;
+        if (new_base + callee->max_stack_height > value_stack.size()) {
+            auto fp_offset = fp - value_stack.data();
+            if (!configuration.ensure_value_stack_size(new_base + callee->max_stack_height))
+                goto trap;
+            fp = value_stack.data() + fp_offset;
+        }
+        call_frames.append(CallFrame { code, ip + 1, static_cast<size_t>(fp - value_stack.data()) });
+        code = callee;
+        ip = code->instructions.data();
+        fp = value_stack.data() + new_base;
+        sp = fp + code->parameter_count;
+        for (auto i = code->parameter_count; i < code->local_count; ++i)
+            *sp++ = 0;
+        refresh_memory();
+        DISPATCH();
+    }
+
+trap:
+    call_frames.shrink(entry_depth);
+    return false;
+
+#undef DISPATCH
+#undef NEXT
+#undef HANDLER
+#undef JUMP_TO
 }
 
 }
@@ -11,7 +11,9 @@
 namespace Wasm {
 
 struct Interpreter {
-    void interpret(Configuration&);
+    // Runs the code with its arguments already placed at the given base of the value stack, leaving its results there.
+    // Returns false if execution trapped.
+    bool interpret(Configuration&, const CompiledCode&, size_t base);
 };
 
 }
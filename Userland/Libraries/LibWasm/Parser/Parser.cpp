@@ -765,6 +765,9 @@ ParseResult<ImportSection::Import> ImportSection::Import::parse(InputStream& str
     if (stream.has_any_error())
         return with_eof_check(stream, ParseError::ExpectedKindTag);
 
+    // GCC can't tell that moving the ImportDesc only reads the alternative that was set.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
     switch (tag) {
     case Constants::extern_function_tag: {
         auto index = GenericIndexParser<TypeIndex>::parse(stream);
@@ -781,6 +784,7 @@ ParseResult<ImportSection::Import> ImportSection::Import::parse(InputStream& str
     default:
         return with_eof_check(stream, ParseError::InvalidTag);
     }
+#pragma GCC diagnostic pop
 }
 
 ParseResult<ImportSection> ImportSection::parse(InputStream& stream)
@@ -800,9 +804,9 @@ ParseResult<FunctionSection> FunctionSection::parse(InputStream& stream)
         return indices.error();
 
     Vector<TypeIndex> typed_indices;
-    typed_indices.resize(indices.value().size());
+    typed_indices.ensure_capacity(indices.value().size());
     for (auto entry : indices.value())
-        typed_indices.append(entry);
+        typed_indices.unchecked_append(entry);
 
     return FunctionSection { move(typed_indices) };
 }
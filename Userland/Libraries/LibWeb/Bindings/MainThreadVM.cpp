@@ -4,16 +4,41 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <LibCore/Timer.h>
+#include <LibJS/Heap/Heap.h>
 #include <LibJS/Runtime/VM.h>
 #include <LibWeb/Bindings/MainThreadVM.h>
 
 namespace Web::Bindings {
 
+// Full garbage collections are done a bit at a time, whenever the event loop gets to it,
+// so they don't hold up input handling and painting for too long.
+static constexpr u64 incremental_gc_step_microseconds = 2000;
+
+static void schedule_incremental_gc_step(JS::Heap& heap)
+{
+    static RefPtr<Core::Timer> timer;
+    if (!timer) {
+        timer = Core::Timer::create_single_shot(0, [&heap] {
+            heap.perform_incremental_step();
+            if (heap.is_collecting_incrementally())
+                timer->start();
+        });
+    }
+    timer->start();
+}
+
 JS::VM& main_thread_vm()
 {
     static RefPtr<JS::VM> vm;
-    if (!vm)
+    if (!vm) {
         vm = JS::VM::create();
+        auto& heap = vm->heap();
+        heap.set_incremental_step_microseconds(incremental_gc_step_microseconds);
+        heap.on_incremental_collection_start = [&heap] {
+            schedule_incremental_gc_step(heap);
+        };
+    }
     return *vm;
 }
 
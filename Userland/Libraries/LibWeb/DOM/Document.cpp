@@ -11,6 +11,7 @@
 #include <LibCore/Timer.h>
 #include <LibJS/Interpreter.h>
 #include <LibJS/Parser.h>
+#include <LibJS/ProgramCache.h>
 #include <LibJS/Runtime/Function.h>
 #include <LibWeb/Bindings/MainThreadVM.h>
 #include <LibWeb/Bindings/WindowObject.h>
@@ -661,13 +662,26 @@ JS::Interpreter& Document::interpreter()
     return *m_interpreter;
 }
 
+static JS::ProgramCache& program_cache()
+{
+    static JS::ProgramCache cache;
+    return cache;
+}
+
 JS::Value Document::run_javascript(const StringView& source, const StringView& filename)
 {
-    auto parser = JS::Parser(JS::Lexer(source, filename));
-    auto program = parser.parse_program();
-    if (parser.has_errors()) {
-        parser.print_errors();
-        return JS::js_undefined();
+    auto program = program_cache().find(source, filename);
+    if (!program) {
+        // Most of the functions in a script never get called, so their bodies are only parsed once they are.
+        auto parser = JS::Parser(JS::Lexer(source, filename));
+        parser.set_parse_function_bodies_lazily(true);
+        auto parsed_program = parser.parse_program();
+        if (parser.has_errors()) {
+            parser.print_errors();
+            return JS::js_undefined();
+        }
+        program_cache().add(source, filename, parsed_program);
+        program = move(parsed_program);
     }
     auto& interpreter = document().interpreter();
     auto& vm = interpreter.vm();
@@ -13,6 +13,8 @@
 #include <LibCore/File.h>
 #include <LibCore/StandardPaths.h>
 #include <LibJS/AST.h>
+#include <LibJS/Bytecode/Block.h>
+#include <LibJS/Bytecode/Interpreter.h>
 #include <LibJS/Console.h>
 #include <LibJS/Interpreter.h>
 #include <LibJS/Parser.h>
@@ -57,10 +59,16 @@ private:
     JS_DECLARE_NATIVE_FUNCTION(repl_help);
     JS_DECLARE_NATIVE_FUNCTION(load_file);
     JS_DECLARE_NATIVE_FUNCTION(save_to_file);
+    JS_DECLARE_NATIVE_FUNCTION(inline_cache_statistics);
+    JS_DECLARE_NATIVE_FUNCTION(gc_statistics);
 };
 
 static bool s_dump_ast = false;
+static bool s_dump_bytecode = false;
+static bool s_parse_lazily = false;
 static bool s_print_last_result = false;
+static bool s_print_inline_cache_statistics = false;
+static bool s_print_gc_statistics = false;
 static RefPtr<Line::Editor> s_editor;
 static String s_history_path = String::formatted("{}/.js-history", Core::StandardPaths::home_directory());
 static int s_repl_line_level = 0;
@@ -469,11 +477,19 @@ static bool write_to_file(const String& path)
 static bool parse_and_run(JS::Interpreter& interpreter, const StringView& source)
 {
     auto parser = JS::Parser(JS::Lexer(source));
+    parser.set_parse_function_bodies_lazily(s_parse_lazily);
     auto program = parser.parse_program();
 
     if (s_dump_ast)
         program->dump(0);
 
+    if (s_dump_bytecode && !parser.has_errors()) {
+        if (auto* block = program->bytecode_block())
+            block->dump();
+        else
+            outln("(The program uses something the bytecode generator doesn't support)");
+    }
+
     if (parser.has_errors()) {
         auto error = parser.errors()[0];
         auto hint = error.source_location_hint(source);
@@ -541,12 +557,32 @@ void ReplObject::initialize_global_object()
     define_native_function("help", repl_help);
     define_native_function("load", load_file, 1);
     define_native_function("save", save_to_file, 1);
+    define_native_function("inlineCacheStatistics", inline_cache_statistics);
+    define_native_function("gcStatistics", gc_statistics);
 }
 
 ReplObject::~ReplObject()
 {
 }
 
+static void print_gc_statistics(const JS::GarbageCollectionStatistics& statistics)
+{
+    auto print_collections = [](const char* name, const JS::GarbageCollectionStatistics::Collections& collections) {
+        outln("{}: {}, {} us total, {} us longest", name, collections.count, collections.total_pause_microseconds, collections.longest_pause_microseconds);
+        for (size_t bucket = 0; bucket < collections.pause_histogram.size(); ++bucket) {
+            if (!collections.pause_histogram[bucket])
+                continue;
+            if (bucket == collections.pause_histogram.size() - 1)
+                outln("    >= {} us: {}", 1ull << (bucket - 1), collections.pause_histogram[bucket]);
+            else
+                outln("    < {} us: {}", 1ull << bucket, collections.pause_histogram[bucket]);
+        }
+    };
+    print_collections("Minor collections", statistics.minor);
+    print_collections("Full collections", statistics.full);
+    print_collections("Incremental steps", statistics.incremental_steps);
+}
+
 JS_DEFINE_NATIVE_FUNCTION(ReplObject::save_to_file)
 {
     if (!vm.argument_count())
@@ -576,9 +612,39 @@ JS_DEFINE_NATIVE_FUNCTION(ReplObject::repl_help)
     outln("    help(): display this menu");
     outln("    load(files): accepts filenames as params to load into running session. For example load(\"js/1.js\", \"js/2.js\", \"js/3.js\")");
     outln("    save(file): accepts a filename, writes REPL input history to a file. For example: save(\"foo.txt\")");
+    outln("    inlineCacheStatistics(): returns how many property lookups hit and missed the inline caches so far");
+    outln("    gcStatistics(): returns how many minor and full garbage collections ran so far, and how long they took");
     return JS::js_undefined();
 }
 
+JS_DEFINE_NATIVE_FUNCTION(ReplObject::inline_cache_statistics)
+{
+    auto& statistics = vm.inline_cache_statistics();
+    auto* object = JS::Object::create_empty(global_object);
+    object->define_property("hits", JS::Value(static_cast<double>(statistics.hits)));
+    object->define_property("misses", JS::Value(static_cast<double>(statistics.misses)));
+    auto lookups = statistics.hits + statistics.misses;
+    object->define_property("hitRate", JS::Value(lookups ? static_cast<double>(statistics.hits) / lookups : 0.0));
+    return object;
+}
+
+JS_DEFINE_NATIVE_FUNCTION(ReplObject::gc_statistics)
+{
+    auto collections_object = [&](const JS::GarbageCollectionStatistics::Collections& collections) {
+        auto* object = JS::Object::create_empty(global_object);
+        object->define_property("count", JS::Value(static_cast<double>(collections.count)));
+        object->define_property("totalPauseMicroseconds", JS::Value(static_cast<double>(collections.total_pause_microseconds)));
+        object->define_property("longestPauseMicroseconds", JS::Value(static_cast<double>(collections.longest_pause_microseconds)));
+        return object;
+    };
+    auto& statistics = vm.heap().statistics();
+    auto* object = JS::Object::create_empty(global_object);
+    object->define_property("minor", collections_object(statistics.minor));
+    object->define_property("full", collections_object(statistics.full));
+    object->define_property("incrementalSteps", collections_object(statistics.incremental_steps));
+    return object;
+}
+
 JS_DEFINE_NATIVE_FUNCTION(ReplObject::load_file)
 {
     if (!vm.argument_count())
@@ -713,14 +779,22 @@ public:
 int main(int argc, char** argv)
 {
     bool gc_on_every_allocation = false;
+    int gc_step_microseconds = 0;
     bool disable_syntax_highlight = false;
+    bool run_bytecode = false;
     const char* script_path = nullptr;
 
     Core::ArgsParser args_parser;
     args_parser.set_general_help("This is a JavaScript interpreter.");
     args_parser.add_option(s_dump_ast, "Dump the AST", "dump-ast", 'A');
+    args_parser.add_option(s_dump_bytecode, "Dump the bytecode", "dump-bytecode", 'd');
+    args_parser.add_option(run_bytecode, "Run the bytecode where possible", "run-bytecode", 'b');
+    args_parser.add_option(s_parse_lazily, "Only parse function bodies once they're called", "lazy-parse", 0);
+    args_parser.add_option(s_print_inline_cache_statistics, "Print inline cache statistics on exit", "inline-cache-statistics", 'c');
+    args_parser.add_option(s_print_gc_statistics, "Print garbage collection statistics on exit", "gc-statistics", 0);
     args_parser.add_option(s_print_last_result, "Print last result", "print-last-result", 'l');
     args_parser.add_option(gc_on_every_allocation, "GC on every allocation", "gc-on-every-allocation", 'g');
+    args_parser.add_option(gc_step_microseconds, "Do full GCs incrementally, in steps of about this long", "incremental-gc", 0, "microseconds");
     args_parser.add_option(disable_syntax_highlight, "Disable live syntax highlighting", "no-syntax-highlight", 's');
     args_parser.add_positional_argument(script_path, "Path to script file", "script", Core::ArgsParser::Required::No);
     args_parser.parse(argc, argv);
@@ -728,6 +802,9 @@ int main(int argc, char** argv)
     bool syntax_highlight = !disable_syntax_highlight;
 
     vm = JS::VM::create();
+    OwnPtr<JS::Bytecode::Interpreter> bytecode_interpreter;
+    if (run_bytecode)
+        bytecode_interpreter = make<JS::Bytecode::Interpreter>(*vm);
     // NOTE: These will print out both warnings when using something like Promise.reject().catch(...) -
     // which is, as far as I can tell, correct - a promise is created, rejected without handler, and a
     // handler then attached to it. The Node.js REPL doesn't warn in this case, so it's something we
@@ -761,6 +838,7 @@ int main(int argc, char** argv)
         ReplConsoleClient console_client(interpreter->global_object().console());
         interpreter->global_object().console().set_client(console_client);
         interpreter->heap().set_should_collect_on_every_allocation(gc_on_every_allocation);
+        interpreter->heap().set_incremental_step_microseconds(gc_step_microseconds);
         interpreter->vm().set_underscore_is_last_value(true);
 
         s_editor = Line::Editor::construct();
@@ -963,6 +1041,7 @@ int main(int argc, char** argv)
         ReplConsoleClient console_client(interpreter->global_object().console());
         interpreter->global_object().console().set_client(console_client);
         interpreter->heap().set_should_collect_on_every_allocation(gc_on_every_allocation);
+        interpreter->heap().set_incremental_step_microseconds(gc_step_microseconds);
 
         signal(SIGINT, [](int) {
             sigint_handler();
@@ -982,7 +1061,15 @@ int main(int argc, char** argv)
             source = file_contents;
         }
 
-        if (!parse_and_run(*interpreter, source))
+        bool success = parse_and_run(*interpreter, source);
+        if (s_print_inline_cache_statistics) {
+            auto& statistics = vm->inline_cache_statistics();
+            auto lookups = statistics.hits + statistics.misses;
+            outln("Inline caches: {} hits, {} misses ({:.1}% hit rate)", statistics.hits, statistics.misses, lookups ? 100.0 * statistics.hits / lookups : 0.0);
+        }
+        if (s_print_gc_statistics)
+            print_gc_statistics(vm->heap().statistics());
+        if (!success)
             return 1;
     }
 
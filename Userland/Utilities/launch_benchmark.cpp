@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/NumericLimits.h>
+#include <AK/Vector.h>
+#include <LibCore/ArgsParser.h>
+#include <LibCore/ElapsedTimer.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <spawn.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+struct Result {
+    i64 min_ms { NumericLimits<i64>::max() };
+    i64 max_ms { 0 };
+    i64 total_ms { 0 };
+    int runs { 0 };
+};
+
+static bool spawn_and_wait(Vector<const char*> const& command, i64& elapsed_ms)
+{
+    posix_spawn_file_actions_t file_actions;
+    posix_spawn_file_actions_init(&file_actions);
+    posix_spawn_file_actions_addopen(&file_actions, STDOUT_FILENO, "/dev/null", O_WRONLY, 0);
+    posix_spawn_file_actions_addopen(&file_actions, STDERR_FILENO, "/dev/null", O_WRONLY, 0);
+
+    Core::ElapsedTimer timer;
+    timer.start();
+
+    pid_t child_pid;
+    errno = posix_spawnp(&child_pid, command[0], &file_actions, nullptr, const_cast<char**>(command.data()), environ);
+    posix_spawn_file_actions_destroy(&file_actions);
+    if (errno) {
+        perror("posix_spawn");
+        return false;
+    }
+
+    int status;
+    if (waitpid(child_pid, &status, 0) < 0) {
+        perror("waitpid");
+        return false;
+    }
+
+    elapsed_ms = timer.elapsed();
+    return true;
+}
+
+static Optional<Result> run_benchmark(Vector<const char*> const& command, int iterations)
+{
+    Result result;
+    for (int i = 0; i < iterations; ++i) {
+        i64 elapsed_ms = 0;
+        if (!spawn_and_wait(command, elapsed_ms))
+            return {};
+        result.min_ms = min(result.min_ms, elapsed_ms);
+        result.max_ms = max(result.max_ms, elapsed_ms);
+        result.total_ms += elapsed_ms;
+        ++result.runs;
+    }
+    return result;
+}
+
+static void print_result(const char* label, Result const& result)
+{
+    outln("{}: min {} ms, avg {} ms, max {} ms ({} runs)", label, result.min_ms, result.total_ms / result.runs, result.max_ms, result.runs);
+}
+
+int main(int argc, char** argv)
+{
+    int iterations = 10;
+    const char* prelink_cache_directory = nullptr;
+    Vector<const char*> command;
+
+    Core::ArgsParser args_parser;
+    args_parser.set_general_help("Measure how long it takes to launch and run a program to completion.");
+    args_parser.add_option(iterations, "Number of launches to time", "iterations", 'n', "count");
+    args_parser.add_option(prelink_cache_directory, "Also time launches with the dynamic loader's prelink cache in this directory", "prelink-cache", 'p', "directory");
+    args_parser.add_positional_argument(command, "Command to launch", "command");
+    args_parser.parse(argc, argv);
+
+    if (iterations <= 0) {
+        warnln("Number of iterations must be positive");
+        return 1;
+    }
+    command.append(nullptr);
+
+    unsetenv("_LOADER_PRELINK_CACHE");
+    auto result = run_benchmark(command, iterations);
+    if (!result.has_value())
+        return 1;
+    print_result("default", result.value());
+
+    if (!prelink_cache_directory)
+        return 0;
+
+    setenv("_LOADER_PRELINK_CACHE", prelink_cache_directory, 1);
+
+    // The first launch populates the cache, so keep it out of the measurements.
+    i64 warmup_ms = 0;
+    if (!spawn_and_wait(command, warmup_ms))
+        return 1;
+
+    auto cached_result = run_benchmark(command, iterations);
+    if (!cached_result.has_value())
+        return 1;
+    print_result("prelinked", cached_result.value());
+
+    return 0;
+}
@@ -4,9 +4,9 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
-#include <AK/QuickSort.h>
 #include <AK/String.h>
 #include <AK/Vector.h>
+#include <LibThread/ParallelSort.h>
 #include <errno.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -15,7 +15,7 @@
 
 int main([[maybe_unused]] int argc, [[maybe_unused]] char** argv)
 {
-    if (pledge("stdio", nullptr) > 0) {
+    if (pledge("stdio thread", nullptr) > 0) {
         perror("pledge");
         return 1;
     }
@@ -37,7 +37,7 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char** argv)
         lines.append({ buffer, AK::ShouldChomp::Chomp });
     }
 
-    quick_sort(lines, [](auto& a, auto& b) {
+    LibThread::parallel_sort(lines, [](auto& a, auto& b) {
         return strcmp(a.characters(), b.characters()) < 0;
     });
 
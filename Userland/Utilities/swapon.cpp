@@ -0,0 +1,32 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/ArgsParser.h>
+#include <serenity.h>
+#include <stdio.h>
+
+int main(int argc, char** argv)
+{
+    const char* path = nullptr;
+    int size_in_kib = 0;
+
+    Core::ArgsParser args_parser;
+    args_parser.set_general_help("Start swapping out memory to a file or block device.");
+    args_parser.add_option(size_in_kib, "How much of it to use, in KiB (all of it by default, required for block devices)", "size", 's', "size");
+    args_parser.add_positional_argument(path, "Swap file or block device", "path");
+    args_parser.parse(argc, argv);
+
+    if (size_in_kib < 0) {
+        warnln("Invalid size: {}", size_in_kib);
+        return 1;
+    }
+
+    if (swapon(path, static_cast<size_t>(size_in_kib) * KiB) < 0) {
+        perror("swapon");
+        return 1;
+    }
+    return 0;
+}
@@ -11,6 +11,7 @@
 #include <AK/QuickSort.h>
 #include <AK/String.h>
 #include <AK/Vector.h>
+#include <LibCore/File.h>
 #include <LibCore/ProcessStatisticsReader.h>
 #include <fcntl.h>
 #include <signal.h>
@@ -72,7 +73,9 @@ struct Snapshot {
 
 static Snapshot get_snapshot()
 {
-    auto all_processes = Core::ProcessStatisticsReader::get_all();
+    // Keeping /proc/processes open lets every refresh after the first only read what changed since the last one.
+    static Core::ProcessStatisticsReader::ProcessesFile proc_processes;
+    auto all_processes = Core::ProcessStatisticsReader::get_all(proc_processes);
     if (!all_processes.has_value())
         return {};
 
@@ -122,7 +125,7 @@ int main(int, char**)
         return 1;
     }
 
-    if (unveil("/proc/all", "r") < 0) {
+    if (unveil("/proc/processes", "r") < 0) {
         perror("unveil");
         return 1;
     }
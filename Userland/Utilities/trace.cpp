@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Vector.h>
+#include <Kernel/API/Syscall.h>
+#include <Kernel/API/TraceEvent.h>
+#include <LibCore/ArgsParser.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdio.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+static bool g_interrupted = false;
+
+static void handle_sigint(int)
+{
+    g_interrupted = true;
+}
+
+static Optional<TraceCategory> parse_categories(StringView const& list)
+{
+    auto categories = TraceCategory::None;
+    for (auto& name : list.split_view(',')) {
+        if (name == "all")
+            categories |= TraceCategory::All;
+        else if (name == "sched")
+            categories |= TraceCategory::Scheduler;
+        else if (name == "pagefault")
+            categories |= TraceCategory::PageFault;
+        else if (name == "blockio")
+            categories |= TraceCategory::BlockIO;
+        else if (name == "syscall")
+            categories |= TraceCategory::Syscall;
+        else
+            return {};
+    }
+    return categories;
+}
+
+static void print_event(TraceEvent const& event)
+{
+    // NOTE: TraceEvent is packed, so copy fields out before handing them to the formatter.
+    u64 timestamp_ns = event.timestamp_ns;
+    u16 cpu = event.cpu;
+    u32 pid = event.pid;
+    u32 tid = event.tid;
+    out("{:>6}.{:09} [{}] {:>4}:{:<4} ", timestamp_ns / 1'000'000'000, timestamp_ns % 1'000'000'000, cpu, pid, tid);
+
+    switch (event.type) {
+    case TraceEventType::EventsLost: {
+        u32 count = event.data.events_lost.count;
+        outln("events_lost count={}", count);
+        break;
+    }
+    case TraceEventType::ContextSwitch: {
+        auto data = event.data.context_switch;
+        u32 next_pid = data.next_pid;
+        u32 next_tid = data.next_tid;
+        u32 previous_state = data.previous_state;
+        outln("sched_switch next={}:{} prev_state={}", next_pid, next_tid, previous_state);
+        break;
+    }
+    case TraceEventType::PageFault: {
+        auto data = event.data.page_fault;
+        FlatPtr vaddr = data.vaddr;
+        u16 code = data.code;
+        outln("page_fault vaddr={:p} code={:#04x}", vaddr, code);
+        break;
+    }
+    case TraceEventType::BlockIOSubmit:
+    case TraceEventType::BlockIOComplete: {
+        auto data = event.data.block_io;
+        u32 major = data.major;
+        u32 minor = data.minor;
+        u64 block_index = data.block_index;
+        u32 block_count = data.block_count;
+        out("{} dev={},{} {} block={} count={}",
+            event.type == TraceEventType::BlockIOSubmit ? "block_submit" : "block_complete",
+            major, minor, data.is_write ? "write" : "read", block_index, block_count);
+        if (event.type == TraceEventType::BlockIOComplete)
+            out(" result={}", static_cast<u8>(data.result));
+        outln();
+        break;
+    }
+    case TraceEventType::SyscallEnter:
+    case TraceEventType::SyscallExit: {
+        auto data = event.data.syscall;
+        u32 function = data.function;
+        FlatPtr value = data.value;
+        auto name = function < Syscall::Function::__Count ? Syscall::to_string(static_cast<Syscall::Function>(function)) : "unknown";
+        if (event.type == TraceEventType::SyscallEnter)
+            outln("syscall_enter {} arg1={:p}", name, value);
+        else
+            outln("syscall_exit {} result={}", name, static_cast<ssize_t>(value));
+        break;
+    }
+    default:
+        outln("unknown event type {}", static_cast<u16>(event.type));
+        break;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (pledge("stdio rpath sigaction", nullptr) < 0) {
+        perror("pledge");
+        return 1;
+    }
+
+    const char* enable_argument = nullptr;
+    bool disable = false;
+    bool follow = false;
+
+    Core::ArgsParser args_parser;
+    args_parser.set_general_help("Control kernel tracepoints and dump the recorded events.");
+    args_parser.add_option(enable_argument, "Enable the given comma-separated categories (sched, pagefault, blockio, syscall, all)", "enable", 'e', "categories");
+    args_parser.add_option(disable, "Disable all categories", "disable", 'd');
+    args_parser.add_option(follow, "Keep streaming events until interrupted", "follow", 'f');
+    args_parser.parse(argc, argv);
+
+    int fd = open("/dev/trace", O_RDONLY);
+    if (fd < 0) {
+        perror("open /dev/trace");
+        return 1;
+    }
+
+    if (enable_argument || disable) {
+        auto categories = TraceCategory::None;
+        if (enable_argument) {
+            auto parsed_categories = parse_categories(enable_argument);
+            if (!parsed_categories.has_value()) {
+                warnln("Invalid category list: {}", enable_argument);
+                return 1;
+            }
+            categories = parsed_categories.value();
+        }
+        if (ioctl(fd, TRACE_IOCTL_SET_CATEGORIES, static_cast<u32>(categories)) < 0) {
+            perror("ioctl");
+            return 1;
+        }
+        if (!follow)
+            return 0;
+    }
+
+    if (pledge("stdio sigaction", nullptr) < 0) {
+        perror("pledge");
+        return 1;
+    }
+
+    struct sigaction sa = {};
+    sa.sa_handler = handle_sigint;
+    sigaction(SIGINT, &sa, nullptr);
+
+    Vector<TraceEvent> events;
+    events.resize(256);
+    while (!g_interrupted) {
+        auto nread = read(fd, events.data(), events.size() * sizeof(TraceEvent));
+        if (nread < 0) {
+            if (errno == EINTR)
+                continue;
+            perror("read");
+            return 1;
+        }
+        auto count = static_cast<size_t>(nread) / sizeof(TraceEvent);
+        for (size_t i = 0; i < count; ++i)
+            print_event(events[i]);
+        if (count == 0) {
+            if (!follow)
+                break;
+            usleep(100'000);
+        }
+    }
+
+    return 0;
+}
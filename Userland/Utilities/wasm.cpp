@@ -10,22 +10,55 @@
 #include <LibWasm/AbstractMachine/AbstractMachine.h>
 #include <LibWasm/Printer/Printer.h>
 #include <LibWasm/Types.h>
+#include <stdlib.h>
+
+static Optional<Wasm::Value> parse_value(const Wasm::ValueType& type, const String& text)
+{
+    switch (type.kind()) {
+    case Wasm::ValueType::I32:
+        if (auto value = text.to_int<i32>(); value.has_value())
+            return Wasm::Value::from_raw(type, static_cast<u32>(value.value()));
+        if (auto value = text.to_uint<u32>(); value.has_value())
+            return Wasm::Value::from_raw(type, value.value());
+        return {};
+    case Wasm::ValueType::I64:
+        if (auto value = text.to_int<i64>(); value.has_value())
+            return Wasm::Value::from_raw(type, static_cast<u64>(value.value()));
+        if (auto value = text.to_uint<u64>(); value.has_value())
+            return Wasm::Value::from_raw(type, value.value());
+        return {};
+    case Wasm::ValueType::F32:
+    case Wasm::ValueType::F64: {
+        char* end = nullptr;
+        auto value = strtod(text.characters(), &end);
+        if (text.is_empty() || *end != '\0')
+            return {};
+        if (type.kind() == Wasm::ValueType::F32)
+            return Wasm::Value::from_raw(type, bit_cast<u32>(static_cast<float>(value)));
+        return Wasm::Value::from_raw(type, bit_cast<u64>(value));
+    }
+    default:
+        return {};
+    }
+}
 
 int main(int argc, char* argv[])
 {
     const char* filename = nullptr;
     bool print = false;
     bool attempt_instantiate = false;
-    bool attemp_execute = false;
+    String exported_function_to_execute;
+    Vector<String> arguments;
 
     Core::ArgsParser parser;
     parser.add_positional_argument(filename, "File name to parse", "file");
     parser.add_option(print, "Print the parsed module", "print", 'p');
     parser.add_option(attempt_instantiate, "Attempt to instantiate the module", "instantiate", 'i');
-    parser.add_option(attemp_execute, "Attempt to execute a function from the module (implies -i)", "execute", 'e');
+    parser.add_option(exported_function_to_execute, "Execute the named exported function from the module (implies -i)", "execute", 'e', "name");
+    parser.add_positional_argument(arguments, "Arguments to pass to the executed function", "args", Core::ArgsParser::Required::No);
     parser.parse(argc, argv);
 
-    if (attemp_execute)
+    if (!exported_function_to_execute.is_empty())
         attempt_instantiate = true;
 
     auto result = Core::File::open(filename, Core::OpenMode::ReadOnly);
@@ -80,32 +113,46 @@ int main(int argc, char* argv[])
             }
         }
 
-        if (attemp_execute) {
+        if (!exported_function_to_execute.is_empty()) {
             Optional<Wasm::FunctionAddress> run_address;
-            Vector<Wasm::Value> values;
-            // Pick a function that takes no args :P
-            for (auto& address : machine.module_instance().functions()) {
-                auto fn = machine.store().get(address);
-                if (!fn)
+            for (auto& entry : machine.module_instance().exports()) {
+                if (entry.name() != exported_function_to_execute)
                     continue;
-                if (auto ptr = fn->get_pointer<Wasm::WasmFunction>()) {
-                    const Wasm::FunctionType& ty = ptr->type();
-                    for (auto& param : ty.parameters()) {
-                        values.append(Wasm::Value { param, 0ull });
-                    }
-                    run_address = address;
-                    break;
-                }
+                if (auto* address = entry.value().get_pointer<Wasm::FunctionAddress>())
+                    run_address = *address;
             }
             if (!run_address.has_value()) {
-                warnln("No nullary function, sorry :(");
+                warnln("No exported function named '{}'", exported_function_to_execute);
+                return 1;
+            }
+
+            auto* fn = machine.store().get(*run_address);
+            auto& type = fn->has<Wasm::WasmFunction>() ? fn->get<Wasm::WasmFunction>().type() : fn->get<Wasm::HostFunction>().type();
+            if (type.parameters().size() != arguments.size()) {
+                warnln("'{}' takes {} arguments, but {} were given", exported_function_to_execute, type.parameters().size(), arguments.size());
                 return 1;
             }
-            outln("Executing ");
-            print_func(*run_address);
-            outln();
+            Vector<Wasm::Value> values;
+            for (size_t i = 0; i < arguments.size(); ++i) {
+                auto value = parse_value(type.parameters()[i], arguments[i]);
+                if (!value.has_value()) {
+                    warnln("Invalid value for argument {}: '{}'", i, arguments[i]);
+                    return 1;
+                }
+                values.append(value.release_value());
+            }
+
+            if (print) {
+                outln("Executing ");
+                print_func(*run_address);
+                outln();
+            }
 
             auto result = machine.invoke(run_address.value(), move(values));
+            if (result.is_trap()) {
+                warnln("Execution trapped!");
+                return 1;
+            }
             if (!result.values().is_empty())
                 warnln("Returned:");
             for (auto& value : result.values()) {